@@ -0,0 +1,455 @@
+// This file has been automatically generated by utils/settings.rb
+// Don't make any modifications to it. They will be lost.
+
+#include "platform.h"
+#include "config/parameter_group_ids.h"
+#include "fc/settings.h"
+#include "common/axis.h"
+#include "common/maths.h"
+#include "fc/config.h"
+#include "fc/controlrate_profile.h"
+#include "flight/pid.h"
+#include "sensors/battery.h"
+#include "settings_unittest.h"
+const pgn_t settingsPgn[] = {
+	PG_SETTINGS_TEST,
+};
+const uint8_t settingsPgnCounts[] = {
+	200,
+};
+static const uint8_t settingNamesWords[] = {
+	0x35, /* "fw" */ 
+	0xc1,0x90,0xdc, /* "yaw" */ 
+	0x6,0xa,0x59,0x30,0x98,0xa0, /* "failsafe" */ 
+	0x68, /* "mc" */ 
+	0xc1,0x20,0xd0,0xa0, /* "rate" */ 
+	0x82,0x68,0x34, /* "pitch" */ 
+	0x2,0x4f,0x63, /* "roll" */ 
+	0x0,0x16,0x24,0xee, /* "align" */ 
+	0x1,0xf3,0x27, /* "gyro" */ 
+	0x81,0x1a, /* "hz" */ 
+	0x3,0x42,0x70, /* "mag" */ 
+	0x35,0x2e, /* "min" */ 
+	0x2, /* "i" */ 
+	0x41,0x0, /* "p" */ 
+	0x10,0xa1,0x20,0x82,0xe2, /* "deadband" */ 
+	0x0,0xf0,0x98, /* "gps" */ 
+	0x10,0x19,0x12,0xe1,0x91, /* "hardware" */ 
+	0x40,0xc8,0x18, /* "lpf" */ 
+	0xd,0xe, /* "max" */ 
+	0x0,0x42,0xb0,0x39, /* "delay" */ 
+	0x3,0xb,0x62,0xb0, /* "level" */ 
+	0x16,0x10,0x68, /* "vbat" */ 
+	0x0,0x8c,0x60, /* "acc" */ 
+	0xb,0x8e,0xc2, /* "angle" */ 
+	0x80,0x68,0xb,0x9c,0x56, /* "channel" */ 
+	0x0,0x80, /* "d" */ 
+	0x2e,0x20,0xf0, /* "expo" */ 
+	0x34,0x2e,0xa8,0x58, /* "manual" */ 
+	0x6,0xbe,0x8f,0x90, /* "motor" */ 
+	0x24,0x30, /* "rc" */ 
+	0x51,0x12,0x7d,0x28,0xc2, /* "throttle" */ 
+	0x82,0xcf,0x65,0x2,0x72, /* "voltage" */ 
+	0x83,0x64, /* "3d" */ 
+	0x0,0x48,0x30, /* "adc" */ 
+	0x6,0xb4,0x78, /* "auto" */ 
+	0x4,0x1a,0x50,0xb2,0xc8, /* "battery" */ 
+	0x6,0x18,0x4,0x69,0xa6, /* "capacity" */ 
+	0x40,0x32,0xb1,0x80, /* "cell" */ 
+	0x1d,0x65,0x22,0xba,0x80, /* "current" */ 
+	0x20,0xda, /* "dcm" */ 
+	0x4,0xb6,0xa0, /* "imu" */ 
+	0x94,0xe6,0x90, /* "rssi" */ 
+	0x4b,0x0, /* "rx" */ 
+	0x98,0xc2,0xc2, /* "scale" */ 
+	0x82,0x65,0x95,0x9e, /* "servo" */ 
+	0xa,0x25,0xa5, /* "time" */ 
+	0x5,0x33,0x2, /* "type" */ 
+	0x80,0x23,0x19,0xc2,0x97, /* "accgain" */ 
+	0x0,0x23,0x1e,0x8b,0x27, /* "acczero" */ 
+	0x80,0x41,0x93, /* "baro" */ 
+	0xc0,0x26,0x4,0x6b,0x13,0xf0, /* "blackbox" */ 
+	0x1,0x3c,0x32,0x20, /* "board" */ 
+	0x7,0x5a,0x3c,0xc6, /* "cutoff" */ 
+	0x1,0x13,0x30,0xc9,0xa0, /* "disarm" */ 
+	0x31, /* "ff" */ 
+	0x80,0x64,0xb2,0x85,0x90, /* "filter" */ 
+	0x1a,0x13,0xe8,0xb2,0x78, /* "magzero" */ 
+	0x1a,0x5a,0x16,0x40, /* "meter" */ 
+	0x7c,0xc,0xc7,0xdc, /* "opflow" */ 
+	0x10,0x4d,0x1f,0x40, /* "pitot" */ 
+	0x42,0xed, /* "pwm" */ 
+	0x4,0xcb,0x24,0x85,0x92,0xc0, /* "serialrx" */ 
+	0x28,0x89, /* "thr" */ 
+	0x2,0x90,0x8, /* "tpa" */ 
+	0x2b,0x32, /* "use" */ 
+	0x83,0x0, /* "x" */ 
+	0xc8, /* "y" */ 
+	0x34, /* "z" */ 
+	0x0,0xa6,0x53,0x81,0x4a,0x40, /* "airspeed" */ 
+	0x8,0x34, /* "bat" */ 
+	0x0,0xd0,0x51,0xac, /* "check" */ 
+	0x4,0x2d,0xa,0x3a, /* "detect" */ 
+	0x0,0x89,0x91,0x47,0x44,0xbd,0xc0, /* "direction" */ 
+	0x22,0x67,0x40,0xb8,0x65, /* "distance" */ 
+	0x1,0x28,0x59,0x34, /* "dterm" */ 
+	0x8,0x7b,0x8, /* "hold" */ 
+	0x4,0xb8,0x6c,0x4b,0x83,0x44,0xbd,0xc0, /* "inclination" */ 
+	0x4b,0xac,0x59,0x50,0xa4, /* "inverted" */ 
+	0x2,0xd2, /* "ki" */ 
+	0x5,0xc0, /* "kp" */ 
+	0xc,0x49,0xd1,0x49, /* "lights" */ 
+	0x81,0x89,0x6a,0x68, /* "limit" */ 
+	0x6,0x3e,0xe0, /* "low" */ 
+	0x69,0x48,0x90,0xb8, /* "median" */ 
+	0xd,0x79,0xa,0xc0, /* "model" */ 
+	0x39,0xf4,0x1a, /* "notch" */ 
+	0x0,0xe7,0xd0,0x68,0xe0, /* "notch1" */ 
+	0x1c,0xfa,0xd,0x1d, /* "notch2" */ 
+	0x3,0xcc,0x69,0x96,0x80, /* "offset" */ 
+	0x83,0xee,0x59, /* "power" */ 
+	0x2,0x12,0x78,0xca,0x4a,0xc8,0xa0, /* "procedure" */ 
+	0x84,0x9f,0x47,0x8d,0xec, /* "protocol" */ 
+	0x4,0x24,0xfb,0x24,0x85,0x90, /* "provider" */ 
+	0x24,0x17,0x1c,0xa6,0x4b,0x88,0x59, /* "rangefinder" */ 
+	0x2,0x70,0x48, /* "spi" */ 
+	0x27,0x74,0xd0,0x68, /* "switch" */ 
+	0x4,0xf2,0xe1, /* "sync" */ 
+	0x82,0x88,0x91,0x66,0x87,0xb0,0x80, /* "threshold" */ 
+	0xa2,0x24,0xfb, /* "throw" */ 
+	0x82,0x8f, /* "to" */ 
+	0x5,0x66,0x51, /* "usec" */ 
+	0x82,0xe1,0x93,0x92,0xe3, /* "warning" */ 
+	0x82,0xe5,0x49,0xd1,0x40, /* "weight" */ 
+	0x4,0x63,0x2b, /* "accel" */ 
+	0x0,0x16,0x50, /* "alt" */ 
+	0x1,0x93, /* "arm" */ 
+	0x40,0x19,0x35,0x2e,0x38, /* "arming" */ 
+	0x4,0x1a,0x90, /* "baud" */ 
+	0x2,0x4b,0x88, /* "bind" */ 
+	0x1,0x48,0xa1,0x5c,0x1e,0x97,0x50, /* "breakpoint" */ 
+	0x3,0xb, /* "cal" */ 
+	0x0,0x30,0xb1,0x22,0x90,0x68,0x97,0xb8, /* "calibration" */ 
+	0x3,0x2b,0x19,0x30, /* "cells" */ 
+	0xc,0xae,0xa1,0x64, /* "center" */ 
+	0x1,0xa0,0x32,0x8,0xe8,0x59, /* "character" */ 
+	0x0,0x6f,0x6b,0x42,0xe2, /* "command" */ 
+	0x0,0x6f,0x6c, /* "comp" */ 
+	0x0,0x37,0xb8,0xc9,0x38, /* "config" */ 
+	0x6,0xf7,0x4e,0x81,0x75, /* "constant" */ 
+	0x0,0x39,0x26,0x89,0x18,0x58, /* "critical" */ 
+	0x1,0xca,0xa9,0x99, /* "cruise" */ 
+	0x40,0x42,0x8c,0xac, /* "decel" */ 
+	0x1,0xa,0x36,0x25,0xc1,0xa2,0x5e,0xe0, /* "declination" */ 
+	0x10,0xa7,0x91,0x4b,0x30, /* "degrees" */ 
+	0x10,0xae,0x7b, /* "denom" */ 
+	0x40,0x42,0xd9,0x23,0x28, /* "device" */ 
+	0x9,0x97, /* "dyn" */ 
+	0x0,0xae,0x2c,0x8f,0x90, /* "energy" */ 
+	0x17,0x14,0x90, /* "extra" */ 
+	0x40,0x60,0xa5,0x93,0x9,0x8b,0xe6,0x24,0xe8,0xa4,0xfc,0x66,0x6,0x68,0xf3,0xdd,0xea,0x25,0xa5, /* "failsafe_lights_flash_on_time" */ 
+	0x1,0x93,0x82,0x90, /* "fixed" */ 
+	0x6,0x60,0x60,0x59,0x3d,0xc0, /* "flaperon" */ 
+	0x33,0x3,0x9, /* "flaps" */ 
+	0x80,0xcc,0xc,0xd0, /* "flash" */ 
+	0x3,0x42,0xc0, /* "fpv" */ 
+	0x34,0x8b,0x1a,0x95,0xc3,0xc8, /* "frequency" */ 
+	0xd,0x7f,0x26,0x85,0x93,0x7c,0xc4,0xb5,0x34,0xf4,0xe8,0x91,0xaf,0xd0,0x7c,0xd3,0x44,0xbd,0xc0, /* "fw_iterm_limit_stick_position" */ 
+	0x35,0xfc,0xd4,0xbb,0xd4,0x44,0x9f,0x4a,0x30,0xbe,0x23,0xee,0xef,0x41,0x34,0x1a, /* "fw_min_throttle_down_pitch" */ 
+	0x0,0x6b,0xfa,0x95,0x93,0xbc,0x19,0xcd,0x33,0xa7,0xb2,0x1b,0xf8,0xe1,0x4b, /* "fw_turn_assist_yaw_gain" */ 
+	0x80,0x70,0xb1,0x2c,0x2b, /* "galileo" */ 
+	0xc0,0x80,0xb0,0xc4,0xac,0x18,0x5c, /* "halfduplex" */ 
+	0x1,0x1,0x98, /* "has" */ 
+	0x10,0x93,0xa0, /* "high" */ 
+	0x9,0x20, /* "id" */ 
+	0x12,0x46,0x14, /* "idle" */ 
+	0x9,0x75,0xb,0x2b,0x5,0x80, /* "interval" */ 
+	0x4d,0xb,0x26, /* "iterm" */ 
+	0x81,0x55,0x6c, /* "jump" */ 
+	0x0,0xb4,0xb1,0x80, /* "kill" */ 
+	0x63,0xd3,0x42,0xc8, /* "loiter" */ 
+	0xc,0x7b,0xe1,0x44,0xb4,0xa0, /* "looptime" */ 
+	0x63,0xef,0x0,0xce,0x60, /* "lowpass" */ 
+	0x68,0x64,0x74,0xb8, /* "margin" */ 
+	0xd,0x49, /* "mid" */ 
+	0x0,0xd4,0xb1,0x89, /* "milli" */ 
+	0x3,0x53,0x80, /* "mix" */ 
+	0x35,0xe4,0x28, /* "mode" */ 
+	0x1a,0xf9,0x3d,0xc0, /* "moron" */ 
+	0x70,0x6c, /* "nav" */ 
+	0x7,0x16,0xb4,0x90,0x58, /* "neutral" */ 
+	0x7,0x55,0xa0, /* "num" */ 
+	0x79,0x8c, /* "off" */ 
+	0x8,0x16,0x49,0x79, /* "period" */ 
+	0x1,0x4,0xd0, /* "pit" */ 
+	0x10,0x60,0x68,0x67,0xc9,0xa0, /* "platform" */ 
+	0x83,0xe6, /* "pos" */ 
+	0x8,0x48,0xb6,0x2b,0xa8,0x97,0xb8, /* "prevention" */ 
+	0x10,0x91,0x6c,0x92,0xdc, /* "preview" */ 
+	0x10,0xab,0x26,0x50, /* "pulse" */ 
+	0x48,0xa2,0x7b,0xe8, /* "reboot" */ 
+	0x9,0x14,0x65,0x4d,0x8b,0x20, /* "receiver" */ 
+	0x48,0xa3,0x7d,0x8b,0x2c, /* "recovery" */ 
+	0x82,0x45,0x31,0x64,0x57,0xc,0xa0, /* "reference" */ 
+	0x93,0x18, /* "rll" */ 
+	0x9,0x51,0x0, /* "rth" */ 
+	0x96,0x3d,0x38,0x27,0xd2,0x37,0x86,0x80,0xb9,0xc5,0x67,0x86,0xfa,0xba,0x80, /* "rx_spi_rf_channel_count" */ 
+	0x98,0x4c,0x5a,0x64, /* "safety" */ 
+	0x13,0xd, /* "sat" */ 
+	0x1,0x30,0xd2,0x60, /* "sats" */ 
+	0x98,0x83,0x30, /* "sbas" */ 
+	0x4c,0x55,0x98, /* "sbus" */ 
+	0x26,0x41,0x86,0x44, /* "sdcard" */ 
+	0x4,0xcb,0x48,0x3d,0x2e,0xa0, /* "setpoint" */ 
+	0x26,0xd0,0xb1,0x80, /* "small" */ 
+	0x9c,0xa,0xba,0x4a,0xad, /* "spektrum" */ 
+	0x4,0xe4,0x30, /* "src" */ 
+	0x4e,0x81,0x39,0x7a, /* "stage2" */ 
+	0x9,0xd1,0x23,0x58, /* "stick" */ 
+	0x28,0xf6,0x16,0x41,0x70,0xca, /* "tolerance" */ 
+	0xa,0x49,0x20, /* "tri" */ 
+	0xa8,0x98,0xfc, /* "ublox" */ 
+	0x2,0xae,0xc,0x9a,0x52, /* "unarmed" */ 
+	0x2,0xae,0x4d, /* "unit" */ 
+	0x1,0x74,0xb8,0xe0, /* "wing" */ 
+};
+static const char wordSymbols[] = {'3','1','2','_',};
+const char * const table_off_on[] = {
+	"OFF",
+	"ON",
+};
+static const lookupTableEntry_t settingLookupTables[] = {
+	{ table_off_on, sizeof(table_off_on) / sizeof(char*) },
+};
+static const uint32_t settingMinMaxTable[] = {
+	0,
+	255,
+};
+typedef uint8_t setting_min_max_idx_t;
+#define SETTING_INDEXES_GET_MIN(val) (val->config.minmax.indexes[0])
+#define SETTING_INDEXES_GET_MAX(val) (val->config.minmax.indexes[1])
+static const setting_t settingsTable[] = {
+	// PG_SETTINGS_TEST
+	{ {151, 0, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[0]) },
+	{ {9, 97, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[1]) },
+	{ {8, 9, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[2]) },
+	{ {9, 17, 18, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[3]) },
+	{ {9, 18, 10, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[4]) },
+	{ {158, 98, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[5]) },
+	{ {9, 87, 10, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[6]) },
+	{ {9, 87, 53, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[7]) },
+	{ {9, 88, 10, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[8]) },
+	{ {9, 88, 53, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[9]) },
+	{ {9, 187, 152, 10}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[10]) },
+	{ {9, 100, 65, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[11]) },
+	{ {22, 34, 25, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[12]) },
+	{ {42, 34, 25, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[13]) },
+	{ {39, 34, 25, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[14]) },
+	{ {69, 34, 25, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[15]) },
+	{ {23, 86, 10, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[16]) },
+	{ {23, 86, 53, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[17]) },
+	{ {8, 23, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[18]) },
+	{ {23, 17, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[19]) },
+	{ {23, 18, 10, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[20]) },
+	{ {49, 66, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[21]) },
+	{ {49, 67, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[22]) },
+	{ {49, 68, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[23]) },
+	{ {48, 66, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[24]) },
+	{ {48, 67, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[25]) },
+	{ {48, 68, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[26]) },
+	{ {94, 17, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[27]) },
+	{ {94, 84, 56, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[28]) },
+	{ {59, 17, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[29]) },
+	{ {59, 44, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[30]) },
+	{ {8, 59, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[31]) },
+	{ {8, 11, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[32]) },
+	{ {11, 17, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[33]) },
+	{ {11, 123, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[34]) },
+	{ {57, 66, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[35]) },
+	{ {57, 67, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[36]) },
+	{ {57, 68, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[37]) },
+	{ {11, 112, 46, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[38]) },
+	{ {11, 100, 65, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[39]) },
+	{ {8, 11, 7, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[40]) },
+	{ {8, 11, 6, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[41]) },
+	{ {8, 11, 2, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[42]) },
+	{ {50, 17, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[43]) },
+	{ {50, 84, 56, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[44]) },
+	{ {50, 111, 189, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[45]) },
+	{ {60, 17, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[46]) },
+	{ {60, 18, 155, 10}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[47]) },
+	{ {60, 44, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[48]) },
+	{ {171, 47, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[49]) },
+	{ {12, 71, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[50]) },
+	{ {19, 71, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[51]) },
+	{ {42, 25, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[52]) },
+	{ {42, 12, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[53]) },
+	{ {42, 19, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[54]) },
+	{ {181, 97, 146, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[55]) },
+	{ {30, 56, 136, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[56]) },
+	{ {62, 93, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[57]) },
+	{ {62, 78, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[58]) },
+	{ {43, 95, 92, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[59]) },
+	{ {43, 95, 144, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[60]) },
+	{ {176, 0, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[61]) },
+	{ {185, 178, 109, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[62]) },
+	{ {43, 12, 101, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[63]) },
+	{ {43, 19, 101, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[64]) },
+	{ {62, 141, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[65]) },
+	{ {51, 5, 161, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[66]) },
+	{ {51, 5, 125, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[67]) },
+	{ {51, 126, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[68]) },
+	{ {182, 72, 78, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[69]) },
+	{ {12, 31, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[70]) },
+	{ {19, 31, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[71]) },
+	{ {12, 116, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[72]) },
+	{ {29, 61, 5, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[73]) },
+	{ {29, 104, 46, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[74]) },
+	{ {29, 122, 46, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[75]) },
+	{ {29, 61, 92, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[76]) },
+	{ {3, 20, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[77]) },
+	{ {3, 172, 20, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[78]) },
+	{ {3, 162, 20, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[79]) },
+	{ {3, 31, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[80]) },
+	{ {3, 31, 83, 20}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[81]) },
+	{ {3, 91, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[82]) },
+	{ {3, 188, 98, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[83]) },
+	{ {3, 1, 7, 24}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[84]) },
+	{ {3, 1, 6, 24}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[85]) },
+	{ {3, 1, 2, 5}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[86]) },
+	{ {3, 12, 74, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[87]) },
+	{ {3, 12, 74, 91}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[88]) },
+	{ {3, 81, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[89]) },
+	{ {3, 81, 134, 163}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[90]) },
+	{ {130, 0, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[91]) },
+	{ {8, 52, 7, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[92]) },
+	{ {8, 52, 6, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[93]) },
+	{ {8, 52, 2, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[94]) },
+	{ {22, 44, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[95]) },
+	{ {39, 58, 44, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[96]) },
+	{ {39, 58, 89, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[97]) },
+	{ {39, 58, 47, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[98]) },
+	{ {70, 32, 186, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[99]) },
+	{ {121, 90, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[100]) },
+	{ {145, 90, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[101]) },
+	{ {175, 128, 153, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[102]) },
+	{ {63, 117, 103, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[103]) },
+	{ {70, 113, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[104]) },
+	{ {22, 38, 72, 32}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[105]) },
+	{ {22, 19, 38, 32}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[106]) },
+	{ {22, 12, 38, 32}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[107]) },
+	{ {22, 102, 38, 32}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[108]) },
+	{ {36, 37, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[109]) },
+	{ {36, 37, 102, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[110]) },
+	{ {36, 37, 120, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[111]) },
+	{ {36, 37, 193, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[112]) },
+	{ {2, 29, 73, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[113]) },
+	{ {2, 148, 167, 82}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[114]) },
+	{ {165, 47, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[115]) },
+	{ {142, 133, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[116]) },
+	{ {85, 168, 47, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[117]) },
+	{ {138, 0, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[118]) },
+	{ {33, 15, 83, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[119]) },
+	{ {33, 15, 143, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[120]) },
+	{ {33, 160, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[121]) },
+	{ {45, 114, 169, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[122]) },
+	{ {45, 61, 5, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[123]) },
+	{ {45, 18, 10, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[124]) },
+	{ {132, 99, 89, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[125]) },
+	{ {190, 192, 45, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[126]) },
+	{ {63, 154, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[127]) },
+	{ {63, 27, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[128]) },
+	{ {64, 5, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[129]) },
+	{ {64, 110, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[130]) },
+	{ {1, 64, 46, 119}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[131]) },
+	{ {30, 27, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[132]) },
+	{ {30, 2, 27, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[133]) },
+	{ {7, 5, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[134]) },
+	{ {6, 5, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[135]) },
+	{ {2, 5, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[136]) },
+	{ {28, 30, 27, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[137]) },
+	{ {28, 30, 2, 27}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[138]) },
+	{ {28, 7, 5, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[139]) },
+	{ {28, 6, 5, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[140]) },
+	{ {28, 2, 5, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[141]) },
+	{ {135, 156, 124, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[142]) },
+	{ {170, 115, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[143]) },
+	{ {41, 40, 80, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[144]) },
+	{ {41, 40, 79, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[145]) },
+	{ {41, 40, 80, 11}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[146]) },
+	{ {41, 40, 79, 11}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[147]) },
+	{ {184, 24, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[148]) },
+	{ {131, 194, 35, 106}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[149]) },
+	{ {54, 149, 96, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[150]) },
+	{ {35, 54, 20, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[151]) },
+	{ {96, 54, 20, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[152]) },
+	{ {16, 93, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[153]) },
+	{ {16, 180, 157, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[154]) },
+	{ {16, 127, 85, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[155]) },
+	{ {16, 35, 118, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[156]) },
+	{ {16, 35, 108, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[157]) },
+	{ {16, 191, 65, 140}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[158]) },
+	{ {16, 12, 179, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[159]) },
+	{ {15, 0, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[160]) },
+	{ {2, 15, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[161]) },
+	{ {166, 76, 15, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[162]) },
+	{ {105, 76, 15, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[163]) },
+	{ {33, 15, 31, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[164]) },
+	{ {4, 14, 6, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[165]) },
+	{ {4, 13, 6, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[166]) },
+	{ {4, 26, 6, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[167]) },
+	{ {4, 14, 7, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[168]) },
+	{ {4, 13, 7, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[169]) },
+	{ {4, 26, 7, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[170]) },
+	{ {4, 14, 2, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[171]) },
+	{ {4, 13, 2, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[172]) },
+	{ {4, 26, 2, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[173]) },
+	{ {4, 14, 21, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[174]) },
+	{ {4, 13, 21, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[175]) },
+	{ {4, 26, 21, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[176]) },
+	{ {1, 14, 6, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[177]) },
+	{ {1, 13, 6, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[178]) },
+	{ {1, 55, 6, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[179]) },
+	{ {1, 14, 7, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[180]) },
+	{ {1, 13, 7, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[181]) },
+	{ {1, 55, 7, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[182]) },
+	{ {1, 14, 2, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[183]) },
+	{ {1, 13, 2, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[184]) },
+	{ {1, 55, 2, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[185]) },
+	{ {1, 14, 21, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[186]) },
+	{ {1, 13, 21, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[187]) },
+	{ {1, 26, 21, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[188]) },
+	{ {19, 24, 77, 174}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[189]) },
+	{ {19, 24, 77, 164}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[190]) },
+	{ {75, 18, 10, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[191]) },
+	{ {2, 18, 10, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[192]) },
+	{ {75, 183, 103, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[193]) },
+	{ {1, 147, 99, 82}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[194]) },
+	{ {1, 150, 73, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[195]) },
+	{ {1, 173, 69, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[196]) },
+	{ {139, 0, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[197]) },
+	{ {137, 0, 0, 0}, VAR_UINT8 | MASTER_VALUE, .config.minmax.indexes = {0, 1}, offsetof(settingsTestConfig_t, values[198]) },
+	{ {159, 129, 107, 177}, VAR_UINT8 | MASTER_VALUE | MODE_LOOKUP, .config.lookup = { TABLE_OFF_ON }, offsetof(settingsTestConfig_t, values[199]) },
+};
+#define SETTINGS_NAME_HASH_BUCKETS 50
+static const uint16_t settingsNameHashSeeds[] = {
+	16, 12, 8, 1, 138, 27, 87, 18, 341, 7, 2, 6, 36, 2, 237, 62,
+	1, 2, 67, 25, 2040, 40, 304, 5, 30, 143, 99, 72, 3, 792, 13, 76,
+	43, 37, 209, 3, 18, 6, 3, 301, 630, 0, 36, 1015, 1573, 1208, 19, 483,
+	12, 11,
+};
+static const uint16_t settingsNameHashSlots[] = {
+	110, 74, 139, 177, 46, 77, 19, 56, 168, 187, 20, 196, 48, 109, 129, 122,
+	166, 162, 125, 29, 52, 7, 41, 98, 61, 11, 75, 43, 130, 158, 55, 100,
+	32, 8, 87, 147, 141, 34, 186, 111, 157, 148, 91, 135, 79, 193, 101, 23,
+	145, 123, 191, 92, 42, 104, 137, 27, 113, 161, 114, 5, 163, 153, 47, 199,
+	68, 142, 22, 131, 25, 171, 102, 176, 184, 44, 197, 140, 108, 198, 103, 117,
+	13, 136, 60, 57, 17, 84, 112, 38, 35, 66, 175, 31, 116, 0, 126, 21,
+	62, 1, 30, 83, 106, 174, 54, 45, 182, 164, 26, 53, 194, 169, 195, 170,
+	24, 12, 95, 150, 39, 96, 146, 80, 33, 181, 16, 71, 90, 132, 118, 72,
+	134, 119, 179, 88, 160, 127, 120, 189, 59, 183, 172, 144, 190, 37, 107, 93,
+	65, 18, 69, 73, 188, 10, 154, 51, 159, 85, 49, 36, 173, 143, 64, 50,
+	2, 178, 133, 138, 121, 94, 67, 192, 180, 167, 86, 40, 155, 105, 3, 70,
+	6, 149, 76, 63, 14, 15, 28, 89, 124, 78, 185, 152, 128, 115, 165, 156,
+	97, 99, 82, 58, 4, 151, 9, 81,
+};
@@ -0,0 +1,620 @@
+// This file has been automatically generated by utils/settings.rb
+// Don't make any modifications to it. They will be lost.
+
+#pragma once
+#define SETTING_MAX_NAME_LENGTH 32
+#define SETTING_MAX_WORD_LENGTH 30
+#define SETTING_ENCODED_NAME_MAX_BYTES 4
+#define SETTING_ENCODED_NAME_USES_BYTE_INDEXING
+#define SETTINGS_WORDS_BITS_PER_CHAR 5
+#define SETTINGS_TABLE_COUNT 200
+typedef uint8_t setting_offset_t;
+#define SETTINGS_PGN_COUNT 1
+typedef int8_t setting_min_t;
+typedef uint8_t setting_max_t;
+#define SETTING_MIN_MAX_INDEX_BYTES 2
+enum {
+	TABLE_OFF_ON,
+	LOOKUP_TABLE_COUNT,
+};
+extern const char * const table_off_on[];
+#define SETTING_LOOPTIME 0
+#define SETTING_LOOPTIME_MIN 0
+#define SETTING_LOOPTIME_MAX 255
+#define SETTING_GYRO_SYNC 1
+#define SETTING_GYRO_SYNC_MIN 0
+#define SETTING_GYRO_SYNC_MAX 255
+#define SETTING_ALIGN_GYRO 2
+#define SETTING_ALIGN_GYRO_MIN 0
+#define SETTING_ALIGN_GYRO_MAX 255
+#define SETTING_GYRO_HARDWARE_LPF 3
+#define SETTING_GYRO_HARDWARE_LPF_MIN 0
+#define SETTING_GYRO_HARDWARE_LPF_MAX 255
+#define SETTING_GYRO_LPF_HZ 4
+#define SETTING_GYRO_LPF_HZ_MIN 0
+#define SETTING_GYRO_LPF_HZ_MAX 255
+#define SETTING_MORON_THRESHOLD 5
+#define SETTING_MORON_THRESHOLD_MIN 0
+#define SETTING_MORON_THRESHOLD_MAX 255
+#define SETTING_GYRO_NOTCH1_HZ 6
+#define SETTING_GYRO_NOTCH1_HZ_MIN 0
+#define SETTING_GYRO_NOTCH1_HZ_MAX 255
+#define SETTING_GYRO_NOTCH1_CUTOFF 7
+#define SETTING_GYRO_NOTCH1_CUTOFF_MIN 0
+#define SETTING_GYRO_NOTCH1_CUTOFF_MAX 255
+#define SETTING_GYRO_NOTCH2_HZ 8
+#define SETTING_GYRO_NOTCH2_HZ_MIN 0
+#define SETTING_GYRO_NOTCH2_HZ_MAX 255
+#define SETTING_GYRO_NOTCH2_CUTOFF 9
+#define SETTING_GYRO_NOTCH2_CUTOFF_MIN 0
+#define SETTING_GYRO_NOTCH2_CUTOFF_MAX 255
+#define SETTING_GYRO_STAGE2_LOWPASS_HZ 10
+#define SETTING_GYRO_STAGE2_LOWPASS_HZ_MIN 0
+#define SETTING_GYRO_STAGE2_LOWPASS_HZ_MAX 255
+#define SETTING_GYRO_TO_USE 11
+#define SETTING_GYRO_TO_USE_MIN 0
+#define SETTING_GYRO_TO_USE_MAX 255
+#define SETTING_VBAT_ADC_CHANNEL 12
+#define SETTING_VBAT_ADC_CHANNEL_MIN 0
+#define SETTING_VBAT_ADC_CHANNEL_MAX 255
+#define SETTING_RSSI_ADC_CHANNEL 13
+#define SETTING_RSSI_ADC_CHANNEL_MIN 0
+#define SETTING_RSSI_ADC_CHANNEL_MAX 255
+#define SETTING_CURRENT_ADC_CHANNEL 14
+#define SETTING_CURRENT_ADC_CHANNEL_MIN 0
+#define SETTING_CURRENT_ADC_CHANNEL_MAX 255
+#define SETTING_AIRSPEED_ADC_CHANNEL 15
+#define SETTING_AIRSPEED_ADC_CHANNEL_MIN 0
+#define SETTING_AIRSPEED_ADC_CHANNEL_MAX 255
+#define SETTING_ACC_NOTCH_HZ 16
+#define SETTING_ACC_NOTCH_HZ_MIN 0
+#define SETTING_ACC_NOTCH_HZ_MAX 255
+#define SETTING_ACC_NOTCH_CUTOFF 17
+#define SETTING_ACC_NOTCH_CUTOFF_MIN 0
+#define SETTING_ACC_NOTCH_CUTOFF_MAX 255
+#define SETTING_ALIGN_ACC 18
+#define SETTING_ALIGN_ACC_MIN 0
+#define SETTING_ALIGN_ACC_MAX 255
+#define SETTING_ACC_HARDWARE 19
+#define SETTING_ACC_HARDWARE_MIN 0
+#define SETTING_ACC_HARDWARE_MAX 255
+#define SETTING_ACC_LPF_HZ 20
+#define SETTING_ACC_LPF_HZ_MIN 0
+#define SETTING_ACC_LPF_HZ_MAX 255
+#define SETTING_ACCZERO_X 21
+#define SETTING_ACCZERO_X_MIN 0
+#define SETTING_ACCZERO_X_MAX 255
+#define SETTING_ACCZERO_Y 22
+#define SETTING_ACCZERO_Y_MIN 0
+#define SETTING_ACCZERO_Y_MAX 255
+#define SETTING_ACCZERO_Z 23
+#define SETTING_ACCZERO_Z_MIN 0
+#define SETTING_ACCZERO_Z_MAX 255
+#define SETTING_ACCGAIN_X 24
+#define SETTING_ACCGAIN_X_MIN 0
+#define SETTING_ACCGAIN_X_MAX 255
+#define SETTING_ACCGAIN_Y 25
+#define SETTING_ACCGAIN_Y_MIN 0
+#define SETTING_ACCGAIN_Y_MAX 255
+#define SETTING_ACCGAIN_Z 26
+#define SETTING_ACCGAIN_Z_MIN 0
+#define SETTING_ACCGAIN_Z_MAX 255
+#define SETTING_RANGEFINDER_HARDWARE 27
+#define SETTING_RANGEFINDER_HARDWARE_MIN 0
+#define SETTING_RANGEFINDER_HARDWARE_MAX 255
+#define SETTING_RANGEFINDER_MEDIAN_FILTER 28
+#define SETTING_RANGEFINDER_MEDIAN_FILTER_MIN 0
+#define SETTING_RANGEFINDER_MEDIAN_FILTER_MAX 255
+#define SETTING_OPFLOW_HARDWARE 29
+#define SETTING_OPFLOW_HARDWARE_MIN 0
+#define SETTING_OPFLOW_HARDWARE_MAX 255
+#define SETTING_OPFLOW_SCALE 30
+#define SETTING_OPFLOW_SCALE_MIN 0
+#define SETTING_OPFLOW_SCALE_MAX 255
+#define SETTING_ALIGN_OPFLOW 31
+#define SETTING_ALIGN_OPFLOW_MIN 0
+#define SETTING_ALIGN_OPFLOW_MAX 255
+#define SETTING_ALIGN_MAG 32
+#define SETTING_ALIGN_MAG_MIN 0
+#define SETTING_ALIGN_MAG_MAX 255
+#define SETTING_MAG_HARDWARE 33
+#define SETTING_MAG_HARDWARE_MIN 0
+#define SETTING_MAG_HARDWARE_MAX 255
+#define SETTING_MAG_DECLINATION 34
+#define SETTING_MAG_DECLINATION_MIN 0
+#define SETTING_MAG_DECLINATION_MAX 255
+#define SETTING_MAGZERO_X 35
+#define SETTING_MAGZERO_X_MIN 0
+#define SETTING_MAGZERO_X_MAX 255
+#define SETTING_MAGZERO_Y 36
+#define SETTING_MAGZERO_Y_MIN 0
+#define SETTING_MAGZERO_Y_MAX 255
+#define SETTING_MAGZERO_Z 37
+#define SETTING_MAGZERO_Z_MIN 0
+#define SETTING_MAGZERO_Z_MAX 255
+#define SETTING_MAG_CALIBRATION_TIME 38
+#define SETTING_MAG_CALIBRATION_TIME_MIN 0
+#define SETTING_MAG_CALIBRATION_TIME_MAX 255
+#define SETTING_MAG_TO_USE 39
+#define SETTING_MAG_TO_USE_MIN 0
+#define SETTING_MAG_TO_USE_MAX 255
+#define SETTING_ALIGN_MAG_ROLL 40
+#define SETTING_ALIGN_MAG_ROLL_MIN 0
+#define SETTING_ALIGN_MAG_ROLL_MAX 255
+#define SETTING_ALIGN_MAG_PITCH 41
+#define SETTING_ALIGN_MAG_PITCH_MIN 0
+#define SETTING_ALIGN_MAG_PITCH_MAX 255
+#define SETTING_ALIGN_MAG_YAW 42
+#define SETTING_ALIGN_MAG_YAW_MIN 0
+#define SETTING_ALIGN_MAG_YAW_MAX 255
+#define SETTING_BARO_HARDWARE 43
+#define SETTING_BARO_HARDWARE_MIN 0
+#define SETTING_BARO_HARDWARE_MAX 255
+#define SETTING_BARO_MEDIAN_FILTER 44
+#define SETTING_BARO_MEDIAN_FILTER_MIN 0
+#define SETTING_BARO_MEDIAN_FILTER_MAX 255
+#define SETTING_BARO_CAL_TOLERANCE 45
+#define SETTING_BARO_CAL_TOLERANCE_MIN 0
+#define SETTING_BARO_CAL_TOLERANCE_MAX 255
+#define SETTING_PITOT_HARDWARE 46
+#define SETTING_PITOT_HARDWARE_MIN 0
+#define SETTING_PITOT_HARDWARE_MAX 255
+#define SETTING_PITOT_LPF_MILLI_HZ 47
+#define SETTING_PITOT_LPF_MILLI_HZ_MIN 0
+#define SETTING_PITOT_LPF_MILLI_HZ_MAX 255
+#define SETTING_PITOT_SCALE 48
+#define SETTING_PITOT_SCALE_MIN 0
+#define SETTING_PITOT_SCALE_MAX 255
+#define SETTING_RECEIVER_TYPE 49
+#define SETTING_RECEIVER_TYPE_MIN 0
+#define SETTING_RECEIVER_TYPE_MAX 255
+#define SETTING_MIN_CHECK 50
+#define SETTING_MIN_CHECK_MIN 0
+#define SETTING_MIN_CHECK_MAX 255
+#define SETTING_MAX_CHECK 51
+#define SETTING_MAX_CHECK_MIN 0
+#define SETTING_MAX_CHECK_MAX 255
+#define SETTING_RSSI_CHANNEL 52
+#define SETTING_RSSI_CHANNEL_MIN 0
+#define SETTING_RSSI_CHANNEL_MAX 255
+#define SETTING_RSSI_MIN 53
+#define SETTING_RSSI_MIN_MIN 0
+#define SETTING_RSSI_MIN_MAX 255
+#define SETTING_RSSI_MAX 54
+#define SETTING_RSSI_MAX_MIN 0
+#define SETTING_RSSI_MAX_MAX 255
+#define SETTING_SBUS_SYNC_INTERVAL 55
+#define SETTING_SBUS_SYNC_INTERVAL_MIN 0
+#define SETTING_SBUS_SYNC_INTERVAL_MAX 255
+#define SETTING_RC_FILTER_FREQUENCY 56
+#define SETTING_RC_FILTER_FREQUENCY_MIN 0
+#define SETTING_RC_FILTER_FREQUENCY_MAX 255
+#define SETTING_SERIALRX_PROVIDER 57
+#define SETTING_SERIALRX_PROVIDER_MIN 0
+#define SETTING_SERIALRX_PROVIDER_MAX 255
+#define SETTING_SERIALRX_INVERTED 58
+#define SETTING_SERIALRX_INVERTED_MIN 0
+#define SETTING_SERIALRX_INVERTED_MAX 255
+#define SETTING_RX_SPI_PROTOCOL 59
+#define SETTING_RX_SPI_PROTOCOL_MIN 0
+#define SETTING_RX_SPI_PROTOCOL_MAX 255
+#define SETTING_RX_SPI_ID 60
+#define SETTING_RX_SPI_ID_MIN 0
+#define SETTING_RX_SPI_ID_MAX 255
+#define SETTING_RX_SPI_RF_CHANNEL_COUNT 61
+#define SETTING_RX_SPI_RF_CHANNEL_COUNT_MIN 0
+#define SETTING_RX_SPI_RF_CHANNEL_COUNT_MAX 255
+#define SETTING_SPEKTRUM_SAT_BIND 62
+#define SETTING_SPEKTRUM_SAT_BIND_MIN 0
+#define SETTING_SPEKTRUM_SAT_BIND_MAX 255
+#define SETTING_RX_MIN_USEC 63
+#define SETTING_RX_MIN_USEC_MIN 0
+#define SETTING_RX_MIN_USEC_MAX 255
+#define SETTING_RX_MAX_USEC 64
+#define SETTING_RX_MAX_USEC_MIN 0
+#define SETTING_RX_MAX_USEC_MAX 255
+#define SETTING_SERIALRX_HALFDUPLEX 65
+#define SETTING_SERIALRX_HALFDUPLEX_MIN 0
+#define SETTING_SERIALRX_HALFDUPLEX_MAX 255
+#define SETTING_BLACKBOX_RATE_NUM 66
+#define SETTING_BLACKBOX_RATE_NUM_MIN 0
+#define SETTING_BLACKBOX_RATE_NUM_MAX 255
+#define SETTING_BLACKBOX_RATE_DENOM 67
+#define SETTING_BLACKBOX_RATE_DENOM_MIN 0
+#define SETTING_BLACKBOX_RATE_DENOM_MAX 255
+#define SETTING_BLACKBOX_DEVICE 68
+#define SETTING_BLACKBOX_DEVICE_MIN 0
+#define SETTING_BLACKBOX_DEVICE_MAX 255
+#define SETTING_SDCARD_DETECT_INVERTED 69
+#define SETTING_SDCARD_DETECT_INVERTED_MIN 0
+#define SETTING_SDCARD_DETECT_INVERTED_MAX 255
+#define SETTING_MIN_THROTTLE 70
+#define SETTING_MIN_THROTTLE_MIN 0
+#define SETTING_MIN_THROTTLE_MAX 255
+#define SETTING_MAX_THROTTLE 71
+#define SETTING_MAX_THROTTLE_MIN 0
+#define SETTING_MAX_THROTTLE_MAX 255
+#define SETTING_MIN_COMMAND 72
+#define SETTING_MIN_COMMAND_MIN 0
+#define SETTING_MIN_COMMAND_MAX 255
+#define SETTING_MOTOR_PWM_RATE 73
+#define SETTING_MOTOR_PWM_RATE_MIN 0
+#define SETTING_MOTOR_PWM_RATE_MAX 255
+#define SETTING_MOTOR_ACCEL_TIME 74
+#define SETTING_MOTOR_ACCEL_TIME_MIN 0
+#define SETTING_MOTOR_ACCEL_TIME_MAX 255
+#define SETTING_MOTOR_DECEL_TIME 75
+#define SETTING_MOTOR_DECEL_TIME_MIN 0
+#define SETTING_MOTOR_DECEL_TIME_MAX 255
+#define SETTING_MOTOR_PWM_PROTOCOL 76
+#define SETTING_MOTOR_PWM_PROTOCOL_MIN 0
+#define SETTING_MOTOR_PWM_PROTOCOL_MAX 255
+#define SETTING_FAILSAFE_DELAY 77
+#define SETTING_FAILSAFE_DELAY_MIN 0
+#define SETTING_FAILSAFE_DELAY_MAX 255
+#define SETTING_FAILSAFE_RECOVERY_DELAY 78
+#define SETTING_FAILSAFE_RECOVERY_DELAY_MIN 0
+#define SETTING_FAILSAFE_RECOVERY_DELAY_MAX 255
+#define SETTING_FAILSAFE_OFF_DELAY 79
+#define SETTING_FAILSAFE_OFF_DELAY_MIN 0
+#define SETTING_FAILSAFE_OFF_DELAY_MAX 255
+#define SETTING_FAILSAFE_THROTTLE 80
+#define SETTING_FAILSAFE_THROTTLE_MIN 0
+#define SETTING_FAILSAFE_THROTTLE_MAX 255
+#define SETTING_FAILSAFE_THROTTLE_LOW_DELAY 81
+#define SETTING_FAILSAFE_THROTTLE_LOW_DELAY_MIN 0
+#define SETTING_FAILSAFE_THROTTLE_LOW_DELAY_MAX 255
+#define SETTING_FAILSAFE_PROCEDURE 82
+#define SETTING_FAILSAFE_PROCEDURE_MIN 0
+#define SETTING_FAILSAFE_PROCEDURE_MAX 255
+#define SETTING_FAILSAFE_STICK_THRESHOLD 83
+#define SETTING_FAILSAFE_STICK_THRESHOLD_MIN 0
+#define SETTING_FAILSAFE_STICK_THRESHOLD_MAX 255
+#define SETTING_FAILSAFE_FW_ROLL_ANGLE 84
+#define SETTING_FAILSAFE_FW_ROLL_ANGLE_MIN 0
+#define SETTING_FAILSAFE_FW_ROLL_ANGLE_MAX 255
+#define SETTING_FAILSAFE_FW_PITCH_ANGLE 85
+#define SETTING_FAILSAFE_FW_PITCH_ANGLE_MIN 0
+#define SETTING_FAILSAFE_FW_PITCH_ANGLE_MAX 255
+#define SETTING_FAILSAFE_FW_YAW_RATE 86
+#define SETTING_FAILSAFE_FW_YAW_RATE_MIN 0
+#define SETTING_FAILSAFE_FW_YAW_RATE_MAX 255
+#define SETTING_FAILSAFE_MIN_DISTANCE 87
+#define SETTING_FAILSAFE_MIN_DISTANCE_MIN 0
+#define SETTING_FAILSAFE_MIN_DISTANCE_MAX 255
+#define SETTING_FAILSAFE_MIN_DISTANCE_PROCEDURE 88
+#define SETTING_FAILSAFE_MIN_DISTANCE_PROCEDURE_MIN 0
+#define SETTING_FAILSAFE_MIN_DISTANCE_PROCEDURE_MAX 255
+#define SETTING_FAILSAFE_LIGHTS 89
+#define SETTING_FAILSAFE_LIGHTS_MIN 0
+#define SETTING_FAILSAFE_LIGHTS_MAX 255
+#define SETTING_FAILSAFE_LIGHTS_FLASH_PERIOD 90
+#define SETTING_FAILSAFE_LIGHTS_FLASH_PERIOD_MIN 0
+#define SETTING_FAILSAFE_LIGHTS_FLASH_PERIOD_MAX 255
+#define SETTING_FAILSAFE_LIGHTS_FLASH_ON_TIME 91
+#define SETTING_FAILSAFE_LIGHTS_FLASH_ON_TIME_MIN 0
+#define SETTING_FAILSAFE_LIGHTS_FLASH_ON_TIME_MAX 255
+#define SETTING_ALIGN_BOARD_ROLL 92
+#define SETTING_ALIGN_BOARD_ROLL_MIN 0
+#define SETTING_ALIGN_BOARD_ROLL_MAX 255
+#define SETTING_ALIGN_BOARD_PITCH 93
+#define SETTING_ALIGN_BOARD_PITCH_MIN 0
+#define SETTING_ALIGN_BOARD_PITCH_MAX 255
+#define SETTING_ALIGN_BOARD_YAW 94
+#define SETTING_ALIGN_BOARD_YAW_MIN 0
+#define SETTING_ALIGN_BOARD_YAW_MAX 255
+#define SETTING_VBAT_SCALE 95
+#define SETTING_VBAT_SCALE_MIN 0
+#define SETTING_VBAT_SCALE_MAX 255
+#define SETTING_CURRENT_METER_SCALE 96
+#define SETTING_CURRENT_METER_SCALE_MIN 0
+#define SETTING_CURRENT_METER_SCALE_MAX 255
+#define SETTING_CURRENT_METER_OFFSET 97
+#define SETTING_CURRENT_METER_OFFSET_MIN 0
+#define SETTING_CURRENT_METER_OFFSET_MAX 255
+#define SETTING_CURRENT_METER_TYPE 98
+#define SETTING_CURRENT_METER_TYPE_MIN 0
+#define SETTING_CURRENT_METER_TYPE_MAX 255
+#define SETTING_BAT_VOLTAGE_SRC 99
+#define SETTING_BAT_VOLTAGE_SRC_MIN 0
+#define SETTING_BAT_VOLTAGE_SRC_MAX 255
+#define SETTING_CRUISE_POWER 100
+#define SETTING_CRUISE_POWER_MIN 0
+#define SETTING_CRUISE_POWER_MAX 255
+#define SETTING_IDLE_POWER 101
+#define SETTING_IDLE_POWER_MIN 0
+#define SETTING_IDLE_POWER_MAX 255
+#define SETTING_RTH_ENERGY_MARGIN 102
+#define SETTING_RTH_ENERGY_MARGIN_MIN 0
+#define SETTING_RTH_ENERGY_MARGIN_MAX 255
+#define SETTING_THR_COMP_WEIGHT 103
+#define SETTING_THR_COMP_WEIGHT_MIN 0
+#define SETTING_THR_COMP_WEIGHT_MAX 255
+#define SETTING_BAT_CELLS 104
+#define SETTING_BAT_CELLS_MIN 0
+#define SETTING_BAT_CELLS_MAX 255
+#define SETTING_VBAT_CELL_DETECT_VOLTAGE 105
+#define SETTING_VBAT_CELL_DETECT_VOLTAGE_MIN 0
+#define SETTING_VBAT_CELL_DETECT_VOLTAGE_MAX 255
+#define SETTING_VBAT_MAX_CELL_VOLTAGE 106
+#define SETTING_VBAT_MAX_CELL_VOLTAGE_MIN 0
+#define SETTING_VBAT_MAX_CELL_VOLTAGE_MAX 255
+#define SETTING_VBAT_MIN_CELL_VOLTAGE 107
+#define SETTING_VBAT_MIN_CELL_VOLTAGE_MIN 0
+#define SETTING_VBAT_MIN_CELL_VOLTAGE_MAX 255
+#define SETTING_VBAT_WARNING_CELL_VOLTAGE 108
+#define SETTING_VBAT_WARNING_CELL_VOLTAGE_MIN 0
+#define SETTING_VBAT_WARNING_CELL_VOLTAGE_MAX 255
+#define SETTING_BATTERY_CAPACITY 109
+#define SETTING_BATTERY_CAPACITY_MIN 0
+#define SETTING_BATTERY_CAPACITY_MAX 255
+#define SETTING_BATTERY_CAPACITY_WARNING 110
+#define SETTING_BATTERY_CAPACITY_WARNING_MIN 0
+#define SETTING_BATTERY_CAPACITY_WARNING_MAX 255
+#define SETTING_BATTERY_CAPACITY_CRITICAL 111
+#define SETTING_BATTERY_CAPACITY_CRITICAL_MIN 0
+#define SETTING_BATTERY_CAPACITY_CRITICAL_MAX 255
+#define SETTING_BATTERY_CAPACITY_UNIT 112
+#define SETTING_BATTERY_CAPACITY_UNIT_MIN 0
+#define SETTING_BATTERY_CAPACITY_UNIT_MAX 255
+#define SETTING_YAW_MOTOR_DIRECTION 113
+#define SETTING_YAW_MOTOR_DIRECTION_MIN 0
+#define SETTING_YAW_MOTOR_DIRECTION_MAX 255
+#define SETTING_YAW_JUMP_PREVENTION_LIMIT 114
+#define SETTING_YAW_JUMP_PREVENTION_LIMIT_MIN 0
+#define SETTING_YAW_JUMP_PREVENTION_LIMIT_MAX 255
+#define SETTING_PLATFORM_TYPE 115
+#define SETTING_PLATFORM_TYPE_MIN 0
+#define SETTING_PLATFORM_TYPE_MAX 255
+#define SETTING_HAS_FLAPS 116
+#define SETTING_HAS_FLAPS_MIN 0
+#define SETTING_HAS_FLAPS_MAX 255
+#define SETTING_MODEL_PREVIEW_TYPE 117
+#define SETTING_MODEL_PREVIEW_TYPE_MIN 0
+#define SETTING_MODEL_PREVIEW_TYPE_MAX 255
+#define SETTING_FW_MIN_THROTTLE_DOWN_PITCH 118
+#define SETTING_FW_MIN_THROTTLE_DOWN_PITCH_MIN 0
+#define SETTING_FW_MIN_THROTTLE_DOWN_PITCH_MAX 255
+#define SETTING_3D_DEADBAND_LOW 119
+#define SETTING_3D_DEADBAND_LOW_MIN 0
+#define SETTING_3D_DEADBAND_LOW_MAX 255
+#define SETTING_3D_DEADBAND_HIGH 120
+#define SETTING_3D_DEADBAND_HIGH_MIN 0
+#define SETTING_3D_DEADBAND_HIGH_MAX 255
+#define SETTING_3D_NEUTRAL 121
+#define SETTING_3D_NEUTRAL_MIN 0
+#define SETTING_3D_NEUTRAL_MAX 255
+#define SETTING_SERVO_CENTER_PULSE 122
+#define SETTING_SERVO_CENTER_PULSE_MIN 0
+#define SETTING_SERVO_CENTER_PULSE_MAX 255
+#define SETTING_SERVO_PWM_RATE 123
+#define SETTING_SERVO_PWM_RATE_MIN 0
+#define SETTING_SERVO_PWM_RATE_MAX 255
+#define SETTING_SERVO_LPF_HZ 124
+#define SETTING_SERVO_LPF_HZ_MIN 0
+#define SETTING_SERVO_LPF_HZ_MAX 255
+#define SETTING_FLAPERON_THROW_OFFSET 125
+#define SETTING_FLAPERON_THROW_OFFSET_MIN 0
+#define SETTING_FLAPERON_THROW_OFFSET_MAX 255
+#define SETTING_TRI_UNARMED_SERVO 126
+#define SETTING_TRI_UNARMED_SERVO_MIN 0
+#define SETTING_TRI_UNARMED_SERVO_MAX 255
+#define SETTING_THR_MID 127
+#define SETTING_THR_MID_MIN 0
+#define SETTING_THR_MID_MAX 255
+#define SETTING_THR_EXPO 128
+#define SETTING_THR_EXPO_MIN 0
+#define SETTING_THR_EXPO_MAX 255
+#define SETTING_TPA_RATE 129
+#define SETTING_TPA_RATE_MIN 0
+#define SETTING_TPA_RATE_MAX 255
+#define SETTING_TPA_BREAKPOINT 130
+#define SETTING_TPA_BREAKPOINT_MIN 0
+#define SETTING_TPA_BREAKPOINT_MAX 255
+#define SETTING_FW_TPA_TIME_CONSTANT 131
+#define SETTING_FW_TPA_TIME_CONSTANT_MIN 0
+#define SETTING_FW_TPA_TIME_CONSTANT_MAX 255
+#define SETTING_RC_EXPO 132
+#define SETTING_RC_EXPO_MIN 0
+#define SETTING_RC_EXPO_MAX 255
+#define SETTING_RC_YAW_EXPO 133
+#define SETTING_RC_YAW_EXPO_MIN 0
+#define SETTING_RC_YAW_EXPO_MAX 255
+#define SETTING_ROLL_RATE 134
+#define SETTING_ROLL_RATE_MIN 0
+#define SETTING_ROLL_RATE_MAX 255
+#define SETTING_PITCH_RATE 135
+#define SETTING_PITCH_RATE_MIN 0
+#define SETTING_PITCH_RATE_MAX 255
+#define SETTING_YAW_RATE 136
+#define SETTING_YAW_RATE_MIN 0
+#define SETTING_YAW_RATE_MAX 255
+#define SETTING_MANUAL_RC_EXPO 137
+#define SETTING_MANUAL_RC_EXPO_MIN 0
+#define SETTING_MANUAL_RC_EXPO_MAX 255
+#define SETTING_MANUAL_RC_YAW_EXPO 138
+#define SETTING_MANUAL_RC_YAW_EXPO_MIN 0
+#define SETTING_MANUAL_RC_YAW_EXPO_MAX 255
+#define SETTING_MANUAL_ROLL_RATE 139
+#define SETTING_MANUAL_ROLL_RATE_MIN 0
+#define SETTING_MANUAL_ROLL_RATE_MAX 255
+#define SETTING_MANUAL_PITCH_RATE 140
+#define SETTING_MANUAL_PITCH_RATE_MIN 0
+#define SETTING_MANUAL_PITCH_RATE_MAX 255
+#define SETTING_MANUAL_YAW_RATE 141
+#define SETTING_MANUAL_YAW_RATE_MIN 0
+#define SETTING_MANUAL_YAW_RATE_MAX 255
+#define SETTING_FPV_MIX_DEGREES 142
+#define SETTING_FPV_MIX_DEGREES_MIN 0
+#define SETTING_FPV_MIX_DEGREES_MAX 255
+#define SETTING_REBOOT_CHARACTER 143
+#define SETTING_REBOOT_CHARACTER_MIN 0
+#define SETTING_REBOOT_CHARACTER_MAX 255
+#define SETTING_IMU_DCM_KP 144
+#define SETTING_IMU_DCM_KP_MIN 0
+#define SETTING_IMU_DCM_KP_MAX 255
+#define SETTING_IMU_DCM_KI 145
+#define SETTING_IMU_DCM_KI_MIN 0
+#define SETTING_IMU_DCM_KI_MAX 255
+#define SETTING_IMU_DCM_KP_MAG 146
+#define SETTING_IMU_DCM_KP_MAG_MIN 0
+#define SETTING_IMU_DCM_KP_MAG_MAX 255
+#define SETTING_IMU_DCM_KI_MAG 147
+#define SETTING_IMU_DCM_KI_MAG_MIN 0
+#define SETTING_IMU_DCM_KI_MAG_MAX 255
+#define SETTING_SMALL_ANGLE 148
+#define SETTING_SMALL_ANGLE_MIN 0
+#define SETTING_SMALL_ANGLE_MAX 255
+#define SETTING_FIXED_WING_AUTO_ARM 149
+#define SETTING_FIXED_WING_AUTO_ARM_MIN 0
+#define SETTING_FIXED_WING_AUTO_ARM_MAX 255
+#define SETTING_DISARM_KILL_SWITCH 150
+#define SETTING_DISARM_KILL_SWITCH_MIN 0
+#define SETTING_DISARM_KILL_SWITCH_MAX 255
+#define SETTING_AUTO_DISARM_DELAY 151
+#define SETTING_AUTO_DISARM_DELAY_MIN 0
+#define SETTING_AUTO_DISARM_DELAY_MAX 255
+#define SETTING_SWITCH_DISARM_DELAY 152
+#define SETTING_SWITCH_DISARM_DELAY_MIN 0
+#define SETTING_SWITCH_DISARM_DELAY_MAX 255
+#define SETTING_GPS_PROVIDER 153
+#define SETTING_GPS_PROVIDER_MIN 0
+#define SETTING_GPS_PROVIDER_MAX 255
+#define SETTING_GPS_SBAS_MODE 154
+#define SETTING_GPS_SBAS_MODE_MIN 0
+#define SETTING_GPS_SBAS_MODE_MAX 255
+#define SETTING_GPS_DYN_MODEL 155
+#define SETTING_GPS_DYN_MODEL_MIN 0
+#define SETTING_GPS_DYN_MODEL_MAX 255
+#define SETTING_GPS_AUTO_CONFIG 156
+#define SETTING_GPS_AUTO_CONFIG_MIN 0
+#define SETTING_GPS_AUTO_CONFIG_MAX 255
+#define SETTING_GPS_AUTO_BAUD 157
+#define SETTING_GPS_AUTO_BAUD_MIN 0
+#define SETTING_GPS_AUTO_BAUD_MAX 255
+#define SETTING_GPS_UBLOX_USE_GALILEO 158
+#define SETTING_GPS_UBLOX_USE_GALILEO_MIN 0
+#define SETTING_GPS_UBLOX_USE_GALILEO_MAX 255
+#define SETTING_GPS_MIN_SATS 159
+#define SETTING_GPS_MIN_SATS_MIN 0
+#define SETTING_GPS_MIN_SATS_MAX 255
+#define SETTING_DEADBAND 160
+#define SETTING_DEADBAND_MIN 0
+#define SETTING_DEADBAND_MAX 255
+#define SETTING_YAW_DEADBAND 161
+#define SETTING_YAW_DEADBAND_MIN 0
+#define SETTING_YAW_DEADBAND_MAX 255
+#define SETTING_POS_HOLD_DEADBAND 162
+#define SETTING_POS_HOLD_DEADBAND_MIN 0
+#define SETTING_POS_HOLD_DEADBAND_MAX 255
+#define SETTING_ALT_HOLD_DEADBAND 163
+#define SETTING_ALT_HOLD_DEADBAND_MIN 0
+#define SETTING_ALT_HOLD_DEADBAND_MAX 255
+#define SETTING_3D_DEADBAND_THROTTLE 164
+#define SETTING_3D_DEADBAND_THROTTLE_MIN 0
+#define SETTING_3D_DEADBAND_THROTTLE_MAX 255
+#define SETTING_MC_P_PITCH 165
+#define SETTING_MC_P_PITCH_MIN 0
+#define SETTING_MC_P_PITCH_MAX 255
+#define SETTING_MC_I_PITCH 166
+#define SETTING_MC_I_PITCH_MIN 0
+#define SETTING_MC_I_PITCH_MAX 255
+#define SETTING_MC_D_PITCH 167
+#define SETTING_MC_D_PITCH_MIN 0
+#define SETTING_MC_D_PITCH_MAX 255
+#define SETTING_MC_P_ROLL 168
+#define SETTING_MC_P_ROLL_MIN 0
+#define SETTING_MC_P_ROLL_MAX 255
+#define SETTING_MC_I_ROLL 169
+#define SETTING_MC_I_ROLL_MIN 0
+#define SETTING_MC_I_ROLL_MAX 255
+#define SETTING_MC_D_ROLL 170
+#define SETTING_MC_D_ROLL_MIN 0
+#define SETTING_MC_D_ROLL_MAX 255
+#define SETTING_MC_P_YAW 171
+#define SETTING_MC_P_YAW_MIN 0
+#define SETTING_MC_P_YAW_MAX 255
+#define SETTING_MC_I_YAW 172
+#define SETTING_MC_I_YAW_MIN 0
+#define SETTING_MC_I_YAW_MAX 255
+#define SETTING_MC_D_YAW 173
+#define SETTING_MC_D_YAW_MIN 0
+#define SETTING_MC_D_YAW_MAX 255
+#define SETTING_MC_P_LEVEL 174
+#define SETTING_MC_P_LEVEL_MIN 0
+#define SETTING_MC_P_LEVEL_MAX 255
+#define SETTING_MC_I_LEVEL 175
+#define SETTING_MC_I_LEVEL_MIN 0
+#define SETTING_MC_I_LEVEL_MAX 255
+#define SETTING_MC_D_LEVEL 176
+#define SETTING_MC_D_LEVEL_MIN 0
+#define SETTING_MC_D_LEVEL_MAX 255
+#define SETTING_FW_P_PITCH 177
+#define SETTING_FW_P_PITCH_MIN 0
+#define SETTING_FW_P_PITCH_MAX 255
+#define SETTING_FW_I_PITCH 178
+#define SETTING_FW_I_PITCH_MIN 0
+#define SETTING_FW_I_PITCH_MAX 255
+#define SETTING_FW_FF_PITCH 179
+#define SETTING_FW_FF_PITCH_MIN 0
+#define SETTING_FW_FF_PITCH_MAX 255
+#define SETTING_FW_P_ROLL 180
+#define SETTING_FW_P_ROLL_MIN 0
+#define SETTING_FW_P_ROLL_MAX 255
+#define SETTING_FW_I_ROLL 181
+#define SETTING_FW_I_ROLL_MIN 0
+#define SETTING_FW_I_ROLL_MAX 255
+#define SETTING_FW_FF_ROLL 182
+#define SETTING_FW_FF_ROLL_MIN 0
+#define SETTING_FW_FF_ROLL_MAX 255
+#define SETTING_FW_P_YAW 183
+#define SETTING_FW_P_YAW_MIN 0
+#define SETTING_FW_P_YAW_MAX 255
+#define SETTING_FW_I_YAW 184
+#define SETTING_FW_I_YAW_MIN 0
+#define SETTING_FW_I_YAW_MAX 255
+#define SETTING_FW_FF_YAW 185
+#define SETTING_FW_FF_YAW_MIN 0
+#define SETTING_FW_FF_YAW_MAX 255
+#define SETTING_FW_P_LEVEL 186
+#define SETTING_FW_P_LEVEL_MIN 0
+#define SETTING_FW_P_LEVEL_MAX 255
+#define SETTING_FW_I_LEVEL 187
+#define SETTING_FW_I_LEVEL_MIN 0
+#define SETTING_FW_I_LEVEL_MAX 255
+#define SETTING_FW_D_LEVEL 188
+#define SETTING_FW_D_LEVEL_MIN 0
+#define SETTING_FW_D_LEVEL_MAX 255
+#define SETTING_MAX_ANGLE_INCLINATION_RLL 189
+#define SETTING_MAX_ANGLE_INCLINATION_RLL_MIN 0
+#define SETTING_MAX_ANGLE_INCLINATION_RLL_MAX 255
+#define SETTING_MAX_ANGLE_INCLINATION_PIT 190
+#define SETTING_MAX_ANGLE_INCLINATION_PIT_MIN 0
+#define SETTING_MAX_ANGLE_INCLINATION_PIT_MAX 255
+#define SETTING_DTERM_LPF_HZ 191
+#define SETTING_DTERM_LPF_HZ_MIN 0
+#define SETTING_DTERM_LPF_HZ_MAX 255
+#define SETTING_YAW_LPF_HZ 192
+#define SETTING_YAW_LPF_HZ_MIN 0
+#define SETTING_YAW_LPF_HZ_MAX 255
+#define SETTING_DTERM_SETPOINT_WEIGHT 193
+#define SETTING_DTERM_SETPOINT_WEIGHT_MIN 0
+#define SETTING_DTERM_SETPOINT_WEIGHT_MAX 255
+#define SETTING_FW_ITERM_THROW_LIMIT 194
+#define SETTING_FW_ITERM_THROW_LIMIT_MIN 0
+#define SETTING_FW_ITERM_THROW_LIMIT_MAX 255
+#define SETTING_FW_LOITER_DIRECTION 195
+#define SETTING_FW_LOITER_DIRECTION_MIN 0
+#define SETTING_FW_LOITER_DIRECTION_MAX 255
+#define SETTING_FW_REFERENCE_AIRSPEED 196
+#define SETTING_FW_REFERENCE_AIRSPEED_MIN 0
+#define SETTING_FW_REFERENCE_AIRSPEED_MAX 255
+#define SETTING_FW_TURN_ASSIST_YAW_GAIN 197
+#define SETTING_FW_TURN_ASSIST_YAW_GAIN_MIN 0
+#define SETTING_FW_TURN_ASSIST_YAW_GAIN_MAX 255
+#define SETTING_FW_ITERM_LIMIT_STICK_POSITION 198
+#define SETTING_FW_ITERM_LIMIT_STICK_POSITION_MIN 0
+#define SETTING_FW_ITERM_LIMIT_STICK_POSITION_MAX 255
+#define SETTING_NAV_EXTRA_ARMING_SAFETY 199
+#define SETTING_NAV_EXTRA_ARMING_SAFETY_MIN 0
+#define SETTING_NAV_EXTRA_ARMING_SAFETY_MAX 0
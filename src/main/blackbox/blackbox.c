@@ -25,6 +25,7 @@
 #ifdef USE_BLACKBOX
 
 #include "blackbox.h"
+#include "blackbox_compress.h"
 #include "blackbox_encoding.h"
 #include "blackbox_io.h"
 
@@ -93,15 +94,33 @@
 #define BLACKBOX_INTERVED_CARD_DETECTION 0
 #endif
 
-PG_REGISTER_WITH_RESET_TEMPLATE(blackboxConfig_t, blackboxConfig, PG_BLACKBOX_CONFIG, 1);
+PG_REGISTER_WITH_RESET_TEMPLATE(blackboxConfig_t, blackboxConfig, PG_BLACKBOX_CONFIG, 3);
 
 PG_RESET_TEMPLATE(blackboxConfig_t, blackboxConfig,
     .device = DEFAULT_BLACKBOX_DEVICE,
     .rate_num = 1,
     .rate_denom = 1,
     .invertedCardDetection = BLACKBOX_INTERVED_CARD_DETECTION,
+    .groupRateDivisor = { [0 ... BLACKBOX_FIELD_GROUP_COUNT - 1] = 1 },
+    .compression = 0,
 );
 
+// Version 2 appended the field group rates, which keep their defaults
+PG_REGISTER_MIGRATION(blackboxConfig, PG_BLACKBOX_CONFIG, 1);
+
+void pgMigrateFn_blackboxConfig_1(void *base)
+{
+    UNUSED(base);
+}
+
+// Version 3 appended compression, which stays off
+PG_REGISTER_MIGRATION(blackboxConfig, PG_BLACKBOX_CONFIG, 2);
+
+void pgMigrateFn_blackboxConfig_2(void *base)
+{
+    UNUSED(base);
+}
+
 #define BLACKBOX_SHUTDOWN_TIMEOUT_MILLIS 200
 static const int32_t blackboxSInterval = 4096;
 
@@ -182,16 +201,16 @@ static const blackboxDeltaFieldDefinition_t blackboxMainFields[] = {
     {"loopIteration",-1, UNSIGNED, .Ipredict = PREDICT(0),     .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(INC),           .Pencode = FLIGHT_LOG_FIELD_ENCODING_NULL, CONDITION(ALWAYS)},
     /* Time advances pretty steadily so the P-frame prediction is a straight line */
     {"time",       -1, UNSIGNED, .Ipredict = PREDICT(0),       .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(STRAIGHT_LINE), .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"axisRate",    0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"axisRate",    1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"axisRate",    2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"axisP",       0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"axisP",       1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"axisP",       2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
+    {"axisRate",    0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(PID)},
+    {"axisRate",    1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(PID)},
+    {"axisRate",    2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(PID)},
+    {"axisP",       0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(PID)},
+    {"axisP",       1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(PID)},
+    {"axisP",       2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(PID)},
     /* I terms get special packed encoding in P frames: */
-    {"axisI",       0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG2_3S32), CONDITION(ALWAYS)},
-    {"axisI",       1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG2_3S32), CONDITION(ALWAYS)},
-    {"axisI",       2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG2_3S32), CONDITION(ALWAYS)},
+    {"axisI",       0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG2_3S32), CONDITION(PID)},
+    {"axisI",       1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG2_3S32), CONDITION(PID)},
+    {"axisI",       2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG2_3S32), CONDITION(PID)},
     {"axisD",       0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NONZERO_PID_D_0)},
     {"axisD",       1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NONZERO_PID_D_1)},
     {"axisD",       2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NONZERO_PID_D_2)},
@@ -226,16 +245,16 @@ static const blackboxDeltaFieldDefinition_t blackboxMainFields[] = {
     {"mcSurfaceOut",-1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(MC_NAV)},
 
     /* rcData are encoded together as a group: */
-    {"rcData",      0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(ALWAYS)},
-    {"rcData",      1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(ALWAYS)},
-    {"rcData",      2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(ALWAYS)},
-    {"rcData",      3, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(ALWAYS)},
+    {"rcData",      0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(RC)},
+    {"rcData",      1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(RC)},
+    {"rcData",      2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(RC)},
+    {"rcData",      3, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(RC)},
     /* rcCommands are encoded together as a group in P-frames: */
-    {"rcCommand",   0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(ALWAYS)},
-    {"rcCommand",   1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(ALWAYS)},
-    {"rcCommand",   2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(ALWAYS)},
+    {"rcCommand",   0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(RC)},
+    {"rcCommand",   1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(RC)},
+    {"rcCommand",   2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_4S16), CONDITION(RC)},
     /* Throttle is always in the range [minthrottle..maxthrottle]: */
-    {"rcCommand",   3, UNSIGNED, .Ipredict = PREDICT(MINTHROTTLE), .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(PREVIOUS),  .Pencode = ENCODING(TAG8_4S16), CONDITION(ALWAYS)},
+    {"rcCommand",   3, UNSIGNED, .Ipredict = PREDICT(MINTHROTTLE), .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(PREVIOUS),  .Pencode = ENCODING(TAG8_4S16), CONDITION(RC)},
 
     {"vbat",       -1, UNSIGNED, .Ipredict = PREDICT(VBATREF), .Iencode = ENCODING(NEG_14BIT),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_8SVB), FLIGHT_LOG_FIELD_CONDITION_VBAT},
     {"amperage",   -1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_8SVB), FLIGHT_LOG_FIELD_CONDITION_AMPERAGE},
@@ -257,15 +276,15 @@ static const blackboxDeltaFieldDefinition_t blackboxMainFields[] = {
     {"rssi",       -1, UNSIGNED, .Ipredict = PREDICT(0),       .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(TAG8_8SVB), FLIGHT_LOG_FIELD_CONDITION_RSSI},
 
     /* Gyros and accelerometers base their P-predictions on the average of the previous 2 frames to reduce noise impact */
-    {"gyroADC",     0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"gyroADC",     1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"gyroADC",     2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"accSmooth",   0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"accSmooth",   1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"accSmooth",   2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"attitude",    0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"attitude",    1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"attitude",    2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
+    {"gyroADC",     0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(GYRO)},
+    {"gyroADC",     1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(GYRO)},
+    {"gyroADC",     2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(GYRO)},
+    {"accSmooth",   0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ACC)},
+    {"accSmooth",   1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ACC)},
+    {"accSmooth",   2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ACC)},
+    {"attitude",    0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ACC)},
+    {"attitude",    1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ACC)},
+    {"attitude",    2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ACC)},
     {"debug",       0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), FLIGHT_LOG_FIELD_CONDITION_DEBUG},
     {"debug",       1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), FLIGHT_LOG_FIELD_CONDITION_DEBUG},
     {"debug",       2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), FLIGHT_LOG_FIELD_CONDITION_DEBUG},
@@ -289,26 +308,26 @@ static const blackboxDeltaFieldDefinition_t blackboxMainFields[] = {
     {"servo",       5, UNSIGNED, .Ipredict = PREDICT(1500),    .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(TRICOPTER)},
 
 #ifdef NAV_BLACKBOX
-    {"navState",  -1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navFlags",  -1, UNSIGNED, .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navEPH",    -1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navEPV",    -1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navPos",     0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navPos",     1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navPos",     2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navVel",     0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navVel",     1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navVel",     2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navAcc",     0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navAcc",     1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navAcc",     2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navTgtVel",  0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navTgtVel",  1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navTgtVel",  2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navTgtPos",  0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navTgtPos",  1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navTgtPos",  2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
-    {"navSurf",    0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(ALWAYS)},
+    {"navState",  -1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navFlags",  -1, UNSIGNED, .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navEPH",    -1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navEPV",    -1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navPos",     0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navPos",     1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navPos",     2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navVel",     0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navVel",     1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navVel",     2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navAcc",     0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navAcc",     1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navAcc",     2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navTgtVel",  0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navTgtVel",  1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navTgtVel",  2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(AVERAGE_2),     .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navTgtPos",  0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navTgtPos",  1, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navTgtPos",  2, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
+    {"navSurf",    0, SIGNED,   .Ipredict = PREDICT(0),       .Iencode = ENCODING(SIGNED_VB),   .Ppredict = PREDICT(PREVIOUS),      .Pencode = ENCODING(SIGNED_VB), CONDITION(NAV)},
 #endif
 };
 
@@ -522,6 +541,72 @@ static blackboxMainState_t blackboxHistoryRing[3];
 // These point into blackboxHistoryRing, use them to know where to store history of a given age (0, 1 or 2 generations old)
 static blackboxMainState_t* blackboxHistory[3];
 
+/*
+ * The flight loop only copies its state into this ring, frames are encoded from it and written to the device by the
+ * lower priority blackbox task. The ring holds the frames logged while that task waits behind the others, OSD redraws
+ * and navigation updates can hold it off for several ms. That's 16 frames for 8ms of logging every iteration of a
+ * 2kHz loop on F4/F7, slower F3 loops need fewer. Must be a power of 2.
+ */
+#ifndef BLACKBOX_SNAPSHOT_COUNT
+#if defined(STM32F4) || defined(STM32F7)
+#define BLACKBOX_SNAPSHOT_COUNT 16
+#else
+#define BLACKBOX_SNAPSHOT_COUNT 8
+#endif
+#endif
+
+STATIC_ASSERT((BLACKBOX_SNAPSHOT_COUNT & (BLACKBOX_SNAPSHOT_COUNT - 1)) == 0, blackbox_snapshot_count_not_power_of_2);
+
+typedef enum {
+    BLACKBOX_SNAPSHOT_IFRAME = 1 << 0,
+    BLACKBOX_SNAPSHOT_RESUME = 1 << 1,  // Logging resumes after a pause, log the resume event before the frame
+} blackboxSnapshotFlags_e;
+
+#ifdef USE_GPS
+// The GPS values logged in G and H frames
+typedef struct blackboxGpsSolution_s {
+    int32_t homeLat;
+    int32_t homeLon;
+    int32_t lat;
+    int32_t lon;
+    int32_t alt;
+    int16_t velNED[XYZ_AXIS_COUNT];
+    int16_t groundSpeed;
+    int16_t groundCourse;
+    uint16_t hdop;
+    uint16_t eph;
+    uint16_t epv;
+    uint8_t fixType;
+    uint8_t numSat;
+} blackboxGpsSolution_t;
+#endif
+
+// Everything a logged iteration writes is captured with it, so frames and events encoded later keep their timing
+typedef struct blackboxSnapshot_s {
+    blackboxMainState_t state;
+    blackboxSlowState_t slow;
+#ifdef USE_GPS
+    blackboxGpsSolution_t gps;
+#endif
+    uint32_t armingBeepTime;
+    uint32_t iteration;
+    uint16_t pFrameIndex;
+    uint16_t iFrameIndex;
+    uint8_t flags;
+} blackboxSnapshot_t;
+
+static blackboxSnapshot_t blackboxSnapshotRing[BLACKBOX_SNAPSHOT_COUNT];
+static uint8_t blackboxSnapshotHead;
+static uint8_t blackboxSnapshotTail;
+// Flags carried over from snapshots that were dropped because the ring was full
+static uint8_t blackboxSnapshotDroppedFlags;
+static uint32_t blackboxSnapshotDroppedFrames;
+
+// Main frames until each field group is read again, groups logged at a lower rate hold their values in between
+static uint8_t blackboxFieldGroupCountdown[BLACKBOX_FIELD_GROUP_COUNT];
+
+STATIC_ASSERT(BLACKBOX_FIELD_GROUP_COUNT <= 16, too_many_blackbox_field_groups);
+
 static bool blackboxModeActivationConditionPresent = false;
 
 /**
@@ -537,6 +622,11 @@ static bool blackboxIsOnlyLoggingIntraframes(void)
     return blackboxConfig()->rate_num == 1 && blackboxConfig()->rate_denom == blackboxIFrameInterval;
 }
 
+static bool blackboxFieldGroupEnabled(blackboxFieldGroup_e group)
+{
+    return blackboxConfig()->groupRateDivisor[group] != 0;
+}
+
 static bool testBlackboxConditionUncached(FlightLogFieldCondition condition)
 {
     switch (condition) {
@@ -551,72 +641,95 @@ static bool testBlackboxConditionUncached(FlightLogFieldCondition condition)
     case FLIGHT_LOG_FIELD_CONDITION_AT_LEAST_MOTORS_6:
     case FLIGHT_LOG_FIELD_CONDITION_AT_LEAST_MOTORS_7:
     case FLIGHT_LOG_FIELD_CONDITION_AT_LEAST_MOTORS_8:
-        return getMotorCount() >= condition - FLIGHT_LOG_FIELD_CONDITION_AT_LEAST_MOTORS_1 + 1;
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_MOTORS) &&
+            getMotorCount() >= condition - FLIGHT_LOG_FIELD_CONDITION_AT_LEAST_MOTORS_1 + 1;
 
     case FLIGHT_LOG_FIELD_CONDITION_TRICOPTER:
-        return mixerConfig()->platformType == PLATFORM_TRICOPTER;
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_MOTORS) && mixerConfig()->platformType == PLATFORM_TRICOPTER;
 
     case FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_D_0:
     case FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_D_1:
     case FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_D_2:
-        return pidBank()->pid[condition - FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_D_0].D != 0;
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_PID) &&
+            pidBank()->pid[condition - FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_D_0].D != 0;
 
     case FLIGHT_LOG_FIELD_CONDITION_MAG:
 #ifdef USE_MAG
-        return sensors(SENSOR_MAG);
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_SENSORS) && sensors(SENSOR_MAG);
 #else
         return false;
 #endif
 
     case FLIGHT_LOG_FIELD_CONDITION_BARO:
 #ifdef USE_BARO
-        return sensors(SENSOR_BARO);
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_SENSORS) && sensors(SENSOR_BARO);
 #else
         return false;
 #endif
 
     case FLIGHT_LOG_FIELD_CONDITION_PITOT:
 #ifdef USE_PITOT
-        return sensors(SENSOR_PITOT);
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_SENSORS) && sensors(SENSOR_PITOT);
 #else
         return false;
 #endif
 
     case FLIGHT_LOG_FIELD_CONDITION_VBAT:
-        return feature(FEATURE_VBAT);
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_SENSORS) && feature(FEATURE_VBAT);
 
     case FLIGHT_LOG_FIELD_CONDITION_AMPERAGE:
-        return feature(FEATURE_CURRENT_METER) && batteryMetersConfig()->current.type == CURRENT_SENSOR_ADC;
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_SENSORS) &&
+            feature(FEATURE_CURRENT_METER) && batteryMetersConfig()->current.type == CURRENT_SENSOR_ADC;
 
     case FLIGHT_LOG_FIELD_CONDITION_SURFACE:
 #ifdef USE_RANGEFINDER
-        return sensors(SENSOR_RANGEFINDER);
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_SENSORS) && sensors(SENSOR_RANGEFINDER);
 #else
         return false;
 #endif
 
     case FLIGHT_LOG_FIELD_CONDITION_FIXED_WING_NAV:
 #ifdef USE_NAV
-        return STATE(FIXED_WING);
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_NAV_PID) && STATE(FIXED_WING);
 #else
         return false;
 #endif
 
     case FLIGHT_LOG_FIELD_CONDITION_MC_NAV:
 #ifdef USE_NAV
-        return !STATE(FIXED_WING);
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_NAV_PID) && !STATE(FIXED_WING);
 #else
         return false;
 #endif
 
     case FLIGHT_LOG_FIELD_CONDITION_RSSI:
-        return rxConfig()->rssi_channel > 0 || feature(FEATURE_RSSI_ADC);
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_SENSORS) &&
+            (rxConfig()->rssi_channel > 0 || feature(FEATURE_RSSI_ADC));
 
     case FLIGHT_LOG_FIELD_CONDITION_NOT_LOGGING_EVERY_FRAME:
         return blackboxConfig()->rate_num < blackboxConfig()->rate_denom;
 
     case FLIGHT_LOG_FIELD_CONDITION_DEBUG:
-        return debugMode != DEBUG_NONE;
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_DEBUG) && debugMode != DEBUG_NONE;
+
+    case FLIGHT_LOG_FIELD_CONDITION_PID:
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_PID);
+
+    case FLIGHT_LOG_FIELD_CONDITION_RC:
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_RC);
+
+    case FLIGHT_LOG_FIELD_CONDITION_GYRO:
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_GYRO);
+
+    case FLIGHT_LOG_FIELD_CONDITION_ACC:
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_ACC);
+
+    case FLIGHT_LOG_FIELD_CONDITION_NAV:
+#ifdef NAV_BLACKBOX
+        return blackboxFieldGroupEnabled(BLACKBOX_FIELD_GROUP_NAV);
+#else
+        return false;
+#endif
 
     case FLIGHT_LOG_FIELD_CONDITION_NEVER:
         return false;
@@ -675,18 +788,20 @@ static void blackboxSetState(BlackboxState newState)
     blackboxState = newState;
 }
 
-static void writeIntraframe(void)
+static void writeIntraframe(uint32_t iteration)
 {
     blackboxMainState_t *blackboxCurrent = blackboxHistory[0];
 
-    blackboxWrite('I');
+    blackboxBeginFrame('I');
 
-    blackboxWriteUnsignedVB(blackboxIteration);
+    blackboxWriteUnsignedVB(iteration);
     blackboxWriteUnsignedVB(blackboxCurrent->time);
 
-    blackboxWriteSignedVBArray(blackboxCurrent->axisPID_Setpoint, XYZ_AXIS_COUNT);
-    blackboxWriteSignedVBArray(blackboxCurrent->axisPID_P, XYZ_AXIS_COUNT);
-    blackboxWriteSignedVBArray(blackboxCurrent->axisPID_I, XYZ_AXIS_COUNT);
+    if (testBlackboxCondition(CONDITION(PID))) {
+        blackboxWriteSignedVBArray(blackboxCurrent->axisPID_Setpoint, XYZ_AXIS_COUNT);
+        blackboxWriteSignedVBArray(blackboxCurrent->axisPID_P, XYZ_AXIS_COUNT);
+        blackboxWriteSignedVBArray(blackboxCurrent->axisPID_I, XYZ_AXIS_COUNT);
+    }
 
     // Don't bother writing the current D term if the corresponding PID setting is zero
     for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
@@ -716,17 +831,19 @@ static void writeIntraframe(void)
         blackboxWriteSignedVB(blackboxCurrent->mcSurfacePIDOutput);
     }
 
-    // Write raw stick positions
-    blackboxWriteSigned16VBArray(blackboxCurrent->rcData, 4);
+    if (testBlackboxCondition(CONDITION(RC))) {
+        // Write raw stick positions
+        blackboxWriteSigned16VBArray(blackboxCurrent->rcData, 4);
 
-    // Write roll, pitch and yaw first:
-    blackboxWriteSigned16VBArray(blackboxCurrent->rcCommand, 3);
+        // Write roll, pitch and yaw first:
+        blackboxWriteSigned16VBArray(blackboxCurrent->rcCommand, 3);
 
-    /*
-     * Write the throttle separately from the rest of the RC data so we can apply a predictor to it.
-     * Throttle lies in range [minthrottle..maxthrottle]:
-     */
-    blackboxWriteUnsignedVB(blackboxCurrent->rcCommand[THROTTLE] - motorConfig()->minthrottle);
+        /*
+         * Write the throttle separately from the rest of the RC data so we can apply a predictor to it.
+         * Throttle lies in range [minthrottle..maxthrottle]:
+         */
+        blackboxWriteUnsignedVB(blackboxCurrent->rcCommand[THROTTLE] - motorConfig()->minthrottle);
+    }
 
     if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_VBAT)) {
         /*
@@ -771,21 +888,28 @@ static void writeIntraframe(void)
         blackboxWriteUnsignedVB(blackboxCurrent->rssi);
     }
 
-    blackboxWriteSigned16VBArray(blackboxCurrent->gyroADC, XYZ_AXIS_COUNT);
-    blackboxWriteSigned16VBArray(blackboxCurrent->accADC, XYZ_AXIS_COUNT);
-    blackboxWriteSigned16VBArray(blackboxCurrent->attitude, XYZ_AXIS_COUNT);
+    if (testBlackboxCondition(CONDITION(GYRO))) {
+        blackboxWriteSigned16VBArray(blackboxCurrent->gyroADC, XYZ_AXIS_COUNT);
+    }
+
+    if (testBlackboxCondition(CONDITION(ACC))) {
+        blackboxWriteSigned16VBArray(blackboxCurrent->accADC, XYZ_AXIS_COUNT);
+        blackboxWriteSigned16VBArray(blackboxCurrent->attitude, XYZ_AXIS_COUNT);
+    }
 
     if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_DEBUG)) {
         blackboxWriteSignedVBArray(blackboxCurrent->debug, DEBUG32_VALUE_COUNT);
     }
 
-    //Motors can be below minthrottle when disarmed, but that doesn't happen much
-    blackboxWriteUnsignedVB(blackboxCurrent->motor[0] - motorConfig()->minthrottle);
+    if (testBlackboxCondition(CONDITION(AT_LEAST_MOTORS_1))) {
+        //Motors can be below minthrottle when disarmed, but that doesn't happen much
+        blackboxWriteUnsignedVB(blackboxCurrent->motor[0] - motorConfig()->minthrottle);
 
-    //Motors tend to be similar to each other so use the first motor's value as a predictor of the others
-    const int motorCount = getMotorCount();
-    for (int x = 1; x < motorCount; x++) {
-        blackboxWriteSignedVB(blackboxCurrent->motor[x] - blackboxCurrent->motor[0]);
+        //Motors tend to be similar to each other so use the first motor's value as a predictor of the others
+        const int motorCount = getMotorCount();
+        for (int x = 1; x < motorCount; x++) {
+            blackboxWriteSignedVB(blackboxCurrent->motor[x] - blackboxCurrent->motor[0]);
+        }
     }
 
     if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_TRICOPTER)) {
@@ -794,35 +918,39 @@ static void writeIntraframe(void)
     }
 
 #ifdef NAV_BLACKBOX
-    blackboxWriteSignedVB(blackboxCurrent->navState);
+    if (testBlackboxCondition(CONDITION(NAV))) {
+        blackboxWriteSignedVB(blackboxCurrent->navState);
 
-    blackboxWriteSignedVB(blackboxCurrent->navFlags);
-    blackboxWriteSignedVB(blackboxCurrent->navEPH);
-    blackboxWriteSignedVB(blackboxCurrent->navEPV);
+        blackboxWriteSignedVB(blackboxCurrent->navFlags);
+        blackboxWriteSignedVB(blackboxCurrent->navEPH);
+        blackboxWriteSignedVB(blackboxCurrent->navEPV);
 
-    for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
-        blackboxWriteSignedVB(blackboxCurrent->navPos[x]);
-    }
+        for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
+            blackboxWriteSignedVB(blackboxCurrent->navPos[x]);
+        }
 
-    for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
-        blackboxWriteSignedVB(blackboxCurrent->navRealVel[x]);
-    }
+        for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
+            blackboxWriteSignedVB(blackboxCurrent->navRealVel[x]);
+        }
 
-    for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
-        blackboxWriteSignedVB(blackboxCurrent->navAccNEU[x]);
-    }
+        for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
+            blackboxWriteSignedVB(blackboxCurrent->navAccNEU[x]);
+        }
 
-    for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
-        blackboxWriteSignedVB(blackboxCurrent->navTargetVel[x]);
-    }
+        for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
+            blackboxWriteSignedVB(blackboxCurrent->navTargetVel[x]);
+        }
 
-    for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
-        blackboxWriteSignedVB(blackboxCurrent->navTargetPos[x]);
-    }
+        for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
+            blackboxWriteSignedVB(blackboxCurrent->navTargetPos[x]);
+        }
 
-    blackboxWriteSignedVB(blackboxCurrent->navSurface);
+        blackboxWriteSignedVB(blackboxCurrent->navSurface);
+    }
 #endif
 
+    blackboxEndFrame();
+
     //Rotate our history buffers:
 
     //The current state becomes the new "before" state
@@ -854,7 +982,7 @@ static void writeInterframe(void)
     blackboxMainState_t *blackboxCurrent = blackboxHistory[0];
     blackboxMainState_t *blackboxLast = blackboxHistory[1];
 
-    blackboxWrite('P');
+    blackboxBeginFrame('P');
 
     //No need to store iteration count since its delta is always 1
 
@@ -865,18 +993,20 @@ static void writeInterframe(void)
     blackboxWriteSignedVB((int32_t) (blackboxHistory[0]->time - 2 * blackboxHistory[1]->time + blackboxHistory[2]->time));
 
     int32_t deltas[8];
-    arraySubInt32(deltas, blackboxCurrent->axisPID_Setpoint, blackboxLast->axisPID_Setpoint, XYZ_AXIS_COUNT);
-    blackboxWriteSignedVBArray(deltas, XYZ_AXIS_COUNT);
+    if (testBlackboxCondition(CONDITION(PID))) {
+        arraySubInt32(deltas, blackboxCurrent->axisPID_Setpoint, blackboxLast->axisPID_Setpoint, XYZ_AXIS_COUNT);
+        blackboxWriteSignedVBArray(deltas, XYZ_AXIS_COUNT);
 
-    arraySubInt32(deltas, blackboxCurrent->axisPID_P, blackboxLast->axisPID_P, XYZ_AXIS_COUNT);
-    blackboxWriteSignedVBArray(deltas, XYZ_AXIS_COUNT);
+        arraySubInt32(deltas, blackboxCurrent->axisPID_P, blackboxLast->axisPID_P, XYZ_AXIS_COUNT);
+        blackboxWriteSignedVBArray(deltas, XYZ_AXIS_COUNT);
 
-    /*
-     * The PID I field changes very slowly, most of the time +-2, so use an encoding
-     * that can pack all three fields into one byte in that situation.
-     */
-    arraySubInt32(deltas, blackboxCurrent->axisPID_I, blackboxLast->axisPID_I, XYZ_AXIS_COUNT);
-    blackboxWriteTag2_3S32(deltas);
+        /*
+         * The PID I field changes very slowly, most of the time +-2, so use an encoding
+         * that can pack all three fields into one byte in that situation.
+         */
+        arraySubInt32(deltas, blackboxCurrent->axisPID_I, blackboxLast->axisPID_I, XYZ_AXIS_COUNT);
+        blackboxWriteTag2_3S32(deltas);
+    }
 
     /*
      * The PID D term is frequently set to zero for yaw, which makes the result from the calculation
@@ -925,19 +1055,21 @@ static void writeInterframe(void)
      * can pack multiple values per byte:
      */
 
-    // rcData
-    for (int x = 0; x < 4; x++) {
-        deltas[x] = blackboxCurrent->rcData[x] - blackboxLast->rcData[x];
-    }
+    if (testBlackboxCondition(CONDITION(RC))) {
+        // rcData
+        for (int x = 0; x < 4; x++) {
+            deltas[x] = blackboxCurrent->rcData[x] - blackboxLast->rcData[x];
+        }
 
-    blackboxWriteTag8_4S16(deltas);
+        blackboxWriteTag8_4S16(deltas);
 
-    // rcCommand
-    for (int x = 0; x < 4; x++) {
-        deltas[x] = blackboxCurrent->rcCommand[x] - blackboxLast->rcCommand[x];
-    }
+        // rcCommand
+        for (int x = 0; x < 4; x++) {
+            deltas[x] = blackboxCurrent->rcCommand[x] - blackboxLast->rcCommand[x];
+        }
 
-    blackboxWriteTag8_4S16(deltas);
+        blackboxWriteTag8_4S16(deltas);
+    }
 
     //Check for sensors that are updated periodically (so deltas are normally zero)
     int optionalFieldCount = 0;
@@ -983,48 +1115,58 @@ static void writeInterframe(void)
     blackboxWriteTag8_8SVB(deltas, optionalFieldCount);
 
     //Since gyros, accs and motors are noisy, base their predictions on the average of the history:
-    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, gyroADC),   XYZ_AXIS_COUNT);
-    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, accADC), XYZ_AXIS_COUNT);
-    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, attitude), XYZ_AXIS_COUNT);
+    if (testBlackboxCondition(CONDITION(GYRO))) {
+        blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, gyroADC),   XYZ_AXIS_COUNT);
+    }
+    if (testBlackboxCondition(CONDITION(ACC))) {
+        blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, accADC), XYZ_AXIS_COUNT);
+        blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, attitude), XYZ_AXIS_COUNT);
+    }
     if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_DEBUG)) {
         blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, debug), DEBUG32_VALUE_COUNT);
     }
-    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, motor),     getMotorCount());
+    if (testBlackboxCondition(CONDITION(AT_LEAST_MOTORS_1))) {
+        blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, motor),     getMotorCount());
+    }
 
     if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_TRICOPTER)) {
         blackboxWriteSignedVB(blackboxCurrent->servo[5] - blackboxLast->servo[5]);
     }
 
 #ifdef NAV_BLACKBOX
-    blackboxWriteSignedVB(blackboxCurrent->navState - blackboxLast->navState);
+    if (testBlackboxCondition(CONDITION(NAV))) {
+        blackboxWriteSignedVB(blackboxCurrent->navState - blackboxLast->navState);
 
-    blackboxWriteSignedVB(blackboxCurrent->navFlags - blackboxLast->navFlags);
-    blackboxWriteSignedVB(blackboxCurrent->navEPH - blackboxLast->navEPH);
-    blackboxWriteSignedVB(blackboxCurrent->navEPV - blackboxLast->navEPV);
+        blackboxWriteSignedVB(blackboxCurrent->navFlags - blackboxLast->navFlags);
+        blackboxWriteSignedVB(blackboxCurrent->navEPH - blackboxLast->navEPH);
+        blackboxWriteSignedVB(blackboxCurrent->navEPV - blackboxLast->navEPV);
 
-    for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
-        blackboxWriteSignedVB(blackboxCurrent->navPos[x] - blackboxLast->navPos[x]);
-    }
+        for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
+            blackboxWriteSignedVB(blackboxCurrent->navPos[x] - blackboxLast->navPos[x]);
+        }
 
-    for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
-        blackboxWriteSignedVB(blackboxHistory[0]->navRealVel[x] - (blackboxHistory[1]->navRealVel[x] + blackboxHistory[2]->navRealVel[x]) / 2);
-    }
+        for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
+            blackboxWriteSignedVB(blackboxHistory[0]->navRealVel[x] - (blackboxHistory[1]->navRealVel[x] + blackboxHistory[2]->navRealVel[x]) / 2);
+        }
 
-    for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
-        blackboxWriteSignedVB(blackboxHistory[0]->navAccNEU[x] - (blackboxHistory[1]->navAccNEU[x] + blackboxHistory[2]->navAccNEU[x]) / 2);
-    }
+        for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
+            blackboxWriteSignedVB(blackboxHistory[0]->navAccNEU[x] - (blackboxHistory[1]->navAccNEU[x] + blackboxHistory[2]->navAccNEU[x]) / 2);
+        }
 
-    for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
-        blackboxWriteSignedVB(blackboxHistory[0]->navTargetVel[x] - (blackboxHistory[1]->navTargetVel[x] + blackboxHistory[2]->navTargetVel[x]) / 2);
-    }
+        for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
+            blackboxWriteSignedVB(blackboxHistory[0]->navTargetVel[x] - (blackboxHistory[1]->navTargetVel[x] + blackboxHistory[2]->navTargetVel[x]) / 2);
+        }
 
-    for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
-        blackboxWriteSignedVB(blackboxHistory[0]->navTargetPos[x] - blackboxLast->navTargetPos[x]);
-    }
+        for (int x = 0; x < XYZ_AXIS_COUNT; x++) {
+            blackboxWriteSignedVB(blackboxHistory[0]->navTargetPos[x] - blackboxLast->navTargetPos[x]);
+        }
 
-    blackboxWriteSignedVB(blackboxCurrent->navSurface - blackboxLast->navSurface);
+        blackboxWriteSignedVB(blackboxCurrent->navSurface - blackboxLast->navSurface);
+    }
 #endif
 
+    blackboxEndFrame();
+
     //Rotate our history buffers
     blackboxHistory[2] = blackboxHistory[1];
     blackboxHistory[1] = blackboxHistory[0];
@@ -1039,7 +1181,7 @@ static void writeSlowFrame(void)
 {
     int32_t values[3];
 
-    blackboxWrite('S');
+    blackboxBeginFrame('S');
 
     blackboxWriteUnsignedVB(slowHistory.flightModeFlags);
     blackboxWriteUnsignedVB(slowHistory.stateFlags);
@@ -1069,6 +1211,8 @@ static void writeSlowFrame(void)
     blackboxWriteSigned16VBArray(slowHistory.tempSensorTemperature, MAX_TEMP_SENSORS);
 #endif
 
+    blackboxEndFrame();
+
     blackboxSlowFrameIterationTimer = 0;
 }
 
@@ -1120,29 +1264,21 @@ static void loadSlowState(blackboxSlowState_t *slow)
 }
 
 /**
- * If the data in the slow frame has changed, log a slow frame.
+ * If the given slow state differs from the one logged last, log a slow frame.
  *
  * If allowPeriodicWrite is true, the frame is also logged if it has been more than blackboxSInterval logging iterations
  * since the field was last logged.
  */
-static bool writeSlowFrameIfNeeded(bool allowPeriodicWrite)
+static bool writeSlowFrameIfNeeded(bool allowPeriodicWrite, const blackboxSlowState_t *slow)
 {
     // Write the slow frame peridocially so it can be recovered if we ever lose sync
     bool shouldWrite = allowPeriodicWrite && blackboxSlowFrameIterationTimer >= blackboxSInterval;
 
-    if (shouldWrite) {
-        loadSlowState(&slowHistory);
-    } else {
-        blackboxSlowState_t newSlowState;
-
-        loadSlowState(&newSlowState);
-
-        // Only write a slow frame if it was different from the previous state
-        if (memcmp(&newSlowState, &slowHistory, sizeof(slowHistory)) != 0) {
-            // Use the new state as our new history
-            memcpy(&slowHistory, &newSlowState, sizeof(slowHistory));
-            shouldWrite = true;
-        }
+    // Only write a slow frame if it was different from the previous state
+    if (shouldWrite || memcmp(slow, &slowHistory, sizeof(slowHistory)) != 0) {
+        // Use the new state as our new history
+        memcpy(&slowHistory, slow, sizeof(slowHistory));
+        shouldWrite = true;
     }
 
     if (shouldWrite) {
@@ -1189,6 +1325,11 @@ static void blackboxResetIterationTimers(void)
     blackboxIteration = 0;
     blackboxPFrameIndex = 0;
     blackboxIFrameIndex = 0;
+
+    blackboxSnapshotHead = 0;
+    blackboxSnapshotTail = 0;
+    blackboxSnapshotDroppedFlags = 0;
+    blackboxSnapshotDroppedFrames = 0;
 }
 
 /**
@@ -1238,6 +1379,8 @@ void blackboxStart(void)
     blackboxSetState(BLACKBOX_STATE_PREPARE_LOG_FILE);
 }
 
+static void blackboxLogPendingSnapshots(void);
+
 /**
  * Begin Blackbox shutdown.
  */
@@ -1252,6 +1395,8 @@ void blackboxFinish(void)
 
     case BLACKBOX_STATE_RUNNING:
     case BLACKBOX_STATE_PAUSED:
+        // Frames captured before disarming belong before the end of the log
+        blackboxLogPendingSnapshots();
         blackboxLogEvent(FLIGHT_LOG_EVENT_LOG_END, NULL);
         FALLTHROUGH;
 
@@ -1261,21 +1406,40 @@ void blackboxFinish(void)
 }
 
 #ifdef USE_GPS
-static void writeGPSHomeFrame(void)
+static void loadGpsSolution(blackboxGpsSolution_t *gps)
+{
+    gps->homeLat = GPS_home.lat;
+    gps->homeLon = GPS_home.lon;
+    gps->lat = gpsSol.llh.lat;
+    gps->lon = gpsSol.llh.lon;
+    gps->alt = gpsSol.llh.alt;
+    memcpy(gps->velNED, gpsSol.velNED, sizeof(gps->velNED));
+    gps->groundSpeed = gpsSol.groundSpeed;
+    gps->groundCourse = gpsSol.groundCourse;
+    gps->hdop = gpsSol.hdop;
+    gps->eph = gpsSol.eph;
+    gps->epv = gpsSol.epv;
+    gps->fixType = gpsSol.fixType;
+    gps->numSat = gpsSol.numSat;
+}
+
+static void writeGPSHomeFrame(const blackboxGpsSolution_t *gps)
 {
-    blackboxWrite('H');
+    blackboxBeginFrame('H');
 
-    blackboxWriteSignedVB(GPS_home.lat);
-    blackboxWriteSignedVB(GPS_home.lon);
+    blackboxWriteSignedVB(gps->homeLat);
+    blackboxWriteSignedVB(gps->homeLon);
     //TODO it'd be great if we could grab the GPS current time and write that too
 
-    gpsHistory.GPS_home[0] = GPS_home.lat;
-    gpsHistory.GPS_home[1] = GPS_home.lon;
+    blackboxEndFrame();
+
+    gpsHistory.GPS_home[0] = gps->homeLat;
+    gpsHistory.GPS_home[1] = gps->homeLon;
 }
 
-static void writeGPSFrame(timeUs_t currentTimeUs)
+static void writeGPSFrame(timeUs_t currentTimeUs, const blackboxGpsSolution_t *gps)
 {
-    blackboxWrite('G');
+    blackboxBeginFrame('G');
 
     /*
      * If we're logging every frame, then a GPS frame always appears just after a frame with the
@@ -1288,136 +1452,163 @@ static void writeGPSFrame(timeUs_t currentTimeUs)
         blackboxWriteUnsignedVB(currentTimeUs - blackboxHistory[1]->time);
     }
 
-    blackboxWriteUnsignedVB(gpsSol.fixType);
-    blackboxWriteUnsignedVB(gpsSol.numSat);
-    blackboxWriteSignedVB(gpsSol.llh.lat - gpsHistory.GPS_home[0]);
-    blackboxWriteSignedVB(gpsSol.llh.lon - gpsHistory.GPS_home[1]);
-    blackboxWriteSignedVB(gpsSol.llh.alt / 100); // meters
-    blackboxWriteUnsignedVB(gpsSol.groundSpeed);
-    blackboxWriteUnsignedVB(gpsSol.groundCourse);
-    blackboxWriteUnsignedVB(gpsSol.hdop);
-    blackboxWriteUnsignedVB(gpsSol.eph);
-    blackboxWriteUnsignedVB(gpsSol.epv);
-    blackboxWriteSigned16VBArray(gpsSol.velNED, XYZ_AXIS_COUNT);
-
-    gpsHistory.GPS_numSat = gpsSol.numSat;
-    gpsHistory.GPS_coord[0] = gpsSol.llh.lat;
-    gpsHistory.GPS_coord[1] = gpsSol.llh.lon;
+    blackboxWriteUnsignedVB(gps->fixType);
+    blackboxWriteUnsignedVB(gps->numSat);
+    blackboxWriteSignedVB(gps->lat - gpsHistory.GPS_home[0]);
+    blackboxWriteSignedVB(gps->lon - gpsHistory.GPS_home[1]);
+    blackboxWriteSignedVB(gps->alt / 100); // meters
+    blackboxWriteUnsignedVB(gps->groundSpeed);
+    blackboxWriteUnsignedVB(gps->groundCourse);
+    blackboxWriteUnsignedVB(gps->hdop);
+    blackboxWriteUnsignedVB(gps->eph);
+    blackboxWriteUnsignedVB(gps->epv);
+    blackboxWriteSigned16VBArray(gps->velNED, XYZ_AXIS_COUNT);
+
+    blackboxEndFrame();
+
+    gpsHistory.GPS_numSat = gps->numSat;
+    gpsHistory.GPS_coord[0] = gps->lat;
+    gpsHistory.GPS_coord[1] = gps->lon;
 }
 #endif
 
+#define FIELD_GROUP(x) (1 << BLACKBOX_FIELD_GROUP_ ## x)
+
 /**
- * Fill the current state of the blackbox using values read from the flight controller
+ * Fill the given state using values read from the flight controller. Only the field groups in the given mask are
+ * read, the others are left as they are.
  */
-static void loadMainState(timeUs_t currentTimeUs)
+static void loadMainState(blackboxMainState_t *blackboxCurrent, timeUs_t currentTimeUs, uint16_t fieldGroups)
 {
-    blackboxMainState_t *blackboxCurrent = blackboxHistory[0];
-
     blackboxCurrent->time = currentTimeUs;
 
-#ifdef USE_NAV
-    const navigationPIDControllers_t *nav_pids = getNavigationPIDControllers();
-#endif
+    if (fieldGroups & FIELD_GROUP(PID)) {
+        for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+            blackboxCurrent->axisPID_Setpoint[i] = axisPID_Setpoint[i];
+            blackboxCurrent->axisPID_P[i] = axisPID_P[i];
+            blackboxCurrent->axisPID_I[i] = axisPID_I[i];
+            blackboxCurrent->axisPID_D[i] = axisPID_D[i];
+        }
+    }
 
-    for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
-        blackboxCurrent->axisPID_Setpoint[i] = axisPID_Setpoint[i];
-        blackboxCurrent->axisPID_P[i] = axisPID_P[i];
-        blackboxCurrent->axisPID_I[i] = axisPID_I[i];
-        blackboxCurrent->axisPID_D[i] = axisPID_D[i];
-        blackboxCurrent->gyroADC[i] = lrintf(gyro.gyroADCf[i]);
-        blackboxCurrent->accADC[i] = lrintf(acc.accADCf[i] * acc.dev.acc_1G);
-#ifdef USE_MAG
-        blackboxCurrent->magADC[i] = mag.magADC[i];
-#endif
-#ifdef USE_NAV
-        if (!STATE(FIXED_WING)) {
-            // log requested velocity in cm/s
-            blackboxCurrent->mcPosAxisP[i] = lrintf(nav_pids->pos[i].output_constrained);
-
-            // log requested acceleration in cm/s^2 and throttle adjustment in µs
-            blackboxCurrent->mcVelAxisPID[0][i] = lrintf(nav_pids->vel[i].proportional);
-            blackboxCurrent->mcVelAxisPID[1][i] = lrintf(nav_pids->vel[i].integral);
-            blackboxCurrent->mcVelAxisPID[2][i] = lrintf(nav_pids->vel[i].derivative);
-            blackboxCurrent->mcVelAxisOutput[i] = lrintf(nav_pids->vel[i].output_constrained);
+    if (fieldGroups & FIELD_GROUP(GYRO)) {
+        for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+            blackboxCurrent->gyroADC[i] = lrintf(gyro.gyroADCf[i]);
         }
-#endif
+    }
+
+    if (fieldGroups & FIELD_GROUP(ACC)) {
+        for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+            blackboxCurrent->accADC[i] = lrintf(acc.accADCf[i] * acc.dev.acc_1G);
+        }
+
+        blackboxCurrent->attitude[0] = attitude.values.roll;
+        blackboxCurrent->attitude[1] = attitude.values.pitch;
+        blackboxCurrent->attitude[2] = attitude.values.yaw;
     }
 
 #ifdef USE_NAV
-    if (STATE(FIXED_WING)) {
+    if (fieldGroups & FIELD_GROUP(NAV_PID)) {
+        const navigationPIDControllers_t *nav_pids = getNavigationPIDControllers();
 
-        // log requested pitch in decidegrees
-        blackboxCurrent->fwAltPID[0] = lrintf(nav_pids->fw_alt.proportional);
-        blackboxCurrent->fwAltPID[1] = lrintf(nav_pids->fw_alt.integral);
-        blackboxCurrent->fwAltPID[2] = lrintf(nav_pids->fw_alt.derivative);
-        blackboxCurrent->fwAltPIDOutput = lrintf(nav_pids->fw_alt.output_constrained);
+        if (STATE(FIXED_WING)) {
 
-        // log requested roll in decidegrees
-        blackboxCurrent->fwPosPID[0] = lrintf(nav_pids->fw_nav.proportional / 10);
-        blackboxCurrent->fwPosPID[1] = lrintf(nav_pids->fw_nav.integral / 10);
-        blackboxCurrent->fwPosPID[2] = lrintf(nav_pids->fw_nav.derivative / 10);
-        blackboxCurrent->fwPosPIDOutput = lrintf(nav_pids->fw_nav.output_constrained / 10);
+            // log requested pitch in decidegrees
+            blackboxCurrent->fwAltPID[0] = lrintf(nav_pids->fw_alt.proportional);
+            blackboxCurrent->fwAltPID[1] = lrintf(nav_pids->fw_alt.integral);
+            blackboxCurrent->fwAltPID[2] = lrintf(nav_pids->fw_alt.derivative);
+            blackboxCurrent->fwAltPIDOutput = lrintf(nav_pids->fw_alt.output_constrained);
 
-    } else {
-        blackboxCurrent->mcSurfacePID[0] = lrintf(nav_pids->surface.proportional / 10);
-        blackboxCurrent->mcSurfacePID[1] = lrintf(nav_pids->surface.integral / 10);
-        blackboxCurrent->mcSurfacePID[2] = lrintf(nav_pids->surface.derivative / 10);
-        blackboxCurrent->mcSurfacePIDOutput = lrintf(nav_pids->surface.output_constrained / 10);
+            // log requested roll in decidegrees
+            blackboxCurrent->fwPosPID[0] = lrintf(nav_pids->fw_nav.proportional / 10);
+            blackboxCurrent->fwPosPID[1] = lrintf(nav_pids->fw_nav.integral / 10);
+            blackboxCurrent->fwPosPID[2] = lrintf(nav_pids->fw_nav.derivative / 10);
+            blackboxCurrent->fwPosPIDOutput = lrintf(nav_pids->fw_nav.output_constrained / 10);
+
+        } else {
+            for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+                // log requested velocity in cm/s
+                blackboxCurrent->mcPosAxisP[i] = lrintf(nav_pids->pos[i].output_constrained);
+
+                // log requested acceleration in cm/s^2 and throttle adjustment in µs
+                blackboxCurrent->mcVelAxisPID[0][i] = lrintf(nav_pids->vel[i].proportional);
+                blackboxCurrent->mcVelAxisPID[1][i] = lrintf(nav_pids->vel[i].integral);
+                blackboxCurrent->mcVelAxisPID[2][i] = lrintf(nav_pids->vel[i].derivative);
+                blackboxCurrent->mcVelAxisOutput[i] = lrintf(nav_pids->vel[i].output_constrained);
+            }
+
+            blackboxCurrent->mcSurfacePID[0] = lrintf(nav_pids->surface.proportional / 10);
+            blackboxCurrent->mcSurfacePID[1] = lrintf(nav_pids->surface.integral / 10);
+            blackboxCurrent->mcSurfacePID[2] = lrintf(nav_pids->surface.derivative / 10);
+            blackboxCurrent->mcSurfacePIDOutput = lrintf(nav_pids->surface.output_constrained / 10);
+        }
     }
 #endif
 
-    for (int i = 0; i < 4; i++) {
-        blackboxCurrent->rcData[i] = rcData[i];
-        blackboxCurrent->rcCommand[i] = rcCommand[i];
+    if (fieldGroups & FIELD_GROUP(RC)) {
+        for (int i = 0; i < 4; i++) {
+            blackboxCurrent->rcData[i] = rcData[i];
+            blackboxCurrent->rcCommand[i] = rcCommand[i];
+        }
     }
 
-    blackboxCurrent->attitude[0] = attitude.values.roll;
-    blackboxCurrent->attitude[1] = attitude.values.pitch;
-    blackboxCurrent->attitude[2] = attitude.values.yaw;
-
-    for (int i = 0; i < DEBUG32_VALUE_COUNT; i++) {
-        blackboxCurrent->debug[i] = debug[i];
+    if (fieldGroups & FIELD_GROUP(DEBUG)) {
+        for (int i = 0; i < DEBUG32_VALUE_COUNT; i++) {
+            blackboxCurrent->debug[i] = debug[i];
+        }
     }
 
-    const int motorCount = getMotorCount();
-    for (int i = 0; i < motorCount; i++) {
-        blackboxCurrent->motor[i] = motor[i];
+    if (fieldGroups & FIELD_GROUP(MOTORS)) {
+        const int motorCount = getMotorCount();
+        for (int i = 0; i < motorCount; i++) {
+            blackboxCurrent->motor[i] = motor[i];
+        }
+
+        //Tail servo for tricopters
+        blackboxCurrent->servo[5] = servo[5];
     }
 
-    blackboxCurrent->vbat = getBatteryRawVoltage();
-    blackboxCurrent->amperage = getAmperage();
+    if (fieldGroups & FIELD_GROUP(SENSORS)) {
+        blackboxCurrent->vbat = getBatteryRawVoltage();
+        blackboxCurrent->amperage = getAmperage();
+
+#ifdef USE_MAG
+        for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+            blackboxCurrent->magADC[i] = mag.magADC[i];
+        }
+#endif
 
 #ifdef USE_BARO
-    blackboxCurrent->BaroAlt = baro.BaroAlt;
+        blackboxCurrent->BaroAlt = baro.BaroAlt;
 #endif
 
 #ifdef USE_PITOT
-    blackboxCurrent->airSpeed = pitot.airSpeed;
+        blackboxCurrent->airSpeed = pitot.airSpeed;
 #endif
 
 #ifdef USE_RANGEFINDER
-    // Store the raw rangefinder surface readout without applying tilt correction
-    blackboxCurrent->surfaceRaw = rangefinderGetLatestRawAltitude();
+        // Store the raw rangefinder surface readout without applying tilt correction
+        blackboxCurrent->surfaceRaw = rangefinderGetLatestRawAltitude();
 #endif
 
-    blackboxCurrent->rssi = getRSSI();
-
-    //Tail servo for tricopters
-    blackboxCurrent->servo[5] = servo[5];
+        blackboxCurrent->rssi = getRSSI();
+    }
 
 #ifdef NAV_BLACKBOX
-    blackboxCurrent->navState = navCurrentState;
-    blackboxCurrent->navFlags = navFlags;
-    blackboxCurrent->navEPH = navEPH;
-    blackboxCurrent->navEPV = navEPV;
-    for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
-        blackboxCurrent->navPos[i] = navLatestActualPosition[i];
-        blackboxCurrent->navRealVel[i] = navActualVelocity[i];
-        blackboxCurrent->navAccNEU[i] = navAccNEU[i];
-        blackboxCurrent->navTargetVel[i] = navDesiredVelocity[i];
-        blackboxCurrent->navTargetPos[i] = navTargetPosition[i];
-    }
-    blackboxCurrent->navSurface = navActualSurface;
+    if (fieldGroups & FIELD_GROUP(NAV)) {
+        blackboxCurrent->navState = navCurrentState;
+        blackboxCurrent->navFlags = navFlags;
+        blackboxCurrent->navEPH = navEPH;
+        blackboxCurrent->navEPV = navEPV;
+        for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+            blackboxCurrent->navPos[i] = navLatestActualPosition[i];
+            blackboxCurrent->navRealVel[i] = navActualVelocity[i];
+            blackboxCurrent->navAccNEU[i] = navAccNEU[i];
+            blackboxCurrent->navTargetVel[i] = navDesiredVelocity[i];
+            blackboxCurrent->navTargetPos[i] = navTargetPosition[i];
+        }
+        blackboxCurrent->navSurface = navActualSurface;
+    }
 #endif
 }
 
@@ -1577,6 +1768,25 @@ static bool blackboxWriteSysinfo(void)
         BLACKBOX_PRINT_HEADER_LINE("Log start datetime", "%s",              blackboxGetStartDateTime(buf));
         BLACKBOX_PRINT_HEADER_LINE("Craft name", "%s",                      systemConfig()->name);
         BLACKBOX_PRINT_HEADER_LINE("P interval", "%u/%u",                   blackboxConfig()->rate_num, blackboxConfig()->rate_denom);
+        // Rate divisors of the main frame field groups in blackboxFieldGroup_e order, held fields repeat their last value
+        BLACKBOX_PRINT_HEADER_LINE("field_group_rates", "%u,%u,%u,%u,%u,%u,%u,%u,%u",
+                                                                            blackboxConfig()->groupRateDivisor[BLACKBOX_FIELD_GROUP_PID],
+                                                                            blackboxConfig()->groupRateDivisor[BLACKBOX_FIELD_GROUP_NAV_PID],
+                                                                            blackboxConfig()->groupRateDivisor[BLACKBOX_FIELD_GROUP_RC],
+                                                                            blackboxConfig()->groupRateDivisor[BLACKBOX_FIELD_GROUP_GYRO],
+                                                                            blackboxConfig()->groupRateDivisor[BLACKBOX_FIELD_GROUP_ACC],
+                                                                            blackboxConfig()->groupRateDivisor[BLACKBOX_FIELD_GROUP_SENSORS],
+                                                                            blackboxConfig()->groupRateDivisor[BLACKBOX_FIELD_GROUP_DEBUG],
+                                                                            blackboxConfig()->groupRateDivisor[BLACKBOX_FIELD_GROUP_MOTORS],
+                                                                            blackboxConfig()->groupRateDivisor[BLACKBOX_FIELD_GROUP_NAV]);
+#ifdef USE_BLACKBOX_COMPRESSION
+        BLACKBOX_PRINT_HEADER_LINE_CUSTOM(
+            // Everything after the headers is compressed
+            if (blackboxConfig()->compression) {
+                blackboxPrintfHeaderLine("data_compression", "%s", BLACKBOX_COMPRESS_FORMAT);
+            }
+            );
+#endif
         BLACKBOX_PRINT_HEADER_LINE("minthrottle", "%d",                     motorConfig()->minthrottle);
         BLACKBOX_PRINT_HEADER_LINE("maxthrottle", "%d",                     motorConfig()->maxthrottle);
         BLACKBOX_PRINT_HEADER_LINE("gyro_scale", "0x%x",                    castFloatBytesToInt(1.0f));
@@ -1690,8 +1900,8 @@ void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data)
     }
 
     //Shared header for event frames
-    blackboxWrite('E');
-    blackboxWrite(event);
+    blackboxBeginFrame('E');
+    blackboxWriteU8(event);
 
     //Now serialize the data for this specific frame type
     switch (event) {
@@ -1704,10 +1914,10 @@ void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data)
         break;
     case FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT:
         if (data->inflightAdjustment.floatFlag) {
-            blackboxWrite(data->inflightAdjustment.adjustmentFunction + FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT_FUNCTION_FLOAT_VALUE_FLAG);
+            blackboxWriteU8(data->inflightAdjustment.adjustmentFunction + FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT_FUNCTION_FLOAT_VALUE_FLAG);
             blackboxWriteFloat(data->inflightAdjustment.newFloatValue);
         } else {
-            blackboxWrite(data->inflightAdjustment.adjustmentFunction);
+            blackboxWriteU8(data->inflightAdjustment.adjustmentFunction);
             blackboxWriteSignedVB(data->inflightAdjustment.newValue);
         }
         break;
@@ -1719,18 +1929,32 @@ void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data)
         blackboxWriteUnsignedVB(data->imuError.errorCode);
         break;
     case FLIGHT_LOG_EVENT_LOG_END:
-        blackboxPrintf("End of log (disarm reason:%d)", getDisarmReason());
+        // The message is printed straight to the device, so the frame header must go first
+        blackboxEndFrame();
+        blackboxPrintf("End of log (disarm reason:%d", getDisarmReason());
+        if (blackboxSnapshotDroppedFrames) {
+            blackboxPrintf(", dropped frames:%u", (unsigned)blackboxSnapshotDroppedFrames);
+        }
+        if (blackboxDeviceDroppedBlocks()) {
+            blackboxPrintf(", dropped blocks:%u", (unsigned)blackboxDeviceDroppedBlocks());
+        }
+        if (blackboxDeviceDroppedBytes()) {
+            blackboxPrintf(", dropped bytes:%u", (unsigned)blackboxDeviceDroppedBytes());
+        }
+        blackboxPrint(")");
         blackboxWrite(0);
         break;
     }
+
+    blackboxEndFrame();
 }
 
 /* If an arming beep has played since it was last logged, write the time of the arming beep to the log as a synchronization point */
-static void blackboxCheckAndLogArmingBeep(void)
+static void blackboxCheckAndLogArmingBeep(uint32_t armingBeepTime)
 {
     // Use != so that we can still detect a change if the counter wraps
-    if (getArmingBeepTimeMicros() != blackboxLastArmingBeep) {
-        blackboxLastArmingBeep = getArmingBeepTimeMicros();
+    if (armingBeepTime != blackboxLastArmingBeep) {
+        blackboxLastArmingBeep = armingBeepTime;
         flightLogEvent_syncBeep_t eventData;
         eventData.time = blackboxLastArmingBeep;
         blackboxLogEvent(FLIGHT_LOG_EVENT_SYNC_BEEP, (flightLogEventData_t *) &eventData);
@@ -1738,14 +1962,14 @@ static void blackboxCheckAndLogArmingBeep(void)
 }
 
 /* monitor the flight mode event status and trigger an event record if the state changes */
-static void blackboxCheckAndLogFlightMode(void)
+static void blackboxCheckAndLogFlightMode(uint32_t flightModeFlags)
 {
     // Use != so that we can still detect a change if the counter wraps
-    if (memcmp(&rcModeActivationMask, &blackboxLastFlightModeFlags, sizeof(blackboxLastFlightModeFlags))) {
+    if (flightModeFlags != blackboxLastFlightModeFlags) {
         flightLogEvent_flightMode_t eventData; // Add new data for current flight mode flags
         eventData.lastFlags = blackboxLastFlightModeFlags;
-        memcpy(&blackboxLastFlightModeFlags, &rcModeActivationMask, sizeof(blackboxLastFlightModeFlags));
-        memcpy(&eventData.flags, &rcModeActivationMask, sizeof(eventData.flags));
+        blackboxLastFlightModeFlags = flightModeFlags;
+        eventData.flags = flightModeFlags;
         blackboxLogEvent(FLIGHT_LOG_EVENT_FLIGHTMODE, (flightLogEventData_t *)&eventData);
     }
 }
@@ -1780,33 +2004,113 @@ static void blackboxAdvanceIterationTimers(void)
     }
 }
 
-// Called once every FC loop in order to log the current state
-static void blackboxLogIteration(timeUs_t currentTimeUs)
+/*
+ * Return the field groups to read from the flight controller for the next main frame, and in heldGroups the enabled
+ * groups that keep their previous values. I-frames read every enabled group and restart the group rate divisors.
+ */
+static uint16_t blackboxFieldGroupsDue(bool intraframe, uint16_t *heldGroups)
+{
+    uint16_t fieldGroups = 0;
+
+    *heldGroups = 0;
+    for (int group = 0; group < BLACKBOX_FIELD_GROUP_COUNT; group++) {
+        const uint8_t divisor = blackboxConfig()->groupRateDivisor[group];
+
+        if (divisor == 0) {
+            continue;
+        }
+
+        if (intraframe || --blackboxFieldGroupCountdown[group] == 0) {
+            blackboxFieldGroupCountdown[group] = divisor;
+            fieldGroups |= 1 << group;
+        } else {
+            *heldGroups |= 1 << group;
+        }
+    }
+
+    return fieldGroups;
+}
+
+/*
+ * Called from the flight loop for iterations that are logged. Copies the loop state into the snapshot ring, if the
+ * blackbox task fell behind and the ring is full the frame is dropped and counted. The next one is logged as an
+ * I-frame since P-frames are predicted from the frames before them, after a logging resume event so decoders know
+ * the gap is intended.
+ */
+static void blackboxCaptureSnapshot(timeUs_t currentTimeUs, uint8_t flags)
 {
+    if ((uint8_t)(blackboxSnapshotHead - blackboxSnapshotTail) == BLACKBOX_SNAPSHOT_COUNT) {
+        blackboxSnapshotDroppedFlags |= flags | BLACKBOX_SNAPSHOT_IFRAME | BLACKBOX_SNAPSHOT_RESUME;
+        blackboxSnapshotDroppedFrames++;
+        return;
+    }
+
+    blackboxSnapshot_t *snapshot = &blackboxSnapshotRing[blackboxSnapshotHead & (BLACKBOX_SNAPSHOT_COUNT - 1)];
+
+    flags |= blackboxSnapshotDroppedFlags;
+    blackboxSnapshotDroppedFlags = 0;
+
+    uint16_t heldGroups;
+    const uint16_t fieldGroups = blackboxFieldGroupsDue(flags & BLACKBOX_SNAPSHOT_IFRAME, &heldGroups);
+
+    if (heldGroups) {
+        /*
+         * Held groups repeat the previous snapshot, which is still in the ring since only P-frames hold values. They
+         * cost next to nothing in P-frames and decoders see an ordinary main frame.
+         */
+        const blackboxSnapshot_t *previous = &blackboxSnapshotRing[(uint8_t)(blackboxSnapshotHead - 1) & (BLACKBOX_SNAPSHOT_COUNT - 1)];
+        memcpy(&snapshot->state, &previous->state, sizeof(blackboxMainState_t));
+    }
+
+    loadMainState(&snapshot->state, currentTimeUs, fieldGroups);
+    loadSlowState(&snapshot->slow);
+#ifdef USE_GPS
+    loadGpsSolution(&snapshot->gps);
+#endif
+    snapshot->armingBeepTime = getArmingBeepTimeMicros();
+    snapshot->iteration = blackboxIteration;
+    snapshot->pFrameIndex = blackboxPFrameIndex;
+    snapshot->iFrameIndex = blackboxIFrameIndex;
+    snapshot->flags = flags;
+
+    blackboxSnapshotHead++;
+}
+
+// Encode the frames of one captured loop iteration
+static void blackboxLogSnapshot(const blackboxSnapshot_t *snapshot)
+{
+    if (snapshot->flags & BLACKBOX_SNAPSHOT_RESUME) {
+        // Write a log entry so the decoder is aware that our large time/iteration skip is intended
+        flightLogEvent_loggingResume_t resume;
+
+        resume.logIteration = snapshot->iteration;
+        resume.currentTimeUs = snapshot->state.time;
+
+        blackboxLogEvent(FLIGHT_LOG_EVENT_LOGGING_RESUME, (flightLogEventData_t *) &resume);
+    }
+
     // Write a keyframe every BLACKBOX_I_INTERVAL frames so we can resynchronise upon missing frames
-    if (blackboxShouldLogIFrame()) {
+    if (snapshot->flags & BLACKBOX_SNAPSHOT_IFRAME) {
         /*
          * Don't log a slow frame if the slow data didn't change ("I" frames are already large enough without adding
          * an additional item to write at the same time). Unless we're *only* logging "I" frames, then we have no choice.
          */
-        writeSlowFrameIfNeeded(blackboxIsOnlyLoggingIntraframes());
+        writeSlowFrameIfNeeded(blackboxIsOnlyLoggingIntraframes(), &snapshot->slow);
 
-        loadMainState(currentTimeUs);
-        writeIntraframe();
+        memcpy(blackboxHistory[0], &snapshot->state, sizeof(blackboxMainState_t));
+        writeIntraframe(snapshot->iteration);
     } else {
-        blackboxCheckAndLogArmingBeep();
-        blackboxCheckAndLogFlightMode();
+        blackboxCheckAndLogArmingBeep(snapshot->armingBeepTime);
+        blackboxCheckAndLogFlightMode(snapshot->slow.flightModeFlags);
 
-        if (blackboxShouldLogPFrame(blackboxPFrameIndex)) {
-            /*
-             * We assume that slow frames are only interesting in that they aid the interpretation of the main data stream.
-             * So only log slow frames during loop iterations where we log a main frame.
-             */
-            writeSlowFrameIfNeeded(true);
+        /*
+         * We assume that slow frames are only interesting in that they aid the interpretation of the main data stream.
+         * So only log slow frames during loop iterations where we log a main frame.
+         */
+        writeSlowFrameIfNeeded(true, &snapshot->slow);
 
-            loadMainState(currentTimeUs);
-            writeInterframe();
-        }
+        memcpy(blackboxHistory[0], &snapshot->state, sizeof(blackboxMainState_t));
+        writeInterframe();
 #ifdef USE_GPS
         if (feature(FEATURE_GPS)) {
             /*
@@ -1816,34 +2120,78 @@ static void blackboxLogIteration(timeUs_t currentTimeUs)
              * We write it periodically so that if one Home Frame goes missing, the GPS coordinates can
              * still be interpreted correctly.
              */
-            if (GPS_home.lat != gpsHistory.GPS_home[0] || GPS_home.lon != gpsHistory.GPS_home[1]
-                || (blackboxPFrameIndex == (blackboxIFrameInterval / 2) && blackboxIFrameIndex % 128 == 0)) {
+            const blackboxGpsSolution_t *gps = &snapshot->gps;
+
+            if (gps->homeLat != gpsHistory.GPS_home[0] || gps->homeLon != gpsHistory.GPS_home[1]
+                || (snapshot->pFrameIndex == (blackboxIFrameInterval / 2) && snapshot->iFrameIndex % 128 == 0)) {
 
-                writeGPSHomeFrame();
-                writeGPSFrame(currentTimeUs);
-            } else if (gpsSol.numSat != gpsHistory.GPS_numSat || gpsSol.llh.lat != gpsHistory.GPS_coord[0]
-                    || gpsSol.llh.lon != gpsHistory.GPS_coord[1]) {
+                writeGPSHomeFrame(gps);
+                writeGPSFrame(snapshot->state.time, gps);
+            } else if (gps->numSat != gpsHistory.GPS_numSat || gps->lat != gpsHistory.GPS_coord[0]
+                    || gps->lon != gpsHistory.GPS_coord[1]) {
                 //We could check for velocity changes as well but I doubt it changes independent of position
-                writeGPSFrame(currentTimeUs);
+                writeGPSFrame(snapshot->state.time, gps);
             }
         }
 #endif
     }
+}
 
-    //Flush every iteration so that our runtime variance is minimized
-    blackboxDeviceFlush();
+static void blackboxLogPendingSnapshots(void)
+{
+    while (blackboxSnapshotTail != blackboxSnapshotHead) {
+        blackboxLogSnapshot(&blackboxSnapshotRing[blackboxSnapshotTail & (BLACKBOX_SNAPSHOT_COUNT - 1)]);
+        blackboxSnapshotTail++;
+    }
 }
 
 /**
- * Call each flight loop iteration to perform blackbox logging.
+ * Call each flight loop iteration. This only decides which iterations are logged and captures their state, the
+ * frames are encoded and written by blackboxUpdate() so logging doesn't add to the flight loop time.
+ */
+void blackboxCaptureLoopState(timeUs_t currentTimeUs)
+{
+    switch (blackboxState) {
+    case BLACKBOX_STATE_PAUSED:
+        // Only allow resume to occur during an I-frame iteration, so that we have an "I" base to work from
+        if (IS_RC_MODE_ACTIVE(BOXBLACKBOX) && blackboxShouldLogIFrame()) {
+            blackboxSetState(BLACKBOX_STATE_RUNNING);
+            blackboxCaptureSnapshot(currentTimeUs, BLACKBOX_SNAPSHOT_IFRAME | BLACKBOX_SNAPSHOT_RESUME);
+        }
+        // Keep the logging timers ticking so our log iteration continues to advance
+        blackboxAdvanceIterationTimers();
+        break;
+    case BLACKBOX_STATE_RUNNING:
+        // On entry to this state, blackboxIteration, blackboxPFrameIndex and blackboxIFrameIndex are reset to 0
+        if (blackboxModeActivationConditionPresent && !IS_RC_MODE_ACTIVE(BOXBLACKBOX)) {
+            blackboxSetState(BLACKBOX_STATE_PAUSED);
+        } else if (blackboxShouldLogIFrame()) {
+            blackboxCaptureSnapshot(currentTimeUs, BLACKBOX_SNAPSHOT_IFRAME);
+        } else if (blackboxShouldLogPFrame(blackboxPFrameIndex)) {
+            blackboxCaptureSnapshot(currentTimeUs, 0);
+        }
+        blackboxAdvanceIterationTimers();
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * Called from the blackbox task to send the log headers and to encode and write the captured frames.
  */
 void blackboxUpdate(timeUs_t currentTimeUs)
 {
+    UNUSED(currentTimeUs);
+
     if (blackboxState >= BLACKBOX_FIRST_HEADER_SENDING_STATE && blackboxState <= BLACKBOX_LAST_HEADER_SENDING_STATE) {
         blackboxReplenishHeaderBudget();
     }
 
     switch (blackboxState) {
+    case BLACKBOX_STATE_STOPPED:
+        blackboxDeviceIdle();
+        break;
     case BLACKBOX_STATE_PREPARE_LOG_FILE:
         if (blackboxDeviceBeginLog()) {
             blackboxSetState(BLACKBOX_STATE_SEND_HEADER);
@@ -1916,35 +2264,17 @@ void blackboxUpdate(timeUs_t currentTimeUs)
              * could wipe out the end of the header if we weren't careful)
              */
             if (blackboxDeviceFlushForce()) {
+                blackboxDeviceBeginCompression();
                 blackboxSetState(BLACKBOX_STATE_RUNNING);
             }
         }
         break;
     case BLACKBOX_STATE_PAUSED:
-        // Only allow resume to occur during an I-frame iteration, so that we have an "I" base to work from
-        if (IS_RC_MODE_ACTIVE(BOXBLACKBOX) && blackboxShouldLogIFrame()) {
-            // Write a log entry so the decoder is aware that our large time/iteration skip is intended
-            flightLogEvent_loggingResume_t resume;
-
-            resume.logIteration = blackboxIteration;
-            resume.currentTimeUs = currentTimeUs;
-
-            blackboxLogEvent(FLIGHT_LOG_EVENT_LOGGING_RESUME, (flightLogEventData_t *) &resume);
-            blackboxSetState(BLACKBOX_STATE_RUNNING);
-
-            blackboxLogIteration(currentTimeUs);
-        }
-        // Keep the logging timers ticking so our log iteration continues to advance
-        blackboxAdvanceIterationTimers();
-        break;
     case BLACKBOX_STATE_RUNNING:
-        // On entry to this state, blackboxIteration, blackboxPFrameIndex and blackboxIFrameIndex are reset to 0
-        if (blackboxModeActivationConditionPresent && !IS_RC_MODE_ACTIVE(BOXBLACKBOX)) {
-            blackboxSetState(BLACKBOX_STATE_PAUSED);
-        } else {
-            blackboxLogIteration(currentTimeUs);
-        }
-        blackboxAdvanceIterationTimers();
+        blackboxLogPendingSnapshots();
+
+        //Flush every iteration so that our runtime variance is minimized
+        blackboxDeviceFlush();
         break;
     case BLACKBOX_STATE_SHUTTING_DOWN:
         //On entry of this state, startTime is set
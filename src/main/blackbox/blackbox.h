@@ -21,11 +21,27 @@
 
 #include "config/parameter_group.h"
 
+// Groups of main frame fields that can be logged at their own rate
+typedef enum {
+    BLACKBOX_FIELD_GROUP_PID = 0,       // axisRate, axisP, axisI, axisD
+    BLACKBOX_FIELD_GROUP_NAV_PID,       // fw* and mc* navigation controllers
+    BLACKBOX_FIELD_GROUP_RC,            // rcData, rcCommand
+    BLACKBOX_FIELD_GROUP_GYRO,
+    BLACKBOX_FIELD_GROUP_ACC,           // accSmooth, attitude
+    BLACKBOX_FIELD_GROUP_SENSORS,       // vbat, amperage, mag, baro, pitot, rangefinder, rssi
+    BLACKBOX_FIELD_GROUP_DEBUG,
+    BLACKBOX_FIELD_GROUP_MOTORS,        // motors and the tricopter tail servo
+    BLACKBOX_FIELD_GROUP_NAV,           // nav* state, NAV_BLACKBOX builds only
+    BLACKBOX_FIELD_GROUP_COUNT
+} blackboxFieldGroup_e;
+
 typedef struct blackboxConfig_s {
     uint16_t rate_num;
     uint16_t rate_denom;
     uint8_t device;
     uint8_t invertedCardDetection;
+    uint8_t groupRateDivisor[BLACKBOX_FIELD_GROUP_COUNT];  // 0 leaves the group out of the log, N logs fresh values every Nth main frame
+    uint8_t compression;
 } blackboxConfig_t;
 
 PG_DECLARE(blackboxConfig_t, blackboxConfig);
@@ -33,6 +49,7 @@ PG_DECLARE(blackboxConfig_t, blackboxConfig);
 void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data);
 
 void blackboxInit(void);
+void blackboxCaptureLoopState(timeUs_t currentTimeUs);
 void blackboxUpdate(timeUs_t currentTimeUs);
 void blackboxStart(void);
 void blackboxFinish(void);
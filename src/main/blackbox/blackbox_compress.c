@@ -0,0 +1,281 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#ifdef USE_BLACKBOX
+
+#include "blackbox_compress.h"
+
+#include "common/crc.h"
+#include "common/maths.h"
+
+#define MIN_MATCH           4
+#define LENGTH_NIBBLE_MAX   15
+
+static uint32_t read32(const uint8_t *p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static unsigned hash32(uint32_t value)
+{
+    return (value * 2654435761u) >> (32 - BLACKBOX_COMPRESS_HASH_BITS);
+}
+
+static uint8_t *writeExtraLength(uint8_t *dst, int length)
+{
+    while (length >= 255) {
+        *dst++ = 255;
+        length -= 255;
+    }
+    *dst++ = length;
+    return dst;
+}
+
+// Upper bound of the bytes a sequence takes, for checking the output limit before writing it
+static int sequenceSizeBound(int literalCount, int matchLength)
+{
+    return 1 + literalCount / 255 + 1 + literalCount + 2 + matchLength / 255 + 1;
+}
+
+/*
+ * Greedy LZ over a single block with a one entry per hash match finder. The hash table isn't cleared between blocks,
+ * stale entries are rejected by comparing the bytes. Returns the end of the payload, or NULL if it would reach limit.
+ */
+static uint8_t *compressPayload(uint8_t *dst, const uint8_t *limit, const uint8_t *src, int length, uint16_t *hashTable)
+{
+    const uint8_t *ip = src;
+    const uint8_t *anchor = src;
+    const uint8_t *const end = src + length;
+
+    while (end - ip >= MIN_MATCH) {
+        const uint32_t sequence = read32(ip);
+        const unsigned hash = hash32(sequence);
+        const uint8_t *candidate = src + hashTable[hash];
+
+        hashTable[hash] = ip - src;
+
+        if (candidate >= ip || read32(candidate) != sequence) {
+            ip++;
+            continue;
+        }
+
+        const uint8_t *matchEnd = ip + MIN_MATCH;
+        candidate += MIN_MATCH;
+        while (matchEnd < end && *matchEnd == *candidate) {
+            matchEnd++;
+            candidate++;
+        }
+
+        const int literalCount = ip - anchor;
+        const int matchLength = matchEnd - ip - MIN_MATCH;
+        const uint16_t offset = matchEnd - candidate;
+
+        if (dst + sequenceSizeBound(literalCount, matchLength) >= limit) {
+            return NULL;
+        }
+
+        uint8_t *token = dst++;
+        *token = (MIN(literalCount, LENGTH_NIBBLE_MAX) << 4) | MIN(matchLength, LENGTH_NIBBLE_MAX);
+        if (literalCount >= LENGTH_NIBBLE_MAX) {
+            dst = writeExtraLength(dst, literalCount - LENGTH_NIBBLE_MAX);
+        }
+        memcpy(dst, anchor, literalCount);
+        dst += literalCount;
+
+        *dst++ = offset & 0xFF;
+        *dst++ = offset >> 8;
+        if (matchLength >= LENGTH_NIBBLE_MAX) {
+            dst = writeExtraLength(dst, matchLength - LENGTH_NIBBLE_MAX);
+        }
+
+        ip = anchor = matchEnd;
+
+        // Frames repeat with a period of a few dozen bytes, so also remember a position at the end of the match
+        if (end - ip >= MIN_MATCH - 2) {
+            hashTable[hash32(read32(ip - 2))] = ip - 2 - src;
+        }
+    }
+
+    const int literalCount = end - anchor;
+    if (literalCount > 0) {
+        if (dst + sequenceSizeBound(literalCount, 0) >= limit) {
+            return NULL;
+        }
+
+        *dst++ = MIN(literalCount, LENGTH_NIBBLE_MAX) << 4;
+        if (literalCount >= LENGTH_NIBBLE_MAX) {
+            dst = writeExtraLength(dst, literalCount - LENGTH_NIBBLE_MAX);
+        }
+        memcpy(dst, anchor, literalCount);
+        dst += literalCount;
+    }
+
+    return dst;
+}
+
+/**
+ * Compress length bytes (at most BLACKBOX_COMPRESS_BLOCK_SIZE) from src into a complete block at dst, which must have
+ * room for BLACKBOX_COMPRESS_MAX_OUTPUT(length) bytes. hashTable holds BLACKBOX_COMPRESS_HASH_SIZE entries and can be
+ * reused between blocks without clearing. Returns the size of the block.
+ */
+int blackboxCompressBlock(uint8_t *dst, const uint8_t *src, int length, uint16_t *hashTable)
+{
+    uint8_t *payload = dst + BLACKBOX_COMPRESS_HEADER_SIZE;
+    const uint8_t *payloadEnd = compressPayload(payload, payload + length, src, length, hashTable);
+    uint16_t payloadInfo;
+
+    if (payloadEnd) {
+        payloadInfo = payloadEnd - payload;
+    } else {
+        memcpy(payload, src, length);
+        payloadEnd = payload + length;
+        payloadInfo = length | BLACKBOX_COMPRESS_STORED_FLAG;
+    }
+
+    dst[0] = BLACKBOX_COMPRESS_BLOCK_MAGIC;
+    dst[1] = payloadInfo & 0xFF;
+    dst[2] = payloadInfo >> 8;
+    dst[3] = length & 0xFF;
+    dst[4] = length >> 8;
+
+    uint8_t crc = crc8_dvb_s2_update(0, dst, BLACKBOX_COMPRESS_HEADER_SIZE - 1);
+    dst[5] = crc8_dvb_s2_update(crc, payload, payloadEnd - payload);
+
+    return payloadEnd - dst;
+}
+
+static int decompressPayload(uint8_t *dst, int dstSize, const uint8_t *src, int length)
+{
+    const uint8_t *ip = src;
+    const uint8_t *const end = src + length;
+    uint8_t *op = dst;
+    uint8_t *const opEnd = dst + dstSize;
+
+    while (ip < end) {
+        const uint8_t token = *ip++;
+
+        int literalCount = token >> 4;
+        if (literalCount == LENGTH_NIBBLE_MAX) {
+            uint8_t extra;
+            do {
+                if (ip >= end) {
+                    return BLACKBOX_DECOMPRESS_INVALID;
+                }
+                extra = *ip++;
+                literalCount += extra;
+            } while (extra == 255);
+        }
+
+        if (literalCount > end - ip || literalCount > opEnd - op) {
+            return BLACKBOX_DECOMPRESS_INVALID;
+        }
+        memcpy(op, ip, literalCount);
+        ip += literalCount;
+        op += literalCount;
+
+        if (ip == end) {
+            break;
+        }
+
+        if (end - ip < 2) {
+            return BLACKBOX_DECOMPRESS_INVALID;
+        }
+        const int offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+
+        int matchLength = token & 0x0F;
+        if (matchLength == LENGTH_NIBBLE_MAX) {
+            uint8_t extra;
+            do {
+                if (ip >= end) {
+                    return BLACKBOX_DECOMPRESS_INVALID;
+                }
+                extra = *ip++;
+                matchLength += extra;
+            } while (extra == 255);
+        }
+        matchLength += MIN_MATCH;
+
+        if (offset == 0 || offset > op - dst || matchLength > opEnd - op) {
+            return BLACKBOX_DECOMPRESS_INVALID;
+        }
+
+        // Matches can overlap their own output
+        const uint8_t *match = op - offset;
+        while (matchLength--) {
+            *op++ = *match++;
+        }
+    }
+
+    return op - dst;
+}
+
+/**
+ * Decode the block at the start of src into dst. Returns the decoded size and sets blockLength to the number of bytes
+ * the block takes in src, or a blackboxDecompressStatus_e. After BLACKBOX_DECOMPRESS_INVALID a stream decoder skips a
+ * byte and tries again to find the next block.
+ */
+int blackboxDecompressBlock(uint8_t *dst, int dstSize, const uint8_t *src, int srcLength, int *blockLength)
+{
+    if (srcLength < 1) {
+        return BLACKBOX_DECOMPRESS_INCOMPLETE;
+    }
+    if (src[0] != BLACKBOX_COMPRESS_BLOCK_MAGIC) {
+        return BLACKBOX_DECOMPRESS_INVALID;
+    }
+    if (srcLength < BLACKBOX_COMPRESS_HEADER_SIZE) {
+        return BLACKBOX_DECOMPRESS_INCOMPLETE;
+    }
+
+    const uint16_t payloadInfo = src[1] | (src[2] << 8);
+    const int payloadLength = payloadInfo & ~BLACKBOX_COMPRESS_STORED_FLAG;
+    const int decodedLength = src[3] | (src[4] << 8);
+
+    if (decodedLength > BLACKBOX_COMPRESS_BLOCK_SIZE || payloadLength > decodedLength || decodedLength > dstSize) {
+        return BLACKBOX_DECOMPRESS_INVALID;
+    }
+    if (srcLength < BLACKBOX_COMPRESS_HEADER_SIZE + payloadLength) {
+        return BLACKBOX_DECOMPRESS_INCOMPLETE;
+    }
+
+    const uint8_t *payload = src + BLACKBOX_COMPRESS_HEADER_SIZE;
+    uint8_t crc = crc8_dvb_s2_update(0, src, BLACKBOX_COMPRESS_HEADER_SIZE - 1);
+    if (crc8_dvb_s2_update(crc, payload, payloadLength) != src[5]) {
+        return BLACKBOX_DECOMPRESS_INVALID;
+    }
+
+    if (payloadInfo & BLACKBOX_COMPRESS_STORED_FLAG) {
+        if (payloadLength != decodedLength) {
+            return BLACKBOX_DECOMPRESS_INVALID;
+        }
+        memcpy(dst, payload, payloadLength);
+    } else if (decompressPayload(dst, decodedLength, payload, payloadLength) != decodedLength) {
+        return BLACKBOX_DECOMPRESS_INVALID;
+    }
+
+    *blockLength = BLACKBOX_COMPRESS_HEADER_SIZE + payloadLength;
+    return decodedLength;
+}
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Compressed logs are a sequence of independent blocks, so a decoder can pick up again after lost or corrupted data:
+ *
+ * 'Z' | u16 payload length (bit 15 set if stored) | u16 decoded length | crc8 | payload
+ *
+ * All values are little endian, the CRC is crc8_dvb_s2 over the header before it and the payload. The payload is a
+ * stream of LZ sequences, each a token byte with the literal count in the high nibble and the match length - 4 in the
+ * low nibble, where 15 is followed by extra length bytes (255 means more follow), then the literals, and unless the
+ * block ends after them, a u16 match offset and the extra match length bytes.
+ */
+#define BLACKBOX_COMPRESS_FORMAT            "lzblock1"
+
+#define BLACKBOX_COMPRESS_BLOCK_MAGIC       'Z'
+#define BLACKBOX_COMPRESS_STORED_FLAG       0x8000
+#define BLACKBOX_COMPRESS_HEADER_SIZE       6
+
+// Largest decoded block
+#define BLACKBOX_COMPRESS_BLOCK_SIZE        1024
+// Blocks that don't get smaller are stored
+#define BLACKBOX_COMPRESS_MAX_OUTPUT(length)    (BLACKBOX_COMPRESS_HEADER_SIZE + (length))
+
+// Match finder size, each entry is two bytes of RAM. 10 bits gain only about 2% on flight logs over 8.
+#define BLACKBOX_COMPRESS_HASH_BITS         8
+#define BLACKBOX_COMPRESS_HASH_SIZE         (1 << BLACKBOX_COMPRESS_HASH_BITS)
+
+typedef enum {
+    BLACKBOX_DECOMPRESS_INVALID = -1,       // Not a valid block at this position
+    BLACKBOX_DECOMPRESS_INCOMPLETE = -2,    // More input is needed to decode the block
+} blackboxDecompressStatus_e;
+
+int blackboxCompressBlock(uint8_t *dst, const uint8_t *src, int length, uint16_t *hashTable);
+int blackboxDecompressBlock(uint8_t *dst, int dstSize, const uint8_t *src, int srcLength, int *blockLength);
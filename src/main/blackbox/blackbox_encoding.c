@@ -80,56 +80,94 @@ void blackboxPrintfHeaderLine(const char *name, const char *fmt, ...)
     blackboxHeaderBudget -= written + 3;
 }
 
-/**
- * Write an unsigned integer to the blackbox serial port using variable byte encoding.
+/*
+ * Frames are encoded into frameBuffer and handed to the device in one write by blackboxEndFrame(). If a frame
+ * doesn't fit, the part encoded so far is written out early, which is harmless since frames have no length prefix.
  */
-void blackboxWriteUnsignedVB(uint32_t value)
+#define BLACKBOX_FRAME_BUFFER_SIZE          256
+// Largest output of a single encoder call, a blackboxWriteTag8_8SVB() header followed by 8 five byte fields
+#define BLACKBOX_MAX_ENCODED_FIELD_SIZE     41
+
+static uint8_t frameBuffer[BLACKBOX_FRAME_BUFFER_SIZE];
+static uint8_t *framePos = frameBuffer;
+
+void blackboxEndFrame(void)
 {
-    //While this isn't the final byte (we can only write 7 bits at a time)
-    while (value > 127) {
-        blackboxWrite((uint8_t) (value | 0x80)); // Set the high bit to mean "more bytes follow"
-        value >>= 7;
+    if (framePos > frameBuffer) {
+        blackboxWriteBuf(frameBuffer, framePos - frameBuffer);
+        framePos = frameBuffer;
     }
-    blackboxWrite(value);
 }
 
-/**
- * Write a signed integer to the blackbox serial port using ZigZig and variable byte encoding.
- */
-void blackboxWriteSignedVB(int32_t value)
+// Make room for one more encoded field
+static uint8_t *frameReserve(void)
 {
-    //ZigZag encode to make the value always positive
-    blackboxWriteUnsignedVB(zigzagEncode(value));
+    if (framePos > frameBuffer + BLACKBOX_FRAME_BUFFER_SIZE - BLACKBOX_MAX_ENCODED_FIELD_SIZE) {
+        blackboxEndFrame();
+    }
+    return framePos;
 }
 
-void blackboxWriteSignedVBArray(int32_t *array, int count)
+void blackboxBeginFrame(uint8_t frameType)
 {
-    for (int i = 0; i < count; i++) {
-        blackboxWriteSignedVB(array[i]);
-    }
+    *frameReserve() = frameType;
+    framePos++;
 }
 
-void blackboxWriteSigned16VBArray(int16_t *array, int count)
+// Number of significant bits in value, counting 0 as 1 bit
+static inline int bitLength(uint32_t value)
 {
-    for (int i = 0; i < count; i++) {
-        blackboxWriteSignedVB(array[i]);
-    }
+    return 32 - __builtin_clz(value | 1);
 }
 
-void blackboxWriteS16(int16_t value)
+// Number of bits needed to store value in two's complement, less the sign bit
+static inline int signedBitLength(int32_t value)
 {
-    blackboxWrite(value & 0xFF);
-    blackboxWrite((value >> 8) & 0xFF);
+    return bitLength(value ^ (value >> 31));
 }
 
 /**
- * Write a 2 bit tag followed by 3 signed fields of 2, 4, 6 or 32 bits
+ * Encode an unsigned integer using variable byte encoding, returns the end of the encoded bytes.
  */
-void blackboxWriteTag2_3S32(int32_t *values)
+uint8_t *blackboxEncodeUnsignedVB(uint8_t *dst, uint32_t value)
+{
+    // Most fields are deltas that fit in a single byte
+    if (value < 0x80) {
+        *dst = value;
+        return dst + 1;
+    }
+
+    //While this isn't the final byte (we can only write 7 bits at a time)
+    do {
+        *dst++ = value | 0x80; // Set the high bit to mean "more bytes follow"
+        value >>= 7;
+    } while (value > 127);
+    *dst++ = value;
+
+    return dst;
+}
+
+/**
+ * Encode a signed integer using ZigZag and variable byte encoding.
+ */
+uint8_t *blackboxEncodeSignedVB(uint8_t *dst, int32_t value)
 {
-    static const int NUM_FIELDS = 3;
+    //ZigZag encode to make the value always positive
+    return blackboxEncodeUnsignedVB(dst, zigzagEncode(value));
+}
 
-    //Need to be enums rather than const ints if we want to switch on them (due to being C)
+/**
+ * Encode a 2 bit tag followed by 3 signed fields of 2, 4, 6 or 32 bits
+ *
+ * Selector possibilities
+ *
+ * 2 bits per field  ss11 2233,
+ * 4 bits per field  ss00 1111 2222 3333
+ * 6 bits per field  ss11 1111 0022 2222 0033 3333
+ * 32 bits per field sstt tttt followed by fields of various byte counts
+ */
+uint8_t *blackboxEncodeTag2_3S32(uint8_t *dst, const int32_t *values)
+{
     enum {
         BITS_2  = 0,
         BITS_4  = 1,
@@ -137,122 +175,63 @@ void blackboxWriteTag2_3S32(int32_t *values)
         BITS_32 = 3
     };
 
-    enum {
-        BYTES_1  = 0,
-        BYTES_2  = 1,
-        BYTES_3  = 2,
-        BYTES_4  = 3
+    // Packing scheme by the signed bit length of the largest field, less one
+    static const uint8_t selectorByBits[32] = {
+        BITS_2, BITS_4, BITS_4, BITS_6, BITS_6, BITS_32, BITS_32, BITS_32,
+        BITS_32, BITS_32, BITS_32, BITS_32, BITS_32, BITS_32, BITS_32, BITS_32,
+        BITS_32, BITS_32, BITS_32, BITS_32, BITS_32, BITS_32, BITS_32, BITS_32,
+        BITS_32, BITS_32, BITS_32, BITS_32, BITS_32, BITS_32, BITS_32, BITS_32,
     };
 
-    int selector = BITS_2, selector2;
-
-    /*
-     * Find out how many bits the largest value requires to encode, and use it to choose one of the packing schemes
-     * below:
-     *
-     * Selector possibilities
-     *
-     * 2 bits per field  ss11 2233,
-     * 4 bits per field  ss00 1111 2222 3333
-     * 6 bits per field  ss11 1111 0022 2222 0033 3333
-     * 32 bits per field sstt tttt followed by fields of various byte counts
-     */
-    for (int x = 0; x < NUM_FIELDS; x++) {
-        //Require more than 6 bits?
-        if (values[x] >= 32 || values[x] < -32) {
-            selector = BITS_32;
-            break;
-        }
-
-        //Require more than 4 bits?
-        if (values[x] >= 8 || values[x] < -8) {
-             if (selector < BITS_6) {
-                 selector = BITS_6;
-             }
-        } else if (values[x] >= 2 || values[x] < -2) { //Require more than 2 bits?
-            if (selector < BITS_4) {
-                selector = BITS_4;
-            }
-        }
-    }
+    const int32_t magnitudes = (values[0] ^ (values[0] >> 31)) | (values[1] ^ (values[1] >> 31)) | (values[2] ^ (values[2] >> 31));
+    const int selector = selectorByBits[bitLength(magnitudes) - 1];
 
     switch (selector) {
     case BITS_2:
-        blackboxWrite((selector << 6) | ((values[0] & 0x03) << 4) | ((values[1] & 0x03) << 2) | (values[2] & 0x03));
+        *dst++ = (selector << 6) | ((values[0] & 0x03) << 4) | ((values[1] & 0x03) << 2) | (values[2] & 0x03);
         break;
     case BITS_4:
-        blackboxWrite((selector << 6) | (values[0] & 0x0F));
-        blackboxWrite((values[1] << 4) | (values[2] & 0x0F));
+        *dst++ = (selector << 6) | (values[0] & 0x0F);
+        *dst++ = (values[1] << 4) | (values[2] & 0x0F);
         break;
     case BITS_6:
-        blackboxWrite((selector << 6) | (values[0] & 0x3F));
-        blackboxWrite((uint8_t)values[1]);
-        blackboxWrite((uint8_t)values[2]);
+        *dst++ = (selector << 6) | (values[0] & 0x3F);
+        *dst++ = (uint8_t)values[1];
+        *dst++ = (uint8_t)values[2];
         break;
     case BITS_32:
+    {
         /*
-         * Do another round to compute a selector for each field, assuming that they are at least 8 bits each
-         *
-         * Selector2 field possibilities
-         * 0 - 8 bits
-         * 1 - 16 bits
-         * 2 - 24 bits
-         * 3 - 32 bits
+         * Each field gets a 2 bit byte count selector, 0 - 8 bits, 1 - 16 bits, 2 - 24 bits, 3 - 32 bits.
+         * Signed bit length 0-7 is one byte, 8-15 two and so on, so the selector is just the bit length / 8.
          */
-        selector2 = 0;
-
-        //Encode in reverse order so the first field is in the low bits:
-        for (int x = NUM_FIELDS - 1; x >= 0; x--) {
-            selector2 <<= 2;
-
-            if (values[x] < 128 && values[x] >= -128) {
-                selector2 |= BYTES_1;
-            } else if (values[x] < 32768 && values[x] >= -32768) {
-                selector2 |= BYTES_2;
-            } else if (values[x] < 8388608 && values[x] >= -8388608) {
-                selector2 |= BYTES_3;
-            } else {
-                selector2 |= BYTES_4;
-            }
+        int byteCount[3];
+        for (int x = 0; x < 3; x++) {
+            byteCount[x] = signedBitLength(values[x]) >> 3;
         }
 
-        //Write the selectors
-        blackboxWrite((selector << 6) | selector2);
-
-        //And now the values according to the selectors we picked for them
-        for (int x = 0; x < NUM_FIELDS; x++, selector2 >>= 2) {
-            switch (selector2 & 0x03) {
-            case BYTES_1:
-                blackboxWrite(values[x]);
-                break;
-            case BYTES_2:
-                blackboxWrite(values[x]);
-                blackboxWrite(values[x] >> 8);
-                break;
-            case BYTES_3:
-                blackboxWrite(values[x]);
-                blackboxWrite(values[x] >> 8);
-                blackboxWrite(values[x] >> 16);
-                break;
-            case BYTES_4:
-                blackboxWrite(values[x]);
-                blackboxWrite(values[x] >> 8);
-                blackboxWrite(values[x] >> 16);
-                blackboxWrite(values[x] >> 24);
-                break;
+        //First field is in the low bits
+        *dst++ = (selector << 6) | (byteCount[2] << 4) | (byteCount[1] << 2) | byteCount[0];
+
+        //And now the values according to the selectors we picked for them, little endian
+        for (int x = 0; x < 3; x++) {
+            const uint32_t value = values[x];
+            for (int i = 0; i <= byteCount[x]; i++) {
+                *dst++ = value >> (i * 8);
             }
         }
         break;
     }
+    }
+
+    return dst;
 }
 
 /**
- * Write an 8-bit selector followed by four signed fields of size 0, 4, 8 or 16 bits.
+ * Encode an 8-bit selector followed by four signed fields of size 0, 4, 8 or 16 bits.
  */
-void blackboxWriteTag8_4S16(int32_t *values)
+uint8_t *blackboxEncodeTag8_4S16(uint8_t *dst, const int32_t *values)
 {
-
-    //Need to be enums rather than const ints if we want to switch on them (due to being C)
     enum {
         FIELD_ZERO  = 0,
         FIELD_4BIT  = 1,
@@ -260,118 +239,145 @@ void blackboxWriteTag8_4S16(int32_t *values)
         FIELD_16BIT = 3
     };
 
+    // Field size by signed bit length less one, zero fields are handled separately
+    static const uint8_t fieldByBits[32] = {
+        FIELD_4BIT, FIELD_4BIT, FIELD_4BIT, FIELD_8BIT, FIELD_8BIT, FIELD_8BIT, FIELD_8BIT, FIELD_16BIT,
+        FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT,
+        FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT,
+        FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT, FIELD_16BIT,
+    };
+
     uint8_t selector = 0;
     //Encode in reverse order so the first field is in the low bits:
     for (int x = 3; x >= 0; x--) {
         selector <<= 2;
-
-        if (values[x] == 0) {
-            selector |= FIELD_ZERO;
-        } else if (values[x] < 8 && values[x] >= -8) {
-            selector |= FIELD_4BIT;
-        } else if (values[x] < 128 && values[x] >= -128) {
-            selector |= FIELD_8BIT;
-        } else {
-            selector |= FIELD_16BIT;
+        if (values[x] != 0) {
+            selector |= fieldByBits[signedBitLength(values[x]) - 1];
         }
     }
 
-    blackboxWrite(selector);
+    *dst++ = selector;
 
-    int nibbleIndex = 0;
-    uint8_t buffer = 0;
+    // Pack nibbles into a bit accumulator, high bits first, and emit whole bytes as they become available
+    uint32_t bits = 0;
+    int bitCount = 0;
     for (int x = 0; x < 4; x++, selector >>= 2) {
-        switch (selector & 0x03) {
-        case FIELD_ZERO:
-            //No-op
-            break;
-        case FIELD_4BIT:
-            if (nibbleIndex == 0) {
-                //We fill high-bits first
-                buffer = values[x] << 4;
-                nibbleIndex = 1;
-            } else {
-                blackboxWrite(buffer | (values[x] & 0x0F));
-                nibbleIndex = 0;
-            }
-            break;
-        case FIELD_8BIT:
-            if (nibbleIndex == 0) {
-                blackboxWrite(values[x]);
-            } else {
-                //Write the high bits of the value first (mask to avoid sign extension)
-                blackboxWrite(buffer | ((values[x] >> 4) & 0x0F));
-                //Now put the leftover low bits into the top of the next buffer entry
-                buffer = values[x] << 4;
-            }
-            break;
-        case FIELD_16BIT:
-            if (nibbleIndex == 0) {
-                //Write high byte first
-                blackboxWrite(values[x] >> 8);
-                blackboxWrite(values[x]);
-            } else {
-                //First write the highest 4 bits
-                blackboxWrite(buffer | ((values[x] >> 12) & 0x0F));
-                // Then the middle 8
-                blackboxWrite(values[x] >> 4);
-                //Only the smallest 4 bits are still left to write
-                buffer = values[x] << 4;
-            }
-            break;
+        static const uint8_t fieldBits[4] = { 0, 4, 8, 16 };
+        const int width = fieldBits[selector & 0x03];
+
+        bits = (bits << width) | (values[x] & ((1 << width) - 1));
+        bitCount += width;
+
+        while (bitCount >= 8) {
+            bitCount -= 8;
+            *dst++ = bits >> bitCount;
         }
     }
     //Anything left over to write?
-    if (nibbleIndex == 1) {
-        blackboxWrite(buffer);
+    if (bitCount) {
+        *dst++ = bits << 4;
     }
+
+    return dst;
 }
 
 /**
- * Write `valueCount` fields from `values` to the Blackbox using signed variable byte encoding. A 1-byte header is
- * written first which specifies which fields are non-zero (so this encoding is compact when most fields are zero).
+ * Encode `valueCount` fields from `values` using signed variable byte encoding. A 1-byte header is written first
+ * which specifies which fields are non-zero (so this encoding is compact when most fields are zero).
  *
  * valueCount must be 8 or less.
  */
-void blackboxWriteTag8_8SVB(int32_t *values, int valueCount)
+uint8_t *blackboxEncodeTag8_8SVB(uint8_t *dst, const int32_t *values, int valueCount)
 {
-    uint8_t header;
+    //If we're only writing one field then we can skip the header
+    if (valueCount == 1) {
+        return blackboxEncodeSignedVB(dst, values[0]);
+    }
 
     if (valueCount > 0) {
-        //If we're only writing one field then we can skip the header
-        if (valueCount == 1) {
-            blackboxWriteSignedVB(values[0]);
-        } else {
-            //First write a one-byte header that marks which fields are non-zero
-            header = 0;
-
-            // First field should be in low bits of header
-            for (int i = valueCount - 1; i >= 0; i--) {
-                header <<= 1;
-
-                if (values[i] != 0) {
-                    header |= 0x01;
-                }
+        //First write a one-byte header that marks which fields are non-zero, first field in the low bits
+        uint8_t *header = dst++;
+        *header = 0;
+
+        for (int i = 0; i < valueCount; i++) {
+            if (values[i] != 0) {
+                *header |= 1 << i;
+                dst = blackboxEncodeSignedVB(dst, values[i]);
             }
+        }
+    }
 
-            blackboxWrite(header);
+    return dst;
+}
 
-            for (int i = 0; i < valueCount; i++) {
-                if (values[i] != 0) {
-                    blackboxWriteSignedVB(values[i]);
-                }
-            }
-        }
+/**
+ * Write an unsigned integer to the blackbox frame using variable byte encoding.
+ */
+void blackboxWriteUnsignedVB(uint32_t value)
+{
+    framePos = blackboxEncodeUnsignedVB(frameReserve(), value);
+}
+
+/**
+ * Write a signed integer to the blackbox frame using ZigZig and variable byte encoding.
+ */
+void blackboxWriteSignedVB(int32_t value)
+{
+    framePos = blackboxEncodeSignedVB(frameReserve(), value);
+}
+
+void blackboxWriteSignedVBArray(int32_t *array, int count)
+{
+    for (int i = 0; i < count; i++) {
+        blackboxWriteSignedVB(array[i]);
+    }
+}
+
+void blackboxWriteSigned16VBArray(const int16_t *array, int count)
+{
+    for (int i = 0; i < count; i++) {
+        blackboxWriteSignedVB(array[i]);
     }
 }
 
+void blackboxWriteU8(uint8_t value)
+{
+    *frameReserve() = value;
+    framePos++;
+}
+
+void blackboxWriteS16(int16_t value)
+{
+    uint8_t *dst = frameReserve();
+    dst[0] = value & 0xFF;
+    dst[1] = (value >> 8) & 0xFF;
+    framePos = dst + 2;
+}
+
+void blackboxWriteTag2_3S32(int32_t *values)
+{
+    framePos = blackboxEncodeTag2_3S32(frameReserve(), values);
+}
+
+void blackboxWriteTag8_4S16(int32_t *values)
+{
+    framePos = blackboxEncodeTag8_4S16(frameReserve(), values);
+}
+
+void blackboxWriteTag8_8SVB(int32_t *values, int valueCount)
+{
+    framePos = blackboxEncodeTag8_8SVB(frameReserve(), values, valueCount);
+}
+
 /** Write unsigned integer **/
 void blackboxWriteU32(int32_t value)
 {
-    blackboxWrite(value & 0xFF);
-    blackboxWrite((value >> 8) & 0xFF);
-    blackboxWrite((value >> 16) & 0xFF);
-    blackboxWrite((value >> 24) & 0xFF);
+    uint8_t *dst = frameReserve();
+    dst[0] = value & 0xFF;
+    dst[1] = (value >> 8) & 0xFF;
+    dst[2] = (value >> 16) & 0xFF;
+    dst[3] = (value >> 24) & 0xFF;
+    framePos = dst + 4;
 }
 
 /** Write float value in the integer form **/
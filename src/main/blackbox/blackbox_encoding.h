@@ -17,14 +17,27 @@
 
 #pragma once
 
+#include <stdint.h>
+
 int blackboxPrintf(const char *fmt, ...);
 void blackboxPrintfHeaderLine(const char *name, const char *fmt, ...);
 int blackboxPrint(const char *s);
 
+uint8_t *blackboxEncodeUnsignedVB(uint8_t *dst, uint32_t value);
+uint8_t *blackboxEncodeSignedVB(uint8_t *dst, int32_t value);
+uint8_t *blackboxEncodeTag2_3S32(uint8_t *dst, const int32_t *values);
+uint8_t *blackboxEncodeTag8_4S16(uint8_t *dst, const int32_t *values);
+uint8_t *blackboxEncodeTag8_8SVB(uint8_t *dst, const int32_t *values, int valueCount);
+
+// The blackboxWrite*() encoders below append to the current frame, which is written to the device by blackboxEndFrame()
+void blackboxBeginFrame(uint8_t frameType);
+void blackboxEndFrame(void);
+
 void blackboxWriteUnsignedVB(uint32_t value);
 void blackboxWriteSignedVB(int32_t value);
 void blackboxWriteSignedVBArray(int32_t *array, int count);
-void blackboxWriteSigned16VBArray(int16_t *array, int count);
+void blackboxWriteSigned16VBArray(const int16_t *array, int count);
+void blackboxWriteU8(uint8_t value);
 void blackboxWriteS16(int16_t value);
 void blackboxWriteTag2_3S32(int32_t *values);
 void blackboxWriteTag8_4S16(int32_t *values);
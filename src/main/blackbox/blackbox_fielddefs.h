@@ -52,6 +52,13 @@ typedef enum FlightLogFieldCondition {
 
     FLIGHT_LOG_FIELD_CONDITION_DEBUG,
 
+    // Field groups that are always available, but can be left out of the log by blackboxConfig()->groupRateDivisor
+    FLIGHT_LOG_FIELD_CONDITION_PID,
+    FLIGHT_LOG_FIELD_CONDITION_RC,
+    FLIGHT_LOG_FIELD_CONDITION_GYRO,
+    FLIGHT_LOG_FIELD_CONDITION_ACC,
+    FLIGHT_LOG_FIELD_CONDITION_NAV,
+
     FLIGHT_LOG_FIELD_CONDITION_NEVER,
 
     FLIGHT_LOG_FIELD_CONDITION_FIRST = FLIGHT_LOG_FIELD_CONDITION_ALWAYS,
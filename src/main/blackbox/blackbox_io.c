@@ -24,12 +24,14 @@
 #ifdef USE_BLACKBOX
 
 #include "blackbox.h"
+#include "blackbox_compress.h"
 #include "blackbox_io.h"
 
 #include "common/axis.h"
 #include "common/encoding.h"
 #include "common/maths.h"
 #include "common/printf.h"
+#include "common/time.h"
 #include "common/typeconversion.h"
 
 #include "config/parameter_group.h"
@@ -76,6 +78,30 @@ static struct {
 
 #endif
 
+#ifdef USE_BLACKBOX_COMPRESSION
+
+/*
+ * Once the headers are written the log goes through the compressor a block at a time. Compressed blocks are written
+ * to the device as fast as its buffers take them, input that arrives while the previous block is still being written
+ * out is dropped a whole block at a time, like the devices drop data when their buffers overflow. Dropped blocks are
+ * counted and reported at the end of the log.
+ */
+static struct {
+    bool active;
+    uint32_t droppedBlocks;
+    uint16_t inputLength;
+    uint16_t outputLength;
+    uint16_t outputPos;
+    uint8_t input[BLACKBOX_COMPRESS_BLOCK_SIZE];
+    uint8_t output[BLACKBOX_COMPRESS_MAX_OUTPUT(BLACKBOX_COMPRESS_BLOCK_SIZE)];
+    uint16_t hashTable[BLACKBOX_COMPRESS_HASH_SIZE];
+} blackboxCompressor;
+
+#endif
+
+// Log bytes the serial port had no room for, a saturated link drops data rather than stalling the tasks
+static uint32_t blackboxSerialDroppedBytes;
+
 #ifndef UNIT_TEST
 void blackboxOpen(void)
 {
@@ -86,8 +112,152 @@ void blackboxOpen(void)
 }
 #endif // UNIT_TEST
 
+static void blackboxDeviceWriteBuf(const uint8_t *data, int length)
+{
+    switch (blackboxConfig()->device) {
+#ifdef USE_FLASHFS
+    case BLACKBOX_DEVICE_FLASH:
+        flashfsWrite(data, length, false); // Write asynchronously
+        break;
+#endif
+#ifdef USE_SDCARD
+    case BLACKBOX_DEVICE_SDCARD:
+        afatfs_fwrite(blackboxSDCard.logFile, data, length); // Ignore failures due to buffers filling up
+        break;
+#endif
+    case BLACKBOX_DEVICE_SERIAL:
+    default:
+        {
+            const int count = MIN(length, (int)serialTxBytesFree(blackboxPort));
+            serialWriteBuf(blackboxPort, data, count);
+            blackboxSerialDroppedBytes += length - count;
+        }
+        break;
+    }
+}
+
+// Number of bytes the device can currently take without dropping any
+static int32_t blackboxDeviceFreeSpace(void)
+{
+    switch (blackboxConfig()->device) {
+    case BLACKBOX_DEVICE_SERIAL:
+        return serialTxBytesFree(blackboxPort);
+#ifdef USE_FLASHFS
+    case BLACKBOX_DEVICE_FLASH:
+        return flashfsGetWriteBufferFreeSpace();
+#endif
+#ifdef USE_SDCARD
+    case BLACKBOX_DEVICE_SDCARD:
+        return afatfs_getFreeBufferSpace();
+#endif
+    default:
+        return 0;
+    }
+}
+
+#ifdef USE_BLACKBOX_COMPRESSION
+
+// Write out as much of the current compressed block as the device takes, returns true once it's all written
+static bool blackboxCompressorDrain(void)
+{
+    const int32_t remaining = blackboxCompressor.outputLength - blackboxCompressor.outputPos;
+    const int32_t length = MIN(remaining, blackboxDeviceFreeSpace());
+
+    if (length > 0) {
+        blackboxDeviceWriteBuf(blackboxCompressor.output + blackboxCompressor.outputPos, length);
+        blackboxCompressor.outputPos += length;
+    }
+
+    return blackboxCompressor.outputPos == blackboxCompressor.outputLength;
+}
+
+static void blackboxCompressorEndBlock(void)
+{
+    if (blackboxCompressorDrain()) {
+        blackboxCompressor.outputLength = blackboxCompressBlock(blackboxCompressor.output, blackboxCompressor.input,
+            blackboxCompressor.inputLength, blackboxCompressor.hashTable);
+        blackboxCompressor.outputPos = 0;
+        blackboxCompressorDrain();
+    } else {
+        blackboxCompressor.droppedBlocks++;
+    }
+
+    blackboxCompressor.inputLength = 0;
+}
+
+static void blackboxCompressorWrite(const uint8_t *data, int length)
+{
+    while (length > 0) {
+        const int count = MIN(length, BLACKBOX_COMPRESS_BLOCK_SIZE - blackboxCompressor.inputLength);
+
+        memcpy(blackboxCompressor.input + blackboxCompressor.inputLength, data, count);
+        blackboxCompressor.inputLength += count;
+        data += count;
+        length -= count;
+
+        if (blackboxCompressor.inputLength == BLACKBOX_COMPRESS_BLOCK_SIZE) {
+            blackboxCompressorEndBlock();
+        }
+    }
+}
+
+// Compress what's left of the input and write it out, returns true once everything is written to the device
+static bool blackboxCompressorFlush(void)
+{
+    if (!blackboxCompressorDrain()) {
+        return false;
+    }
+
+    if (blackboxCompressor.inputLength > 0) {
+        blackboxCompressorEndBlock();
+    }
+
+    return blackboxCompressorDrain();
+}
+
+#endif
+
+/**
+ * Called once the log headers are written. If enabled the rest of the log is compressed.
+ */
+void blackboxDeviceBeginCompression(void)
+{
+    blackboxSerialDroppedBytes = 0;
+
+#ifdef USE_BLACKBOX_COMPRESSION
+    blackboxCompressor.active = blackboxConfig()->compression;
+    blackboxCompressor.droppedBlocks = 0;
+    blackboxCompressor.inputLength = 0;
+    blackboxCompressor.outputLength = 0;
+    blackboxCompressor.outputPos = 0;
+#endif
+}
+
+// Compressed blocks lost since the log started because the device was still busy with the previous one
+uint32_t blackboxDeviceDroppedBlocks(void)
+{
+#ifdef USE_BLACKBOX_COMPRESSION
+    return blackboxCompressor.active ? blackboxCompressor.droppedBlocks : 0;
+#else
+    return 0;
+#endif
+}
+
+// Bytes lost since the log started because the serial port's TX buffer was full
+uint32_t blackboxDeviceDroppedBytes(void)
+{
+    return blackboxSerialDroppedBytes;
+}
+
 void blackboxWrite(uint8_t value)
 {
+#ifdef USE_BLACKBOX_COMPRESSION
+    if (blackboxCompressor.active) {
+        blackboxCompressorWrite(&value, 1);
+        return;
+    }
+#endif
+
     switch (blackboxConfig()->device) {
 #ifdef USE_FLASHFS
     case BLACKBOX_DEVICE_FLASH:
@@ -101,17 +271,41 @@ void blackboxWrite(uint8_t value)
 #endif
     case BLACKBOX_DEVICE_SERIAL:
     default:
-        serialWrite(blackboxPort, value);
+        if (serialTxBytesFree(blackboxPort)) {
+            serialWrite(blackboxPort, value);
+        } else {
+            blackboxSerialDroppedBytes++;
+        }
         break;
     }
 }
 
+void blackboxWriteBuf(const uint8_t *data, int length)
+{
+#ifdef USE_BLACKBOX_COMPRESSION
+    if (blackboxCompressor.active) {
+        blackboxCompressorWrite(data, length);
+        return;
+    }
+#endif
+
+    blackboxDeviceWriteBuf(data, length);
+}
+
 // Print the null-terminated string 's' to the blackbox device and return the number of bytes written
 int blackboxPrint(const char *s)
 {
     int length;
     const uint8_t *pos;
 
+#ifdef USE_BLACKBOX_COMPRESSION
+    if (blackboxCompressor.active) {
+        length = strlen(s);
+        blackboxCompressorWrite((const uint8_t*) s, length);
+        return length;
+    }
+#endif
+
     switch (blackboxConfig()->device) {
 
 #ifdef USE_FLASHFS
@@ -150,6 +344,12 @@ int blackboxPrint(const char *s)
  */
 void blackboxDeviceFlush(void)
 {
+#ifdef USE_BLACKBOX_COMPRESSION
+    if (blackboxCompressor.active) {
+        blackboxCompressorDrain();
+    }
+#endif
+
     switch (blackboxConfig()->device) {
 #ifdef USE_FLASHFS
         /*
@@ -157,7 +357,25 @@ void blackboxDeviceFlush(void)
          * devices will progressively write in the background without Blackbox calling anything.
          */
     case BLACKBOX_DEVICE_FLASH:
-        flashfsFlushAsync();
+        flashfsFlushAsync(false);
+        break;
+#endif
+
+    default:
+        ;
+    }
+}
+
+/**
+ * Call while not logging to let the device catch up on housekeeping that would hold up writes.
+ */
+void blackboxDeviceIdle(void)
+{
+    switch (blackboxConfig()->device) {
+#ifdef USE_FLASHFS
+    case BLACKBOX_DEVICE_FLASH:
+        // Erase ahead of the next log
+        flashfsEraseAsync();
         break;
 #endif
 
@@ -173,6 +391,12 @@ void blackboxDeviceFlush(void)
  */
 bool blackboxDeviceFlushForce(void)
 {
+#ifdef USE_BLACKBOX_COMPRESSION
+    if (blackboxCompressor.active && !blackboxCompressorFlush()) {
+        return false;
+    }
+#endif
+
     switch (blackboxConfig()->device) {
     case BLACKBOX_DEVICE_SERIAL:
         // Nothing to speed up flushing on serial, as serial is continuously being drained out of its buffer
@@ -180,7 +404,7 @@ bool blackboxDeviceFlushForce(void)
 
 #ifdef USE_FLASHFS
     case BLACKBOX_DEVICE_FLASH:
-        return flashfsFlushAsync();
+        return flashfsFlushAsync(true);
 #endif
 
 #ifdef USE_SDCARD
@@ -278,6 +502,10 @@ bool blackboxDeviceOpen(void)
 #ifndef UNIT_TEST
 void blackboxDeviceClose(void)
 {
+#ifdef USE_BLACKBOX_COMPRESSION
+    blackboxCompressor.active = false;
+#endif
+
     switch (blackboxConfig()->device) {
     case BLACKBOX_DEVICE_SERIAL:
         // Since the serial port could be shared with other processes, we have to give it back here
@@ -436,6 +664,13 @@ static bool blackboxSDCardBeginLog(void)
 bool blackboxDeviceBeginLog(void)
 {
     switch (blackboxConfig()->device) {
+#ifdef USE_FLASHFS
+    case BLACKBOX_DEVICE_FLASH:
+        {
+            rtcTime_t now;
+            return flashfsBeginLog(rtcGet(&now) ? rtcTimeGetSeconds(&now) : 0);
+        }
+#endif
 #ifdef USE_SDCARD
     case BLACKBOX_DEVICE_SDCARD:
         return blackboxSDCardBeginLog();
@@ -459,7 +694,21 @@ bool blackboxDeviceEndLog(bool retainLog)
     (void) retainLog;
 #endif
 
+#ifdef USE_BLACKBOX_COMPRESSION
+    // The end of the log has to reach the device before the log file is closed
+    if (blackboxCompressor.active) {
+        if (!blackboxCompressorFlush()) {
+            return false;
+        }
+        blackboxCompressor.active = false;
+    }
+#endif
+
     switch (blackboxConfig()->device) {
+#ifdef USE_FLASHFS
+    case BLACKBOX_DEVICE_FLASH:
+        return flashfsEndLog();
+#endif
 #ifdef USE_SDCARD
     case BLACKBOX_DEVICE_SDCARD:
         // Keep retrying until the close operation queues
@@ -506,25 +755,7 @@ bool isBlackboxDeviceFull(void)
  */
 void blackboxReplenishHeaderBudget(void)
 {
-    int32_t freeSpace;
-
-    switch (blackboxConfig()->device) {
-    case BLACKBOX_DEVICE_SERIAL:
-        freeSpace = serialTxBytesFree(blackboxPort);
-        break;
-#ifdef USE_FLASHFS
-    case BLACKBOX_DEVICE_FLASH:
-        freeSpace = flashfsGetWriteBufferFreeSpace();
-        break;
-#endif
-#ifdef USE_SDCARD
-    case BLACKBOX_DEVICE_SDCARD:
-        freeSpace = afatfs_getFreeBufferSpace();
-        break;
-#endif
-    default:
-        freeSpace = 0;
-    }
+    const int32_t freeSpace = blackboxDeviceFreeSpace();
 
     blackboxHeaderBudget = MIN(MIN(freeSpace, blackboxHeaderBudget + blackboxMaxHeaderBytesPerIteration), BLACKBOX_MAX_ACCUMULATED_HEADER_BUDGET);
 }
@@ -578,7 +809,7 @@ blackboxBufferReserveStatus_e blackboxDeviceReserveBufferSpace(int32_t bytes)
              * that the Blackbox header writing code doesn't have to guess about the best time to ask flashfs to
              * flush, and doesn't stall waiting for a flush that would otherwise not automatically be called.
              */
-            flashfsFlushAsync();
+            flashfsFlushAsync(false);
         }
 
         return BLACKBOX_RESERVE_TEMPORARY_FAILURE;
@@ -57,8 +57,14 @@ extern int32_t blackboxHeaderBudget;
 
 void blackboxOpen(void);
 void blackboxWrite(uint8_t value);
+void blackboxWriteBuf(const uint8_t *data, int length);
+
+void blackboxDeviceBeginCompression(void);
+uint32_t blackboxDeviceDroppedBlocks(void);
+uint32_t blackboxDeviceDroppedBytes(void);
 
 void blackboxDeviceFlush(void);
+void blackboxDeviceIdle(void);
 bool blackboxDeviceFlushForce(void);
 bool blackboxDeviceOpen(void);
 void blackboxDeviceClose(void);
@@ -44,15 +44,13 @@
 #include "io/flashfs.h"
 
 #ifdef USE_FLASHFS
-static long cmsx_EraseFlash(displayPort_t *pDisplay, const void *ptr)
+static long cmsx_EraseFlashWith(displayPort_t *pDisplay, void (*eraseFn)(void))
 {
-    UNUSED(ptr);
-
     displayClearScreen(pDisplay);
     displayWrite(pDisplay, 5, 3, "ERASING FLASH...");
     displayResync(pDisplay); // Was max7456RefreshAll(); Why at this timing?
 
-    flashfsEraseCompletely();
+    eraseFn();
     while (!flashfsIsReady()) {
         delay(100);
     }
@@ -62,6 +60,20 @@ static long cmsx_EraseFlash(displayPort_t *pDisplay, const void *ptr)
 
     return 0;
 }
+
+static long cmsx_EraseFlash(displayPort_t *pDisplay, const void *ptr)
+{
+    UNUSED(ptr);
+
+    return cmsx_EraseFlashWith(pDisplay, flashfsEraseCompletely);
+}
+
+static long cmsx_EraseUsedFlash(displayPort_t *pDisplay, const void *ptr)
+{
+    UNUSED(ptr);
+
+    return cmsx_EraseFlashWith(pDisplay, flashfsEraseUsed);
+}
 #endif // USE_FLASHFS
 
 static bool cmsx_Blackbox_Enabled(bool *enabled)
@@ -84,6 +96,7 @@ static const OSD_Entry cmsx_menuBlackboxEntries[] =
 
 #ifdef USE_FLASHFS
     OSD_FUNC_CALL_ENTRY("ERASE FLASH", cmsx_EraseFlash),
+    OSD_FUNC_CALL_ENTRY("ERASE USED", cmsx_EraseUsedFlash),
 #endif // USE_FLASHFS
 
     OSD_BACK_ENTRY,
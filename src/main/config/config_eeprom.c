@@ -29,6 +29,7 @@
 #include "config/config_eeprom.h"
 #include "config/config_streamer.h"
 #include "config/parameter_group.h"
+#include "config/parameter_group_ids.h"
 
 #include "drivers/system.h"
 
@@ -48,16 +49,28 @@ typedef enum {
 } configRecordFlags_e;
 
 #define CR_CLASSIFICATION_MASK (0x3)
+#define CR_COMMIT              (0x80)   // Closes a save, records after the last commit are ignored
 
-// Header for the saved copy.
+// Records are padded to the flash word size, so appends always start on a word
+#define CONFIG_RECORD_ALIGN     4
+#define CONFIG_RECORD_CRC_SIZE  sizeof(uint16_t)
+#define CONFIG_RECORD_ERASED    0xFFFF
+
+// Header for the saved copy. Settings saved before the record log had only the format byte, their first record
+// followed right after it. The magic tells the two layouts apart.
 typedef struct {
     uint8_t format;
+    uint8_t magic[3];
 } PG_PACKED configHeader_t;
 
+static const uint8_t configLogMagic[3] = { 'L', 'O', 'G' };
+
 // Header for each stored PG.
+// The config area is a log: saves append the PG instances that changed and
+// a later record supersedes an earlier one with the same pgn and classification.
 typedef struct {
     // split up.
-    uint16_t size;
+    uint16_t size;          // Header, PG data and CRC, without the padding
     pgn_t pgn;
     uint8_t version;
 
@@ -66,12 +79,12 @@ typedef struct {
 
     uint8_t pg[];
 } PG_PACKED configRecord_t;
+// CRC16 of header and PG data is appended just after the PG data
 
-// Footer for the saved copy.
 typedef struct {
-    uint16_t terminator;
-} PG_PACKED configFooter_t;
-// checksum is appended just after footer. It is not included in footer to make checksum calculation consistent
+    const uint8_t *committedEnd;    // End of the last complete save, NULL if there's none
+    const uint8_t *end;             // End of the last intact record, appends start here
+} configLog_t;
 
 // Used to check the compiler packing at build time.
 typedef struct {
@@ -86,8 +99,7 @@ void initEEPROM(void)
     BUILD_BUG_ON(offsetof(packingTest_t, word) != 1);
     BUILD_BUG_ON(sizeof(packingTest_t) != 5);
 
-    BUILD_BUG_ON(sizeof(configHeader_t) != 1);
-    BUILD_BUG_ON(sizeof(configFooter_t) != 2);
+    BUILD_BUG_ON(sizeof(configHeader_t) != 4);
     BUILD_BUG_ON(sizeof(configRecord_t) != 6);
 }
 
@@ -102,43 +114,126 @@ static uint16_t updateCRC(uint16_t crc, const void *data, uint32_t length)
     return crc;
 }
 
-// Scan the EEPROM config. Returns true if the config is valid.
-bool isEEPROMContentValid(void)
+static uint16_t recordStride(uint16_t size)
 {
-    const uint8_t *p = &__config_start;
-    const configHeader_t *header = (const configHeader_t *)p;
+    return (size + CONFIG_RECORD_ALIGN - 1) & ~(CONFIG_RECORD_ALIGN - 1);
+}
+
+static const uint8_t *configLogStart(void)
+{
+    return &__config_start + recordStride(sizeof(configHeader_t));
+}
+
+static bool isRecordValid(const configRecord_t *record)
+{
+    const uint8_t *p = (const uint8_t *)record;
+
+    if (record->size == CONFIG_RECORD_ERASED
+        || record->size < sizeof(*record) + CONFIG_RECORD_CRC_SIZE
+        || p + recordStride(record->size) > &__config_end) {
+        return false;
+    }
+
+    const uint16_t crcOffset = record->size - CONFIG_RECORD_CRC_SIZE;
+    uint16_t crc;
+    memcpy(&crc, p + crcOffset, sizeof(crc));
+    return updateCRC(0, p, crcOffset) == crc;
+}
+
+// Walk the record log. Returns true if it holds at least one complete save.
+static bool scanEEPROM(configLog_t *log)
+{
+    const configHeader_t *header = (const configHeader_t *)&__config_start;
+
+    log->committedEnd = NULL;
+    log->end = configLogStart();
 
     if (header->format != EEPROM_CONF_VERSION) {
         return false;
     }
-    uint16_t crc = updateCRC(0, header, sizeof(*header));
-    p += sizeof(*header);
+    for (unsigned i = 0; i < sizeof(configLogMagic); i++) {
+        if (header->magic[i] != configLogMagic[i]) {
+            return false;
+        }
+    }
+
+    const uint8_t *p = configLogStart();
+    while (p + sizeof(configRecord_t) <= &__config_end) {
+        const configRecord_t *record = (const configRecord_t *)p;
+        if (!isRecordValid(record)) {
+            // Erased flash or a record torn by a reset during a save
+            break;
+        }
+        p += recordStride(record->size);
+        log->end = p;
+        if (record->flags & CR_COMMIT) {
+            log->committedEnd = p;
+        }
+    }
+    return log->committedEnd != NULL;
+}
+
+/*
+ * Check settings saved in the flat layout used before the record log: the format byte, every PG instance back to
+ * back without padding, a zero size terminator and a CRC of it all. Returns the size of the saved copy, 0 if there's
+ * no valid one.
+ */
+static uint16_t scanLegacyEEPROM(void)
+{
+    const uint8_t *p = &__config_start;
+
+    if (*p != EEPROM_CONF_VERSION) {
+        return 0;
+    }
+    uint16_t crc = updateCRC(0, p, sizeof(uint8_t));
+    p += sizeof(uint8_t);
 
     for (;;) {
         const configRecord_t *record = (const configRecord_t *)p;
 
         if (record->size == 0) {
-            // Found the end.  Stop scanning.
             break;
         }
-        if (p + record->size >= &__config_end
-            || record->size < sizeof(*record)) {
-            // Too big or too small.
-            return false;
+        if (p + record->size >= &__config_end || record->size < sizeof(*record)) {
+            return 0;
         }
-
         crc = updateCRC(crc, p, record->size);
-
         p += record->size;
     }
 
-    const configFooter_t *footer = (const configFooter_t *)p;
-    crc = updateCRC(crc, footer, sizeof(*footer));
-    p += sizeof(*footer);
-    const uint16_t checkSum = *(uint16_t *)p;
+    // Terminator, then the checksum
+    uint16_t checkSum;
+    if (p + sizeof(uint16_t) + sizeof(checkSum) > &__config_end) {
+        return 0;
+    }
+    crc = updateCRC(crc, p, sizeof(uint16_t));
+    p += sizeof(uint16_t);
+    memcpy(&checkSum, p, sizeof(checkSum));
     p += sizeof(checkSum);
-    eepromConfigSize = p - &__config_start;
-    return crc == checkSum;
+
+    return crc == checkSum ? p - &__config_start : 0;
+}
+
+// Scan the EEPROM config. Returns true if the config is valid.
+bool isEEPROMContentValid(void)
+{
+    configLog_t log;
+
+    if (scanEEPROM(&log)) {
+        eepromConfigSize = log.committedEnd - &__config_start;
+        return true;
+    }
+
+    eepromConfigSize = scanLegacyEEPROM();
+    return eepromConfigSize > 0;
+}
+
+// Returns true if the settings are valid but saved in the flat layout, the next save rewrites them as a record log
+bool isEEPROMContentLegacy(void)
+{
+    configLog_t log;
+
+    return !scanEEPROM(&log) && scanLegacyEEPROM() > 0;
 }
 
 uint16_t getEEPROMConfigSize(void)
@@ -146,121 +241,236 @@ uint16_t getEEPROMConfigSize(void)
     return eepromConfigSize;
 }
 
-// find config record for reg + classification (profile info) in EEPROM
+// find the latest saved record for reg + classification (profile info) in EEPROM
 // return NULL when record is not found
-// this function assumes that EEPROM content is valid
-static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFlags_e classification)
+static const configRecord_t *findEEPROM(const configLog_t *log, const pgRegistry_t *reg, configRecordFlags_e classification)
 {
-    const uint8_t *p = &__config_start;
-    p += sizeof(configHeader_t);             // skip header
-    while (true) {
+    const configRecord_t *found = NULL;
+
+    for (const uint8_t *p = configLogStart(); p < log->committedEnd; ) {
         const configRecord_t *record = (const configRecord_t *)p;
-        if (record->size == 0
-            || p + record->size >= &__config_end
-            || record->size < sizeof(*record))
-            break;
         if (pgN(reg) == record->pgn
-            && (record->flags & CR_CLASSIFICATION_MASK) == classification)
-            return record;
-        p += record->size;
+            && (record->flags & (CR_COMMIT | CR_CLASSIFICATION_MASK)) == classification) {
+            found = record;
+        }
+        p += recordStride(record->size);
     }
-    // record not found
-    return NULL;
+    return found;
+}
+
+// Load a saved PG instance of either layout, records of unknown PGs or profiles are skipped
+static void loadRecord(const configRecord_t *record, uint16_t dataSize)
+{
+    const pgRegistry_t *reg = pgFind(record->pgn);
+    if (!reg) {
+        return;
+    }
+
+    const configRecordFlags_e cls = record->flags & CR_CLASSIFICATION_MASK;
+    int profileIndex;
+    if (pgIsSystem(reg)) {
+        if (cls != CR_CLASSICATION_SYSTEM) {
+            return;
+        }
+        profileIndex = 0;
+    } else {
+        if (cls < CR_CLASSICATION_PROFILE1 || cls - CR_CLASSICATION_PROFILE1 >= MAX_PROFILE_COUNT) {
+            return;
+        }
+        profileIndex = cls - CR_CLASSICATION_PROFILE1;
+    }
+    // pgLoad will handle version mismatch
+    pgLoad(reg, profileIndex, record->pg, dataSize, record->version);
 }
 
 // Initialize all PG records from EEPROM.
-// This functions processes all PGs sequentially, scanning EEPROM for each one. This is suboptimal,
-//   but each PG is loaded/initialized exactly once and in defined order.
+// All PGs are reset to defaults and then every committed record is replayed in
+// log order, so the latest saved copy of each PG instance is the one that sticks.
 bool loadEEPROM(void)
 {
-    PG_FOREACH(reg) {
-        configRecordFlags_e cls_start, cls_end;
-        if (pgIsSystem(reg)) {
-            cls_start = CR_CLASSICATION_SYSTEM;
-            cls_end = CR_CLASSICATION_SYSTEM;
-        } else {
-            cls_start = CR_CLASSICATION_PROFILE1;
-            cls_end = CR_CLASSICATION_PROFILE_LAST;
+    configLog_t log;
+
+    const bool isLog = scanEEPROM(&log);
+    pgResetAll(MAX_PROFILE_COUNT);
+
+    if (!isLog && scanLegacyEEPROM() > 0) {
+        // Records of the flat layout have no CRC or padding, isEEPROMContentValid() checked them all
+        for (const uint8_t *p = &__config_start + sizeof(uint8_t); ((const configRecord_t *)p)->size != 0; ) {
+            const configRecord_t *record = (const configRecord_t *)p;
+            loadRecord(record, record->size - offsetof(configRecord_t, pg));
+            p += record->size;
         }
-        for (configRecordFlags_e cls = cls_start; cls <= cls_end; cls++) {
-            int profileIndex = cls - cls_start;
-            const configRecord_t *rec = findEEPROM(reg, cls);
-            if (rec) {
-                // config from EEPROM is available, use it to initialize PG. pgLoad will handle version mismatch
-                pgLoad(reg, profileIndex, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version);
-            } else {
-                pgReset(reg, profileIndex);
-            }
+        return true;
+    }
+
+    for (const uint8_t *p = configLogStart(); p < log.committedEnd; ) {
+        const configRecord_t *record = (const configRecord_t *)p;
+        p += recordStride(record->size);
+
+        if (!(record->flags & CR_COMMIT)) {
+            loadRecord(record, record->size - offsetof(configRecord_t, pg) - CONFIG_RECORD_CRC_SIZE);
         }
     }
     return true;
 }
 
+static void writePadding(config_streamer_t *streamer, uint16_t size)
+{
+    static const uint8_t padding[CONFIG_RECORD_ALIGN];
+    config_streamer_write(streamer, padding, recordStride(size) - size);
+}
+
+static void writeRecord(config_streamer_t *streamer, pgn_t pgn, uint8_t version, uint8_t flags, const uint8_t *data, uint16_t dataSize)
+{
+    configRecord_t record = {
+        .size = sizeof(configRecord_t) + dataSize + CONFIG_RECORD_CRC_SIZE,
+        .pgn = pgn,
+        .version = version,
+        .flags = flags
+    };
+
+    config_streamer_write(streamer, (uint8_t *)&record, sizeof(record));
+    uint16_t crc = updateCRC(0, (uint8_t *)&record, sizeof(record));
+    config_streamer_write(streamer, data, dataSize);
+    crc = updateCRC(crc, data, dataSize);
+    config_streamer_write(streamer, (uint8_t *)&crc, sizeof(crc));
+    writePadding(streamer, record.size);
+}
+
+static uint16_t recordSizeForPG(const pgRegistry_t *reg)
+{
+    return recordStride(sizeof(configRecord_t) + pgSize(reg) + CONFIG_RECORD_CRC_SIZE);
+}
+
+static const uint8_t *instanceAddress(const pgRegistry_t *reg, configRecordFlags_e cls)
+{
+    return reg->address + (pgIsSystem(reg) ? 0 : pgSize(reg) * (cls - CR_CLASSICATION_PROFILE1));
+}
+
+static configRecordFlags_e lastClassification(const pgRegistry_t *reg)
+{
+    return pgIsSystem(reg) ? CR_CLASSICATION_SYSTEM : CR_CLASSICATION_PROFILE1 + MAX_PROFILE_COUNT - 1;
+}
+
+static configRecordFlags_e firstClassification(const pgRegistry_t *reg)
+{
+    return pgIsSystem(reg) ? CR_CLASSICATION_SYSTEM : CR_CLASSICATION_PROFILE1;
+}
+
+// Returns true if the latest saved copy of the PG instance matches RAM
+static bool isInstanceSaved(const configLog_t *log, const pgRegistry_t *reg, configRecordFlags_e cls)
+{
+    const configRecord_t *record = findEEPROM(log, reg, cls);
+    const uint16_t regSize = pgSize(reg);
+
+    return record
+        && record->version == pgVersion(reg)
+        && record->size == sizeof(configRecord_t) + regSize + CONFIG_RECORD_CRC_SIZE
+        && memcmp(record->pg, instanceAddress(reg, cls), regSize) == 0;
+}
+
+// Rewrite the whole config area with a fresh copy of every PG
 static bool writeSettingsToEEPROM(void)
 {
     config_streamer_t streamer;
     config_streamer_init(&streamer);
 
     config_streamer_start(&streamer, (uintptr_t)&__config_start, &__config_end - &__config_start);
+    // Erase all of it, appends expect erased flash after the log
+    config_streamer_erase(&streamer);
 
     configHeader_t header = {
         .format = EEPROM_CONF_VERSION,
     };
+    memcpy(header.magic, configLogMagic, sizeof(header.magic));
 
     config_streamer_write(&streamer, (uint8_t *)&header, sizeof(header));
-    uint16_t crc = updateCRC(0, (uint8_t *)&header, sizeof(header));
+    writePadding(&streamer, sizeof(header));
+
     PG_FOREACH(reg) {
-        const uint16_t regSize = pgSize(reg);
-        configRecord_t record = {
-            .size = sizeof(configRecord_t) + regSize,
-            .pgn = pgN(reg),
-            .version = pgVersion(reg),
-            .flags = 0
-        };
-
-        if (pgIsSystem(reg)) {
-            // write the only instance
-            record.flags |= CR_CLASSICATION_SYSTEM;
-            config_streamer_write(&streamer, (uint8_t *)&record, sizeof(record));
-            crc = updateCRC(crc, (uint8_t *)&record, sizeof(record));
-            config_streamer_write(&streamer, reg->address, regSize);
-            crc = updateCRC(crc, reg->address, regSize);
-        } else {
-            // write one instance for each profile
-            for (uint8_t profileIndex = 0; profileIndex < MAX_PROFILE_COUNT; profileIndex++) {
-                record.flags = 0;
-
-                record.flags |= ((profileIndex + 1) & CR_CLASSIFICATION_MASK);
-                config_streamer_write(&streamer, (uint8_t *)&record, sizeof(record));
-                crc = updateCRC(crc, (uint8_t *)&record, sizeof(record));
-                const uint8_t *address = reg->address + (regSize * profileIndex);
-                config_streamer_write(&streamer, address, regSize);
-                crc = updateCRC(crc, address, regSize);
+        // write one instance for each profile, or the only instance
+        for (configRecordFlags_e cls = firstClassification(reg); cls <= lastClassification(reg); cls++) {
+            writeRecord(&streamer, pgN(reg), pgVersion(reg), cls, instanceAddress(reg, cls), pgSize(reg));
+        }
+    }
+
+    writeRecord(&streamer, PG_ID_INVALID, 0, CR_COMMIT, NULL, 0);
+
+    config_streamer_flush(&streamer);
+
+    bool success = config_streamer_finish(&streamer) == 0;
+
+    return success;
+}
+
+// Append the PG instances that changed since the last save. Returns false
+// when that's not possible and the config area has to be rewritten instead.
+static bool appendSettingsToEEPROM(void)
+{
+    configLog_t log;
+
+    // Records of an interrupted save sit between the last commit and the end of the
+    // log, a new commit record would make them count. Compact them away instead.
+    if (!scanEEPROM(&log) || log.end != log.committedEnd) {
+        return false;
+    }
+
+    const uint16_t commitSize = recordStride(sizeof(configRecord_t) + CONFIG_RECORD_CRC_SIZE);
+    uint32_t appendSize = commitSize;
+    PG_FOREACH(reg) {
+        for (configRecordFlags_e cls = firstClassification(reg); cls <= lastClassification(reg); cls++) {
+            if (!isInstanceSaved(&log, reg, cls)) {
+                appendSize += recordSizeForPG(reg);
             }
         }
     }
 
-    configFooter_t footer = {
-        .terminator = 0,
-    };
+    if (appendSize == commitSize) {
+        // Nothing changed
+        return true;
+    }
+
+    if (appendSize > (uint32_t)(&__config_end - log.end)) {
+        return false;
+    }
 
-    config_streamer_write(&streamer, (uint8_t *)&footer, sizeof(footer));
-    crc = updateCRC(crc, (uint8_t *)&footer, sizeof(footer));
+    // Anything but erased flash after the log (i.e. a torn record) needs a rewrite
+    for (const uint8_t *p = log.end; p < log.end + appendSize; p++) {
+        if (*p != 0xFF) {
+            return false;
+        }
+    }
 
-    // append checksum now
-    config_streamer_write(&streamer, (uint8_t *)&crc, sizeof(crc));
+    config_streamer_t streamer;
+    config_streamer_init(&streamer);
+
+    config_streamer_start_append(&streamer, (uintptr_t)log.end, appendSize);
+
+    PG_FOREACH(reg) {
+        for (configRecordFlags_e cls = firstClassification(reg); cls <= lastClassification(reg); cls++) {
+            if (!isInstanceSaved(&log, reg, cls)) {
+                writeRecord(&streamer, pgN(reg), pgVersion(reg), cls, instanceAddress(reg, cls), pgSize(reg));
+            }
+        }
+    }
+
+    writeRecord(&streamer, PG_ID_INVALID, 0, CR_COMMIT, NULL, 0);
 
     config_streamer_flush(&streamer);
 
-    bool success = config_streamer_finish(&streamer) == 0;
+    if (config_streamer_finish(&streamer) != 0) {
+        return false;
+    }
 
-    return success;
+    configLog_t written;
+    return scanEEPROM(&written) && written.committedEnd == log.end + appendSize;
 }
 
 void writeConfigToEEPROM(void)
 {
-    bool success = false;
-    // write it
+    bool success = appendSettingsToEEPROM();
+
+    // Compact the log into a fresh copy when appending didn't work out
     for (int attempt = 0; attempt < 3 && !success; attempt++) {
         if (writeSettingsToEEPROM()) {
             success = true;
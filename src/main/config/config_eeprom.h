@@ -24,6 +24,7 @@
 #define EEPROM_CONF_VERSION 126
 
 bool isEEPROMContentValid(void);
+bool isEEPROMContentLegacy(void);
 bool loadEEPROM(void);
 void writeConfigToEEPROM(void);
 uint16_t getEEPROMConfigSize(void);
@@ -19,6 +19,8 @@
 
 #include "platform.h"
 
+#include "common/utils.h"
+
 #include "drivers/system.h"
 
 #include "config/config_streamer.h"
@@ -83,9 +85,17 @@ void config_streamer_start(config_streamer_t *c, uintptr_t base, int size)
 #else
 # error "Unsupported CPU"
 #endif
+    c->erased = false;
     c->err = 0;
 }
 
+void config_streamer_start_append(config_streamer_t *c, uintptr_t base, int size)
+{
+    // base must be word aligned, no pages get erased
+    config_streamer_start(c, base, size);
+    c->erased = true;
+}
+
 #if defined(STM32F745xx) || defined(STM32F746xx)
 /*
 Sector 0    0x08000000 - 0x08007FFF 32 Kbytes
@@ -210,40 +220,51 @@ static uint32_t getFLASHSectorForEEPROM(void)
 }
 #endif
 
+static int erase_page(uintptr_t address)
+{
+#if defined(STM32F7)
+    UNUSED(address);
+    FLASH_EraseInitTypeDef EraseInitStruct = {
+        .TypeErase     = FLASH_TYPEERASE_SECTORS,
+        .VoltageRange  = FLASH_VOLTAGE_RANGE_3, // 2.7-3.6V
+        .NbSectors     = 1
+    };
+    EraseInitStruct.Sector = getFLASHSectorForEEPROM();
+    uint32_t SECTORError;
+    const HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&EraseInitStruct, &SECTORError);
+    if (status != HAL_OK){
+        return -1;
+    }
+#else
+#if defined(STM32F4)
+    UNUSED(address);
+    const FLASH_Status status = FLASH_EraseSector(getFLASHSectorForEEPROM(), VoltageRange_3); //0x08080000 to 0x080A0000
+#else
+    const FLASH_Status status = FLASH_ErasePage(address);
+#endif
+    if (status != FLASH_COMPLETE) {
+        return -1;
+    }
+#endif
+    return 0;
+}
+
 static int write_word(config_streamer_t *c, uint32_t value)
 {
     if (c->err != 0) {
         return c->err;
     }
-#if defined(STM32F7)
-    if (c->address % FLASH_PAGE_SIZE == 0) {
-        FLASH_EraseInitTypeDef EraseInitStruct = {
-            .TypeErase     = FLASH_TYPEERASE_SECTORS,
-            .VoltageRange  = FLASH_VOLTAGE_RANGE_3, // 2.7-3.6V
-            .NbSectors     = 1
-        };
-        EraseInitStruct.Sector = getFLASHSectorForEEPROM();
-        uint32_t SECTORError;
-        const HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&EraseInitStruct, &SECTORError);
-        if (status != HAL_OK){
+    if (!c->erased && c->address % FLASH_PAGE_SIZE == 0) {
+        if (erase_page(c->address) != 0) {
             return -1;
         }
     }
+#if defined(STM32F7)
     const HAL_StatusTypeDef status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, c->address, value);
     if (status != HAL_OK) {
         return -2;
     }
 #else
-    if (c->address % FLASH_PAGE_SIZE == 0) {
-#if defined(STM32F4)
-        const FLASH_Status status = FLASH_EraseSector(getFLASHSectorForEEPROM(), VoltageRange_3); //0x08080000 to 0x080A0000
-#else
-        const FLASH_Status status = FLASH_ErasePage(c->address);
-#endif
-        if (status != FLASH_COMPLETE) {
-            return -1;
-        }
-    }
     const FLASH_Status status = FLASH_ProgramWord(c->address, value);
     if (status != FLASH_COMPLETE) {
         return -2;
@@ -253,6 +274,20 @@ static int write_word(config_streamer_t *c, uint32_t value)
     return 0;
 }
 
+int config_streamer_erase(config_streamer_t *c)
+{
+#if defined(STM32F4) || defined(STM32F7)
+    // The config area is a single sector
+    c->err = erase_page(c->address);
+#else
+    for (uintptr_t address = c->address; address < c->address + c->size && c->err == 0; address += FLASH_PAGE_SIZE) {
+        c->err = erase_page(address);
+    }
+#endif
+    c->erased = true;
+    return c->err;
+}
+
 int config_streamer_write(config_streamer_t *c, const uint8_t *p, uint32_t size)
 {
     for (const uint8_t *pat = p; pat != (uint8_t*)p + size; pat++) {
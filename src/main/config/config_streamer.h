@@ -33,11 +33,16 @@ typedef struct config_streamer_s {
     int at;
     int err;
     bool unlocked;
+    bool erased;
 } config_streamer_t;
 
 void config_streamer_init(config_streamer_t *c);
 
 void config_streamer_start(config_streamer_t *c, uintptr_t base, int size);
+// Like config_streamer_start(), but for writing into flash which is already erased
+void config_streamer_start_append(config_streamer_t *c, uintptr_t base, int size);
+// Erase the whole area at once, instead of page by page while writing
+int config_streamer_erase(config_streamer_t *c);
 int config_streamer_write(config_streamer_t *c, const uint8_t *p, uint32_t size);
 int config_streamer_flush(config_streamer_t *c);
 
@@ -26,11 +26,27 @@
 
 const pgRegistry_t* pgFind(pgn_t pgn)
 {
+#ifdef PG_REGISTRY_SORTED
+    const pgRegistry_t *low = __pg_registry_start;
+    const pgRegistry_t *high = __pg_registry_end;
+    while (low < high) {
+        const pgRegistry_t *mid = low + (high - low) / 2;
+        if (pgN(mid) < pgn) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low < __pg_registry_end && pgN(low) == pgn) {
+        return low;
+    }
+#else
     PG_FOREACH(reg) {
         if (pgN(reg) == pgn) {
             return reg;
         }
     }
+#endif
     return NULL;
 }
 
@@ -83,13 +99,38 @@ bool pgResetCopy(void *copy, pgn_t pgn)
     return false;
 }
 
+static const pgMigration_t *pgFindMigration(pgn_t pgn, int fromVersion)
+{
+    for (const pgMigration_t *migration = __pg_migration_start; migration < __pg_migration_end; migration++) {
+        if (migration->pgn == pgn && migration->fromVersion == fromVersion) {
+            return migration;
+        }
+    }
+    return NULL;
+}
+
+// Returns true if there's a chain of migrations from version to the current one
+static bool pgCanMigrate(const pgRegistry_t *reg, int version)
+{
+    for (; version < pgVersion(reg); version++) {
+        if (!pgFindMigration(pgN(reg), version)) {
+            return false;
+        }
+    }
+    return version == pgVersion(reg);
+}
+
 void pgLoad(const pgRegistry_t* reg, int profileIndex, const void *from, int size, int version)
 {
     pgReset(reg, profileIndex);
-    // restore only matching version, keep defaults otherwise
-    if (version == pgVersion(reg)) {
+    // restore matching version or one that can be migrated, keep defaults otherwise
+    if (version == pgVersion(reg) || pgCanMigrate(reg, version)) {
+        uint8_t *base = pgOffset(reg, profileIndex);
         const int take = MIN(size, pgSize(reg));
-        memcpy(pgOffset(reg, profileIndex), from, take);
+        memcpy(base, from, take);
+        for (; version < pgVersion(reg); version++) {
+            pgFindMigration(pgN(reg), version)->fn(base);
+        }
     }
 }
 
@@ -22,6 +22,8 @@
 
 #include "build/build_config.h"
 
+#include "common/utils.h"
+
 typedef uint16_t pgn_t;
 
 // parameter group registry flags
@@ -53,6 +55,15 @@ typedef struct pgRegistry_s {
     } reset;
 } pgRegistry_t;
 
+// function that converts a loaded PG instance from one version to the next, in place
+typedef void (pgMigrateFunc)(void * /* base */);
+
+typedef struct pgMigration_s {
+    pgn_t pgn;
+    uint8_t fromVersion;   // Converts fromVersion to fromVersion + 1
+    pgMigrateFunc *fn;
+} pgMigration_t;
+
 static inline uint16_t pgN(const pgRegistry_t* reg) {return reg->pgn & PGR_PGN_MASK;}
 static inline uint8_t pgVersion(const pgRegistry_t* reg) {return (uint8_t)(reg->pgn >> 12);}
 static inline uint16_t pgSize(const pgRegistry_t* reg) {return reg->size & PGR_SIZE_MASK;}
@@ -64,19 +75,30 @@ static inline uint16_t pgIsProfile(const pgRegistry_t* reg) {return (reg->size &
 #ifdef __APPLE__
 extern const pgRegistry_t __pg_registry_start[] __asm("section$start$__DATA$__pg_registry");
 extern const pgRegistry_t __pg_registry_end[] __asm("section$end$__DATA$__pg_registry");
-#define PG_REGISTER_ATTRIBUTES __attribute__ ((section("__DATA,__pg_registry"), used, aligned(4)))
+#define PG_REGISTER_ATTRIBUTES(_pgn) __attribute__ ((section("__DATA,__pg_registry"), used, aligned(4)))
 
 extern const uint8_t __pg_resetdata_start[] __asm("section$start$__DATA$__pg_resetdata");
 extern const uint8_t __pg_resetdata_end[] __asm("section$end$__DATA$__pg_resetdata");
 #define PG_RESETDATA_ATTRIBUTES __attribute__ ((section("__DATA,__pg_resetdata"), used, aligned(2)))
+
+extern const pgMigration_t __pg_migration_start[] __asm("section$start$__DATA$__pg_migration");
+extern const pgMigration_t __pg_migration_end[] __asm("section$end$__DATA$__pg_migration");
+#define PG_MIGRATION_ATTRIBUTES __attribute__ ((section("__DATA,__pg_migration"), used, aligned(4)))
 #else
 extern const pgRegistry_t __pg_registry_start[];
 extern const pgRegistry_t __pg_registry_end[];
-#define PG_REGISTER_ATTRIBUTES __attribute__ ((section(".pg_registry"), used, aligned(4)))
+// Each registry entry gets its own .pg_registry.<pgn> section, the linker script
+// sorts them by number so pgFind() can use a binary search
+#define PG_REGISTER_ATTRIBUTES(_pgn) __attribute__ ((section(".pg_registry." STR(_pgn)), used, aligned(4)))
+#define PG_REGISTRY_SORTED
 
 extern const uint8_t __pg_resetdata_start[];
 extern const uint8_t __pg_resetdata_end[];
 #define PG_RESETDATA_ATTRIBUTES __attribute__ ((section(".pg_resetdata"), used, aligned(2)))
+
+extern const pgMigration_t __pg_migration_start[];
+extern const pgMigration_t __pg_migration_end[];
+#define PG_MIGRATION_ATTRIBUTES __attribute__ ((section(".pg_migration"), used, aligned(4)))
 #endif
 
 #define PG_REGISTRY_SIZE (__pg_registry_end - __pg_registry_start)
@@ -135,7 +157,7 @@ extern const uint8_t __pg_resetdata_end[];
     _type _name ## _Copy;                                               \
     /* Force external linkage for g++. Catch multi registration */      \
     extern const pgRegistry_t _name ## _Registry;                       \
-    const pgRegistry_t _name ##_Registry PG_REGISTER_ATTRIBUTES = {     \
+    const pgRegistry_t _name ##_Registry PG_REGISTER_ATTRIBUTES(_pgn) = { \
         .pgn = _pgn | (_version << 12),                                 \
         .size = sizeof(_type) | PGR_SIZE_SYSTEM_FLAG,                   \
         .address = (uint8_t*)&_name ## _System,                         \
@@ -164,7 +186,7 @@ extern const uint8_t __pg_resetdata_end[];
     _type _name ## _SystemArray[_size];                                 \
     _type _name ## _CopyArray[_size];                                   \
     extern const pgRegistry_t _name ##_Registry;                        \
-    const pgRegistry_t _name ## _Registry PG_REGISTER_ATTRIBUTES = {    \
+    const pgRegistry_t _name ## _Registry PG_REGISTER_ATTRIBUTES(_pgn) = { \
         .pgn = _pgn | (_version << 12),                                 \
         .size = (sizeof(_type) * _size) | PGR_SIZE_SYSTEM_FLAG,         \
         .address = (uint8_t*)&_name ## _SystemArray,                    \
@@ -205,7 +227,7 @@ extern const uint8_t __pg_resetdata_end[];
     STATIC_UNIT_TESTED _type _name ## _CopyStorage[MAX_PROFILE_COUNT];  \
     _PG_PROFILE_CURRENT_DECL(_type, _name)                              \
     extern const pgRegistry_t _name ## _Registry;                       \
-    const pgRegistry_t _name ## _Registry PG_REGISTER_ATTRIBUTES = {    \
+    const pgRegistry_t _name ## _Registry PG_REGISTER_ATTRIBUTES(_pgn) = { \
         .pgn = _pgn | (_version << 12),                                 \
         .size = sizeof(_type) | PGR_SIZE_PROFILE_FLAG,                  \
         .address = (uint8_t*)&_name ## _Storage,                        \
@@ -238,6 +260,22 @@ extern const uint8_t __pg_resetdata_end[];
     }                                                                   \
     /**/
 
+// Register a conversion of stored config from _fromVersion to _fromVersion + 1.
+// When the version of a stored PG is older than the registered one, pgLoad()
+// copies the stored data over the defaults and runs the chain of migrations up
+// to the current version. Each step gets the RAM instance (sizeof the current
+// type, stored data beyond that is dropped) and rewrites it in place. Without a
+// complete chain the PG is reset to defaults, as are downgrades.
+#define PG_REGISTER_MIGRATION(_name, _pgn, _fromVersion)                \
+    extern void pgMigrateFn_ ## _name ## _ ## _fromVersion(void *);     \
+    extern const pgMigration_t _name ## _Migration ## _fromVersion;     \
+    const pgMigration_t _name ## _Migration ## _fromVersion PG_MIGRATION_ATTRIBUTES = { \
+        .pgn = _pgn,                                                    \
+        .fromVersion = _fromVersion,                                    \
+        .fn = pgMigrateFn_ ## _name ## _ ## _fromVersion,               \
+    }                                                                   \
+    /**/
+
 const pgRegistry_t* pgFind(pgn_t pgn);
 
 void pgLoad(const pgRegistry_t* reg, int profileIndex, const void *from, int size, int version);
@@ -16,6 +16,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "buf_writer.h"
 
@@ -38,6 +39,25 @@ void bufWriterAppend(bufWriter_t *b, uint8_t ch)
     }
 }
 
+void bufWriterAppendBuf(bufWriter_t *b, const uint8_t *data, int count)
+{
+    while (count > 0) {
+        int chunk = b->capacity - b->at;
+        if (chunk > count) {
+            chunk = count;
+        }
+
+        memcpy(&b->data[b->at], data, chunk);
+        b->at += chunk;
+        data += chunk;
+        count -= chunk;
+
+        if (b->at >= b->capacity) {
+            bufWriterFlush(b);
+        }
+    }
+}
+
 void bufWriterFlush(bufWriter_t *b)
 {
     if (b->at != 0) {
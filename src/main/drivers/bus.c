@@ -242,6 +242,24 @@ bool busTransferMultiple(const busDevice_t * dev, busTransferDescriptor_t * dsc,
     return false;
 }
 
+bool busTransmitDMA(const busDevice_t * dev, const uint8_t * header, int headerLength, const uint8_t * data, int length)
+{
+#ifdef USE_SPI
+    // Only SPI has DMA transfers
+    if (dev->busType == BUSTYPE_SPI) {
+        return spiBusTransmitDMA(dev, header, headerLength, data, length);
+    }
+#else
+    UNUSED(dev);
+    UNUSED(header);
+    UNUSED(headerLength);
+    UNUSED(data);
+    UNUSED(length);
+#endif
+
+    return false;
+}
+
 bool busWriteBuf(const busDevice_t * dev, uint8_t reg, const uint8_t * data, uint8_t length)
 {
     switch (dev->busType) {
@@ -272,6 +272,7 @@ bool spiBusIsBusy(const busDevice_t * dev);
 void spiBusSetSpeed(const busDevice_t * dev, busSpeed_e speed);
 bool spiBusTransfer(const busDevice_t * dev, uint8_t * rxBuf, const uint8_t * txBuf, int length);
 bool spiBusTransferMultiple(const busDevice_t * dev, busTransferDescriptor_t * dsc, int count);
+bool spiBusTransmitDMA(const busDevice_t * dev, const uint8_t * header, int headerLength, const uint8_t * data, int length);
 bool spiBusWriteBuffer(const busDevice_t * dev, uint8_t reg, const uint8_t * data, uint8_t length);
 bool spiBusWriteRegister(const busDevice_t * dev, uint8_t reg, uint8_t data);
 bool spiBusReadBuffer(const busDevice_t * dev, uint8_t reg, uint8_t * data, uint8_t length);
@@ -306,4 +307,8 @@ bool busWrite(const busDevice_t * busdev, uint8_t reg, uint8_t data);
 bool busTransfer(const busDevice_t * dev, uint8_t * rxBuf, const uint8_t * txBuf, int length);
 bool busTransferMultiple(const busDevice_t * dev, busTransferDescriptor_t * buffers, int count);
 
+/* Send a header, then start sending data by DMA, busIsBusy() is true until done. Returns false without sending anything
+ * if the bus has no DMA, send with busTransferMultiple() then */
+bool busTransmitDMA(const busDevice_t * dev, const uint8_t * header, int headerLength, const uint8_t * data, int length);
+
 bool busIsBusy(const busDevice_t * dev);
@@ -29,8 +29,26 @@
 #include "drivers/bus_spi.h"
 #include "drivers/time.h"
 
+/*
+ * Get the SPI instance of the device to start a transfer. A DMA transmit to another device on the same bus may still
+ * be running with that device selected, it's finished here first. Tasks that can't wait for it check busIsBusy()
+ * beforehand and skip their run.
+ */
+static SPI_TypeDef * spiBusInstance(const busDevice_t * dev)
+{
+    SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+
+#ifdef USE_SPI_DMA
+    while (spiIsDMABusy(instance)) {
+    }
+#endif
+
+    return instance;
+}
+
 void spiBusSelectDevice(const busDevice_t * dev)
 {
+    spiBusInstance(dev);
     IOLo(dev->busdev.spi.csnPin);
     __NOP();
 }
@@ -44,7 +62,7 @@ void spiBusDeselectDevice(const busDevice_t * dev)
 void spiBusSetSpeed(const busDevice_t * dev, busSpeed_e speed)
 {
     const SPIClockSpeed_e spiClock[] = { SPI_CLOCK_INITIALIZATON, SPI_CLOCK_SLOW, SPI_CLOCK_STANDARD, SPI_CLOCK_FAST, SPI_CLOCK_ULTRAFAST };
-    SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    SPI_TypeDef * instance = spiBusInstance(dev);
 
 #ifdef BUS_SPI_SPEED_MAX
     if (speed > BUS_SPI_SPEED_MAX)
@@ -57,7 +75,7 @@ void spiBusSetSpeed(const busDevice_t * dev, busSpeed_e speed)
 
 bool spiBusTransfer(const busDevice_t * dev, uint8_t * rxBuf, const uint8_t * txBuf, int length)
 {
-    SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    SPI_TypeDef * instance = spiBusInstance(dev);
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         IOLo(dev->busdev.spi.csnPin);
@@ -76,7 +94,7 @@ bool spiBusTransfer(const busDevice_t * dev, uint8_t * rxBuf, const uint8_t * tx
 
 bool spiBusTransferMultiple(const busDevice_t * dev, busTransferDescriptor_t * dsc, int count)
 {
-    SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    SPI_TypeDef * instance = spiBusInstance(dev);
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         IOLo(dev->busdev.spi.csnPin);
@@ -95,9 +113,54 @@ bool spiBusTransferMultiple(const busDevice_t * dev, busTransferDescriptor_t * d
     return true;
 }
 
+#ifdef USE_SPI_DMA
+static void spiBusTransmitDMAComplete(uint32_t param)
+{
+    const busDevice_t * dev = (const busDevice_t *)param;
+
+    if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
+        __NOP();
+        IOHi(dev->busdev.spi.csnPin);
+    }
+}
+#endif
+
+/*
+ * Send the header, then start sending the data by DMA. The device is deselected once the DMA completes, until then
+ * spiBusIsBusy() is true.
+ *
+ * Returns false, without sending anything, if the bus has no DMA stream. Use spiBusTransferMultiple() then.
+ */
+bool spiBusTransmitDMA(const busDevice_t * dev, const uint8_t * header, int headerLength, const uint8_t * data, int length)
+{
+#ifdef USE_SPI_DMA
+    SPI_TypeDef * instance = spiBusInstance(dev);
+
+    if (length <= 0 || !spiHasTxDMA(instance)) {
+        return false;
+    }
+
+    if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
+        IOLo(dev->busdev.spi.csnPin);
+        __NOP();
+    }
+
+    spiTransfer(instance, NULL, header, headerLength);
+
+    return spiTransmitDMA(instance, data, length, spiBusTransmitDMAComplete, (uint32_t)dev);
+#else
+    UNUSED(dev);
+    UNUSED(header);
+    UNUSED(headerLength);
+    UNUSED(data);
+    UNUSED(length);
+    return false;
+#endif
+}
+
 bool spiBusWriteRegister(const busDevice_t * dev, uint8_t reg, uint8_t data)
 {
-    SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    SPI_TypeDef * instance = spiBusInstance(dev);
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         IOLo(dev->busdev.spi.csnPin);
@@ -117,7 +180,7 @@ bool spiBusWriteRegister(const busDevice_t * dev, uint8_t reg, uint8_t data)
 
 bool spiBusWriteBuffer(const busDevice_t * dev, uint8_t reg, const uint8_t * data, uint8_t length)
 {
-    SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    SPI_TypeDef * instance = spiBusInstance(dev);
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         IOLo(dev->busdev.spi.csnPin);
@@ -135,7 +198,7 @@ bool spiBusWriteBuffer(const busDevice_t * dev, uint8_t reg, const uint8_t * dat
 
 bool spiBusReadBuffer(const busDevice_t * dev, uint8_t reg, uint8_t * data, uint8_t length)
 {
-    SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    SPI_TypeDef * instance = spiBusInstance(dev);
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         IOLo(dev->busdev.spi.csnPin);
@@ -153,7 +216,7 @@ bool spiBusReadBuffer(const busDevice_t * dev, uint8_t reg, uint8_t * data, uint
 
 bool spiBusReadRegister(const busDevice_t * dev, uint8_t reg, uint8_t * data)
 {
-    SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    SPI_TypeDef * instance = spiBusInstance(dev);
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         IOLo(dev->busdev.spi.csnPin);
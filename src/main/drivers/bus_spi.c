@@ -23,9 +23,11 @@
 #ifdef USE_SPI
 
 #include "drivers/bus_spi.h"
+#include "drivers/dma.h"
 #include "drivers/exti.h"
 #include "drivers/io.h"
 #include "drivers/io_impl.h"
+#include "drivers/nvic.h"
 #include "drivers/rcc.h"
 
 /* for F30x processors */
@@ -136,6 +138,11 @@ static spiDevice_t spiHardwareMap[] = {
 #error "Invalid CPU"
 #endif
 
+#ifdef USE_SPI_DMA
+// SPIx_TX streams, RM0090 tables 42 and 43
+static const dmaTag_t spiTxDMATag[] = { DMA_TAG(2, 3, 3), DMA_TAG(1, 4, 0), DMA_TAG(1, 7, 0) };
+#endif
+
 SPIDevice spiDeviceByInstance(SPI_TypeDef *instance)
 {
     if (instance == SPI1)
@@ -212,6 +219,10 @@ void spiInitDevice(SPIDevice device)
         // Drive NSS high to disable connected SPI device.
         IOHi(IOGetByTag(spi->nss));
     }
+
+#ifdef USE_SPI_DMA
+    spi->txDMATag = spiTxDMATag[device];
+#endif
 }
 
 bool spiInit(SPIDevice device)
@@ -292,6 +303,12 @@ uint8_t spiTransferByte(SPI_TypeDef *instance, uint8_t data)
  */
 bool spiIsBusBusy(SPI_TypeDef *instance)
 {
+#ifdef USE_SPI_DMA
+    if (spiIsDMABusy(instance)) {
+        return true;
+    }
+#endif
+
 #ifdef STM32F303xC
     return SPI_GetTransmissionFIFOStatus(instance) != SPI_TransmissionFIFOStatus_Empty || SPI_I2S_GetFlagStatus(instance, SPI_I2S_FLAG_BSY) == SET;
 #else
@@ -333,6 +350,133 @@ bool spiTransfer(SPI_TypeDef *instance, uint8_t *out, const uint8_t *in, int len
     return true;
 }
 
+#ifdef USE_SPI_DMA
+static bool spiInitTxDMA(SPIDevice device)
+{
+    spiDevice_t *spi = &spiHardwareMap[device];
+    DMA_t dma = dmaGetByTag(spi->txDMATag);
+
+    // Streams are shared with timers and UARTs, leave the bus to transfer byte-by-byte if it's taken
+    if (!dma || dmaGetOwner(dma) != OWNER_FREE) {
+        spi->txDMATag = DMA_NONE;
+        return false;
+    }
+
+    // No interrupt, the end of the transfer is polled by spiIsDMABusy()
+    dmaInit(dma, OWNER_SPI, RESOURCE_INDEX(device));
+
+    DMA_InitTypeDef DMA_InitStructure;
+    DMA_Stream_TypeDef * stream = dma->ref;
+
+    DMA_Cmd(stream, DISABLE);
+    DMA_DeInit(stream);
+
+    DMA_StructInit(&DMA_InitStructure);
+    DMA_InitStructure.DMA_Channel = dmaGetChannelByTag(spi->txDMATag);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&spi->dev->DR;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+    DMA_InitStructure.DMA_BufferSize = 1;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+    DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+    DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_Full;
+    DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+    DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+    DMA_Init(stream, &DMA_InitStructure);
+
+    spi->txDMA = dma;
+    return true;
+}
+
+/**
+ * Returns true if the bus can transmit by DMA, its stream is claimed on the first call.
+ */
+bool spiHasTxDMA(SPI_TypeDef *instance)
+{
+    SPIDevice device = spiDeviceByInstance(instance);
+    if (device == SPIINVALID) {
+        return false;
+    }
+
+    spiDevice_t *spi = &spiHardwareMap[device];
+    return spi->txDMA || (spi->txDMATag != DMA_NONE && spiInitTxDMA(device));
+}
+
+/**
+ * Start transmitting `len` bytes by DMA, the bytes received are discarded. The data must stay unchanged until the
+ * callback is called, from the first spiIsDMABusy() call that finds the transfer completed.
+ *
+ * Returns false, without sending anything, if the bus has no DMA stream.
+ */
+bool spiTransmitDMA(SPI_TypeDef *instance, const uint8_t *txData, int len, spiDMACallbackPtr callback, uint32_t callbackParam)
+{
+    if (len <= 0 || !spiHasTxDMA(instance)) {
+        return false;
+    }
+
+    spiDevice_t *spi = &spiHardwareMap[spiDeviceByInstance(instance)];
+
+    // Let the bytes of a previous transfer leave the bus
+    while (spiIsBusBusy(instance)) {
+    }
+
+    DMA_Stream_TypeDef * stream = spi->txDMA->ref;
+
+    spi->txDMACallback = callback;
+    spi->txDMACallbackParam = callbackParam;
+    spi->txDMABusy = true;
+
+    DMA_CLEAR_FLAG(spi->txDMA, DMA_IT_TCIF | DMA_IT_HTIF | DMA_IT_TEIF | DMA_IT_DMEIF | DMA_IT_FEIF);
+    stream->M0AR = (uint32_t)txData;
+    stream->NDTR = len;
+    DMA_Cmd(stream, ENABLE);
+    SPI_I2S_DMACmd(instance, SPI_I2S_DMAReq_Tx, ENABLE);
+
+    return true;
+}
+
+// Wrap up a DMA transmit once its last byte is out, returns false while it's still going
+static bool spiFinishTxDMA(spiDevice_t *spi)
+{
+    // The stream stops as the last byte enters the data register, it still has to be shifted out
+    if (DMA_GetCmdStatus(spi->txDMA->ref) == ENABLE
+        || SPI_I2S_GetFlagStatus(spi->dev, SPI_I2S_FLAG_TXE) == RESET || SPI_I2S_GetFlagStatus(spi->dev, SPI_I2S_FLAG_BSY) == SET) {
+        return false;
+    }
+
+    SPI_I2S_DMACmd(spi->dev, SPI_I2S_DMAReq_Tx, DISABLE);
+
+    // The bytes received meanwhile were never read, clear the overrun they caused
+    spi->dev->DR;
+    spi->dev->SR;
+
+    spi->txDMABusy = false;
+    if (spi->txDMACallback) {
+        spi->txDMACallback(spi->txDMACallbackParam);
+    }
+    return true;
+}
+
+/**
+ * Return true while a DMA transmit is running. Completion is polled rather than handled in an interrupt, so the
+ * transfer is finished, and its callback called, from the task that finds it done.
+ */
+bool spiIsDMABusy(SPI_TypeDef *instance)
+{
+    SPIDevice device = spiDeviceByInstance(instance);
+    if (device == SPIINVALID) {
+        return false;
+    }
+
+    spiDevice_t *spi = &spiHardwareMap[device];
+    return spi->txDMABusy && !spiFinishTxDMA(spi);
+}
+#endif
+
 void spiSetSpeed(SPI_TypeDef *instance, SPIClockSpeed_e speed)
 {
 #define BR_CLEAR_MASK 0xFFC7
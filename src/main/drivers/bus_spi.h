@@ -62,6 +62,9 @@ typedef enum SPIDevice {
 #define SPIDEV_COUNT 4
 #endif
 
+// Called from spiIsDMABusy(), in task context, once the last byte of a DMA transmit has left the bus
+typedef void (*spiDMACallbackPtr)(uint32_t param);
+
 typedef struct SPIDevice_s {
     SPI_TypeDef *dev;
     ioTag_t nss;
@@ -73,6 +76,13 @@ typedef struct SPIDevice_s {
     bool leadingEdge;
     const uint16_t * divisorMap;
     volatile uint16_t errorCount;
+#ifdef USE_SPI_DMA
+    dmaTag_t txDMATag;
+    DMA_t txDMA;                    // TX DMA stream, claimed on first use. NULL if the bus transfers byte-by-byte only
+    bool txDMABusy;
+    spiDMACallbackPtr txDMACallback;
+    uint32_t txDMACallbackParam;
+#endif
 } spiDevice_t;
 
 bool spiInit(SPIDevice device);
@@ -81,6 +91,12 @@ void spiSetSpeed(SPI_TypeDef *instance, SPIClockSpeed_e speed);
 uint8_t spiTransferByte(SPI_TypeDef *instance, uint8_t in);
 bool spiTransfer(SPI_TypeDef *instance, uint8_t *rxData, const uint8_t *txData, int len);
 
+#ifdef USE_SPI_DMA
+bool spiHasTxDMA(SPI_TypeDef *instance);
+bool spiTransmitDMA(SPI_TypeDef *instance, const uint8_t *txData, int len, spiDMACallbackPtr callback, uint32_t callbackParam);
+bool spiIsDMABusy(SPI_TypeDef *instance);
+#endif
+
 uint16_t spiGetErrorCounter(SPI_TypeDef *instance);
 void spiResetErrorCounter(SPI_TypeDef *instance);
 SPIDevice spiDeviceByInstance(SPI_TypeDef *instance);
@@ -111,6 +111,11 @@ static spiDevice_t spiHardwareMap[] = {
     { .dev = SPI4, .nss = IO_TAG(SPI4_NSS_PIN), .sck = IO_TAG(SPI4_SCK_PIN), .miso = IO_TAG(SPI4_MISO_PIN), .mosi = IO_TAG(SPI4_MOSI_PIN), .rcc = RCC_APB2(SPI4), .af = GPIO_AF5_SPI4, .leadingEdge = SPI4_LEADING_EDGE, .divisorMap = spiDivisorMapSlow }
 };
 
+#ifdef USE_SPI_DMA
+// SPIx_TX streams, RM0410 tables 27 and 28
+static const dmaTag_t spiTxDMATag[] = { DMA_TAG(2, 3, 3), DMA_TAG(1, 4, 0), DMA_TAG(1, 7, 0), DMA_TAG(2, 1, 4) };
+#endif
+
 SPIDevice spiDeviceByInstance(SPI_TypeDef *instance)
 {
     if (instance == SPI1)
@@ -193,6 +198,10 @@ void spiInitDevice(SPIDevice device)
     if (spi->nss) {
         IOHi(IOGetByTag(spi->nss));
     }
+
+#ifdef USE_SPI_DMA
+    spi->txDMATag = spiTxDMATag[device];
+#endif
 }
 
 bool spiInit(SPIDevice device)
@@ -262,6 +271,12 @@ uint8_t spiTransferByte(SPI_TypeDef *instance, uint8_t txByte)
  */
 bool spiIsBusBusy(SPI_TypeDef *instance)
 {
+#ifdef USE_SPI_DMA
+    if (spiIsDMABusy(instance)) {
+        return true;
+    }
+#endif
+
     return (LL_SPI_GetTxFIFOLevel(instance) != LL_SPI_TX_FIFO_EMPTY) || LL_SPI_IsActiveFlag_BSY(instance);
 }
 
@@ -296,6 +311,132 @@ bool spiTransfer(SPI_TypeDef *instance, uint8_t *rxData, const uint8_t *txData,
     return true;
 }
 
+#ifdef USE_SPI_DMA
+static bool spiInitTxDMA(SPIDevice device)
+{
+    spiDevice_t *spi = &spiHardwareMap[device];
+    DMA_t dma = dmaGetByTag(spi->txDMATag);
+
+    // Streams are shared with timers and UARTs, leave the bus to transfer byte-by-byte if it's taken
+    if (!dma || dmaGetOwner(dma) != OWNER_FREE) {
+        spi->txDMATag = DMA_NONE;
+        return false;
+    }
+
+    // No interrupt, the end of the transfer is polled by spiIsDMABusy()
+    dmaInit(dma, OWNER_SPI, RESOURCE_INDEX(device));
+
+    const uint32_t streamLL = DMATAG_GET_STREAM(spi->txDMATag);
+    LL_DMA_InitTypeDef init;
+
+    LL_DMA_DisableStream(dma->dma, streamLL);
+    LL_DMA_DeInit(dma->dma, streamLL);
+
+    LL_DMA_StructInit(&init);
+    init.Channel = dmaGetChannelByTag(spi->txDMATag);
+    init.PeriphOrM2MSrcAddress = (uint32_t)&spi->dev->DR;
+    init.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+    init.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_BYTE;
+    init.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+    init.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_BYTE;
+    init.NbData = 1;
+    init.Direction = LL_DMA_DIRECTION_MEMORY_TO_PERIPH;
+    init.Mode = LL_DMA_MODE_NORMAL;
+    init.Priority = LL_DMA_PRIORITY_MEDIUM;
+    init.FIFOMode = LL_DMA_FIFOMODE_DISABLE;
+    LL_DMA_Init(dma->dma, streamLL, &init);
+
+    spi->txDMA = dma;
+    return true;
+}
+
+/**
+ * Returns true if the bus can transmit by DMA, its stream is claimed on the first call.
+ */
+bool spiHasTxDMA(SPI_TypeDef *instance)
+{
+    SPIDevice device = spiDeviceByInstance(instance);
+    if (device == SPIINVALID) {
+        return false;
+    }
+
+    spiDevice_t *spi = &spiHardwareMap[device];
+    return spi->txDMA || (spi->txDMATag != DMA_NONE && spiInitTxDMA(device));
+}
+
+/**
+ * Start transmitting `len` bytes by DMA, the bytes received are discarded. The data must stay unchanged until the
+ * callback is called, from the first spiIsDMABusy() call that finds the transfer completed.
+ *
+ * Returns false, without sending anything, if the bus has no DMA stream.
+ */
+bool spiTransmitDMA(SPI_TypeDef *instance, const uint8_t *txData, int len, spiDMACallbackPtr callback, uint32_t callbackParam)
+{
+    if (len <= 0 || !spiHasTxDMA(instance)) {
+        return false;
+    }
+
+    spiDevice_t *spi = &spiHardwareMap[spiDeviceByInstance(instance)];
+
+    // Let the bytes of a previous transfer leave the bus
+    while (spiIsBusBusy(instance)) {
+    }
+
+    const uint32_t streamLL = DMATAG_GET_STREAM(spi->txDMATag);
+
+    spi->txDMACallback = callback;
+    spi->txDMACallbackParam = callbackParam;
+    spi->txDMABusy = true;
+
+    DMA_CLEAR_FLAG(spi->txDMA, DMA_IT_TCIF | DMA_IT_HTIF | DMA_IT_TEIF | DMA_IT_DMEIF | DMA_IT_FEIF);
+    LL_DMA_SetMemoryAddress(spi->txDMA->dma, streamLL, (uint32_t)txData);
+    LL_DMA_SetDataLength(spi->txDMA->dma, streamLL, len);
+    LL_DMA_EnableStream(spi->txDMA->dma, streamLL);
+    LL_SPI_EnableDMAReq_TX(instance);
+
+    return true;
+}
+
+// Wrap up a DMA transmit once its last byte is out, returns false while it's still going
+static bool spiFinishTxDMA(spiDevice_t *spi)
+{
+    // The stream stops as the last byte enters the TX FIFO, it still has to be shifted out
+    if (LL_DMA_IsEnabledStream(spi->txDMA->dma, DMATAG_GET_STREAM(spi->txDMATag))
+        || LL_SPI_GetTxFIFOLevel(spi->dev) != LL_SPI_TX_FIFO_EMPTY || LL_SPI_IsActiveFlag_BSY(spi->dev)) {
+        return false;
+    }
+
+    LL_SPI_DisableDMAReq_TX(spi->dev);
+
+    // The bytes received meanwhile were never read, drop them and clear the overrun they caused
+    while (LL_SPI_GetRxFIFOLevel(spi->dev) != LL_SPI_RX_FIFO_EMPTY) {
+        LL_SPI_ReceiveData8(spi->dev);
+    }
+    LL_SPI_ClearFlag_OVR(spi->dev);
+
+    spi->txDMABusy = false;
+    if (spi->txDMACallback) {
+        spi->txDMACallback(spi->txDMACallbackParam);
+    }
+    return true;
+}
+
+/**
+ * Return true while a DMA transmit is running. Completion is polled rather than handled in an interrupt, so the
+ * transfer is finished, and its callback called, from the task that finds it done.
+ */
+bool spiIsDMABusy(SPI_TypeDef *instance)
+{
+    SPIDevice device = spiDeviceByInstance(instance);
+    if (device == SPIINVALID) {
+        return false;
+    }
+
+    spiDevice_t *spi = &spiHardwareMap[device];
+    return spi->txDMABusy && !spiFinishTxDMA(spi);
+}
+#endif
+
 void spiSetSpeed(SPI_TypeDef *instance, SPIClockSpeed_e speed)
 {
     SPIDevice device = spiDeviceByInstance(instance);
@@ -27,6 +27,8 @@
 #include "drivers/bus.h"
 #include "drivers/time.h"
 
+#include "common/utils.h"
+
 #define M25P16_INSTRUCTION_RDID             0x9F
 #define M25P16_INSTRUCTION_READ_BYTES       0x03
 #define M25P16_INSTRUCTION_READ_STATUS_REG  0x05
@@ -108,6 +110,13 @@ static uint8_t m25p16_readStatus(void)
 
 bool m25p16_isReady(void)
 {
+#ifdef USE_SPI_DMA
+    // The data of a page program may still be on its way to the chip
+    if (couldBeBusy && busIsBusy(busDev)) {
+        return false;
+    }
+#endif
+
     // If couldBeBusy is false, don't bother to poll the flash chip for its status
     couldBeBusy = couldBeBusy && ((m25p16_readStatus() & M25P16_STATUS_FLAG_WRITE_IN_PROGRESS) != 0);
 
@@ -268,22 +277,7 @@ void m25p16_eraseCompletely(void)
     m25p16_performOneByteCommand(M25P16_INSTRUCTION_BULK_ERASE);
 }
 
-/**
- * Write bytes to a flash page. Address must not cross a page boundary.
- *
- * Bits can only be set to zero, not from zero back to one again. In order to set bits to 1, use the erase command.
- *
- * Length must be smaller than the page size.
- *
- * This will wait for the flash to become ready before writing begins.
- *
- * Datasheet indicates typical programming time is 0.8ms for 256 bytes, 0.2ms for 64 bytes, 0.05ms for 16 bytes.
- * (Although the maximum possible write time is noted as 5ms).
- *
- * If you want to write multiple buffers (whose sum of sizes is still not more than the page size) then you can
- * break this operation up into one beginProgram call, one or more continueProgram calls, and one finishProgram call.
- */
-uint32_t m25p16_pageProgram(uint32_t address, const uint8_t *data, int length)
+static uint32_t m25p16_program(uint32_t address, const uint8_t *data, int length, bool async)
 {
     uint8_t command[5] = { M25P16_INSTRUCTION_PAGE_PROGRAM };
 
@@ -298,11 +292,46 @@ uint32_t m25p16_pageProgram(uint32_t address, const uint8_t *data, int length)
 
     m25p16_writeEnable();
 
+#ifdef USE_SPI_DMA
+    // Without a DMA stream the page is programmed right away instead
+    if (async && busTransmitDMA(busDev, txn[0].txBuf, txn[0].length, data, length)) {
+        return address + length;
+    }
+#else
+    UNUSED(async);
+#endif
+
     busTransferMultiple(busDev, txn, 2);
 
     return address + length;
 }
 
+/**
+ * Write bytes to a flash page. Address must not cross a page boundary.
+ *
+ * Bits can only be set to zero, not from zero back to one again. In order to set bits to 1, use the erase command.
+ *
+ * Length must be smaller than the page size.
+ *
+ * This will wait for the flash to become ready before writing begins.
+ *
+ * Datasheet indicates typical programming time is 0.8ms for 256 bytes, 0.2ms for 64 bytes, 0.05ms for 16 bytes.
+ * (Although the maximum possible write time is noted as 5ms).
+ */
+uint32_t m25p16_pageProgram(uint32_t address, const uint8_t *data, int length)
+{
+    return m25p16_program(address, data, length, false);
+}
+
+/**
+ * As m25p16_pageProgram(), but where the SPI bus has DMA the data is sent in the background and this returns as soon
+ * as the transfer has started. The data must be left unchanged until m25p16_isReady() returns true.
+ */
+uint32_t m25p16_pageProgramAsync(uint32_t address, const uint8_t *data, int length)
+{
+    return m25p16_program(address, data, length, true);
+}
+
 /**
  * Read `length` bytes into the provided `buffer` from the flash starting from the given `address` (which need not lie
  * on a page boundary).
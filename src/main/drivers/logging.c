@@ -60,6 +60,14 @@ static const char *     eventDescription[BOOT_EVENT_CODE_COUNT] = {
     [BOOT_EVENT_1WIRE_DETECTION]            = "1WIRE_DETECTION",
     [BOOT_EVENT_HARDWARE_IO_CONFLICT]       = "HARDWARE_CONFLICT",
     [BOOT_EVENT_OPFLOW_DETECTION]           = "OPFLOW_DETECTION",
+    [BOOT_EVENT_EEPROM_LOAD]                = "EEPROM_LOAD",
+    [BOOT_EVENT_SERIAL_INIT]                = "SERIAL_INIT",
+    [BOOT_EVENT_PWM_INIT]                   = "PWM_INIT",
+    [BOOT_EVENT_BUS_INIT]                   = "BUS_INIT",
+    [BOOT_EVENT_STORAGE_INIT]               = "STORAGE_INIT",
+    [BOOT_EVENT_SENSOR_POWER_UP_WAIT]       = "SENSOR_POWER_UP_WAIT",
+    [BOOT_EVENT_SENSORS_AUTODETECT]         = "SENSORS_AUTODETECT",
+    [BOOT_EVENT_OSD_INIT]                   = "OSD_INIT",
 };
 
 const char * getBootlogEventDescription(bootLogEventCode_e eventCode)
@@ -137,6 +145,24 @@ void addBootlogEvent6(bootLogEventCode_e eventCode, uint16_t eventFlags, uint16_
     event.params.u16[3] = param4;
     addBootlogEntry(&event);
 }
+
+void addBootlogPhaseBegin(bootLogEventCode_e eventCode)
+{
+    addBootlogEvent4(eventCode, BOOT_EVENT_FLAGS_PHASE_BEGIN, micros(), 0);
+}
+
+void addBootlogPhaseEnd(bootLogEventCode_e eventCode)
+{
+    const timeUs_t now = micros();
+
+    for (int idx = eventCount - 1; idx >= 0; idx--) {
+        if (events[idx].eventCode == eventCode && (events[idx].eventFlags & BOOT_EVENT_FLAGS_PHASE_BEGIN)) {
+            const timeUs_t start = events[idx].params.u32[0];
+            addBootlogEvent4(eventCode, BOOT_EVENT_FLAGS_PHASE_END, start, now - start);
+            return;
+        }
+    }
+}
 #else
 const char * getBootlogEventDescription(bootLogEventCode_e eventCode) {UNUSED(eventCode);return NULL;}
 void initBootlog(void) {}
@@ -148,4 +174,6 @@ void addBootlogEvent4(bootLogEventCode_e eventCode, uint16_t eventFlags, uint32_
     {UNUSED(eventCode);UNUSED(eventFlags);UNUSED(param1);UNUSED(param2);}
 void addBootlogEvent6(bootLogEventCode_e eventCode, uint16_t eventFlags, uint16_t param1, uint16_t param2, uint16_t param3, uint16_t param4)
     {UNUSED(eventCode);UNUSED(eventFlags);UNUSED(param1);UNUSED(param2);UNUSED(param3);UNUSED(param4);}
+void addBootlogPhaseBegin(bootLogEventCode_e eventCode) {UNUSED(eventCode);}
+void addBootlogPhaseEnd(bootLogEventCode_e eventCode) {UNUSED(eventCode);}
 #endif
@@ -36,3 +36,6 @@ const char * getBootlogEventDescription(bootLogEventCode_e eventCode);
 void addBootlogEvent2(bootLogEventCode_e eventCode, bootLogFlags_e eventFlags);
 void addBootlogEvent4(bootLogEventCode_e eventCode, bootLogFlags_e eventFlags, uint32_t param1, uint32_t param2);
 void addBootlogEvent6(bootLogEventCode_e eventCode, bootLogFlags_e eventFlags, uint16_t param1, uint16_t param2, uint16_t param3, uint16_t param4);
+// Phases are a begin/end pair of events with the same code, the end event records the duration
+void addBootlogPhaseBegin(bootLogEventCode_e eventCode);
+void addBootlogPhaseEnd(bootLogEventCode_e eventCode);
@@ -21,6 +21,8 @@ typedef enum {
     BOOT_EVENT_FLAGS_NONE           = 0,
     BOOT_EVENT_FLAGS_WARNING        = 1 << 0,
     BOOT_EVENT_FLAGS_ERROR          = 1 << 1,
+    BOOT_EVENT_FLAGS_PHASE_BEGIN    = 1 << 2,   // param #1 - start time (us)
+    BOOT_EVENT_FLAGS_PHASE_END      = 1 << 3,   // param #1 - start time (us), #2 - duration (us)
 
     BOOT_EVENT_FLAGS_PARAM16        = 1 << 14,
     BOOT_EVENT_FLAGS_PARAM32        = 1 << 15
@@ -52,6 +54,14 @@ typedef enum {
     BOOT_EVENT_1WIRE_DETECTION          = 22,
     BOOT_EVENT_HARDWARE_IO_CONFLICT     = 23,   // Hardware IO resource conflict, parameters: #1 - current owner, #2 - requested owner
     BOOT_EVENT_OPFLOW_DETECTION         = 24,
+    BOOT_EVENT_EEPROM_LOAD              = 25,
+    BOOT_EVENT_SERIAL_INIT              = 26,
+    BOOT_EVENT_PWM_INIT                 = 27,
+    BOOT_EVENT_BUS_INIT                 = 28,
+    BOOT_EVENT_STORAGE_INIT             = 29,
+    BOOT_EVENT_SENSOR_POWER_UP_WAIT     = 30,
+    BOOT_EVENT_SENSORS_AUTODETECT       = 31,
+    BOOT_EVENT_OSD_INIT                 = 32,
 
     BOOT_EVENT_CODE_COUNT
 } bootLogEventCode_e;
@@ -585,6 +585,11 @@ void max7456Update(void)
         return;
     }
 
+    // Leave the bus to a running DMA transfer, redraw on the next call
+    if (busIsBusy(state.dev)) {
+        return;
+    }
+
     if ((max7456OSDIsEnabled() && max7456TryLock()) || !state.isInitialized) {
         // (Re)Initialize MAX7456 at startup or stall is detected.
         max7456StallCheck();
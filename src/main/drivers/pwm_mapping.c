@@ -251,5 +251,7 @@ pwmIOConfiguration_t *pwmInit(drv_pwm_config_t *init)
         pwmIOConfiguration.ioCount++;
     }
 
+    pwmCompleteMotorConfig(pwmIOConfiguration.motorCount);
+
     return &pwmIOConfiguration;
 }
@@ -53,6 +53,25 @@
 #define DSHOT_MOTOR_BITLENGTH   19
 
 #define DSHOT_DMA_BUFFER_SIZE   18 /* resolution + frame reset (2us) */
+
+#define DSHOT_COMMAND_QUEUE_SIZE        8
+#define DSHOT_COMMAND_REPEATS           10      // Configuration commands are only accepted by ESC after 6+ repetitions
+#define DSHOT_COMMAND_DELAY_US          1000    // Regular frames sent after a command before the next one
+#define DSHOT_BEACON_DELAY_US           260000  // ESC beacon tone duration
+
+#ifdef USE_DSHOT_DMAR
+#define MAX_DMA_TIMERS          8
+
+// All DSHOT motors of one timer are driven by a single DMA burst to TIMx->DMAR.
+// Buffer is interleaved: for each DSHOT bit it holds CCRx values for channels [firstChannelIndex .. firstChannelIndex + channelCount - 1]
+typedef struct {
+    TCH_t * tch;                    // Any channel of the timer, used as a handle for burst operations
+    uint8_t channelMask;
+    uint8_t firstChannelIndex;
+    uint8_t channelCount;
+    uint32_t dmaBurstBuffer[DSHOT_DMA_BUFFER_SIZE * CC_CHANNELS_PER_TIMER] __attribute__ ((aligned (4)));
+} burstDmaTimer_t;
+#endif
 #endif
 
 typedef void (*pwmWriteFuncPtr)(uint8_t index, uint16_t value);  // function pointer used to write motors
@@ -71,6 +90,9 @@ typedef struct {
 #ifdef USE_DSHOT
     // DSHOT parameters
     uint32_t dmaBuffer[DSHOT_DMA_BUFFER_SIZE] __attribute__ ((aligned (4)));
+#ifdef USE_DSHOT_DMAR
+    burstDmaTimer_t * burstDmaTimer;    // If not NULL - motor is updated via timer burst DMA instead of dmaBuffer
+#endif
 #endif
 } pwmOutputPort_t;
 
@@ -84,6 +106,22 @@ static pwmOutputPort_t *servos[MAX_PWM_SERVOS];
 static bool isProtocolDshot = false;
 static timeUs_t dshotMotorUpdateIntervalUs = 0;
 static timeUs_t dshotMotorLastUpdateUs;
+
+typedef struct {
+    uint8_t motorIndex;     // Motor index or DSHOT_CMD_ALL_MOTORS
+    uint8_t command;
+} dshotCommandRequest_t;
+
+static dshotCommandRequest_t dshotCommandQueue[DSHOT_COMMAND_QUEUE_SIZE];
+static uint8_t dshotCommandQueueHead = 0;
+static uint8_t dshotCommandQueueTail = 0;
+static uint8_t dshotCommandRepeatsLeft = 0;     // Repetitions left for the command at queue head, 0 if not started yet
+static timeUs_t dshotCommandNextUs = 0;
+
+#ifdef USE_DSHOT_DMAR
+static burstDmaTimer_t burstDmaTimers[MAX_DMA_TIMERS];
+static uint8_t burstDmaTimersCount = 0;
+#endif
 #endif
 
 #ifdef BEEPER_PWM
@@ -210,6 +248,58 @@ uint32_t getDshotHz(motorPwmProtocolTypes_e pwmProtocolType)
     }
 }
 
+#ifdef USE_DSHOT_DMAR
+static burstDmaTimer_t * motorConfigDshotBurst(pwmOutputPort_t * port)
+{
+    burstDmaTimer_t * burstDmaTimer = NULL;
+
+    // Reuse burst descriptor if another motor already lives on the same timer
+    for (int i = 0; i < burstDmaTimersCount; i++) {
+        if (burstDmaTimers[i].tch->timCtx == port->tch->timCtx) {
+            burstDmaTimer = &burstDmaTimers[i];
+            break;
+        }
+    }
+
+    if (burstDmaTimer == NULL) {
+        if (burstDmaTimersCount >= MAX_DMA_TIMERS) {
+            return NULL;
+        }
+
+        burstDmaTimer = &burstDmaTimers[burstDmaTimersCount];
+        burstDmaTimer->tch = port->tch;
+        burstDmaTimer->channelMask = 0;
+    }
+
+    if (!timerPWMConfigDMABurst(port->tch, burstDmaTimer->dmaBurstBuffer, DSHOT_DMA_BUFFER_SIZE * CC_CHANNELS_PER_TIMER)) {
+        return NULL;
+    }
+
+    if (burstDmaTimer == &burstDmaTimers[burstDmaTimersCount]) {
+        burstDmaTimersCount++;
+    }
+
+    // Burst covers the CCRx range of the motor channels of this timer, pwmCompleteMotorConfig() makes sure it has no gaps
+    burstDmaTimer->channelMask |= 1 << port->tch->timHw->channelIndex;
+    burstDmaTimer->firstChannelIndex = __builtin_ctz(burstDmaTimer->channelMask);
+    burstDmaTimer->channelCount = 32 - __builtin_clz(burstDmaTimer->channelMask) - burstDmaTimer->firstChannelIndex;
+
+    memset(burstDmaTimer->dmaBurstBuffer, 0, sizeof(burstDmaTimer->dmaBurstBuffer));
+
+    return burstDmaTimer;
+}
+#endif
+
+static void motorConfigDshotDMA(pwmOutputPort_t * port)
+{
+    // Configure timer DMA
+    if (timerPWMConfigChannelDMA(port->tch, port->dmaBuffer, DSHOT_DMA_BUFFER_SIZE)) {
+        // Only mark as DSHOT channel if DMA was set successfully
+        memset(port->dmaBuffer, 0, sizeof(port->dmaBuffer));
+        port->configured = true;
+    }
+}
+
 static pwmOutputPort_t * motorConfigDshot(const timerHardware_t * timerHardware, motorPwmProtocolTypes_e proto, uint16_t motorPwmRateHz, bool enableOutput)
 {
     // Try allocating new port
@@ -223,12 +313,11 @@ static pwmOutputPort_t * motorConfigDshot(const timerHardware_t * timerHardware,
     const timeUs_t motorIntervalUs = 1000000 / motorPwmRateHz;
     dshotMotorUpdateIntervalUs = MAX(dshotMotorUpdateIntervalUs, motorIntervalUs);
 
-    // Configure timer DMA
-    if (timerPWMConfigChannelDMA(port->tch, port->dmaBuffer, DSHOT_DMA_BUFFER_SIZE)) {
-        // Only mark as DSHOT channel if DMA was set successfully
-        memset(port->dmaBuffer, 0, sizeof(port->dmaBuffer));
-        port->configured = true;
-    }
+#ifdef USE_DSHOT_DMAR
+    // DMA is set up by pwmCompleteMotorConfig() once it's known which motors share a timer
+#else
+    motorConfigDshotDMA(port);
+#endif
 
     return port;
 }
@@ -239,10 +328,10 @@ static void pwmWriteDshot(uint8_t index, uint16_t value)
     motors[index]->value = value;
 }
 
-static void loadDmaBufferDshot(uint32_t * dmaBuffer, uint16_t packet)
+static void loadDmaBufferDshot(uint32_t * dmaBuffer, int stride, uint16_t packet)
 {
     for (int i = 0; i < 16; i++) {
-        dmaBuffer[i] = (packet & 0x8000) ? DSHOT_MOTOR_BIT_1 : DSHOT_MOTOR_BIT_0;  // MSB first
+        dmaBuffer[i * stride] = (packet & 0x8000) ? DSHOT_MOTOR_BIT_1 : DSHOT_MOTOR_BIT_0;  // MSB first
         packet <<= 1;
     }
 }
@@ -266,6 +355,85 @@ static uint16_t prepareDshotPacket(const uint16_t value, bool requestTelemetry)
     return packet;
 }
 
+static uint8_t dshotCommandRepeatCount(uint8_t command)
+{
+    // Beacons and stop are executed immediately, everything else needs repetitions to be accepted
+    return (command <= DSHOT_CMD_BEACON5) ? 1 : DSHOT_COMMAND_REPEATS;
+}
+
+static timeUs_t dshotCommandDelayUs(uint8_t command)
+{
+    return (command >= DSHOT_CMD_BEACON1 && command <= DSHOT_CMD_BEACON5) ? DSHOT_BEACON_DELAY_US : DSHOT_COMMAND_DELAY_US;
+}
+
+bool pwmIsDshotCommandQueueEmpty(void)
+{
+    return dshotCommandQueueHead == dshotCommandQueueTail;
+}
+
+// Queues either all of the commands or, if any of them is invalid or they don't fit, none
+bool pwmRequestDshotCommands(uint8_t motorIndex, const uint8_t *commands, int count)
+{
+    const uint8_t queued = (dshotCommandQueueTail + DSHOT_COMMAND_QUEUE_SIZE - dshotCommandQueueHead) % DSHOT_COMMAND_QUEUE_SIZE;
+
+    if (!isProtocolDshot || ARMING_FLAG(ARMED) || count <= 0 || queued + count >= DSHOT_COMMAND_QUEUE_SIZE) {
+        return false;
+    }
+
+    if (motorIndex != DSHOT_CMD_ALL_MOTORS && (motorIndex >= MAX_PWM_MOTORS || !motors[motorIndex])) {
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (commands[i] > DSHOT_CMD_MAX) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        dshotCommandQueue[dshotCommandQueueTail].motorIndex = motorIndex;
+        dshotCommandQueue[dshotCommandQueueTail].command = commands[i];
+        dshotCommandQueueTail = (dshotCommandQueueTail + 1) % DSHOT_COMMAND_QUEUE_SIZE;
+    }
+
+    return true;
+}
+
+/*
+ * Picks the command to be sent in the current DSHOT frame (if any). Commands are repeated in consecutive
+ * frames, then regular throttle frames are sent for a command-specific delay before the next queued command.
+ */
+static bool dshotCommandProcess(timeUs_t currentTimeUs, dshotCommandRequest_t * request)
+{
+    if (pwmIsDshotCommandQueueEmpty()) {
+        return false;
+    }
+
+    // Never interfere with motor output when armed - drop whatever is left
+    if (ARMING_FLAG(ARMED)) {
+        dshotCommandQueueHead = dshotCommandQueueTail;
+        dshotCommandRepeatsLeft = 0;
+        return false;
+    }
+
+    if (cmpTimeUs(currentTimeUs, dshotCommandNextUs) < 0) {
+        return false;
+    }
+
+    *request = dshotCommandQueue[dshotCommandQueueHead];
+
+    if (dshotCommandRepeatsLeft == 0) {
+        dshotCommandRepeatsLeft = dshotCommandRepeatCount(request->command);
+    }
+
+    if (--dshotCommandRepeatsLeft == 0) {
+        dshotCommandQueueHead = (dshotCommandQueueHead + 1) % DSHOT_COMMAND_QUEUE_SIZE;
+        dshotCommandNextUs = currentTimeUs + dshotCommandDelayUs(request->command);
+    }
+
+    return true;
+}
+
 void pwmCompleteDshotUpdate(uint8_t motorCount)
 {
     // Get latest REAL time
@@ -278,20 +446,53 @@ void pwmCompleteDshotUpdate(uint8_t motorCount)
 
     dshotMotorLastUpdateUs = currentTimeUs;
 
+    dshotCommandRequest_t commandRequest;
+    const bool commandPending = dshotCommandProcess(currentTimeUs, &commandRequest);
+
     // Generate DMA buffers
     for (int index = 0; index < motorCount; index++) {
         if (motors[index] && motors[index]->configured) {
-            // TODO: ESC telemetry
-            uint16_t packet = prepareDshotPacket(motors[index]->value, false);
+            uint16_t packet;
+
+            if (commandPending && (commandRequest.motorIndex == DSHOT_CMD_ALL_MOTORS || commandRequest.motorIndex == index)) {
+                // Special commands are only executed by ESC if telemetry bit is set
+                packet = prepareDshotPacket(commandRequest.command, true);
+            }
+            else {
+                // TODO: ESC telemetry
+                packet = prepareDshotPacket(motors[index]->value, false);
+            }
+
+#ifdef USE_DSHOT_DMAR
+            burstDmaTimer_t * burstDmaTimer = motors[index]->burstDmaTimer;
+            if (burstDmaTimer) {
+                const int channelOffset = motors[index]->tch->timHw->channelIndex - burstDmaTimer->firstChannelIndex;
+                loadDmaBufferDshot(&burstDmaTimer->dmaBurstBuffer[channelOffset], burstDmaTimer->channelCount, packet);
+                continue;
+            }
+#endif
 
-            loadDmaBufferDshot(motors[index]->dmaBuffer, packet);
+            loadDmaBufferDshot(motors[index]->dmaBuffer, 1, packet);
             timerPWMPrepareDMA(motors[index]->tch, DSHOT_DMA_BUFFER_SIZE);
         }
     }
 
+#ifdef USE_DSHOT_DMAR
+    // Start one burst per timer
+    for (int i = 0; i < burstDmaTimersCount; i++) {
+        burstDmaTimer_t * burstDmaTimer = &burstDmaTimers[i];
+        timerPWMStartDMABurst(burstDmaTimer->tch, burstDmaTimer->firstChannelIndex, burstDmaTimer->channelCount, DSHOT_DMA_BUFFER_SIZE * burstDmaTimer->channelCount);
+    }
+#endif
+
     // Start DMA on all timers
     for (int index = 0; index < motorCount; index++) {
         if (motors[index] && motors[index]->configured) {
+#ifdef USE_DSHOT_DMAR
+            if (motors[index]->burstDmaTimer) {
+                continue;
+            }
+#endif
             timerPWMStartDMA(motors[index]->tch);
         }
     }
@@ -361,6 +562,49 @@ bool pwmMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, ui
     return false;
 }
 
+/*
+ * Called once all motors are configured. A timer driving two or more DSHOT motors gets a single DMA burst on its
+ * update stream, a timer with a single motor keeps the channel stream rather than taking a second one for nothing.
+ * The burst writes every CCRx between the first and the last motor channel, so a timer with another output (or an
+ * unused channel) in between keeps per-channel DMA too, rather than having that CCRx overwritten.
+ */
+void pwmCompleteMotorConfig(uint8_t motorCount)
+{
+#ifdef USE_DSHOT_DMAR
+    if (!isProtocolDshot) {
+        return;
+    }
+
+    for (int i = 0; i < motorCount; i++) {
+        pwmOutputPort_t * port = motors[i];
+        uint8_t motorChannelMask = 0;
+
+        for (int j = 0; j < motorCount; j++) {
+            if (motors[j]->tch->timCtx == port->tch->timCtx) {
+                motorChannelMask |= 1 << motors[j]->tch->timHw->channelIndex;
+            }
+        }
+
+        // Motor channels of the timer have to be contiguous, e.g. CH1-CH3 but not CH1, CH3
+        const uint8_t motorChannelSpan = motorChannelMask >> __builtin_ctz(motorChannelMask);
+        const bool isContiguous = (motorChannelSpan & (motorChannelSpan + 1)) == 0;
+
+        // Fall back to per-channel DMA if timer update DMA is not available
+        if (motorChannelSpan > 1 && isContiguous) {
+            port->burstDmaTimer = motorConfigDshotBurst(port);
+            if (port->burstDmaTimer) {
+                port->configured = true;
+                continue;
+            }
+        }
+
+        motorConfigDshotDMA(port);
+    }
+#else
+    UNUSED(motorCount);
+#endif
+}
+
 bool pwmServoConfig(const timerHardware_t *timerHardware, uint8_t servoIndex, uint16_t servoPwmRate, uint16_t servoCenterPulse, bool enableOutput)
 {
     pwmOutputPort_t * port = pwmOutConfigMotor(timerHardware, PWM_TIMER_HZ, PWM_TIMER_HZ / servoPwmRate, servoCenterPulse, enableOutput);
@@ -32,10 +32,34 @@ typedef enum {
     PWM_TYPE_DSHOT1200,
 } motorPwmProtocolTypes_e;
 
+// DSHOT special commands, sent in place of throttle value while motors are stopped
+typedef enum {
+    DSHOT_CMD_MOTOR_STOP = 0,
+    DSHOT_CMD_BEACON1,
+    DSHOT_CMD_BEACON2,
+    DSHOT_CMD_BEACON3,
+    DSHOT_CMD_BEACON4,
+    DSHOT_CMD_BEACON5,
+    DSHOT_CMD_ESC_INFO,
+    DSHOT_CMD_SPIN_DIRECTION_1,
+    DSHOT_CMD_SPIN_DIRECTION_2,
+    DSHOT_CMD_3D_MODE_OFF,
+    DSHOT_CMD_3D_MODE_ON,
+    DSHOT_CMD_SETTINGS_REQUEST,
+    DSHOT_CMD_SAVE_SETTINGS,
+    DSHOT_CMD_SPIN_DIRECTION_NORMAL = 20,
+    DSHOT_CMD_SPIN_DIRECTION_REVERSED = 21,
+    DSHOT_CMD_MAX = 47
+} dshotCommands_e;
+
+#define DSHOT_CMD_ALL_MOTORS    255
+
 void pwmWriteMotor(uint8_t index, uint16_t value);
 void pwmShutdownPulsesForAllMotors(uint8_t motorCount);
 void pwmCompleteDshotUpdate(uint8_t motorCount);
 bool isMotorProtocolDshot(void);
+bool pwmRequestDshotCommands(uint8_t motorIndex, const uint8_t *commands, int count);
+bool pwmIsDshotCommandQueueEmpty(void);
 
 void pwmWriteServo(uint8_t index, uint16_t value);
 
@@ -43,6 +67,7 @@ void pwmDisableMotors(void);
 void pwmEnableMotors(void);
 struct timerHardware_s;
 bool pwmMotorConfig(const struct timerHardware_s *timerHardware, uint8_t motorIndex, uint16_t motorPwmRate, motorPwmProtocolTypes_e proto, bool enableOutput);
+void pwmCompleteMotorConfig(uint8_t motorCount);
 bool pwmServoConfig(const struct timerHardware_s *timerHardware, uint8_t servoIndex, uint16_t servoPwmRate, uint16_t servoCenterPulse, bool enableOutput);
 void pwmWriteBeeper(bool onoffBeep);
 void beeperPwmInit(ioTag_t tag, uint16_t frequency);
\ No newline at end of file
@@ -299,16 +299,27 @@ static bool sdcardSpi_sendDataBlockFinish(void)
 
 /**
  * Begin sending a buffer of SDCARD_BLOCK_SIZE bytes to the SD card.
+ *
+ * Returns the number of chunks sent, all of them if the block went to DMA.
  */
-static void sdcardSpi_sendDataBlockBegin(uint8_t *buffer, bool multiBlockWrite)
+static uint8_t sdcardSpi_sendDataBlockBegin(uint8_t *buffer, bool multiBlockWrite)
 {
     uint8_t blockStartToken[2] = { 0xFF, multiBlockWrite ? SDCARD_MULTIPLE_BLOCK_WRITE_START_TOKEN : SDCARD_SINGLE_BLOCK_WRITE_START_TOKEN };
 
     // Card wants 8 dummy clock cycles between the write command's response and a data block beginning:
+#ifdef USE_SPI_DMA
+    if (busTransmitDMA(sdcard.dev, blockStartToken, 2, buffer, SDCARD_BLOCK_SIZE)) {
+        return SDCARD_BLOCK_SIZE / SDCARD_BLOCK_CHUNK_SIZE;
+    }
+#endif
+
+    // Without a DMA stream the block goes a chunk at a time instead
     busTransfer(sdcard.dev, NULL, blockStartToken, 2);
 
     // Send the first chunk now
     busTransfer(sdcard.dev, NULL, buffer, SDCARD_BLOCK_CHUNK_SIZE);
+
+    return 1;
 }
 
 static bool sdcardSpi_receiveCID(void)
@@ -537,10 +548,15 @@ static bool sdcardSpi_poll(void)
             // Have we finished sending the write yet?
             sendComplete = false;
 
-            // Send another chunk
-            busTransfer(sdcard.dev, NULL, sdcard.pendingOperation.buffer + SDCARD_BLOCK_CHUNK_SIZE * sdcard.pendingOperation.chunkIndex, SDCARD_BLOCK_CHUNK_SIZE);
-            sdcard.pendingOperation.chunkIndex++;
-            sendComplete = sdcard.pendingOperation.chunkIndex == SDCARD_BLOCK_SIZE / SDCARD_BLOCK_CHUNK_SIZE;
+            if (sdcard.pendingOperation.chunkIndex < SDCARD_BLOCK_SIZE / SDCARD_BLOCK_CHUNK_SIZE) {
+                // Send another chunk
+                busTransfer(sdcard.dev, NULL, sdcard.pendingOperation.buffer + SDCARD_BLOCK_CHUNK_SIZE * sdcard.pendingOperation.chunkIndex, SDCARD_BLOCK_CHUNK_SIZE);
+                sdcard.pendingOperation.chunkIndex++;
+                sendComplete = sdcard.pendingOperation.chunkIndex == SDCARD_BLOCK_SIZE / SDCARD_BLOCK_CHUNK_SIZE;
+            } else {
+                // The block is being sent by DMA, wait for it rather than stalling the bus
+                sendComplete = !busIsBusy(sdcard.dev);
+            }
 
             if (sendComplete) {
                 // Finish up by sending the CRC and checking the SD-card's acceptance/rejectance
@@ -714,13 +730,12 @@ static sdcardOperationStatus_e sdcardSpi_writeBlock(uint32_t blockIndex, uint8_t
             return SDCARD_OPERATION_BUSY;
     }
 
-    sdcardSpi_sendDataBlockBegin(buffer, sdcard.state == SDCARD_STATE_WRITING_MULTIPLE_BLOCKS);
+    sdcard.pendingOperation.chunkIndex = sdcardSpi_sendDataBlockBegin(buffer, sdcard.state == SDCARD_STATE_WRITING_MULTIPLE_BLOCKS);
 
     sdcard.pendingOperation.buffer = buffer;
     sdcard.pendingOperation.blockIndex = blockIndex;
     sdcard.pendingOperation.callback = callback;
     sdcard.pendingOperation.callbackData = callbackData;
-    sdcard.pendingOperation.chunkIndex = 1;
     sdcard.state = SDCARD_STATE_SENDING_WRITE;
 
     return SDCARD_OPERATION_IN_PROGRESS;
@@ -17,6 +17,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -44,7 +45,12 @@ void serialWrite(serialPort_t *instance, uint8_t ch)
 void serialWriteBuf(serialPort_t *instance, const uint8_t *data, int count)
 {
     if (instance->vTable->writeBuf) {
-        instance->vTable->writeBuf(instance, data, count);
+        // The port takes what fits, wait for room for the rest like the bytewise path below
+        while (count > 0) {
+            const int written = instance->vTable->writeBuf(instance, data, count);
+            data += written;
+            count -= written;
+        }
     } else {
         for (const uint8_t *p = data; count > 0; count--, p++) {
 
@@ -71,6 +77,59 @@ uint8_t serialRead(serialPort_t *instance)
     return instance->vTable->serialRead(instance);
 }
 
+uint32_t serialPeekRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    return instance->vTable->peekRxSpan(instance, data);
+}
+
+void serialConsumeRx(serialPort_t *instance, uint32_t count)
+{
+    instance->vTable->consumeRx(instance, count);
+}
+
+uint32_t serialReadBuf(serialPort_t *instance, uint8_t *data, uint32_t maxCount)
+{
+    uint32_t count = 0;
+
+    // A ring buffer holds at most two spans, keep going until it runs dry or the destination is full
+    while (count < maxCount) {
+        const uint8_t *span;
+        uint32_t spanSize = serialPeekRxSpan(instance, &span);
+
+        if (spanSize == 0) {
+            break;
+        }
+
+        if (spanSize > maxCount - count) {
+            spanSize = maxCount - count;
+        }
+
+        memcpy(data + count, span, spanSize);
+        serialConsumeRx(instance, spanSize);
+        count += spanSize;
+    }
+
+    return count;
+}
+
+uint32_t serialRxRingSpan(const serialPort_t *instance, uint32_t rxBufferHead, const uint8_t **data)
+{
+    *data = (const uint8_t *)&instance->rxBuffer[instance->rxBufferTail];
+
+    if (rxBufferHead >= instance->rxBufferTail) {
+        return rxBufferHead - instance->rxBufferTail;
+    } else {
+        // Wrapped data is returned by the next call, after this span is consumed
+        return instance->rxBufferSize - instance->rxBufferTail;
+    }
+}
+
+void serialRxRingConsume(serialPort_t *instance, uint32_t count)
+{
+    const uint32_t rxBufferTail = instance->rxBufferTail + count;
+    instance->rxBufferTail = (rxBufferTail >= instance->rxBufferSize) ? rxBufferTail - instance->rxBufferSize : rxBufferTail;
+}
+
 void serialSetBaudRate(serialPort_t *instance, uint32_t baudRate)
 {
     instance->vTable->serialSetBaudRate(instance, baudRate);
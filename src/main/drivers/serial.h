@@ -78,6 +78,10 @@ struct serialPortVTable {
 
     uint8_t (*serialRead)(serialPort_t *instance);
 
+    // Bulk receive: expose received bytes contiguous in memory without copying, consume them once parsed.
+    uint32_t (*peekRxSpan)(serialPort_t *instance, const uint8_t **data);
+    void (*consumeRx)(serialPort_t *instance, uint32_t count);
+
     // Specified baud rate may not be allowed by an implementation, use serialGetBaudRate to determine actual baud rate in use.
     void (*serialSetBaudRate)(serialPort_t *instance, uint32_t baudRate);
 
@@ -85,7 +89,8 @@ struct serialPortVTable {
 
     void (*setMode)(serialPort_t *instance, portMode_t mode);
 
-    void (*writeBuf)(serialPort_t *instance, const void *data, int count);
+    // Returns the number of bytes taken, fewer than count if the port can't take them without waiting
+    int (*writeBuf)(serialPort_t *instance, const void *data, int count);
 
     bool (*isConnected)(const serialPort_t *instance);
 
@@ -99,6 +104,9 @@ uint32_t serialRxBytesWaiting(const serialPort_t *instance);
 uint32_t serialTxBytesFree(const serialPort_t *instance);
 void serialWriteBuf(serialPort_t *instance, const uint8_t *data, int count);
 uint8_t serialRead(serialPort_t *instance);
+uint32_t serialPeekRxSpan(serialPort_t *instance, const uint8_t **data);
+void serialConsumeRx(serialPort_t *instance, uint32_t count);
+uint32_t serialReadBuf(serialPort_t *instance, uint8_t *data, uint32_t maxCount);
 void serialSetBaudRate(serialPort_t *instance, uint32_t baudRate);
 void serialSetMode(serialPort_t *instance, portMode_t mode);
 bool isSerialTransmitBufferEmpty(const serialPort_t *instance);
@@ -106,6 +114,10 @@ void serialPrint(serialPort_t *instance, const char *str);
 uint32_t serialGetBaudRate(serialPort_t *instance);
 bool serialIsConnected(const serialPort_t *instance);
 
+// Helpers for drivers receiving into the serialPort_t rx ring buffer
+uint32_t serialRxRingSpan(const serialPort_t *instance, uint32_t rxBufferHead, const uint8_t **data);
+void serialRxRingConsume(serialPort_t *instance, uint32_t count);
+
 // A shim that adapts the bufWriter API to the serialWriteBuf() API.
 void serialWriteBufShim(void *instance, const uint8_t *data, int count);
 void serialBeginWrite(serialPort_t *instance);
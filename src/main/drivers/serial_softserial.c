@@ -588,6 +588,20 @@ uint8_t softSerialReadByte(serialPort_t *instance)
     return ch;
 }
 
+uint32_t softSerialPeekRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    if ((instance->mode & MODE_RX) == 0) {
+        return 0;
+    }
+
+    return serialRxRingSpan(instance, instance->rxBufferHead, data);
+}
+
+void softSerialConsumeRx(serialPort_t *instance, uint32_t count)
+{
+    serialRxRingConsume(instance, count);
+}
+
 void softSerialWriteByte(serialPort_t *s, uint8_t ch)
 {
     if ((s->mode & MODE_TX) == 0) {
@@ -622,6 +636,8 @@ static const struct serialPortVTable softSerialVTable = {
     .serialTotalRxWaiting = softSerialRxBytesWaiting,
     .serialTotalTxFree = softSerialTxBytesFree,
     .serialRead = softSerialReadByte,
+    .peekRxSpan = softSerialPeekRxSpan,
+    .consumeRx = softSerialConsumeRx,
     .serialSetBaudRate = softSerialSetBaudRate,
     .isSerialTransmitBufferEmpty = isSoftSerialTransmitBufferEmpty,
     .setMode = softSerialSetMode,
@@ -31,5 +31,7 @@ void softSerialWriteByte(serialPort_t *instance, uint8_t ch);
 uint32_t softSerialRxBytesWaiting(const serialPort_t *instance);
 uint32_t softSerialTxBytesFree(const serialPort_t *instance);
 uint8_t softSerialReadByte(serialPort_t *instance);
+uint32_t softSerialPeekRxSpan(serialPort_t *instance, const uint8_t **data);
+void softSerialConsumeRx(serialPort_t *instance, uint32_t count);
 void softSerialSetBaudRate(serialPort_t *s, uint32_t baudRate);
 bool isSoftSerialTransmitBufferEmpty(const serialPort_t *s);
@@ -22,11 +22,13 @@
 */
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
 #include "build/build_config.h"
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "drivers/uart_inverter.h"
@@ -150,7 +152,7 @@ serialPort_t *uartOpen(USART_TypeDef *USARTx, serialReceiveCallbackPtr rxCallbac
     // common serial initialisation code should move to serialPort::init()
     s->port.rxBufferHead = s->port.rxBufferTail = 0;
     s->port.txBufferHead = s->port.txBufferTail = 0;
-    // callback works for IRQ-based RX ONLY
+    // callback works for IRQ-based and DMA RX
     s->port.rxCallback = rxCallback;
     s->port.rxCallbackData = rxCallbackData;
     s->port.mode = mode;
@@ -160,12 +162,27 @@ serialPort_t *uartOpen(USART_TypeDef *USARTx, serialReceiveCallbackPtr rxCallbac
     uartReconfigure(s);
 
     if (mode & MODE_RX) {
-        USART_ClearITPendingBit(s->USARTx, USART_IT_RXNE);
-        USART_ITConfig(s->USARTx, USART_IT_RXNE, ENABLE);
+#ifdef USE_UART_RX_DMA
+        if (s->rxDMA) {
+            uartStartRxDMA(s);
+        } else
+#endif
+        {
+            USART_ClearITPendingBit(s->USARTx, USART_IT_RXNE);
+            USART_ITConfig(s->USARTx, USART_IT_RXNE, ENABLE);
+        }
     }
 
     if (mode & MODE_TX) {
-        USART_ITConfig(s->USARTx, USART_IT_TXE, ENABLE);
+#ifdef USE_UART_TX_DMA
+        if (s->txDMA) {
+            s->txDMAEmpty = true;
+            USART_DMACmd(s->USARTx, USART_DMAReq_Tx, ENABLE);
+        } else
+#endif
+        {
+            USART_ITConfig(s->USARTx, USART_IT_TXE, ENABLE);
+        }
     }
 
     USART_Cmd(s->USARTx, ENABLE);
@@ -187,14 +204,26 @@ void uartSetMode(serialPort_t *instance, portMode_t mode)
     uartReconfigure(uartPort);
 }
 
+static uint32_t uartRxBufferHead(const uartPort_t *s)
+{
+#ifdef USE_UART_RX_DMA
+    // In DMA mode the write position is owned by the DMA controller
+    if (s->rxDMA) {
+        return uartRxDMAHead(s);
+    }
+#endif
+    return s->port.rxBufferHead;
+}
+
 uint32_t uartTotalRxBytesWaiting(const serialPort_t *instance)
 {
     const uartPort_t *s = (const uartPort_t*)instance;
+    const uint32_t rxBufferHead = uartRxBufferHead(s);
 
-    if (s->port.rxBufferHead >= s->port.rxBufferTail) {
-        return s->port.rxBufferHead - s->port.rxBufferTail;
+    if (rxBufferHead >= s->port.rxBufferTail) {
+        return rxBufferHead - s->port.rxBufferTail;
     } else {
-        return s->port.rxBufferSize + s->port.rxBufferHead - s->port.rxBufferTail;
+        return s->port.rxBufferSize + rxBufferHead - s->port.rxBufferTail;
     }
 }
 
@@ -210,12 +239,29 @@ uint32_t uartTotalTxBytesFree(const serialPort_t *instance)
         bytesUsed = s->port.txBufferSize + s->port.txBufferHead - s->port.txBufferTail;
     }
 
+#ifdef USE_UART_TX_DMA
+    if (s->txDMA) {
+        // Tail is advanced when a DMA segment is queued, bytes still being sent are not free yet
+        bytesUsed += uartTxDMABytesInFlight(s);
+
+        // Head may have caught up with the in-flight segment, never report more than a full buffer
+        if (bytesUsed >= s->port.txBufferSize - 1) {
+            return 0;
+        }
+    }
+#endif
+
     return (s->port.txBufferSize - 1) - bytesUsed;
 }
 
 bool isUartTransmitBufferEmpty(const serialPort_t *instance)
 {
     const uartPort_t *s = (const uartPort_t *)instance;
+#ifdef USE_UART_TX_DMA
+    if (s->txDMA) {
+        return s->txDMAEmpty;
+    }
+#endif
     return s->port.txBufferTail == s->port.txBufferHead;
 }
 
@@ -234,6 +280,28 @@ uint8_t uartRead(serialPort_t *instance)
     return ch;
 }
 
+uint32_t uartPeekRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    const uartPort_t *s = (const uartPort_t *)instance;
+    return serialRxRingSpan(instance, uartRxBufferHead(s), data);
+}
+
+void uartConsumeRx(serialPort_t *instance, uint32_t count)
+{
+    serialRxRingConsume(instance, count);
+}
+
+static void uartStartTx(uartPort_t *s)
+{
+#ifdef USE_UART_TX_DMA
+    if (s->txDMA) {
+        uartStartTxDMA(s);
+        return;
+    }
+#endif
+    USART_ITConfig(s->USARTx, USART_IT_TXE, ENABLE);
+}
+
 void uartWrite(serialPort_t *instance, uint8_t ch)
 {
     uartPort_t *s = (uartPort_t *)instance;
@@ -244,7 +312,39 @@ void uartWrite(serialPort_t *instance, uint8_t ch)
         s->port.txBufferHead++;
     }
 
-    USART_ITConfig(s->USARTx, USART_IT_TXE, ENABLE);
+    uartStartTx(s);
+}
+
+int uartWriteBuf(serialPort_t *instance, const void *data, int count)
+{
+    uartPort_t *s = (uartPort_t *)instance;
+    const uint8_t *p = data;
+
+    // Never wait for room, only take what fits
+    count = MIN(count, (int)uartTotalTxBytesFree(instance));
+    if (count <= 0) {
+        return 0;
+    }
+
+    const int written = count;
+    while (count > 0) {
+        // Copy up to the end of the ring, the next iteration continues from the start
+        const uint32_t chunk = MIN((uint32_t)count, s->port.txBufferSize - s->port.txBufferHead);
+        memcpy((void *)&s->port.txBuffer[s->port.txBufferHead], p, chunk);
+
+        if (s->port.txBufferHead + chunk >= s->port.txBufferSize) {
+            s->port.txBufferHead = 0;
+        } else {
+            s->port.txBufferHead += chunk;
+        }
+
+        p += chunk;
+        count -= chunk;
+    }
+
+    uartStartTx(s);
+
+    return written;
 }
 
 const struct serialPortVTable uartVTable[] = {
@@ -253,11 +353,13 @@ const struct serialPortVTable uartVTable[] = {
         .serialTotalRxWaiting = uartTotalRxBytesWaiting,
         .serialTotalTxFree = uartTotalTxBytesFree,
         .serialRead = uartRead,
+        .peekRxSpan = uartPeekRxSpan,
+        .consumeRx = uartConsumeRx,
         .serialSetBaudRate = uartSetBaudRate,
         .isSerialTransmitBufferEmpty = isUartTransmitBufferEmpty,
         .setMode = uartSetMode,
         .isConnected = NULL,
-        .writeBuf = NULL,
+        .writeBuf = uartWriteBuf,
         .beginWrite = NULL,
         .endWrite = NULL,
     }
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include "drivers/dma.h"
+
 // Since serial ports can be used for any function these buffer sizes should be equal
 // The two largest things that need to be sent are: 1, MSP responses, 2, UBLOX SVINFO packet.
 
@@ -59,14 +61,27 @@ typedef struct {
 #endif
 
     USART_TypeDef *USARTx;
+
+#ifdef USE_UART_RX_DMA
+    DMA_t rxDMA;                    // Circular RX DMA, NULL if port receives byte-by-byte from RXNE interrupt
+    uint32_t rxDMAChannel;
+#endif
+
+#ifdef USE_UART_TX_DMA
+    DMA_t txDMA;                    // TX DMA, NULL if port transmits byte-by-byte from TXE interrupt
+    volatile bool txDMAEmpty;
+#endif
 } uartPort_t;
 
 serialPort_t *uartOpen(USART_TypeDef *USARTx, serialReceiveCallbackPtr rxCallback, void *rxCallbackData, uint32_t baudRate, portMode_t mode, portOptions_t options);
 
 // serialPort API
 void uartWrite(serialPort_t *instance, uint8_t ch);
+int uartWriteBuf(serialPort_t *instance, const void *data, int count);
 uint32_t uartTotalRxBytesWaiting(const serialPort_t *instance);
 uint32_t uartTotalTxBytesFree(const serialPort_t *instance);
 uint8_t uartRead(serialPort_t *instance);
+uint32_t uartPeekRxSpan(serialPort_t *instance, const uint8_t **data);
+void uartConsumeRx(serialPort_t *instance, uint32_t count);
 void uartSetBaudRate(serialPort_t *s, uint32_t baudRate);
 bool isUartTransmitBufferEmpty(const serialPort_t *s);
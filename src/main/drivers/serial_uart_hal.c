@@ -233,6 +233,16 @@ uint8_t uartRead(serialPort_t *instance)
     return ch;
 }
 
+uint32_t uartPeekRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    return serialRxRingSpan(instance, instance->rxBufferHead, data);
+}
+
+void uartConsumeRx(serialPort_t *instance, uint32_t count)
+{
+    serialRxRingConsume(instance, count);
+}
+
 void uartWrite(serialPort_t *instance, uint8_t ch)
 {
     uartPort_t *s = (uartPort_t *)instance;
@@ -252,6 +262,8 @@ const struct serialPortVTable uartVTable[] = {
         .serialTotalRxWaiting = uartTotalRxBytesWaiting,
         .serialTotalTxFree = uartTotalTxBytesFree,
         .serialRead = uartRead,
+        .peekRxSpan = uartPeekRxSpan,
+        .consumeRx = uartConsumeRx,
         .serialSetBaudRate = uartSetBaudRate,
         .isSerialTransmitBufferEmpty = isUartTransmitBufferEmpty,
         .setMode = uartSetMode,
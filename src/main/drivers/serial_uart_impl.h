@@ -21,7 +21,15 @@
 
 extern const struct serialPortVTable uartVTable[];
 
+#ifdef USE_UART_TX_DMA
 void uartStartTxDMA(uartPort_t *s);
+uint32_t uartTxDMABytesInFlight(const uartPort_t *s);
+#endif
+
+#ifdef USE_UART_RX_DMA
+void uartStartRxDMA(uartPort_t *s);
+uint32_t uartRxDMAHead(const uartPort_t *s);
+#endif
 
 uartPort_t *serialUART1(uint32_t baudRate, portMode_t mode, portOptions_t options);
 uartPort_t *serialUART2(uint32_t baudRate, portMode_t mode, portOptions_t options);
@@ -20,8 +20,11 @@
 
 #include "platform.h"
 
+#include "build/atomic.h"
+
 #include "drivers/time.h"
 #include "drivers/io.h"
+#include "drivers/logging.h"
 #include "rcc.h"
 #include "drivers/nvic.h"
 
@@ -32,11 +35,72 @@
 #define UART_RX_BUFFER_SIZE UART1_RX_BUFFER_SIZE
 #define UART_TX_BUFFER_SIZE UART1_RX_BUFFER_SIZE
 
+// DMA streams of each UART, a target can set one to DMA_NONE to leave the stream to another peripheral
+#ifdef USE_UART_RX_DMA
+#ifndef UART1_RX_DMA
+#define UART1_RX_DMA    DMA_TAG(2, 2, 4)
+#endif
+#ifndef UART2_RX_DMA
+#define UART2_RX_DMA    DMA_TAG(1, 5, 4)
+#endif
+#ifndef UART3_RX_DMA
+#define UART3_RX_DMA    DMA_TAG(1, 1, 4)
+#endif
+#ifndef UART4_RX_DMA
+#define UART4_RX_DMA    DMA_TAG(1, 2, 4)
+#endif
+#ifndef UART5_RX_DMA
+#define UART5_RX_DMA    DMA_TAG(1, 0, 4)
+#endif
+#ifndef UART6_RX_DMA
+#define UART6_RX_DMA    DMA_TAG(2, 1, 5)
+#endif
+#ifndef UART7_RX_DMA
+#define UART7_RX_DMA    DMA_TAG(1, 3, 5)
+#endif
+#ifndef UART8_RX_DMA
+#define UART8_RX_DMA    DMA_TAG(1, 6, 5)
+#endif
+#endif
+
+#ifdef USE_UART_TX_DMA
+#ifndef UART1_TX_DMA
+#define UART1_TX_DMA    DMA_TAG(2, 7, 4)
+#endif
+#ifndef UART2_TX_DMA
+#define UART2_TX_DMA    DMA_TAG(1, 6, 4)
+#endif
+#ifndef UART3_TX_DMA
+#define UART3_TX_DMA    DMA_TAG(1, 3, 4)
+#endif
+#ifndef UART4_TX_DMA
+#define UART4_TX_DMA    DMA_TAG(1, 4, 4)
+#endif
+#ifndef UART5_TX_DMA
+#define UART5_TX_DMA    DMA_TAG(1, 7, 4)
+#endif
+#ifndef UART6_TX_DMA
+#define UART6_TX_DMA    DMA_TAG(2, 6, 5)
+#endif
+#ifndef UART7_TX_DMA
+#define UART7_TX_DMA    DMA_TAG(1, 1, 5)
+#endif
+#ifndef UART8_TX_DMA
+#define UART8_TX_DMA    DMA_TAG(1, 0, 5)
+#endif
+#endif
+
 typedef struct uartDevice_s {
     USART_TypeDef* dev;
     uartPort_t port;
     ioTag_t rx;
     ioTag_t tx;
+#ifdef USE_UART_RX_DMA
+    dmaTag_t rxDMATag;
+#endif
+#ifdef USE_UART_TX_DMA
+    dmaTag_t txDMATag;
+#endif
     volatile uint8_t rxBuffer[UART_RX_BUFFER_SIZE];
     volatile uint8_t txBuffer[UART_TX_BUFFER_SIZE];
     uint32_t rcc_ahb1;
@@ -54,6 +118,12 @@ static uartDevice_t uart1 =
     .dev = USART1,
     .rx = IO_TAG(UART1_RX_PIN),
     .tx = IO_TAG(UART1_TX_PIN),
+#ifdef USE_UART_RX_DMA
+    .rxDMATag = UART1_RX_DMA,
+#endif
+#ifdef USE_UART_TX_DMA
+    .txDMATag = UART1_TX_DMA,
+#endif
     .af = GPIO_AF_USART1,
 #ifdef UART1_AHB1_PERIPHERALS
     .rcc_ahb1 = UART1_AHB1_PERIPHERALS,
@@ -70,6 +140,12 @@ static uartDevice_t uart2 =
     .dev = USART2,
     .rx = IO_TAG(UART2_RX_PIN),
     .tx = IO_TAG(UART2_TX_PIN),
+#ifdef USE_UART_RX_DMA
+    .rxDMATag = UART2_RX_DMA,
+#endif
+#ifdef USE_UART_TX_DMA
+    .txDMATag = UART2_TX_DMA,
+#endif
     .af = GPIO_AF_USART2,
 #ifdef UART2_AHB1_PERIPHERALS
     .rcc_ahb1 = UART2_AHB1_PERIPHERALS,
@@ -86,6 +162,12 @@ static uartDevice_t uart3 =
     .dev = USART3,
     .rx = IO_TAG(UART3_RX_PIN),
     .tx = IO_TAG(UART3_TX_PIN),
+#ifdef USE_UART_RX_DMA
+    .rxDMATag = UART3_RX_DMA,
+#endif
+#ifdef USE_UART_TX_DMA
+    .txDMATag = UART3_TX_DMA,
+#endif
     .af = GPIO_AF_USART3,
 #ifdef UART3_AHB1_PERIPHERALS
     .rcc_ahb1 = UART3_AHB1_PERIPHERALS,
@@ -102,6 +184,12 @@ static uartDevice_t uart4 =
     .dev = UART4,
     .rx = IO_TAG(UART4_RX_PIN),
     .tx = IO_TAG(UART4_TX_PIN),
+#ifdef USE_UART_RX_DMA
+    .rxDMATag = UART4_RX_DMA,
+#endif
+#ifdef USE_UART_TX_DMA
+    .txDMATag = UART4_TX_DMA,
+#endif
     .af = GPIO_AF_UART4,
 #ifdef UART4_AHB1_PERIPHERALS
     .rcc_ahb1 = UART4_AHB1_PERIPHERALS,
@@ -118,6 +206,12 @@ static uartDevice_t uart5 =
     .dev = UART5,
     .rx = IO_TAG(UART5_RX_PIN),
     .tx = IO_TAG(UART5_TX_PIN),
+#ifdef USE_UART_RX_DMA
+    .rxDMATag = UART5_RX_DMA,
+#endif
+#ifdef USE_UART_TX_DMA
+    .txDMATag = UART5_TX_DMA,
+#endif
     .af = GPIO_AF_UART5,
 #ifdef UART5_AHB1_PERIPHERALS
     .rcc_ahb1 = UART5_AHB1_PERIPHERALS,
@@ -134,6 +228,12 @@ static uartDevice_t uart6 =
     .dev = USART6,
     .rx = IO_TAG(UART6_RX_PIN),
     .tx = IO_TAG(UART6_TX_PIN),
+#ifdef USE_UART_RX_DMA
+    .rxDMATag = UART6_RX_DMA,
+#endif
+#ifdef USE_UART_TX_DMA
+    .txDMATag = UART6_TX_DMA,
+#endif
     .af = GPIO_AF_USART6,
 #ifdef UART6_AHB1_PERIPHERALS
     .rcc_ahb1 = UART6_AHB1_PERIPHERALS,
@@ -150,6 +250,12 @@ static uartDevice_t uart7 =
     .dev = UART7,
     .rx = IO_TAG(UART7_RX_PIN),
     .tx = IO_TAG(UART7_TX_PIN),
+#ifdef USE_UART_RX_DMA
+    .rxDMATag = UART7_RX_DMA,
+#endif
+#ifdef USE_UART_TX_DMA
+    .txDMATag = UART7_TX_DMA,
+#endif
     .af = GPIO_AF_UART7,
     .rcc_apb1 = RCC_APB1(UART7),
     .irq = UART7_IRQn,
@@ -163,6 +269,12 @@ static uartDevice_t uart8 =
     .dev = UART8,
     .rx = IO_TAG(UART8_RX_PIN),
     .tx = IO_TAG(UART8_TX_PIN),
+#ifdef USE_UART_RX_DMA
+    .rxDMATag = UART8_RX_DMA,
+#endif
+#ifdef USE_UART_TX_DMA
+    .txDMATag = UART8_TX_DMA,
+#endif
     .af = GPIO_AF_UART8,
     .rcc_apb1 = RCC_APB1(UART8),
     .irq = UART8_IRQn,
@@ -213,8 +325,170 @@ static uartDevice_t* uartHardwareMap[] = {
 #endif
     };
 
+#ifdef USE_UART_RX_DMA
+uint32_t uartRxDMAHead(const uartPort_t *s)
+{
+    // NDTR counts down from rxBufferSize and reloads immediately in circular mode
+    return s->port.rxBufferSize - s->rxDMA->ref->NDTR;
+}
+
+static void uartRxDMADeliver(uartPort_t *s)
+{
+    // In callback mode nobody reads the buffer, rxBufferTail tracks the last byte handed to the callback
+    const uint32_t rxBufferHead = uartRxDMAHead(s);
+
+    while (s->port.rxBufferTail != rxBufferHead) {
+        s->port.rxCallback(s->port.rxBuffer[s->port.rxBufferTail], s->port.rxCallbackData);
+        s->port.rxBufferTail = (s->port.rxBufferTail + 1) % s->port.rxBufferSize;
+    }
+}
+
+static void uartRxDMAIrqHandler(DMA_t descriptor)
+{
+    uartPort_t *s = (uartPort_t *)descriptor->userParam;
+
+    // Half/full buffer marks keep long frames without an idle gap flowing to the callback
+    DMA_CLEAR_FLAG(descriptor, DMA_IT_HTIF | DMA_IT_TCIF);
+
+    if (s->port.rxCallback) {
+        uartRxDMADeliver(s);
+    }
+}
+
+void uartStartRxDMA(uartPort_t *s)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+    DMA_Stream_TypeDef * stream = s->rxDMA->ref;
+
+    USART_DMACmd(s->USARTx, USART_DMAReq_Rx, DISABLE);
+    DMA_Cmd(stream, DISABLE);
+    DMA_DeInit(stream);
+    DMA_CLEAR_FLAG(s->rxDMA, DMA_IT_HTIF | DMA_IT_TCIF | DMA_IT_TEIF | DMA_IT_DMEIF | DMA_IT_FEIF);
+
+    DMA_StructInit(&DMA_InitStructure);
+    DMA_InitStructure.DMA_Channel = s->rxDMAChannel;
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&s->USARTx->DR;
+    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)s->port.rxBuffer;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
+    DMA_InitStructure.DMA_BufferSize = s->port.rxBufferSize;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+    DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+    DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_Full;
+    DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+    DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+    DMA_Init(stream, &DMA_InitStructure);
+
+    // Without a callback data is pulled by serialRead() and no interrupts are needed at all
+    if (s->port.rxCallback) {
+        DMA_ITConfig(stream, DMA_IT_HT | DMA_IT_TC, ENABLE);
+        USART_ClearITPendingBit(s->USARTx, USART_IT_IDLE);
+        USART_ITConfig(s->USARTx, USART_IT_IDLE, ENABLE);
+    } else {
+        DMA_ITConfig(stream, DMA_IT_HT | DMA_IT_TC, DISABLE);
+        USART_ITConfig(s->USARTx, USART_IT_IDLE, DISABLE);
+    }
+
+    DMA_Cmd(stream, ENABLE);
+    USART_DMACmd(s->USARTx, USART_DMAReq_Rx, ENABLE);
+}
+#endif
+
+#ifdef USE_UART_TX_DMA
+uint32_t uartTxDMABytesInFlight(const uartPort_t *s)
+{
+    return s->txDMA->ref->NDTR;
+}
+
+void uartStartTxDMA(uartPort_t *s)
+{
+    DMA_Stream_TypeDef * stream = s->txDMA->ref;
+
+    // Called both from uartWrite() and the TC interrupt, serialize queueing of the next segment
+    ATOMIC_BLOCK(NVIC_PRIO_MAX) {
+        // A segment is in flight, TC interrupt will queue whatever was added meanwhile
+        if (stream->CR & DMA_SxCR_EN) {
+            return;
+        }
+
+        if (s->port.txBufferHead == s->port.txBufferTail) {
+            s->txDMAEmpty = true;
+            return;
+        }
+
+        // Send the largest contiguous segment of the ring, wrapped data goes out in the next one
+        stream->M0AR = (uint32_t)&s->port.txBuffer[s->port.txBufferTail];
+        if (s->port.txBufferHead > s->port.txBufferTail) {
+            stream->NDTR = s->port.txBufferHead - s->port.txBufferTail;
+            s->port.txBufferTail = s->port.txBufferHead;
+        } else {
+            stream->NDTR = s->port.txBufferSize - s->port.txBufferTail;
+            s->port.txBufferTail = 0;
+        }
+
+        s->txDMAEmpty = false;
+        DMA_CLEAR_FLAG(s->txDMA, DMA_IT_TCIF | DMA_IT_HTIF | DMA_IT_TEIF | DMA_IT_DMEIF | DMA_IT_FEIF);
+        DMA_Cmd(stream, ENABLE);
+    }
+}
+
+static void uartTxDMAIrqHandler(DMA_t descriptor)
+{
+    uartPort_t *s = (uartPort_t *)descriptor->userParam;
+
+    if (DMA_GET_FLAG_STATUS(descriptor, DMA_IT_TCIF)) {
+        DMA_CLEAR_FLAG(descriptor, DMA_IT_TCIF);
+        uartStartTxDMA(s);
+    }
+}
+
+static void uartConfigureTxDMA(uartPort_t *s, uint32_t channel)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+    DMA_Stream_TypeDef * stream = s->txDMA->ref;
+
+    DMA_Cmd(stream, DISABLE);
+    DMA_DeInit(stream);
+
+    DMA_StructInit(&DMA_InitStructure);
+    DMA_InitStructure.DMA_Channel = channel;
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&s->USARTx->DR;
+    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)s->port.txBuffer;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+    DMA_InitStructure.DMA_BufferSize = s->port.txBufferSize;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+    DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+    DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_Full;
+    DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+    DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+    DMA_Init(stream, &DMA_InitStructure);
+
+    DMA_ITConfig(stream, DMA_IT_TC, ENABLE);
+    s->txDMAEmpty = true;
+}
+#endif
+
 void uartIrqHandler(uartPort_t *s)
 {
+#ifdef USE_UART_RX_DMA
+    if (s->rxDMA) {
+        if (USART_GetITStatus(s->USARTx, USART_IT_IDLE) == SET) {
+            // IDLE is cleared by reading SR followed by DR, received bytes are already in rxBuffer
+            (void)s->USARTx->DR;
+            uartRxDMADeliver(s);
+        }
+    }
+    else
+#endif
     if (USART_GetITStatus(s->USARTx, USART_IT_RXNE) == SET) {
         if (s->port.rxCallback) {
             s->port.rxCallback(s->USARTx->DR, s->port.rxCallbackData);
@@ -259,6 +533,49 @@ uartPort_t *serialUART(UARTDevice_e device, uint32_t baudRate, portMode_t mode,
 
     s->USARTx = uart->dev;
 
+#ifdef USE_UART_RX_DMA
+    if (s->rxDMA) {
+        USART_DMACmd(s->USARTx, USART_DMAReq_Rx, DISABLE);
+        DMA_Cmd(s->rxDMA->ref, DISABLE);
+        s->rxDMA = NULL;
+    }
+
+    if ((mode & MODE_RX) && uart->rxDMATag != DMA_NONE) {
+        DMA_t dma = dmaGetByTag(uart->rxDMATag);
+
+        // Stream may already be used by a timer or another peripheral - fall back to RXNE interrupt then
+        if (dma && (dmaGetOwner(dma) == OWNER_FREE || (dmaGetOwner(dma) == OWNER_SERIAL && dma->resourceIndex == RESOURCE_INDEX(device)))) {
+            dmaInit(dma, OWNER_SERIAL, RESOURCE_INDEX(device));
+            dmaSetHandler(dma, uartRxDMAIrqHandler, uart->irqPriority, (uint32_t)s);
+            s->rxDMA = dma;
+            s->rxDMAChannel = dmaGetChannelByTag(uart->rxDMATag);
+        } else if (dma) {
+            addBootlogEvent4(BOOT_EVENT_HARDWARE_IO_CONFLICT, BOOT_EVENT_FLAGS_WARNING, dmaGetOwner(dma), OWNER_SERIAL);
+        }
+    }
+#endif
+
+#ifdef USE_UART_TX_DMA
+    if (s->txDMA) {
+        USART_DMACmd(s->USARTx, USART_DMAReq_Tx, DISABLE);
+        DMA_Cmd(s->txDMA->ref, DISABLE);
+        s->txDMA = NULL;
+    }
+
+    if ((mode & MODE_TX) && uart->txDMATag != DMA_NONE) {
+        DMA_t dma = dmaGetByTag(uart->txDMATag);
+
+        if (dma && (dmaGetOwner(dma) == OWNER_FREE || (dmaGetOwner(dma) == OWNER_SERIAL && dma->resourceIndex == RESOURCE_INDEX(device)))) {
+            dmaInit(dma, OWNER_SERIAL, RESOURCE_INDEX(device));
+            dmaSetHandler(dma, uartTxDMAIrqHandler, uart->irqPriority, (uint32_t)s);
+            s->txDMA = dma;
+            uartConfigureTxDMA(s, dmaGetChannelByTag(uart->txDMATag));
+        } else if (dma) {
+            addBootlogEvent4(BOOT_EVENT_HARDWARE_IO_CONFLICT, BOOT_EVENT_FLAGS_WARNING, dmaGetOwner(dma), OWNER_SERIAL);
+        }
+    }
+#endif
+
     IO_t tx = IOGetByTag(uart->tx);
     IO_t rx = IOGetByTag(uart->rx);
 
@@ -75,14 +75,18 @@ static bool isUsbVcpTransmitBufferEmpty(const serialPort_t *instance)
 
 static uint32_t usbVcpAvailable(const serialPort_t *instance)
 {
-    UNUSED(instance);
+    const vcpPort_t *port = container_of(instance, vcpPort_t, port);
 
-    return CDC_Receive_BytesAvailable();
+    return (port->rxCount - port->rxAt) + CDC_Receive_BytesAvailable();
 }
 
 static uint8_t usbVcpRead(serialPort_t *instance)
 {
-    UNUSED(instance);
+    vcpPort_t *port = container_of(instance, vcpPort_t, port);
+
+    if (port->rxAt < port->rxCount) {
+        return port->rxBuf[port->rxAt++];
+    }
 
     uint8_t buf[1];
 
@@ -92,31 +96,55 @@ static uint8_t usbVcpRead(serialPort_t *instance)
     }
 }
 
+static uint32_t usbVcpPeekRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    vcpPort_t *port = container_of(instance, vcpPort_t, port);
+
+    // USB stack buffers are not exposed, stage a packet worth of data locally
+    if (port->rxAt >= port->rxCount) {
+        port->rxAt = 0;
+        port->rxCount = CDC_Receive_DATA(port->rxBuf, sizeof(port->rxBuf));
+    }
+
+    *data = &port->rxBuf[port->rxAt];
+    return port->rxCount - port->rxAt;
+}
+
+static void usbVcpConsumeRx(serialPort_t *instance, uint32_t count)
+{
+    vcpPort_t *port = container_of(instance, vcpPort_t, port);
+    port->rxAt += count;
+}
+
 static bool usbVcpIsConnected(const serialPort_t *instance)
 {
     (void)instance;
     return usbIsConnected() && usbIsConfigured();
 }
 
-static void usbVcpWriteBuf(serialPort_t *instance, const void *data, int count)
+// Waits for the host itself, what isn't sent before the timeout is dropped
+static int usbVcpWriteBuf(serialPort_t *instance, const void *data, int count)
 {
     UNUSED(instance);
 
     if (!usbVcpIsConnected(instance)) {
-        return;
+        return count;
     }
 
     uint32_t start = millis();
     const uint8_t *p = data;
-    while (count > 0) {
-        uint32_t txed = CDC_Send_DATA(p, count);
-        count -= txed;
+    int remaining = count;
+    while (remaining > 0) {
+        uint32_t txed = CDC_Send_DATA(p, remaining);
+        remaining -= txed;
         p += txed;
 
         if (millis() - start > USB_TIMEOUT) {
             break;
         }
     }
+
+    return count;
 }
 
 static bool usbVcpFlush(vcpPort_t *port)
@@ -181,6 +209,8 @@ static const struct serialPortVTable usbVTable[] = {
         .serialTotalRxWaiting = usbVcpAvailable,
         .serialTotalTxFree = usbTxBytesFree,
         .serialRead = usbVcpRead,
+        .peekRxSpan = usbVcpPeekRxSpan,
+        .consumeRx = usbVcpConsumeRx,
         .serialSetBaudRate = usbVcpSetBaudRate,
         .isSerialTransmitBufferEmpty = isUsbVcpTransmitBufferEmpty,
         .setMode = usbVcpSetMode,
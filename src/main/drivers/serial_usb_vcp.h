@@ -25,6 +25,11 @@ typedef struct {
     uint8_t txAt;
     // Set if the port is in bulk write mode and can buffer.
     bool buffering;
+
+    // Received data staged for bulk reads, served before data still held by the USB stack.
+    uint8_t rxBuf[64];
+    uint8_t rxAt;
+    uint8_t rxCount;
 } vcpPort_t;
 
 void usbVcpInitHardware(void);
@@ -256,4 +256,21 @@ void timerPWMStopDMA(TCH_t * tch)
 bool timerPWMDMAInProgress(TCH_t * tch)
 {
     return tch->dmaState != TCH_DMA_IDLE;
-}
\ No newline at end of file
+}
+
+#ifdef USE_DSHOT_DMAR
+bool timerPWMConfigDMABurst(TCH_t * tch, void * dmaBuffer, uint32_t dmaBufferSize)
+{
+    return impl_timerPWMConfigDMABurst(tch, dmaBuffer, dmaBufferSize);
+}
+
+void timerPWMStartDMABurst(TCH_t * tch, uint8_t firstChannelIndex, uint8_t channelCount, uint32_t dmaBufferSize)
+{
+    impl_timerPWMStartDMABurst(tch, firstChannelIndex, channelCount, dmaBufferSize);
+}
+
+bool timerPWMDMABurstInProgress(TCH_t * tch)
+{
+    return tch->timCtx->dmaBurstState != TCH_DMA_IDLE;
+}
+#endif
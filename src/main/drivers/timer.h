@@ -58,6 +58,7 @@ typedef struct timerDef_s {
     rccPeriphTag_t  rcc;
     uint8_t         irq;
     uint8_t         secondIrq;
+    dmaTag_t        dmaTagUp;       // TIMx_UP DMA request, used for DMAR burst transfers
 } timerDef_t;
 
 typedef enum {
@@ -127,6 +128,11 @@ typedef struct timHardwareContext_s {
     TIM_HandleTypeDef * timHandle;
 #endif
     TCH_t               ch[CC_CHANNELS_PER_TIMER];
+#ifdef USE_DSHOT_DMAR
+    DMA_t               dmaBurst;       // Timer update DMA handle (DMAR burst to CCRx)
+    volatile tchDmaState_e dmaBurstState;
+    void *              dmaBurstBuffer;
+#endif
 } timHardwareContext_t;
 
 #if defined(STM32F3)
@@ -196,6 +202,12 @@ void timerPWMStartDMA(TCH_t * tch);
 void timerPWMStopDMA(TCH_t * tch);
 bool timerPWMDMAInProgress(TCH_t * tch);
 
+#ifdef USE_DSHOT_DMAR
+bool timerPWMConfigDMABurst(TCH_t * tch, void * dmaBuffer, uint32_t dmaBufferSize);
+void timerPWMStartDMABurst(TCH_t * tch, uint8_t firstChannelIndex, uint8_t channelCount, uint32_t dmaBufferSize);
+bool timerPWMDMABurstInProgress(TCH_t * tch);
+#endif
+
 volatile timCCR_t *timerCCR(TCH_t * tch);
 
 uint16_t timerGetPrescalerByDesiredMhz(TIM_TypeDef *tim, uint16_t mhz);
@@ -59,3 +59,8 @@ bool impl_timerPWMConfigChannelDMA(TCH_t * tch, void * dmaBuffer, uint32_t dmaBu
 void impl_timerPWMPrepareDMA(TCH_t * tch, uint32_t dmaBufferSize);
 void impl_timerPWMStartDMA(TCH_t * tch);
 void impl_timerPWMStopDMA(TCH_t * tch);
+
+#ifdef USE_DSHOT_DMAR
+bool impl_timerPWMConfigDMABurst(TCH_t * tch, void * dmaBuffer, uint32_t dmaBufferSize);
+void impl_timerPWMStartDMABurst(TCH_t * tch, uint8_t firstChannelIndex, uint8_t channelCount, uint32_t dmaBufferSize);
+#endif
@@ -27,6 +27,7 @@
 #include "common/utils.h"
 
 #include "drivers/io.h"
+#include "drivers/logging.h"
 #include "drivers/rcc.h"
 #include "drivers/time.h"
 #include "drivers/nvic.h"
@@ -432,3 +433,116 @@ void impl_timerPWMStopDMA(TCH_t * tch)
     (void)tch;
     // FIXME
 }
+
+#ifdef USE_DSHOT_DMAR
+static const uint32_t lookupDMABurstBaseTable[] = { LL_TIM_DMABURST_BASEADDR_CCR1, LL_TIM_DMABURST_BASEADDR_CCR2, LL_TIM_DMABURST_BASEADDR_CCR3, LL_TIM_DMABURST_BASEADDR_CCR4 };
+static const uint32_t lookupDMABurstLengthTable[] = { LL_TIM_DMABURST_LENGTH_1TRANSFER, LL_TIM_DMABURST_LENGTH_2TRANSFERS, LL_TIM_DMABURST_LENGTH_3TRANSFERS, LL_TIM_DMABURST_LENGTH_4TRANSFERS };
+
+static void impl_timerDMABurst_IRQHandler(DMA_t descriptor)
+{
+    if (DMA_GET_FLAG_STATUS(descriptor, DMA_IT_TCIF)) {
+        timHardwareContext_t * timCtx = (timHardwareContext_t *)descriptor->userParam;
+
+        if (timCtx->dmaBurstState == TCH_DMA_ACTIVE) {
+            timCtx->dmaBurstState = TCH_DMA_IDLE;
+        }
+
+        LL_DMA_DisableStream(descriptor->dma, lookupDMALLStreamTable[DMATAG_GET_STREAM(timCtx->timDef->dmaTagUp)]);
+        LL_TIM_DisableDMAReq_UPDATE(timCtx->timDef->tim);
+
+        DMA_CLEAR_FLAG(descriptor, DMA_IT_TCIF);
+    }
+}
+
+bool impl_timerPWMConfigDMABurst(TCH_t * tch, void * dmaBuffer, uint32_t dmaBufferSize)
+{
+    timHardwareContext_t * timCtx = tch->timCtx;
+
+    // Update DMA is shared by all channels of the timer - only the first channel sets it up
+    if (timCtx->dmaBurst == NULL) {
+        DMA_t dma = dmaGetByTag(timCtx->timDef->dmaTagUp);
+        if (dma == NULL) {
+            return false;
+        }
+
+        if (dmaGetOwner(dma) != OWNER_FREE) {
+            // Stream is shared with another peripheral which was set up first
+            addBootlogEvent4(BOOT_EVENT_HARDWARE_IO_CONFLICT, BOOT_EVENT_FLAGS_WARNING, dmaGetOwner(dma), OWNER_TIMER);
+            return false;
+        }
+
+        const uint32_t streamLL = lookupDMALLStreamTable[DMATAG_GET_STREAM(timCtx->timDef->dmaTagUp)];
+        const uint32_t channelLL = lookupDMALLChannelTable[DMATAG_GET_CHANNEL(timCtx->timDef->dmaTagUp)];
+
+        timCtx->dmaBurst = dma;
+        timCtx->dmaBurstBuffer = dmaBuffer;
+        timCtx->dmaBurstState = TCH_DMA_IDLE;
+
+        LL_DMA_DeInit(dma->dma, streamLL);
+
+        LL_DMA_InitTypeDef init;
+        LL_DMA_StructInit(&init);
+
+        init.Channel = channelLL;
+        init.PeriphOrM2MSrcAddress = (uint32_t)&timCtx->timDef->tim->DMAR;
+        init.PeriphOrM2MSrcIncMode = LL_DMA_PERIPH_NOINCREMENT;
+        init.PeriphOrM2MSrcDataSize = LL_DMA_PDATAALIGN_WORD;
+        init.MemoryOrM2MDstAddress = (uint32_t)dmaBuffer;
+        init.MemoryOrM2MDstIncMode = LL_DMA_MEMORY_INCREMENT;
+        init.MemoryOrM2MDstDataSize = LL_DMA_MDATAALIGN_WORD;
+        init.NbData = dmaBufferSize;
+        init.Direction = LL_DMA_DIRECTION_MEMORY_TO_PERIPH;
+        init.Mode = LL_DMA_MODE_NORMAL;
+        init.Priority = LL_DMA_PRIORITY_HIGH;
+        init.FIFOMode = LL_DMA_FIFOMODE_ENABLE;
+        init.FIFOThreshold = LL_DMA_FIFOTHRESHOLD_FULL;
+        init.MemBurst = LL_DMA_MBURST_SINGLE;
+        init.PeriphBurst = LL_DMA_PBURST_SINGLE;
+
+        dmaInit(dma, OWNER_TIMER, 0);
+        dmaSetHandler(dma, impl_timerDMABurst_IRQHandler, NVIC_PRIO_WS2811_DMA, (uint32_t)timCtx);
+
+        LL_DMA_Init(dma->dma, streamLL, &init);
+    }
+    else if (timCtx->dmaBurstBuffer != dmaBuffer) {
+        return false;
+    }
+
+    // Start PWM generation
+    if (tch->timHw->output & TIMER_OUTPUT_N_CHANNEL) {
+        HAL_TIMEx_PWMN_Start(timCtx->timHandle, lookupTIMChannelTable[tch->timHw->channelIndex]);
+    }
+    else {
+        HAL_TIM_PWM_Start(timCtx->timHandle, lookupTIMChannelTable[tch->timHw->channelIndex]);
+    }
+
+    return true;
+}
+
+void impl_timerPWMStartDMABurst(TCH_t * tch, uint8_t firstChannelIndex, uint8_t channelCount, uint32_t dmaBufferSize)
+{
+    timHardwareContext_t * timCtx = tch->timCtx;
+    TIM_TypeDef * timer = timCtx->timDef->tim;
+    DMA_TypeDef * dmaBase = timCtx->dmaBurst->dma;
+    const uint32_t streamLL = lookupDMALLStreamTable[DMATAG_GET_STREAM(timCtx->timDef->dmaTagUp)];
+
+    // Terminate previous burst, see impl_timerPWMPrepareDMA
+    ATOMIC_BLOCK(NVIC_PRIO_MAX) {
+        LL_TIM_DisableDMAReq_UPDATE(timer);
+        LL_DMA_DisableStream(dmaBase, streamLL);
+        DMA_CLEAR_FLAG(timCtx->dmaBurst, DMA_IT_TCIF);
+    }
+
+    // Each update event writes channelCount consecutive CCRx registers via DMAR
+    LL_TIM_ConfigDMABurst(timer, lookupDMABurstBaseTable[firstChannelIndex], lookupDMABurstLengthTable[channelCount - 1]);
+
+    LL_DMA_SetDataLength(dmaBase, streamLL, dmaBufferSize);
+    LL_DMA_ConfigAddresses(dmaBase, streamLL, (uint32_t)timCtx->dmaBurstBuffer, (uint32_t)&timer->DMAR, LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
+    LL_DMA_EnableIT_TC(dmaBase, streamLL);
+    LL_DMA_EnableStream(dmaBase, streamLL);
+    timCtx->dmaBurstState = TCH_DMA_ACTIVE;
+
+    LL_TIM_SetCounter(timer, 0);
+    LL_TIM_EnableDMAReq_UPDATE(timer);
+}
+#endif
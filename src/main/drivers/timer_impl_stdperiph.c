@@ -26,6 +26,7 @@
 #include "common/utils.h"
 
 #include "drivers/io.h"
+#include "drivers/logging.h"
 #include "drivers/rcc.h"
 #include "drivers/time.h"
 #include "drivers/nvic.h"
@@ -398,3 +399,105 @@ void impl_timerPWMStopDMA(TCH_t * tch)
     TIM_DMACmd(tch->timHw->tim, lookupDMASourceTable[tch->timHw->channelIndex], DISABLE);
     TIM_Cmd(tch->timHw->tim, ENABLE);
 }
+
+#ifdef USE_DSHOT_DMAR
+static const uint16_t lookupDMABurstBaseTable[4] = { TIM_DMABase_CCR1, TIM_DMABase_CCR2, TIM_DMABase_CCR3, TIM_DMABase_CCR4 };
+static const uint16_t lookupDMABurstLengthTable[4] = { TIM_DMABurstLength_1Transfer, TIM_DMABurstLength_2Transfers, TIM_DMABurstLength_3Transfers, TIM_DMABurstLength_4Transfers };
+
+static void impl_timerDMABurst_IRQHandler(DMA_t descriptor)
+{
+    if (DMA_GET_FLAG_STATUS(descriptor, DMA_IT_TCIF)) {
+        timHardwareContext_t * timCtx = (timHardwareContext_t *)descriptor->userParam;
+        timCtx->dmaBurstState = TCH_DMA_IDLE;
+
+        DMA_Cmd(descriptor->ref, DISABLE);
+        TIM_DMACmd(timCtx->timDef->tim, TIM_DMA_Update, DISABLE);
+
+        DMA_CLEAR_FLAG(descriptor, DMA_IT_TCIF);
+    }
+}
+
+bool impl_timerPWMConfigDMABurst(TCH_t * tch, void * dmaBuffer, uint32_t dmaBufferSize)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+    timHardwareContext_t * timCtx = tch->timCtx;
+    TIM_TypeDef * timer = tch->timHw->tim;
+
+    // Update DMA is shared by all channels of the timer - only the first channel sets it up
+    if (timCtx->dmaBurst == NULL) {
+        DMA_t dma = dmaGetByTag(timCtx->timDef->dmaTagUp);
+        if (dma == NULL) {
+            return false;
+        }
+
+        if (dma->owner != OWNER_FREE) {
+            // Stream is shared with another peripheral which was set up first
+            addBootlogEvent4(BOOT_EVENT_HARDWARE_IO_CONFLICT, BOOT_EVENT_FLAGS_WARNING, dma->owner, OWNER_TIMER);
+            return false;
+        }
+
+        timCtx->dmaBurst = dma;
+        timCtx->dmaBurstBuffer = dmaBuffer;
+        timCtx->dmaBurstState = TCH_DMA_IDLE;
+
+        dmaInit(dma, OWNER_TIMER, 0);
+        dmaSetHandler(dma, impl_timerDMABurst_IRQHandler, NVIC_PRIO_WS2811_DMA, (uint32_t)timCtx);
+
+        DMA_Cmd(dma->ref, DISABLE);
+        DMA_DeInit(dma->ref);
+        DMA_StructInit(&DMA_InitStructure);
+
+        DMA_InitStructure.DMA_Channel = dmaGetChannelByTag(timCtx->timDef->dmaTagUp);
+        DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&timer->DMAR;
+        DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)dmaBuffer;
+        DMA_InitStructure.DMA_BufferSize = dmaBufferSize;
+        DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+        DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+        DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+        DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Word;
+        DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Word;
+        DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+        DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+
+        DMA_Init(dma->ref, &DMA_InitStructure);
+        DMA_ITConfig(dma->ref, DMA_IT_TC, ENABLE);
+    }
+    else if (timCtx->dmaBurstBuffer != dmaBuffer) {
+        return false;
+    }
+
+    // We assume that timer channels are already initialized by calls to:
+    //  timerConfigBase
+    //  timerPWMConfigChannel
+    TIM_CtrlPWMOutputs(timer, ENABLE);
+    TIM_ARRPreloadConfig(timer, ENABLE);
+
+    TIM_CCxCmd(timer, lookupTIMChannelTable[tch->timHw->channelIndex], TIM_CCx_Enable);
+    TIM_Cmd(timer, ENABLE);
+
+    return true;
+}
+
+void impl_timerPWMStartDMABurst(TCH_t * tch, uint8_t firstChannelIndex, uint8_t channelCount, uint32_t dmaBufferSize)
+{
+    timHardwareContext_t * timCtx = tch->timCtx;
+    TIM_TypeDef * timer = timCtx->timDef->tim;
+
+    // Terminate previous burst, see impl_timerPWMPrepareDMA
+    ATOMIC_BLOCK(NVIC_PRIO_MAX) {
+        DMA_Cmd(timCtx->dmaBurst->ref, DISABLE);
+        TIM_DMACmd(timer, TIM_DMA_Update, DISABLE);
+        DMA_CLEAR_FLAG(timCtx->dmaBurst, DMA_IT_TCIF);
+    }
+
+    // Each update event writes channelCount consecutive CCRx registers via DMAR
+    TIM_DMAConfig(timer, lookupDMABurstBaseTable[firstChannelIndex], lookupDMABurstLengthTable[channelCount - 1]);
+
+    DMA_SetCurrDataCounter(timCtx->dmaBurst->ref, dmaBufferSize);
+    DMA_Cmd(timCtx->dmaBurst->ref, ENABLE);
+    timCtx->dmaBurstState = TCH_DMA_ACTIVE;
+
+    TIM_SetCounter(timer, 0);
+    TIM_DMACmd(timer, TIM_DMA_Update, ENABLE);
+}
+#endif
@@ -35,23 +35,23 @@
 
 const timerDef_t timerDefinitions[HARDWARE_TIMER_DEFINITION_COUNT] = {
 #if defined(TIM1)
-    [0] = { .tim = TIM1,  .rcc = RCC_APB2(TIM1),  .irq = TIM1_CC_IRQn, .secondIrq = TIM1_UP_TIM10_IRQn },
+    [0] = { .tim = TIM1,  .rcc = RCC_APB2(TIM1),  .irq = TIM1_CC_IRQn, .secondIrq = TIM1_UP_TIM10_IRQn, .dmaTagUp = DMA_TAG(2, 5, 6) },
 #endif
 
 #if defined(TIM2)
-    [1] = { .tim = TIM2,  .rcc = RCC_APB1(TIM2),  .irq = TIM2_IRQn},
+    [1] = { .tim = TIM2,  .rcc = RCC_APB1(TIM2),  .irq = TIM2_IRQn, .dmaTagUp = DMA_TAG(1, 1, 3) },
 #endif
 
 #if defined(TIM3)
-    [2] = { .tim = TIM3,  .rcc = RCC_APB1(TIM3),  .irq = TIM3_IRQn},
+    [2] = { .tim = TIM3,  .rcc = RCC_APB1(TIM3),  .irq = TIM3_IRQn, .dmaTagUp = DMA_TAG(1, 2, 5) },
 #endif
 
 #if defined(TIM4)
-    [3] = { .tim = TIM4,  .rcc = RCC_APB1(TIM4),  .irq = TIM4_IRQn},
+    [3] = { .tim = TIM4,  .rcc = RCC_APB1(TIM4),  .irq = TIM4_IRQn, .dmaTagUp = DMA_TAG(1, 6, 2) },
 #endif
 
 #if defined(TIM5)
-    [4] = { .tim = TIM5,  .rcc = RCC_APB1(TIM5),  .irq = TIM5_IRQn},
+    [4] = { .tim = TIM5,  .rcc = RCC_APB1(TIM5),  .irq = TIM5_IRQn, .dmaTagUp = DMA_TAG(1, 0, 6) },
 #endif
 
 #if defined(TIM6)
@@ -64,9 +64,9 @@ const timerDef_t timerDefinitions[HARDWARE_TIMER_DEFINITION_COUNT] = {
 
 #if defined(TIM8) && !defined(STM32F411xE)
 #if defined(STM32F446xx)
-    [7] = { .tim = TIM8,  .rcc = RCC_APB2(TIM8),  .irq = 0 },
+    [7] = { .tim = TIM8,  .rcc = RCC_APB2(TIM8),  .irq = 0, .dmaTagUp = DMA_TAG(2, 1, 7) },
 #else
-    [7] = { .tim = TIM8,  .rcc = RCC_APB2(TIM8),  .irq = TIM8_CC_IRQn, .secondIrq = TIM8_UP_TIM13_IRQn },
+    [7] = { .tim = TIM8,  .rcc = RCC_APB2(TIM8),  .irq = TIM8_CC_IRQn, .secondIrq = TIM8_UP_TIM13_IRQn, .dmaTagUp = DMA_TAG(2, 1, 7) },
 #endif
 #endif
 
@@ -56,6 +56,7 @@ extern uint8_t __config_end;
 #include "drivers/io.h"
 #include "drivers/io_impl.h"
 #include "drivers/logging.h"
+#include "drivers/pwm_output.h"
 #include "drivers/max7456_symbols.h"
 #include "drivers/rx_pwm.h"
 #include "drivers/sdcard.h"
@@ -200,9 +201,7 @@ static const char * const *sensorHardwareNames[] = {
 
 static void cliPrint(const char *str)
 {
-    while (*str) {
-        bufWriterAppend(cliWriter, *str++);
-    }
+    bufWriterAppendBuf(cliWriter, (const uint8_t *)str, strlen(str));
 }
 
 static void cliPrintLinefeed(void)
@@ -620,6 +619,23 @@ static void cliBootlog(char *cmdline)
             cliPrintLinefeed();
         }
     }
+
+    cliPrintLinefeed();
+    cliPrintLine("Phase timing (us)");
+
+    for (int idx = 0; idx < bootEventCount; idx++) {
+        const bootLogEntry_t * event = getBootlogEvent(idx);
+        if (!(event->eventFlags & BOOT_EVENT_FLAGS_PHASE_END)) {
+            continue;
+        }
+
+#if defined(BOOTLOG_DESCRIPTIONS)
+        const char * eventDescription = getBootlogEventDescription(event->eventCode);
+        cliPrintLinef("%2d %22s %8u +%u", event->eventCode, eventDescription ? eventDescription : "", event->params.u32[0], event->params.u32[1]);
+#else
+        cliPrintLinef("%2d %8u +%u", event->eventCode, event->params.u32[0], event->params.u32[1]);
+#endif
+    }
 }
 #endif
 
@@ -1566,11 +1582,7 @@ static void cliServoMix(char *cmdline)
 
 static void cliWriteBytes(const uint8_t *buffer, int count)
 {
-    while (count > 0) {
-        cliWrite(*buffer);
-        buffer++;
-        count--;
-    }
+    bufWriterAppendBuf(cliWriter, buffer, count);
 }
 
 static void cliSdInfo(char *cmdline)
@@ -1642,16 +1654,18 @@ static void cliFlashInfo(char *cmdline)
 
     UNUSED(cmdline);
 
-    cliPrintLinef("Flash sectors=%u, sectorSize=%u, pagesPerSector=%u, pageSize=%u, totalSize=%u, usedSize=%u",
-            layout->sectors, layout->sectorSize, layout->pagesPerSector, layout->pageSize, layout->totalSize, flashfsGetOffset());
+    cliPrintLinef("Flash sectors=%u, sectorSize=%u, pagesPerSector=%u, pageSize=%u, totalSize=%u, usedSize=%u, logs=%d",
+            layout->sectors, layout->sectorSize, layout->pagesPerSector, layout->pageSize, layout->totalSize, flashfsGetOffset(), flashfsGetLogCount());
 }
 
 static void cliFlashErase(char *cmdline)
 {
-    UNUSED(cmdline);
-
     cliPrintLine("Erasing...");
-    flashfsEraseCompletely();
+    if (sl_strcasecmp(cmdline, "used") == 0) {
+        flashfsEraseUsed();
+    } else {
+        flashfsEraseCompletely();
+    }
 
     while (!flashfsIsReady()) {
         delay(100);
@@ -1695,9 +1709,7 @@ static void cliFlashRead(char *cmdline)
         while (length > 0) {
             int bytesRead = flashfsReadAbs(address, buffer, length < sizeof(buffer) ? length : sizeof(buffer));
 
-            for (int i = 0; i < bytesRead; i++) {
-                cliWrite(buffer[i]);
-            }
+            bufWriterAppendBuf(cliWriter, buffer, bytesRead);
 
             length -= bytesRead;
             address += bytesRead;
@@ -2191,6 +2203,86 @@ static void cliMotor(char *cmdline)
     cliPrintLinef("motor %d: %d", motor_index, motor_disarmed[motor_index]);
 }
 
+#ifdef USE_DSHOT
+static const char * const dshotCommandNames[] = {
+    [DSHOT_CMD_BEACON1] = "beacon1",
+    [DSHOT_CMD_BEACON2] = "beacon2",
+    [DSHOT_CMD_BEACON3] = "beacon3",
+    [DSHOT_CMD_BEACON4] = "beacon4",
+    [DSHOT_CMD_BEACON5] = "beacon5",
+    [DSHOT_CMD_3D_MODE_OFF] = "3d_off",
+    [DSHOT_CMD_3D_MODE_ON] = "3d_on",
+    [DSHOT_CMD_SAVE_SETTINGS] = "save",
+    [DSHOT_CMD_SPIN_DIRECTION_NORMAL] = "normal",
+    [DSHOT_CMD_SPIN_DIRECTION_REVERSED] = "reversed",
+};
+
+static int cliDshotCommandByName(const char *name)
+{
+    for (unsigned i = 0; i < ARRAYLEN(dshotCommandNames); i++) {
+        if (dshotCommandNames[i] && sl_strcasecmp(dshotCommandNames[i], name) == 0) {
+            return i;
+        }
+    }
+
+    return isdigit((unsigned char)name[0]) ? fastA2I(name) : -1;
+}
+
+static void cliDshotCommand(char *cmdline)
+{
+    char *saveptr;
+    const char *motorArg = strtok_r(cmdline, " ", &saveptr);
+
+    if (!isMotorProtocolDshot()) {
+        cliPrintLine("DSHOT not enabled");
+        return;
+    }
+
+    if (motorArg == NULL) {
+        cliShowParseError();
+        return;
+    }
+
+    const int motorIndex = (sl_strcasecmp(motorArg, "all") == 0) ? DSHOT_CMD_ALL_MOTORS : fastA2I(motorArg);
+    if (motorIndex != DSHOT_CMD_ALL_MOTORS && (motorIndex < 0 || motorIndex >= getMotorCount())) {
+        cliShowArgumentRangeError("index", 0, getMotorCount() - 1);
+        return;
+    }
+
+    // Remaining arguments are checked first, then queued together in order and sent asynchronously
+    uint8_t commands[8];
+    int count = 0;
+    for (const char *pch = strtok_r(NULL, " ", &saveptr); pch != NULL; pch = strtok_r(NULL, " ", &saveptr)) {
+        const int command = cliDshotCommandByName(pch);
+
+        if (command < 0 || command > DSHOT_CMD_MAX) {
+            cliShowArgumentRangeError("command", 0, DSHOT_CMD_MAX);
+            return;
+        }
+
+        if (count == (int)ARRAYLEN(commands)) {
+            cliPrintLine("Too many commands");
+            return;
+        }
+        commands[count++] = command;
+    }
+
+    if (count == 0) {
+        cliShowParseError();
+        return;
+    }
+
+    if (!pwmRequestDshotCommands(motorIndex, commands, count)) {
+        cliPrintLine("Command rejected");
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        cliPrintLinef("dshot %s: %d", motorArg, commands[i]);
+    }
+}
+#endif
+
 #ifdef PLAY_SOUND
 static void cliPlaySound(char *cmdline)
 {
@@ -2362,65 +2454,71 @@ static void cliSet(char *cmdline)
             eqptr++;
         }
 
-        for (uint32_t i = 0; i < SETTINGS_TABLE_COUNT; i++) {
-            val = settingGet(i);
-            // ensure exact match when setting to prevent setting variables with shorter names
-            if (settingNameIsExactMatch(val, name, cmdline, variableNameLength)) {
-                const setting_type_e type = SETTING_TYPE(val);
-                if (type == VAR_STRING) {
-                    settingSetString(val, eqptr, strlen(eqptr));
-                    return;
-                }
-                const setting_mode_e mode = SETTING_MODE(val);
-                bool changeValue = false;
-                int_float_value_t tmp = {0};
-                switch (mode) {
-                case MODE_DIRECT: {
-                        if (*eqptr != 0 && strspn(eqptr, "0123456789.+-") == strlen(eqptr)) {
-                            float valuef = fastA2F(eqptr);
-                            // note: compare float values
-                            if (valuef >= (float)settingGetMin(val) && valuef <= (float)settingGetMax(val)) {
-
-                                if (type == VAR_FLOAT)
-                                    tmp.float_value = valuef;
-                                else if (type == VAR_UINT32)
-                                    tmp.uint_value = fastA2UL(eqptr);
-                                else
-                                    tmp.int_value = fastA2I(eqptr);
-
-                                changeValue = true;
-                            }
+        // Names are stored in lower case, the CLI accepts any case
+        val = NULL;
+        if (variableNameLength < SETTING_MAX_NAME_LENGTH) {
+            for (unsigned ii = 0; ii < variableNameLength; ii++) {
+                name[ii] = sl_tolower(cmdline[ii]);
+            }
+            name[variableNameLength] = '\0';
+            val = settingFind(name);
+        }
+
+        if (val) {
+            const setting_type_e type = SETTING_TYPE(val);
+            if (type == VAR_STRING) {
+                settingSetString(val, eqptr, strlen(eqptr));
+                return;
+            }
+            const setting_mode_e mode = SETTING_MODE(val);
+            bool changeValue = false;
+            int_float_value_t tmp = {0};
+            switch (mode) {
+            case MODE_DIRECT: {
+                    if (*eqptr != 0 && strspn(eqptr, "0123456789.+-") == strlen(eqptr)) {
+                        float valuef = fastA2F(eqptr);
+                        // note: compare float values
+                        if (valuef >= (float)settingGetMin(val) && valuef <= (float)settingGetMax(val)) {
+
+                            if (type == VAR_FLOAT)
+                                tmp.float_value = valuef;
+                            else if (type == VAR_UINT32)
+                                tmp.uint_value = fastA2UL(eqptr);
+                            else
+                                tmp.int_value = fastA2I(eqptr);
+
+                            changeValue = true;
                         }
                     }
-                    break;
-                case MODE_LOOKUP: {
-                        const lookupTableEntry_t *tableEntry = settingLookupTable(val);
-                        bool matched = false;
-                        for (uint32_t tableValueIndex = 0; tableValueIndex < tableEntry->valueCount && !matched; tableValueIndex++) {
-                            matched = sl_strcasecmp(tableEntry->values[tableValueIndex], eqptr) == 0;
-
-                            if (matched) {
-                                tmp.int_value = tableValueIndex;
-                                changeValue = true;
-                            }
+                }
+                break;
+            case MODE_LOOKUP: {
+                    const lookupTableEntry_t *tableEntry = settingLookupTable(val);
+                    bool matched = false;
+                    for (uint32_t tableValueIndex = 0; tableValueIndex < tableEntry->valueCount && !matched; tableValueIndex++) {
+                        matched = sl_strcasecmp(tableEntry->values[tableValueIndex], eqptr) == 0;
+
+                        if (matched) {
+                            tmp.int_value = tableValueIndex;
+                            changeValue = true;
                         }
                     }
-                    break;
                 }
+                break;
+            }
 
-                if (changeValue) {
-                    cliSetIntFloatVar(val, tmp);
-
-                    cliPrintf("%s set to ", name);
-                    cliPrintVar(val, 0);
-                } else {
-                    cliPrint("Invalid value. ");
-                    cliPrintVarRange(val);
-                    cliPrintLinefeed();
-                }
+            if (changeValue) {
+                cliSetIntFloatVar(val, tmp);
 
-                return;
+                cliPrintf("%s set to ", name);
+                cliPrintVar(val, 0);
+            } else {
+                cliPrint("Invalid value. ");
+                cliPrintVarRange(val);
+                cliPrintLinefeed();
             }
+
+            return;
         }
         cliPrintLine("Invalid name");
     } else {
@@ -2867,6 +2965,10 @@ const clicmd_t cmdTable[] = {
     CLI_COMMAND_DEF("dfu", "DFU mode on reboot", NULL, cliDfu),
     CLI_COMMAND_DEF("diff", "list configuration changes from default",
         "[master|battery_profile|profile|rates|all] {showdefaults}", cliDiff),
+#ifdef USE_DSHOT
+    CLI_COMMAND_DEF("dshot_cmd", "send DSHOT command to ESC (disarmed only)",
+        "<index|all> <command|beacon1..5|3d_off|3d_on|normal|reversed|save> ...", cliDshotCommand),
+#endif
     CLI_COMMAND_DEF("dump", "dump configuration",
         "[master|battery_profile|profile|rates|all] {showdefaults}", cliDump),
 #ifdef USE_RX_ELERES
@@ -2877,7 +2979,7 @@ const clicmd_t cmdTable[] = {
         "list\r\n"
         "\t<+|->[name]", cliFeature),
 #ifdef USE_FLASHFS
-    CLI_COMMAND_DEF("flash_erase", "erase flash chip", NULL, cliFlashErase),
+    CLI_COMMAND_DEF("flash_erase", "erase flash chip", "[used]", cliFlashErase),
     CLI_COMMAND_DEF("flash_info", "show flash chip info", NULL, cliFlashInfo),
 #ifdef USE_FLASH_TOOLS
     CLI_COMMAND_DEF("flash_read", NULL, "<length> <address>", cliFlashRead),
@@ -414,6 +414,11 @@ void resetEEPROM(void)
 void ensureEEPROMContainsValidData(void)
 {
     if (isEEPROMContentValid()) {
+        // Settings saved in the flat layout of earlier versions are saved again as a record log, once
+        if (isEEPROMContentLegacy()) {
+            loadEEPROM();
+            writeEEPROM();
+        }
         return;
     }
     resetEEPROM();
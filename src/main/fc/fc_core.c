@@ -768,7 +768,7 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
 
 #ifdef USE_BLACKBOX
     if (!cliMode && feature(FEATURE_BLACKBOX)) {
-        blackboxUpdate(micros());
+        blackboxCaptureLoopState(micros());
     }
 #endif
 }
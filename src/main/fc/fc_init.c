@@ -32,6 +32,7 @@
 #include "common/color.h"
 #include "common/maths.h"
 #include "common/printf.h"
+#include "common/utils.h"
 #include "common/memory.h"
 
 #include "config/config_eeprom.h"
@@ -171,6 +172,41 @@ void flashLedsAndBeep(void)
     LED1_OFF;
 }
 
+#if defined(USE_GPS) || defined(USE_MAG)
+#define SENSOR_POWER_UP_DELAY_MS            500
+#define SENSOR_COLD_BOOT_EXTRA_DELAY_MS     500
+
+static void waitForSensorPowerUp(timeMs_t deadline)
+{
+    addBootlogPhaseBegin(BOOT_EVENT_SENSOR_POWER_UP_WAIT);
+
+    /* Extra delay prior to initialising hardware if board is cold-booting */
+    if (!isMPUSoftReset()) {
+        addBootlogEvent2(BOOT_EVENT_EXTRA_BOOT_DELAY, BOOT_EVENT_FLAGS_NONE);
+
+        LED1_ON;
+        LED0_OFF;
+
+        int32_t remaining;
+        while ((remaining = cmp32(deadline, millis())) > 0) {
+            LED1_TOGGLE;
+            LED0_TOGGLE;
+            delay(MIN(remaining, 100));
+        }
+
+        LED0_OFF;
+        LED1_OFF;
+    } else {
+        const int32_t remaining = cmp32(deadline, millis());
+        if (remaining > 0) {
+            delay(remaining);
+        }
+    }
+
+    addBootlogPhaseEnd(BOOT_EVENT_SENSOR_POWER_UP_WAIT);
+}
+#endif
+
 void init(void)
 {
 #ifdef USE_HAL_DRIVER
@@ -196,9 +232,11 @@ void init(void)
     detectBrushedESC();
 #endif
 
+    addBootlogPhaseBegin(BOOT_EVENT_EEPROM_LOAD);
     initEEPROM();
     ensureEEPROMContainsValidData();
     readEEPROM();
+    addBootlogPhaseEnd(BOOT_EVENT_EEPROM_LOAD);
 
     // Re-initialize system clock to their final values (if necessary)
     systemClockSetup(systemConfig()->cpuUnderclock);
@@ -250,6 +288,7 @@ void init(void)
 
     timerInit();  // timer must be initialized before any channel is allocated
 
+    addBootlogPhaseBegin(BOOT_EVENT_SERIAL_INIT);
 #if defined(AVOID_UART2_FOR_PWM_PPM)
     serialInit(feature(FEATURE_SOFTSERIAL),
             (rxConfig()->receiverType == RX_TYPE_PWM) || (rxConfig()->receiverType == RX_TYPE_PPM) ? SERIAL_PORT_USART2 : SERIAL_PORT_NONE);
@@ -264,6 +303,7 @@ void init(void)
     // XXX: Don't call mspFcInit() yet, since it initializes the boxes and needs
     // to run after the sensors have been detected.
     mspSerialInit();
+    addBootlogPhaseEnd(BOOT_EVENT_SERIAL_INIT);
 
 #if defined(USE_DEBUG_TRACE)
     // Debug trace uses serial output, so we only can init it after serial port is ready
@@ -345,7 +385,9 @@ void init(void)
 #endif
 
     // pwmInit() needs to be called as soon as possible for ESC compatibility reasons
+    addBootlogPhaseBegin(BOOT_EVENT_PWM_INIT);
     pwmInit(&pwm_params);
+    addBootlogPhaseEnd(BOOT_EVENT_PWM_INIT);
 
     mixerUsePWMIOConfiguration();
 
@@ -378,6 +420,7 @@ void init(void)
 #endif
 
     // Initialize buses
+    addBootlogPhaseBegin(BOOT_EVENT_BUS_INIT);
     busInit();
 
 #ifdef USE_SPI
@@ -401,6 +444,8 @@ void init(void)
 #endif
 #endif
 
+    addBootlogPhaseEnd(BOOT_EVENT_BUS_INIT);
+
 #ifdef USE_HARDWARE_REVISION_DETECTION
     updateHardwareRevision();
 #endif
@@ -494,24 +539,28 @@ void init(void)
 #endif
 
 #if defined(USE_GPS) || defined(USE_MAG)
-    delay(500);
+    // GPS and mag need time to power up. Do the init that doesn't depend on them while waiting
+    const timeMs_t sensorPowerUpDeadline = millis() + SENSOR_POWER_UP_DELAY_MS + (isMPUSoftReset() ? 0 : SENSOR_COLD_BOOT_EXTRA_DELAY_MS);
+#endif
 
-    /* Extra 500ms delay prior to initialising hardware if board is cold-booting */
-    if (!isMPUSoftReset()) {
-        addBootlogEvent2(BOOT_EVENT_EXTRA_BOOT_DELAY, BOOT_EVENT_FLAGS_NONE);
+    addBootlogPhaseBegin(BOOT_EVENT_STORAGE_INIT);
+#ifdef USE_FLASHFS
+#ifdef USE_FLASH_M25P16
+    m25p16_init(0);
+#endif
 
-        LED1_ON;
-        LED0_OFF;
+    flashfsInit();
+#endif
 
-        for (int i = 0; i < 5; i++) {
-            LED1_TOGGLE;
-            LED0_TOGGLE;
-            delay(100);
-        }
+#ifdef USE_SDCARD
+    sdcardInsertionDetectInit();
+    sdcard_init();
+    afatfs_init();
+#endif
+    addBootlogPhaseEnd(BOOT_EVENT_STORAGE_INIT);
 
-        LED0_OFF;
-        LED1_OFF;
-    }
+#if defined(USE_GPS) || defined(USE_MAG)
+    waitForSensorPowerUp(sensorPowerUpDeadline);
 #endif
 
     initBoardAlignment();
@@ -537,10 +586,12 @@ void init(void)
     owInit();
 #endif
 
+    addBootlogPhaseBegin(BOOT_EVENT_SENSORS_AUTODETECT);
     if (!sensorsAutodetect()) {
         // if gyro was not detected due to whatever reason, we give up now.
         failureMode(FAILURE_MISSING_ACC);
     }
+    addBootlogPhaseEnd(BOOT_EVENT_SENSORS_AUTODETECT);
 
     addBootlogEvent2(BOOT_EVENT_SENSOR_INIT_DONE, BOOT_EVENT_FLAGS_NONE);
     systemState |= SYSTEM_STATE_SENSORS_READY;
@@ -567,6 +618,7 @@ void init(void)
 
 #ifdef USE_OSD
     if (feature(FEATURE_OSD)) {
+        addBootlogPhaseBegin(BOOT_EVENT_OSD_INIT);
 #if defined(USE_MAX7456)
         // If there is a max7456 chip for the OSD then use it
         osdDisplayPort = max7456DisplayPortInit(osdConfig()->video_system);
@@ -575,6 +627,7 @@ void init(void)
 #endif
         // osdInit  will register with CMS by itself.
         osdInit(osdDisplayPort);
+        addBootlogPhaseEnd(BOOT_EVENT_OSD_INIT);
     }
 #endif
 
@@ -617,20 +670,6 @@ void init(void)
     }
 #endif
 
-#ifdef USE_FLASHFS
-#ifdef USE_FLASH_M25P16
-    m25p16_init(0);
-#endif
-
-    flashfsInit();
-#endif
-
-#ifdef USE_SDCARD
-    sdcardInsertionDetectInit();
-    sdcard_init();
-    afatfs_init();
-#endif
-
 #ifdef USE_BLACKBOX
     blackboxInit();
 #endif
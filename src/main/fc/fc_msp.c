@@ -30,6 +30,7 @@
 
 #include "common/axis.h"
 #include "common/color.h"
+#include "common/crc.h"
 #include "common/maths.h"
 #include "common/streambuf.h"
 #include "common/bitarray.h"
@@ -41,8 +42,10 @@
 #include "drivers/accgyro/accgyro.h"
 #include "drivers/bus_i2c.h"
 #include "drivers/compass/compass.h"
+#include "drivers/logging.h"
 #include "drivers/max7456.h"
 #include "drivers/pwm_mapping.h"
+#include "drivers/pwm_output.h"
 #include "drivers/sdcard.h"
 #include "drivers/serial.h"
 #include "drivers/system.h"
@@ -246,7 +249,7 @@ static void serializeDataflashSummaryReply(sbuf_t *dst)
     const flashGeometry_t *geometry = flashfsGetGeometry();
     sbufWriteU8(dst, flashfsIsReady() ? 1 : 0);
     sbufWriteU32(dst, geometry->sectors);
-    sbufWriteU32(dst, geometry->totalSize);
+    sbufWriteU32(dst, flashfsGetSize()); // Space for logs, the last sector holds their directory
     sbufWriteU32(dst, flashfsGetOffset()); // Effectively the current number of bytes stored on the volume
 #else
     sbufWriteU8(dst, 0);
@@ -257,8 +260,22 @@ static void serializeDataflashSummaryReply(sbuf_t *dst)
 }
 
 #ifdef USE_FLASHFS
-static void serializeDataflashReadReply(sbuf_t *dst, uint32_t address, uint16_t size)
+#define MSP_DATAFLASH_READ_PACK_ERASED  (1 << 0)
+
+static void serializeDataflashReadReply(sbuf_t *dst, uint32_t address, uint16_t size, uint8_t flags)
 {
+    // Write address
+    sbufWriteU32(dst, address);
+
+    /*
+     * Packed reply: U16 bytes read, U16 CRC16-CCITT of the bytes read, U8 number of erased runs, the bytes read without
+     * the runs, then the runs as {U16 offset, U16 length}. Never longer than the plain reply.
+     */
+    sbuf_t info = { .ptr = sbufPtr(dst), .end = sbufPtr(dst) + 5 };
+    if (flags & MSP_DATAFLASH_READ_PACK_ERASED) {
+        sbufAdvance(dst, 5);
+    }
+
     // Check how much bytes we can read
     const int bytesRemainingInBuf = sbufBytesRemaining(dst);
     uint16_t readLen = (size > bytesRemainingInBuf) ? bytesRemainingInBuf : size;
@@ -270,12 +287,19 @@ static void serializeDataflashReadReply(sbuf_t *dst, uint32_t address, uint16_t
         readLen = flashfsSize - address;
     }
 
-    // Write address
-    sbufWriteU32(dst, address);
-
     // Read into streambuf directly
     const int bytesRead = flashfsReadAbs(address, sbufPtr(dst), readLen);
-    sbufAdvance(dst, bytesRead);
+
+    if (flags & MSP_DATAFLASH_READ_PACK_ERASED) {
+        unsigned runCount;
+
+        sbufWriteU16(&info, bytesRead);
+        sbufWriteU16(&info, crc16_ccitt_update(0, sbufPtr(dst), bytesRead));
+        sbufAdvance(dst, flashfsPackErasedRuns(sbufPtr(dst), bytesRead, &runCount));
+        sbufWriteU8(&info, runCount);
+    } else {
+        sbufAdvance(dst, bytesRead);
+    }
 }
 #endif
 
@@ -1425,6 +1449,20 @@ static bool mspFcProcessOutCommand(uint16_t cmdMSP, sbuf_t *dst, mspPostProcessF
         break;
 #endif
 
+#ifdef USE_BOOTLOG
+    case MSP2_INAV_BOOTLOG:
+        // Init phase timing: code, start (us since power up), duration (us)
+        for (int idx = 0; idx < getBootlogEventCount(); idx++) {
+            const bootLogEntry_t *event = getBootlogEvent(idx);
+            if ((event->eventFlags & BOOT_EVENT_FLAGS_PHASE_END) && sbufBytesRemaining(dst) >= 9) {
+                sbufWriteU8(dst, event->eventCode);
+                sbufWriteU32(dst, event->params.u32[0]);
+                sbufWriteU32(dst, event->params.u32[1]);
+            }
+        }
+        break;
+#endif
+
     default:
         return false;
     }
@@ -1432,9 +1470,8 @@ static bool mspFcProcessOutCommand(uint16_t cmdMSP, sbuf_t *dst, mspPostProcessF
 }
 
 #ifdef USE_NAV
-static void mspFcWaypointOutCommand(sbuf_t *dst, sbuf_t *src)
+static void mspFcSerializeWaypoint(sbuf_t *dst, uint8_t msp_wp_no)
 {
-    const uint8_t msp_wp_no = sbufReadU8(src);    // get the wp number
     navWaypoint_t msp_wp;
     getWaypoint(msp_wp_no, &msp_wp);
     sbufWriteU8(dst, msp_wp_no);   // wp_no
@@ -1447,6 +1484,54 @@ static void mspFcWaypointOutCommand(sbuf_t *dst, sbuf_t *src)
     sbufWriteU16(dst, msp_wp.p3);     // P3
     sbufWriteU8(dst, msp_wp.flag);    // flags
 }
+
+static void mspFcDeserializeWaypoint(sbuf_t *src)
+{
+    const uint8_t msp_wp_no = sbufReadU8(src);     // get the waypoint number
+    navWaypoint_t msp_wp;
+    msp_wp.action = sbufReadU8(src);    // action
+    msp_wp.lat = sbufReadU32(src);      // lat
+    msp_wp.lon = sbufReadU32(src);      // lon
+    msp_wp.alt = sbufReadU32(src);      // to set altitude (cm)
+    msp_wp.p1 = sbufReadU16(src);       // P1
+    msp_wp.p2 = sbufReadU16(src);       // P2
+    msp_wp.p3 = sbufReadU16(src);       // P3
+    msp_wp.flag = sbufReadU8(src);      // future: to set nav flag
+    setWaypoint(msp_wp_no, &msp_wp);
+}
+
+static void mspFcWaypointOutCommand(sbuf_t *dst, sbuf_t *src)
+{
+    mspFcSerializeWaypoint(dst, sbufReadU8(src));
+}
+
+/*
+ * Mission as consecutive MSP_WP records of waypoints 1..count, read by byte offset so it can be
+ * streamed with MSP2_INAV_CHUNK_STREAM. Request: U32 offset, U16 size. Reply: U32 offset, whole records.
+ */
+static bool mspFcWaypointBlockCommand(sbuf_t *dst, sbuf_t *src)
+{
+    if (sbufBytesRemaining(src) < 6) {
+        return false;
+    }
+
+    const uint32_t offset = sbufReadU32(src);
+    const uint16_t size = sbufReadU16(src);
+
+    if (offset % MSP_WP_RECORD_SIZE) {
+        return false;
+    }
+
+    sbufWriteU32(dst, offset);
+
+    const int firstWp = offset / MSP_WP_RECORD_SIZE + 1;
+    const int lastWp = MIN(getWaypointCount(), firstWp + size / MSP_WP_RECORD_SIZE - 1);
+    for (int wp = firstWp; wp <= lastWp && sbufBytesRemaining(dst) >= MSP_WP_RECORD_SIZE; wp++) {
+        mspFcSerializeWaypoint(dst, wp);
+    }
+
+    return true;
+}
 #endif
 
 #ifdef USE_FLASHFS
@@ -1454,12 +1539,14 @@ static void mspFcDataFlashReadCommand(sbuf_t *dst, sbuf_t *src)
 {
     const unsigned int dataSize = sbufBytesRemaining(src);
     uint16_t readLength;
+    uint8_t flags = 0;
 
     const uint32_t readAddress = sbufReadU32(src);
 
     // Request payload:
     //  uint32_t    - address to read from
     //  uint16_t    - size of block to read (optional)
+    //  uint8_t     - MSP_DATAFLASH_READ_* flags (optional)
     if (dataSize >= sizeof(uint32_t) + sizeof(uint16_t)) {
         readLength = sbufReadU16(src);
     }
@@ -1467,7 +1554,31 @@ static void mspFcDataFlashReadCommand(sbuf_t *dst, sbuf_t *src)
         readLength = 128;
     }
 
-    serializeDataflashReadReply(dst, readAddress, readLength);
+    if (dataSize >= sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint8_t)) {
+        flags = sbufReadU8(src);
+    }
+
+    serializeDataflashReadReply(dst, readAddress, readLength, flags);
+}
+
+static void mspFcDataFlashLogsCommand(sbuf_t *dst, sbuf_t *src)
+{
+    int start = 0;
+    if (sbufBytesRemaining(src) >= 2) {
+        start = sbufReadU16(src);
+    }
+
+    // Logs in the order they were written, client pages through the list by passing the index of the first one it wants.
+    // Any log can then be fetched with MSP_DATAFLASH_READ from its start address.
+    sbufWriteU16(dst, flashfsGetLogCount());
+    sbufWriteU16(dst, start);
+
+    flashfsLogEntry_t log;
+    for (int i = start; sbufBytesRemaining(dst) >= 12 && flashfsGetLog(i, &log); i++) {
+        sbufWriteU32(dst, log.start);
+        sbufWriteU32(dst, log.length);
+        sbufWriteU32(dst, log.timestamp);
+    }
 }
 #endif
 
@@ -2241,7 +2352,12 @@ static mspResult_e mspFcProcessInCommand(uint16_t cmdMSP, sbuf_t *src)
 
 #ifdef USE_FLASHFS
     case MSP_DATAFLASH_ERASE:
-        flashfsEraseCompletely();
+        // An optional byte of 1 erases only the used part of the flash
+        if (dataSize >= 1 && sbufReadU8(src) == 1) {
+            flashfsEraseUsed();
+        } else {
+            flashfsEraseCompletely();
+        }
         break;
 #endif
 
@@ -2276,18 +2392,18 @@ static mspResult_e mspFcProcessInCommand(uint16_t cmdMSP, sbuf_t *src)
 
 #ifdef USE_NAV
     case MSP_SET_WP:
-        if (dataSize >= 21) {
-            const uint8_t msp_wp_no = sbufReadU8(src);     // get the waypoint number
-            navWaypoint_t msp_wp;
-            msp_wp.action = sbufReadU8(src);    // action
-            msp_wp.lat = sbufReadU32(src);      // lat
-            msp_wp.lon = sbufReadU32(src);      // lon
-            msp_wp.alt = sbufReadU32(src);      // to set altitude (cm)
-            msp_wp.p1 = sbufReadU16(src);       // P1
-            msp_wp.p2 = sbufReadU16(src);       // P2
-            msp_wp.p3 = sbufReadU16(src);       // P3
-            msp_wp.flag = sbufReadU8(src);      // future: to set nav flag
-            setWaypoint(msp_wp_no, &msp_wp);
+        if (dataSize >= MSP_WP_RECORD_SIZE) {
+            mspFcDeserializeWaypoint(src);
+        } else
+            return MSP_RESULT_ERROR;
+        break;
+
+    case MSP2_INAV_SET_WP_BLOCK:
+        // Several MSP_SET_WP records in one frame, applied in order
+        if (dataSize >= MSP_WP_RECORD_SIZE && (dataSize % MSP_WP_RECORD_SIZE) == 0) {
+            while (sbufBytesRemaining(src) >= MSP_WP_RECORD_SIZE) {
+                mspFcDeserializeWaypoint(src);
+            }
         } else
             return MSP_RESULT_ERROR;
         break;
@@ -2671,6 +2787,20 @@ static mspResult_e mspFcProcessInCommand(uint16_t cmdMSP, sbuf_t *src)
         }
         break;
 
+#ifdef USE_DSHOT
+    case MSP2_INAV_DSHOT_COMMAND:
+        // Motor index (255 - all motors) followed by one or more DSHOT commands
+        // Commands are validated together and queued all or none
+        if (dataSize >= 2) {
+            const uint8_t motorIndex = sbufReadU8(src);
+            if (!pwmRequestDshotCommands(motorIndex, sbufPtr(src), sbufBytesRemaining(src))) {
+                return MSP_RESULT_ERROR;
+            }
+        } else
+            return MSP_RESULT_ERROR;
+        break;
+#endif
+
 #ifdef USE_TEMPERATURE_SENSOR
     case MSP2_INAV_SET_TEMP_SENSOR_CONFIG:
         if (dataSize == sizeof(tempSensorConfig_t) * MAX_TEMP_SENSORS) {
@@ -2738,19 +2868,11 @@ static bool mspSettingCommand(sbuf_t *dst, sbuf_t *src)
     return true;
 }
 
-static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
+static bool mspSetSettingValue(const setting_t *setting, void *ptr, sbuf_t *src)
 {
-    UNUSED(dst);
-
-    const setting_t *setting = mspReadSetting(src);
-    if (!setting) {
-        return false;
-    }
-
     setting_min_t min = settingGetMin(setting);
     setting_max_t max = settingGetMax(setting);
 
-    void *ptr = settingGetValuePointer(setting);
     switch (SETTING_TYPE(setting)) {
         case VAR_UINT8:
             {
@@ -2826,7 +2948,10 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
             break;
         case VAR_STRING:
             {
-                settingSetString(setting, (const char*)sbufPtr(src), sbufBytesRemaining(src));
+                char *str = ptr;
+                const size_t size = MIN((size_t)sbufBytesRemaining(src), settingGetMax(setting));
+                memcpy(str, sbufPtr(src), size);
+                str[size] = '\0';
             }
             break;
     }
@@ -2834,6 +2959,197 @@ static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
     return true;
 }
 
+static bool mspSetSettingCommand(sbuf_t *dst, sbuf_t *src)
+{
+    UNUSED(dst);
+
+    const setting_t *setting = mspReadSetting(src);
+    if (!setting) {
+        return false;
+    }
+
+    return mspSetSettingValue(setting, settingGetValuePointer(setting), src);
+}
+
+#define MSP_SETTING_RECORD_HEADER_SIZE  4
+
+typedef enum {
+    MSP_SETTINGS_IMPORT_BEGIN = 0,
+    MSP_SETTINGS_IMPORT_DATA = 1,
+    MSP_SETTINGS_IMPORT_COMMIT = 2,
+} mspSettingsImportOp_e;
+
+static struct {
+    bool active;
+    uint16_t crc;
+} mspSettingsImport;
+
+/*
+ * Bulk record: U16 setting index, U8 profile index, U8 setting type, raw value (settingGetValueSize bytes).
+ * Profile and battery profile settings have a record for every profile, master settings only one with index 0.
+ */
+static uint16_t mspSettingRecordCrc(uint16_t crc, const setting_t *setting, uint8_t profileIndex)
+{
+    const uint16_t index = settingGetIndex(setting);
+    const uint8_t header[MSP_SETTING_RECORD_HEADER_SIZE] = { index & 0xFF, index >> 8, profileIndex, SETTING_TYPE(setting) };
+
+    crc = crc16_ccitt_update(crc, header, sizeof(header));
+    return crc16_ccitt_update(crc, settingGetProfileValuePointer(setting, profileIndex), settingGetValueSize(setting));
+}
+
+/*
+ * Request: U16 start record (optional).
+ * Reply: U16 record count, U16 CRC16-CCITT of all records, U16 start record, U16 records in this reply, records.
+ * Records are added while they fit, the client continues from start record + records in this reply.
+ */
+static bool mspSettingsExportCommand(sbuf_t *dst, sbuf_t *src)
+{
+    uint16_t start = 0;
+    sbufReadU16Safe(&start, src);
+
+    uint16_t total = 0;
+    uint16_t crc = 0;
+    for (unsigned ii = 0; ii < SETTINGS_TABLE_COUNT; ii++) {
+        const setting_t *setting = settingGet(ii);
+        for (uint8_t profileIndex = 0; profileIndex < settingGetProfileCount(setting); profileIndex++) {
+            crc = mspSettingRecordCrc(crc, setting, profileIndex);
+            total++;
+        }
+    }
+
+    if (start > total) {
+        return false;
+    }
+
+    sbufWriteU16(dst, total);
+    sbufWriteU16(dst, crc);
+    sbufWriteU16(dst, start);
+    uint8_t *countPtr = sbufPtr(dst);
+    sbufWriteU16(dst, 0);
+
+    uint16_t record = 0;
+    uint16_t count = 0;
+    bool full = false;
+    for (unsigned ii = 0; ii < SETTINGS_TABLE_COUNT && !full; ii++) {
+        const setting_t *setting = settingGet(ii);
+        const size_t size = settingGetValueSize(setting);
+
+        for (uint8_t profileIndex = 0; profileIndex < settingGetProfileCount(setting); profileIndex++, record++) {
+            if (record < start) {
+                continue;
+            }
+            if ((size_t)sbufBytesRemaining(dst) < MSP_SETTING_RECORD_HEADER_SIZE + size) {
+                full = true;
+                break;
+            }
+
+            sbufWriteU16(dst, ii);
+            sbufWriteU8(dst, profileIndex);
+            sbufWriteU8(dst, SETTING_TYPE(setting));
+            sbufWriteData(dst, settingGetProfileValuePointer(setting, profileIndex), size);
+            count++;
+        }
+    }
+
+    countPtr[0] = count & 0xFF;
+    countPtr[1] = count >> 8;
+
+    return true;
+}
+
+static void mspSettingsImportAbort(void)
+{
+    // Values are applied as they arrive, restore the stored configuration
+    mspSettingsImport.active = false;
+    readEEPROM();
+}
+
+static bool mspSettingsImportRecords(sbuf_t *src)
+{
+    while (sbufBytesRemaining(src) > 0) {
+        uint16_t index;
+        uint8_t profileIndex;
+        uint8_t type;
+        if (!sbufReadU16Safe(&index, src) || !sbufReadU8Safe(&profileIndex, src) || !sbufReadU8Safe(&type, src)) {
+            return false;
+        }
+
+        const setting_t *setting = settingGet(index);
+        if (!setting || profileIndex >= settingGetProfileCount(setting) || SETTING_TYPE(setting) != type) {
+            return false;
+        }
+
+        const size_t size = settingGetValueSize(setting);
+        if ((size_t)sbufBytesRemaining(src) < size) {
+            return false;
+        }
+
+        sbuf_t value;
+        sbufInit(&value, sbufPtr(src), sbufPtr(src) + size);
+        if (!mspSetSettingValue(setting, settingGetProfileValuePointer(setting, profileIndex), &value)) {
+            return false;
+        }
+
+        // CRC covers the received record, which matches the export of the value that was just set
+        mspSettingsImport.crc = crc16_ccitt_update(mspSettingsImport.crc, sbufPtr(src) - MSP_SETTING_RECORD_HEADER_SIZE, MSP_SETTING_RECORD_HEADER_SIZE + size);
+        sbufAdvance(src, size);
+    }
+
+    return true;
+}
+
+/*
+ * Request: U8 operation followed by its data.
+ *  BEGIN:  starts a transaction.
+ *  DATA:   records in the export format, applied to the running configuration.
+ *  COMMIT: U16 CRC16-CCITT of all records sent, on a match the configuration is written to EEPROM once.
+ * Any failure aborts the transaction and reloads the stored configuration.
+ */
+static mspResult_e mspSettingsImportCommand(sbuf_t *src)
+{
+    uint8_t op;
+    if (ARMING_FLAG(ARMED) || !sbufReadU8Safe(&op, src)) {
+        return MSP_RESULT_ERROR;
+    }
+
+    if (op == MSP_SETTINGS_IMPORT_BEGIN) {
+        mspSettingsImport.active = true;
+        mspSettingsImport.crc = 0;
+        return MSP_RESULT_ACK;
+    }
+
+    if (!mspSettingsImport.active) {
+        return MSP_RESULT_ERROR;
+    }
+
+    switch (op) {
+    case MSP_SETTINGS_IMPORT_DATA:
+        if (mspSettingsImportRecords(src)) {
+            return MSP_RESULT_ACK;
+        }
+        break;
+
+    case MSP_SETTINGS_IMPORT_COMMIT:
+        {
+            uint16_t crc;
+            unsigned invalidIndex;
+            if (sbufReadU16Safe(&crc, src) && crc == mspSettingsImport.crc && settingsValidate(&invalidIndex)) {
+                mspSettingsImport.active = false;
+                writeEEPROM();
+                readEEPROM();
+                return MSP_RESULT_ACK;
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    mspSettingsImportAbort();
+    return MSP_RESULT_ERROR;
+}
+
 static bool mspSettingInfoCommand(sbuf_t *dst, sbuf_t *src)
 {
     const setting_t *setting = mspReadSetting(src);
@@ -2922,6 +3238,132 @@ static bool mspParameterGroupsCommand(sbuf_t *dst, sbuf_t *src)
     return true;
 }
 
+// Out handlers don't check for buffer space, only start one while a worst case reply still fits
+#define MSP_MULTI_REQUEST_RESERVE       256
+#define MSP_MULTI_REQUEST_MAX_PAYLOAD   254
+#define MSP_MULTI_REQUEST_FAILED        0xFF
+
+/*
+ * Request: list of U16 command ids. Reply: for each id, in request order, U8 payload size followed by the payload.
+ * Size MSP_MULTI_REQUEST_FAILED marks a command that is unknown, not a read-only command or doesn't fit.
+ * Processing stops early when the reply buffer runs out of space, the client re-requests the remaining ids.
+ */
+static bool mspFcMultiRequestCommand(sbuf_t *dst, sbuf_t *src)
+{
+    while (sbufBytesRemaining(src) >= 2 && sbufBytesRemaining(dst) >= 1 + MSP_MULTI_REQUEST_RESERVE) {
+        const uint16_t cmdMSP = sbufReadU16(src);
+        uint8_t *sizePtr = sbufPtr(dst);
+        sbufWriteU8(dst, MSP_MULTI_REQUEST_FAILED);
+
+        sbuf_t payload;
+        sbufInit(&payload, sbufPtr(dst), dst->end);
+
+        // Only side effect free output commands can be batched, post-process functions (reboot) are not run
+        if (mspFcProcessOutCommand(cmdMSP, &payload, NULL)) {
+            const int payloadSize = sbufPtr(&payload) - sbufPtr(dst);
+            if (payloadSize <= MSP_MULTI_REQUEST_MAX_PAYLOAD) {
+                *sizePtr = payloadSize;
+                sbufAdvance(dst, payloadSize);
+            }
+        }
+    }
+
+    return true;
+}
+
+typedef enum {
+    MSP_HANDLER_UNKNOWN = 0,
+    MSP_HANDLER_SENSOR,
+    MSP_HANDLER_OUT,
+    MSP_HANDLER_4WAY,
+    MSP_HANDLER_INOUT,
+    MSP_HANDLER_IN,
+} mspHandlerType_e;
+
+#ifdef USE_MSP_STATISTICS
+#define MSP_V1_COMMAND_COUNT        256
+#define MSP_V2_STATS_MAX_COMMANDS   48
+
+typedef struct mspCommandStats_s {
+    uint16_t cmd;
+    uint8_t handler;        // mspHandlerType_e, learned on first dispatch of the command
+    uint32_t calls;
+    uint32_t totalTimeUs;
+} mspCommandStats_t;
+
+// MSP v1 commands are indexed directly, MSP2 commands are kept sorted and looked up by binary search
+static mspCommandStats_t mspV1Stats[MSP_V1_COMMAND_COUNT];
+static mspCommandStats_t mspV2Stats[MSP_V2_STATS_MAX_COMMANDS];
+static uint8_t mspV2StatsCount;
+
+static mspCommandStats_t *mspGetCommandStats(uint16_t cmdMSP)
+{
+    if (cmdMSP < MSP_V1_COMMAND_COUNT) {
+        mspV1Stats[cmdMSP].cmd = cmdMSP;
+        return &mspV1Stats[cmdMSP];
+    }
+
+    int low = 0;
+    int high = mspV2StatsCount - 1;
+    while (low <= high) {
+        const int mid = (low + high) / 2;
+        if (mspV2Stats[mid].cmd < cmdMSP) {
+            low = mid + 1;
+        } else if (mspV2Stats[mid].cmd > cmdMSP) {
+            high = mid - 1;
+        } else {
+            return &mspV2Stats[mid];
+        }
+    }
+
+    // Not seen before, insert at the position found by the search
+    if (mspV2StatsCount >= MSP_V2_STATS_MAX_COMMANDS) {
+        return NULL;
+    }
+
+    memmove(&mspV2Stats[low + 1], &mspV2Stats[low], (mspV2StatsCount - low) * sizeof(mspCommandStats_t));
+    memset(&mspV2Stats[low], 0, sizeof(mspCommandStats_t));
+    mspV2Stats[low].cmd = cmdMSP;
+    mspV2StatsCount++;
+
+    return &mspV2Stats[low];
+}
+
+static bool mspStatsCommand(sbuf_t *dst, sbuf_t *src)
+{
+    unsigned start = 0;
+    if (sbufBytesRemaining(src) >= 2) {
+        start = sbufReadU16(src);
+    }
+
+    unsigned activeCount = mspV2StatsCount;
+    for (unsigned i = 0; i < MSP_V1_COMMAND_COUNT; i++) {
+        if (mspV1Stats[i].calls) {
+            activeCount++;
+        }
+    }
+
+    sbufWriteU16(dst, activeCount);
+
+    // Entries ordered by command id, client pages through the list by passing the index of the first entry it wants
+    const unsigned tableSize = MSP_V1_COMMAND_COUNT + mspV2StatsCount;
+    unsigned index = 0;
+    for (unsigned i = 0; i < tableSize && sbufBytesRemaining(dst) >= 10; i++) {
+        const mspCommandStats_t *stats = (i < MSP_V1_COMMAND_COUNT) ? &mspV1Stats[i] : &mspV2Stats[i - MSP_V1_COMMAND_COUNT];
+
+        if (stats->calls == 0 || index++ < start) {
+            continue;
+        }
+
+        sbufWriteU16(dst, stats->cmd);
+        sbufWriteU32(dst, stats->calls);
+        sbufWriteU32(dst, stats->totalTimeUs);
+    }
+
+    return true;
+}
+#endif
+
 bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResult_e *ret)
 {
     switch (cmdMSP) {
@@ -2931,6 +3373,10 @@ bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResu
         mspFcWaypointOutCommand(dst, src);
         *ret = MSP_RESULT_ACK;
         break;
+
+    case MSP2_INAV_WP_BLOCK:
+        *ret = mspFcWaypointBlockCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
+        break;
 #endif
 
 #if defined(USE_FLASHFS)
@@ -2938,6 +3384,11 @@ bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResu
         mspFcDataFlashReadCommand(dst, src);
         *ret = MSP_RESULT_ACK;
         break;
+
+    case MSP2_INAV_DATAFLASH_LOGS:
+        mspFcDataFlashLogsCommand(dst, src);
+        *ret = MSP_RESULT_ACK;
+        break;
 #endif
 
     case MSP2_COMMON_SETTING:
@@ -2952,10 +3403,28 @@ bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResu
         *ret = mspSettingInfoCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
         break;
 
+    case MSP2_COMMON_SETTINGS_EXPORT:
+        *ret = mspSettingsExportCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
+        break;
+
+    case MSP2_COMMON_SETTINGS_IMPORT:
+        *ret = mspSettingsImportCommand(src);
+        break;
+
     case MSP2_COMMON_PG_LIST:
         *ret = mspParameterGroupsCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
         break;
 
+    case MSP2_INAV_MULTI_REQUEST:
+        *ret = mspFcMultiRequestCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
+        break;
+
+#ifdef USE_MSP_STATISTICS
+    case MSP2_INAV_MSP_STATS:
+        *ret = mspStatsCommand(dst, src) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
+        break;
+#endif
+
 #if defined(USE_OSD)
     case MSP2_INAV_OSD_LAYOUTS:
         if (sbufBytesRemaining(src) >= 1) {
@@ -3015,32 +3484,93 @@ static mspResult_e mspProcessSensorCommand(uint16_t cmdMSP, sbuf_t *src)
     return MSP_RESULT_NO_REPLY;
 }
 
+/*
+ * Walks the handler chain. Once a command has been dispatched its handler type is known
+ * and the handlers that don't implement it are skipped on subsequent calls.
+ */
+static mspResult_e mspFcDispatchCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspPostProcessFnPtr *mspPostProcessFn, mspHandlerType_e *handler)
+{
+    const mspHandlerType_e knownHandler = *handler;
+    mspResult_e ret = MSP_RESULT_ACK;
+
+    if ((knownHandler == MSP_HANDLER_UNKNOWN || knownHandler == MSP_HANDLER_SENSOR) && MSP2_IS_SENSOR_MESSAGE(cmdMSP)) {
+        *handler = MSP_HANDLER_SENSOR;
+        return mspProcessSensorCommand(cmdMSP, src);
+    }
+
+    if (knownHandler == MSP_HANDLER_UNKNOWN || knownHandler == MSP_HANDLER_OUT) {
+        if (mspFcProcessOutCommand(cmdMSP, dst, mspPostProcessFn)) {
+            *handler = MSP_HANDLER_OUT;
+            return MSP_RESULT_ACK;
+        }
+        if (knownHandler == MSP_HANDLER_OUT) {
+            // Claimed before but can't reply this time, no other handler implements it
+            return MSP_RESULT_ERROR;
+        }
+    }
+
+#ifdef USE_SERIAL_4WAY_BLHELI_INTERFACE
+    if (cmdMSP == MSP_SET_4WAY_IF) {
+        *handler = MSP_HANDLER_4WAY;
+        mspFc4waySerialCommand(dst, src, mspPostProcessFn);
+        return MSP_RESULT_ACK;
+    }
+#endif
+
+    if (knownHandler == MSP_HANDLER_UNKNOWN || knownHandler == MSP_HANDLER_INOUT) {
+        if (mspFCProcessInOutCommand(cmdMSP, dst, src, &ret)) {
+            *handler = MSP_HANDLER_INOUT;
+            return ret;
+        }
+        if (knownHandler == MSP_HANDLER_INOUT) {
+            return MSP_RESULT_ERROR;
+        }
+    }
+
+    // The in handler answers unknown commands with an error, so only a
+    // successful command proves it is implemented there
+    ret = mspFcProcessInCommand(cmdMSP, src);
+    if (ret != MSP_RESULT_ERROR) {
+        *handler = MSP_HANDLER_IN;
+    }
+    return ret;
+}
+
 /*
  * Returns MSP_RESULT_ACK, MSP_RESULT_ERROR or MSP_RESULT_NO_REPLY
  */
 mspResult_e mspFcProcessCommand(mspPacket_t *cmd, mspPacket_t *reply, mspPostProcessFnPtr *mspPostProcessFn)
 {
-    mspResult_e ret = MSP_RESULT_ACK;
+    mspResult_e ret;
     sbuf_t *dst = &reply->buf;
     sbuf_t *src = &cmd->buf;
     const uint16_t cmdMSP = cmd->cmd;
     // initialize reply by default
     reply->cmd = cmd->cmd;
 
-    if (MSP2_IS_SENSOR_MESSAGE(cmdMSP)) {
-        ret = mspProcessSensorCommand(cmdMSP, src);
-    } else if (mspFcProcessOutCommand(cmdMSP, dst, mspPostProcessFn)) {
-        ret = MSP_RESULT_ACK;
-#ifdef USE_SERIAL_4WAY_BLHELI_INTERFACE
-    } else if (cmdMSP == MSP_SET_4WAY_IF) {
-        mspFc4waySerialCommand(dst, src, mspPostProcessFn);
-        ret = MSP_RESULT_ACK;
-#endif
-    } else {
-        if (!mspFCProcessInOutCommand(cmdMSP, dst, src, &ret)) {
-            ret = mspFcProcessInCommand(cmdMSP, src);
-        }
+    // Push subscriptions may only render output commands, these are free of side effects
+    if (cmd->flags & MSP_FLAG_OUT_ONLY) {
+        ret = mspFcProcessOutCommand(cmdMSP, dst, NULL) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
+        reply->result = ret;
+        return ret;
+    }
+
+#ifdef USE_MSP_STATISTICS
+    mspCommandStats_t *stats = mspGetCommandStats(cmdMSP);
+    mspHandlerType_e handler = stats ? stats->handler : MSP_HANDLER_UNKNOWN;
+    const timeUs_t startTime = micros();
+
+    ret = mspFcDispatchCommand(cmdMSP, dst, src, mspPostProcessFn, &handler);
+
+    if (stats) {
+        stats->handler = handler;
+        stats->calls++;
+        stats->totalTimeUs += micros() - startTime;
     }
+#else
+    mspHandlerType_e handler = MSP_HANDLER_UNKNOWN;
+    ret = mspFcDispatchCommand(cmdMSP, dst, src, mspPostProcessFn, &handler);
+#endif
 
     // Process DONT_REPLY flag
     if (cmd->flags & MSP_FLAG_DONT_REPLY) {
@@ -21,6 +21,8 @@
 
 #include "platform.h"
 
+#include "blackbox/blackbox.h"
+
 #include "cms/cms.h"
 
 #include "common/axis.h"
@@ -94,6 +96,11 @@ void taskHandleSerial(timeUs_t currentTimeUs)
 
     // Allow MSP processing even if in CLI mode
     mspSerialProcess(ARMING_FLAG(ARMED) ? MSP_SKIP_NON_MSP_DATA : MSP_EVALUATE_NON_MSP_DATA, mspFcProcessCommand);
+
+    // Chunked transfers such as dataflash downloads are paced by the task rate, stream them as fast as the link takes.
+    // Never while armed, the faster rate would take time from the control loop
+    const bool fastTransfer = mspSerialTransferActive() && !ARMING_FLAG(ARMED);
+    rescheduleTask(TASK_SELF, fastTransfer ? TASK_PERIOD_HZ(1000) : TASK_PERIOD_HZ(100));
 }
 
 void taskUpdateBattery(timeUs_t currentTimeUs)
@@ -262,6 +269,15 @@ void taskUpdateOsd(timeUs_t currentTimeUs)
 }
 #endif
 
+#ifdef USE_BLACKBOX
+void taskBlackbox(timeUs_t currentTimeUs)
+{
+    if (!cliMode && feature(FEATURE_BLACKBOX)) {
+        blackboxUpdate(currentTimeUs);
+    }
+}
+#endif
+
 void fcTasksInit(void)
 {
     schedulerInit();
@@ -269,6 +285,12 @@ void fcTasksInit(void)
     rescheduleTask(TASK_GYROPID, getLooptime());
     setTaskEnabled(TASK_GYROPID, true);
 
+#ifdef USE_BLACKBOX
+    // The flight loop captures logged iterations into a ring, drain it when about half full
+    rescheduleTask(TASK_BLACKBOX, getLooptime() * 2);
+    setTaskEnabled(TASK_BLACKBOX, feature(FEATURE_BLACKBOX));
+#endif
+
     setTaskEnabled(TASK_SERIAL, true);
 #ifdef BEEPER
     setTaskEnabled(TASK_BEEPER, true);
@@ -542,4 +564,13 @@ cfTask_t cfTasks[TASK_COUNT] = {
         .staticPriority = TASK_PRIORITY_IDLE,
     },
 #endif
+
+#ifdef USE_BLACKBOX
+    [TASK_BLACKBOX] = {
+        .taskName = "BLACKBOX",
+        .taskFunc = taskBlackbox,
+        .desiredPeriod = TASK_PERIOD_US(1000),  // Rescheduled from the looptime in fcTasksInit()
+        .staticPriority = TASK_PRIORITY_MEDIUM,
+    },
+#endif
 };
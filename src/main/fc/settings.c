@@ -107,17 +107,26 @@ bool settingNameIsExactMatch(const setting_t *val, char *buf, const char *cmdlin
 	return sl_strncasecmp(cmdline, buf, strlen(buf)) == 0 && var_name_length == strlen(buf);
 }
 
+// FNV-1a, seeded through the offset basis. Must match NameHash in utils/settings.rb
+static uint32_t settingNameHash(const char *name, uint32_t seed)
+{
+	uint32_t hash = 2166136261U ^ seed;
+	while (*name) {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
 const setting_t *settingFind(const char *name)
 {
+	// The perfect hash yields the only candidate, its name decides if it's a match
+	const uint16_t seed = settingsNameHashSeeds[settingNameHash(name, 0) % SETTINGS_NAME_HASH_BUCKETS];
+	const setting_t *setting = &settingsTable[settingsNameHashSlots[settingNameHash(name, seed) % SETTINGS_TABLE_COUNT]];
+
 	char buf[SETTING_MAX_NAME_LENGTH];
-	for (int ii = 0; ii < SETTINGS_TABLE_COUNT; ii++) {
-		const setting_t *setting = &settingsTable[ii];
-		settingGetName(setting, buf);
-		if (strcmp(buf, name) == 0) {
-			return setting;
-		}
-	}
-	return NULL;
+	settingGetName(setting, buf);
+	return strcmp(buf, name) == 0 ? setting : NULL;
 }
 
 const setting_t *settingGet(unsigned index)
@@ -224,31 +233,66 @@ pgn_t settingGetPgn(const setting_t *val)
 	return -1;
 }
 
-static uint16_t getValueOffset(const setting_t *value)
+static uint16_t getValueOffset(const setting_t *value, uint8_t profileIndex)
 {
     switch (SETTING_SECTION(value)) {
     case MASTER_VALUE:
         return value->offset;
     case PROFILE_VALUE:
-        return value->offset + sizeof(pidProfile_t) * getConfigProfile();
+        return value->offset + sizeof(pidProfile_t) * profileIndex;
     case CONTROL_RATE_VALUE:
-        return value->offset + sizeof(controlRateConfig_t) * getConfigProfile();
+        return value->offset + sizeof(controlRateConfig_t) * profileIndex;
     case BATTERY_CONFIG_VALUE:
-        return value->offset + sizeof(batteryProfile_t) * getConfigBatteryProfile();
+        return value->offset + sizeof(batteryProfile_t) * profileIndex;
     }
     return 0;
 }
 
+static uint8_t getCurrentProfileIndex(const setting_t *value)
+{
+    switch (SETTING_SECTION(value)) {
+    case MASTER_VALUE:
+        return 0;
+    case PROFILE_VALUE:
+        FALLTHROUGH;
+    case CONTROL_RATE_VALUE:
+        return getConfigProfile();
+    case BATTERY_CONFIG_VALUE:
+        return getConfigBatteryProfile();
+    }
+    return 0;
+}
+
+uint8_t settingGetProfileCount(const setting_t *val)
+{
+    switch (SETTING_SECTION(val)) {
+    case MASTER_VALUE:
+        return 1;
+    case PROFILE_VALUE:
+        FALLTHROUGH;
+    case CONTROL_RATE_VALUE:
+        return MAX_PROFILE_COUNT;
+    case BATTERY_CONFIG_VALUE:
+        return MAX_BATTERY_PROFILE_COUNT;
+    }
+    return 1;
+}
+
 void *settingGetValuePointer(const setting_t *val)
+{
+    return settingGetProfileValuePointer(val, getCurrentProfileIndex(val));
+}
+
+void *settingGetProfileValuePointer(const setting_t *val, uint8_t profileIndex)
 {
     const pgRegistry_t *pg = pgFind(settingGetPgn(val));
-    return pg->address + getValueOffset(val);
+    return pg->address + getValueOffset(val, profileIndex);
 }
 
 const void * settingGetCopyValuePointer(const setting_t *val)
 {
     const pgRegistry_t *pg = pgFind(settingGetPgn(val));
-    return pg->copy + getValueOffset(val);
+    return pg->copy + getValueOffset(val, getCurrentProfileIndex(val));
 }
 
 setting_min_t settingGetMin(const setting_t *val)
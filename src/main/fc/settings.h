@@ -67,9 +67,9 @@ typedef struct {
 
 } __attribute__((packed)) setting_t;
 
-static inline setting_type_e SETTING_TYPE(const setting_t *s) { return s->type &  SETTING_TYPE_MASK; }
-static inline setting_section_e SETTING_SECTION(const setting_t *s) { return s->type & SETTING_SECTION_MASK; }
-static inline setting_mode_e SETTING_MODE(const setting_t *s) { return s->type & SETTING_MODE_MASK; }
+static inline setting_type_e SETTING_TYPE(const setting_t *s) { return (setting_type_e)(s->type & SETTING_TYPE_MASK); }
+static inline setting_section_e SETTING_SECTION(const setting_t *s) { return (setting_section_e)(s->type & SETTING_SECTION_MASK); }
+static inline setting_mode_e SETTING_MODE(const setting_t *s) { return (setting_mode_e)(s->type & SETTING_MODE_MASK); }
 
 void settingGetName(const setting_t *val, char *buf);
 bool settingNameContains(const setting_t *val, char *buf, const char *cmdline);
@@ -92,6 +92,12 @@ pgn_t settingGetPgn(const setting_t *val);
 // Returns a pointer to the actual value stored by
 // the setting_t. The returned value might be modified.
 void * settingGetValuePointer(const setting_t *val);
+// Returns the number of instances of the setting: 1 for master settings,
+// otherwise the number of profiles or battery profiles.
+uint8_t settingGetProfileCount(const setting_t *val);
+// Returns a pointer to the value in the given profile (or battery
+// profile), regardless of which one is active.
+void * settingGetProfileValuePointer(const setting_t *val, uint8_t profileIndex);
 // Returns a pointer to the backed up copy of the value. Note that
 // this will contain random garbage unless a copy of the parameter
 // group for the value has been manually performed. Currently, this
@@ -38,7 +38,17 @@
     #define ONLY_EXPOSE_FOR_TESTING static
 #endif
 
+/*
+ * Sectors of cache, each of AFATFS_SECTOR_SIZE bytes. This is what Blackbox can buffer while the card is busy, targets
+ * can define it to trade RAM for fewer dropped frames on slow cards.
+ */
+#ifndef AFATFS_NUM_CACHE_SECTORS
+#if defined(STM32F4) || defined(STM32F7)
+#define AFATFS_NUM_CACHE_SECTORS 16
+#else
 #define AFATFS_NUM_CACHE_SECTORS 8
+#endif
+#endif
 
 // FAT filesystems are allowed to differ from these parameters, but we choose not to support those weird filesystems:
 #define AFATFS_SECTOR_SIZE  512
@@ -442,6 +452,12 @@ typedef struct afatfs_t {
     int cacheDirtyEntries; // The number of cache entries in the AFATFS_CACHE_STATE_DIRTY state
     bool cacheFlushInProgress;
 
+#ifdef AFATFS_MIN_MULTIPLE_BLOCK_WRITE_COUNT
+    // The sector that continues the multi-block write the card has open, and how many sectors that write has left
+    uint32_t cacheFlushNextSector;
+    uint32_t cacheFlushChainRemain;
+#endif
+
     afatfsFile_t openFiles[AFATFS_MAX_OPEN_FILES];
 
 #ifdef AFATFS_USE_FREEFILE
@@ -698,8 +714,21 @@ static void afatfs_cacheFlushSector(int cacheIndex)
         case SDCARD_OPERATION_BUSY:
         case SDCARD_OPERATION_FAILURE:
         default:
-            ;
+            return;
     }
+
+#ifdef AFATFS_MIN_MULTIPLE_BLOCK_WRITE_COUNT
+    // Follow the multi-block write so afatfs_flush() can keep it going, writing any other sector ends it
+    if (cacheDescriptor->consecutiveEraseBlockCount) {
+        afatfs.cacheFlushNextSector = cacheDescriptor->sectorIndex + 1;
+        afatfs.cacheFlushChainRemain = cacheDescriptor->consecutiveEraseBlockCount - 1;
+    } else if (afatfs.cacheFlushChainRemain > 0 && cacheDescriptor->sectorIndex == afatfs.cacheFlushNextSector) {
+        afatfs.cacheFlushNextSector++;
+        afatfs.cacheFlushChainRemain--;
+    } else {
+        afatfs.cacheFlushChainRemain = 0;
+    }
+#endif
 }
 
 /**
@@ -810,9 +839,22 @@ bool afatfs_flush(void)
         int earliestSectorIndex = -1;
 
         for (int i = 0; i < AFATFS_NUM_CACHE_SECTORS; i++) {
-            if (afatfs.cacheDescriptor[i].state == AFATFS_CACHE_STATE_DIRTY && !afatfs.cacheDescriptor[i].locked
-                && (earliestSectorIndex == -1 || afatfs.cacheDescriptor[i].writeTimestamp < earliestSectorTime)
-            ) {
+            if (afatfs.cacheDescriptor[i].state != AFATFS_CACHE_STATE_DIRTY || afatfs.cacheDescriptor[i].locked) {
+                continue;
+            }
+
+#ifdef AFATFS_MIN_MULTIPLE_BLOCK_WRITE_COUNT
+            /*
+             * Unless a sector continues the card's multi-block write, which would have to be stopped and restarted for
+             * any other sector. Flushing the run of file sectors first lets the card write them as one.
+             */
+            if (afatfs.cacheFlushChainRemain > 0 && afatfs.cacheDescriptor[i].sectorIndex == afatfs.cacheFlushNextSector) {
+                earliestSectorIndex = i;
+                break;
+            }
+#endif
+
+            if (earliestSectorIndex == -1 || afatfs.cacheDescriptor[i].writeTimestamp < earliestSectorTime) {
                 earliestSectorIndex = i;
                 earliestSectorTime = afatfs.cacheDescriptor[i].writeTimestamp;
             }
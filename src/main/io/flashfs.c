@@ -29,51 +29,188 @@
  * and make calls through that, at the moment flashfs just calls m25p16_* routines explicitly.
  */
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
 
+#include "common/maths.h"
+
 #include "drivers/flash_m25p16.h"
 #include "flashfs.h"
 
+// Datasheets give up to 5ms for a page program and 3s for a sector erase
+#define FLASHFS_PROGRAM_TIMEOUT_MS 6
+#define FLASHFS_ERASE_TIMEOUT_MS 5000
+
+/*
+ * The write buffer is a ring indexed by flash address, the byte for address A is kept at A % FLASHFS_WRITE_BUFFER_SIZE.
+ * The buffer holds a whole number of pages, so every flash page maps to a contiguous slot of the buffer. A page is
+ * programmed straight out of its slot in a single operation, by DMA where the SPI bus supports it, while the next
+ * slot fills up.
+ */
 static uint8_t flashWriteBuffer[FLASHFS_WRITE_BUFFER_SIZE];
 
-/* The position of our head and tail in the circular flash write buffer.
- *
- * The head is the index that a byte would be inserted into on writing, while the tail is the index of the
- * oldest byte that has yet to be written to flash.
+/*
+ * bufferStartAddress <= tailAddress <= headAddress
  *
- * When the circular buffer is empty, head == tail
+ * [bufferStartAddress, tailAddress) has been sent to the flash, its slots are reused once the flash is ready again.
+ * [tailAddress, headAddress) is the dirty data still to be programmed, headAddress is where the next byte goes.
  */
-static uint8_t bufferHead = 0, bufferTail = 0;
-
-// The position of the buffer's tail in the overall flash address space:
+static uint32_t bufferStartAddress = 0;
 static uint32_t tailAddress = 0;
+static uint32_t headAddress = 0;
+
+/*
+ * Sectors in [eraseAddress, eraseEndAddress) may still hold old data, the rest of the flash past the write pointer is
+ * erased. These sectors are erased in the background while not logging, or when the write pointer reaches them.
+ */
+static uint32_t eraseAddress = 0;
+static uint32_t eraseEndAddress = 0;
 
+/*
+ * The last sector of the flash holds a directory of the logs below it, one entry per log in the order they were
+ * written. Entries are only ever appended, and the length of a log is programmed into its erased field when it ends.
+ */
+#define FLASHFS_DIRECTORY_MAGIC 0x474F4C42 // "BLOG"
+#define FLASHFS_ERASED_WORD     0xFFFFFFFF
+
+typedef struct flashfsDirectoryEntry_s {
+    uint32_t magic;
+    uint32_t start;
+    uint32_t timestamp;
+    uint32_t length;        // Erased until the log ends
+} flashfsDirectoryEntry_t;
+
+// -1 if the directory sector holds something else, like a log written by firmware without a directory
+static int directoryEntryCount = 0;
+static bool directoryNeedsErase = false;
+static bool logOpen = false;
+static uint32_t logStartAddress = 0;
+
+// Discard the dirty data
 static void flashfsClearBuffer(void)
 {
-    bufferTail = bufferHead = 0;
+    headAddress = tailAddress;
 }
 
 static bool flashfsBufferIsEmpty(void)
 {
-    return bufferTail == bufferHead;
+    return tailAddress == headAddress;
 }
 
 static void flashfsSetTailAddress(uint32_t address)
 {
-    tailAddress = address;
+    bufferStartAddress = tailAddress = headAddress = address;
+}
+
+static uint32_t flashfsPageEnd(uint32_t address)
+{
+    return (address / FLASHFS_WRITE_PAGE_SIZE + 1) * FLASHFS_WRITE_PAGE_SIZE;
+}
+
+static uint32_t flashfsSectorRoundUp(uint32_t address)
+{
+    const uint32_t sectorSize = m25p16_getGeometry()->sectorSize;
+
+    return (address + sectorSize - 1) / sectorSize * sectorSize;
+}
+
+static bool flashfsNeedsErase(uint32_t address)
+{
+    return address >= eraseAddress && address < eraseEndAddress;
+}
+
+// The flash must be ready
+static void flashfsEraseNextSector(void)
+{
+    m25p16_eraseSector(eraseAddress);
+
+    eraseAddress += m25p16_getGeometry()->sectorSize;
+}
+
+static uint32_t flashfsDirectoryAddress(void)
+{
+    return flashfsGetSize();
+}
+
+static int flashfsDirectoryMaxEntries(void)
+{
+    return m25p16_getGeometry()->sectorSize / sizeof(flashfsDirectoryEntry_t);
+}
+
+static bool flashfsReadDirectoryEntry(int index, flashfsDirectoryEntry_t *entry)
+{
+    const uint32_t address = flashfsDirectoryAddress() + index * sizeof(flashfsDirectoryEntry_t);
+
+    return m25p16_readBytes(address, (uint8_t *)entry, sizeof(*entry)) == sizeof(*entry);
+}
+
+// The flash must be ready
+static void flashfsEraseDirectory(void)
+{
+    m25p16_eraseSector(flashfsDirectoryAddress());
+
+    directoryNeedsErase = false;
 }
 
 void flashfsEraseCompletely(void)
 {
     m25p16_eraseCompletely();
 
-    flashfsClearBuffer();
+    eraseAddress = eraseEndAddress = 0;
+    directoryEntryCount = 0;
+    directoryNeedsErase = false;
+    logOpen = false;
+    flashfsSetTailAddress(0);
+}
 
+/**
+ * Erase only the sectors that hold data and start writing again from the start of the flash. With little of the flash
+ * used this is much quicker than erasing the whole chip.
+ *
+ * The sectors are erased in the background by flashfsEraseAsync(), poll flashfsIsReady() to wait for them. A log can't
+ * begin before then, see flashfsBeginLog().
+ */
+void flashfsEraseUsed(void)
+{
+    if (flashfsGetSize() == 0) {
+        return;
+    }
+
+    flashfsFlushSync();
+
+    eraseEndAddress = MAX(eraseEndAddress, flashfsSectorRoundUp(headAddress));
+    eraseAddress = 0;
+    directoryNeedsErase = directoryNeedsErase || directoryEntryCount != 0;
+    directoryEntryCount = 0;
+    logOpen = false;
     flashfsSetTailAddress(0);
 }
 
+/**
+ * If the flash is idle, start erasing the next sector of old data ahead of the write pointer. Call while not logging,
+ * as a sector erase holds up writes to the flash for up to a few seconds.
+ *
+ * Returns true if there is nothing left to erase.
+ */
+bool flashfsEraseAsync(void)
+{
+    if (!directoryNeedsErase && eraseAddress >= eraseEndAddress) {
+        return true;
+    }
+
+    if (flashfsBufferIsEmpty() && m25p16_isReady()) {
+        if (directoryNeedsErase) {
+            flashfsEraseDirectory();
+        } else {
+            flashfsEraseNextSector();
+        }
+    }
+
+    return false;
+}
+
 /**
  * Start and end must lie on sector boundaries, or they will be rounded out to sector boundaries such that
  * all the bytes in the range [start...end) are erased.
@@ -102,24 +239,22 @@ void flashfsEraseRange(uint32_t start, uint32_t end)
 }
 
 /**
- * Return true if the flash is not currently occupied with an operation.
+ * Return true if the flash is not currently occupied with an operation and has no erase pending. Polling this moves a
+ * pending erase along.
  */
 bool flashfsIsReady(void)
 {
-    return m25p16_isReady();
+    return flashfsEraseAsync() && m25p16_isReady();
 }
 
+/**
+ * Get the space available to logs, which excludes the directory sector.
+ */
 uint32_t flashfsGetSize(void)
 {
-    return m25p16_getGeometry()->totalSize;
-}
-
-static uint32_t flashfsTransmitBufferUsed(void)
-{
-    if (bufferHead >= bufferTail)
-        return bufferHead - bufferTail;
+    const flashGeometry_t *geometry = m25p16_getGeometry();
 
-    return FLASHFS_WRITE_BUFFER_SIZE - bufferTail + bufferHead;
+    return geometry->totalSize - geometry->sectorSize;
 }
 
 /**
@@ -127,7 +262,7 @@ static uint32_t flashfsTransmitBufferUsed(void)
  */
 uint32_t flashfsGetWriteBufferSize(void)
 {
-    return FLASHFS_WRITE_BUFFER_USABLE;
+    return FLASHFS_WRITE_BUFFER_SIZE;
 }
 
 /**
@@ -135,7 +270,7 @@ uint32_t flashfsGetWriteBufferSize(void)
  */
 uint32_t flashfsGetWriteBufferFreeSpace(void)
 {
-    return flashfsGetWriteBufferSize() - flashfsTransmitBufferUsed();
+    return FLASHFS_WRITE_BUFFER_SIZE - (headAddress - bufferStartAddress);
 }
 
 const flashGeometry_t* flashfsGetGeometry(void)
@@ -144,199 +279,116 @@ const flashGeometry_t* flashfsGetGeometry(void)
 }
 
 /**
- * Write the given buffers to flash sequentially at the current tail address, advancing the tail address after
- * each write.
- *
- * In synchronous mode, waits for the flash to become ready before writing so that every byte requested can be written.
- *
- * In asynchronous mode, if the flash is busy, then the write is aborted and the routine returns immediately.
- * In this case the returned number of bytes written will be less than the total amount requested.
+ * Start programming the dirty data of the flash page at the tail address.
  *
- * Modifies the supplied buffer pointers and sizes to reflect how many bytes remain in each of them.
+ * Unless forced, only a page that has been filled up to its end is programmed, so that pages are written in a single
+ * program operation rather than a piece at a time.
  *
- * bufferCount: the number of buffers provided
- * buffers: an array of pointers to the beginning of buffers
- * bufferSizes: an array of the sizes of those buffers
- * sync: true if we should wait for the device to be idle before writes, otherwise if the device is busy the
- *       write will be aborted and this routine will return immediately.
+ * In synchronous mode, waits for the flash to become ready first. In asynchronous mode, if the flash is busy, nothing
+ * is programmed and the routine returns immediately.
  *
- * Returns the number of bytes written
+ * Returns true if a program was started.
  */
-static uint32_t flashfsWriteBuffers(uint8_t const **buffers, uint32_t *bufferSizes, int bufferCount, bool sync)
+static bool flashfsProgramNextPage(bool force, bool sync)
 {
-    uint32_t bytesTotal = 0;
-
-    int i;
-
-    for (i = 0; i < bufferCount; i++) {
-        bytesTotal += bufferSizes[i];
+    if (sync) {
+        m25p16_waitForReady(FLASHFS_PROGRAM_TIMEOUT_MS);
+    } else if (!m25p16_isReady()) {
+        return false;
     }
 
-    if (!sync && !m25p16_isReady()) {
-        return 0;
-    }
+    // The flash has finished with the data sent to it, its slots can take new data
+    bufferStartAddress = tailAddress;
 
-    uint32_t bytesTotalRemaining = bytesTotal;
+    // Are we at EOF already? May as well throw away any buffered data
+    if (flashfsIsEOF()) {
+        flashfsClearBuffer();
+        return false;
+    }
 
-    while (bytesTotalRemaining > 0) {
-        uint32_t bytesTotalThisIteration;
-        uint32_t bytesRemainThisIteration;
-        uint32_t currentFlashAddress = tailAddress;
+    const uint32_t pageEnd = flashfsPageEnd(tailAddress);
 
-        /*
-         * Each page needs to be saved in a separate program operation, so
-         * if we would cross a page boundary, only write up to the boundary in this iteration:
-         */
-        if (tailAddress % M25P16_PAGESIZE + bytesTotalRemaining > M25P16_PAGESIZE) {
-            bytesTotalThisIteration = M25P16_PAGESIZE - tailAddress % M25P16_PAGESIZE;
-        } else {
-            bytesTotalThisIteration = bytesTotalRemaining;
-        }
+    if (flashfsBufferIsEmpty() || (!force && headAddress < pageEnd)) {
+        return false;
+    }
 
-        // Are we at EOF already? Abort.
-        if (flashfsIsEOF()) {
-            // May as well throw away any buffered data
-            flashfsClearBuffer();
+    // Never program over old data, erase up to the page first
+    while (flashfsNeedsErase(tailAddress)) {
+        flashfsEraseNextSector();
 
-            break;
+        if (!sync) {
+            // The page is programmed by a later call once the erase is done
+            return false;
         }
 
-        bytesRemainThisIteration = bytesTotalThisIteration;
-
-        for (i = 0; i < bufferCount; i++) {
-            if (bufferSizes[i] > 0) {
-                // Is buffer larger than our write limit? Write our limit out of it
-                if (bufferSizes[i] >= bytesRemainThisIteration) {
-                    currentFlashAddress = m25p16_pageProgram(currentFlashAddress, buffers[i], bytesRemainThisIteration);
-
-                    buffers[i] += bytesRemainThisIteration;
-                    bufferSizes[i] -= bytesRemainThisIteration;
-
-                    bytesRemainThisIteration = 0;
-                    break;
-                } else {
-                    // We'll still have more to write after finishing this buffer off
-                    currentFlashAddress = m25p16_pageProgram(currentFlashAddress, buffers[i], bufferSizes[i]);
-
-                    bytesRemainThisIteration -= bufferSizes[i];
+        m25p16_waitForReady(FLASHFS_ERASE_TIMEOUT_MS);
+    }
 
-                    buffers[i] += bufferSizes[i];
-                    bufferSizes[i] = 0;
-                }
-            }
-        }
+    const uint32_t programEnd = MIN(headAddress, pageEnd);
 
-        bytesTotalRemaining -= bytesTotalThisIteration;
+    m25p16_pageProgramAsync(tailAddress, flashWriteBuffer + tailAddress % FLASHFS_WRITE_BUFFER_SIZE, programEnd - tailAddress);
 
-        // Advance the cursor in the file system to match the bytes we wrote
-        flashfsSetTailAddress(tailAddress + bytesTotalThisIteration);
+    tailAddress = programEnd;
 
-        /*
-         * We'll have to wait for that write to complete before we can issue the next one, so if
-         * the user requested asynchronous writes, break now.
-         */
-        if (!sync)
-            break;
-    }
-
-    return bytesTotal - bytesTotalRemaining;
+    return true;
 }
 
-/*
- * Since the buffered data might wrap around the end of the circular buffer, we can have two segments of data to write,
- * an initial portion and a possible wrapped portion.
+/**
+ * Copy as much of the given data as there is free space for into the write buffer.
  *
- * This routine will fill the details of those buffers into the provided arrays, which must be at least 2 elements long.
+ * Returns the number of bytes buffered.
  */
-static void flashfsGetDirtyDataBuffers(uint8_t const *buffers[], uint32_t bufferSizes[])
+static uint32_t flashfsBufferData(const uint8_t *data, uint32_t len)
 {
-    buffers[0] = flashWriteBuffer + bufferTail;
-    buffers[1] = flashWriteBuffer + 0;
+    len = MIN(len, flashfsGetWriteBufferFreeSpace());
 
-    if (bufferHead >= bufferTail) {
-        bufferSizes[0] = bufferHead - bufferTail;
-        bufferSizes[1] = 0;
-    } else {
-        bufferSizes[0] = FLASHFS_WRITE_BUFFER_SIZE - bufferTail;
-        bufferSizes[1] = bufferHead;
-    }
-}
-
-/**
- * Get the current offset of the file pointer within the volume.
- */
-uint32_t flashfsGetOffset(void)
-{
-    uint8_t const * buffers[2];
-    uint32_t bufferSizes[2];
+    // The data may wrap around the end of the buffer
+    const uint32_t offset = headAddress % FLASHFS_WRITE_BUFFER_SIZE;
+    const uint32_t firstPortion = MIN(len, FLASHFS_WRITE_BUFFER_SIZE - offset);
 
-    // Dirty data in the buffers contributes to the offset
+    memcpy(flashWriteBuffer + offset, data, firstPortion);
+    memcpy(flashWriteBuffer, data + firstPortion, len - firstPortion);
 
-    flashfsGetDirtyDataBuffers(buffers, bufferSizes);
+    headAddress += len;
 
-    return tailAddress + bufferSizes[0] + bufferSizes[1];
+    return len;
 }
 
 /**
- * Called after bytes have been written from the buffer to advance the position of the tail by the given amount.
+ * Get the current offset of the file pointer within the volume.
  */
-static void flashfsAdvanceTailInBuffer(uint32_t delta)
+uint32_t flashfsGetOffset(void)
 {
-    bufferTail += delta;
-
-    // Wrap tail around the end of the buffer
-    if (bufferTail >= FLASHFS_WRITE_BUFFER_SIZE) {
-        bufferTail -= FLASHFS_WRITE_BUFFER_SIZE;
-    }
-
-    if (flashfsBufferIsEmpty()) {
-        flashfsClearBuffer(); // Bring buffer pointers back to the start to be tidier
-    }
+    // Dirty data in the buffer contributes to the offset
+    return headAddress;
 }
 
 /**
- * If the flash is ready to accept writes, flush the buffer to it.
+ * If the flash is ready to accept writes, start programming the next page of the buffer.
+ *
+ * Only complete pages are programmed unless `force` is set, call with force at the end of a log to write out the
+ * partial page.
  *
  * Returns true if all data in the buffer has been flushed to the device, or false if
  * there is still data to be written (call flush again later).
  */
-bool flashfsFlushAsync(void)
+bool flashfsFlushAsync(bool force)
 {
-    if (flashfsBufferIsEmpty()) {
-        return true; // Nothing to flush
-    }
-
-    uint8_t const * buffers[2];
-    uint32_t bufferSizes[2];
-    uint32_t bytesWritten;
-
-    flashfsGetDirtyDataBuffers(buffers, bufferSizes);
-    bytesWritten = flashfsWriteBuffers(buffers, bufferSizes, 2, false);
-    flashfsAdvanceTailInBuffer(bytesWritten);
+    flashfsProgramNextPage(force, false);
 
     return flashfsBufferIsEmpty();
 }
 
 /**
- * Wait for the flash to become ready and begin flushing any buffered data to flash.
+ * Wait for the flash to become ready and flush any buffered data to flash.
  *
- * The flash will still be busy some time after this sync completes, but space will
- * be freed up to accept more writes in the write buffer.
+ * The flash will still be busy some time after this sync completes, but the whole buffer
+ * is free to accept more writes.
  */
 void flashfsFlushSync(void)
 {
-    if (flashfsBufferIsEmpty()) {
-        return; // Nothing to flush
+    while (flashfsProgramNextPage(true, true)) {
     }
-
-    uint8_t const * buffers[2];
-    uint32_t bufferSizes[2];
-
-    flashfsGetDirtyDataBuffers(buffers, bufferSizes);
-    flashfsWriteBuffers(buffers, bufferSizes, 2, true);
-
-    // We've written our entire buffer now:
-    flashfsClearBuffer();
 }
 
 void flashfsSeekAbs(uint32_t offset)
@@ -353,20 +405,31 @@ void flashfsSeekRel(int32_t offset)
     flashfsSetTailAddress(tailAddress + offset);
 }
 
+// Start programming the page at the tail as soon as it is complete, so the flash works while the next one fills
+static void flashfsProgramCompletePage(void)
+{
+    if (headAddress >= flashfsPageEnd(tailAddress)) {
+        flashfsProgramNextPage(false, false);
+    }
+}
+
 /**
  * Write the given byte asynchronously to the flash. If the buffer overflows, data is silently discarded.
  */
 void flashfsWriteByte(uint8_t byte)
 {
-    flashWriteBuffer[bufferHead++] = byte;
+    if (flashfsGetWriteBufferFreeSpace() == 0) {
+        flashfsProgramNextPage(false, false);
 
-    if (bufferHead >= FLASHFS_WRITE_BUFFER_SIZE) {
-        bufferHead = 0;
+        if (flashfsGetWriteBufferFreeSpace() == 0) {
+            return;
+        }
     }
 
-    if (flashfsTransmitBufferUsed() >= FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN) {
-        flashfsFlushAsync();
-    }
+    flashWriteBuffer[headAddress % FLASHFS_WRITE_BUFFER_SIZE] = byte;
+    headAddress++;
+
+    flashfsProgramCompletePage();
 }
 
 /**
@@ -377,80 +440,34 @@ void flashfsWriteByte(uint8_t byte)
  */
 void flashfsWrite(const uint8_t *data, unsigned int len, bool sync)
 {
-    uint8_t const * buffers[3];
-    uint32_t bufferSizes[3];
-
-    // There could be two dirty buffers to write out already:
-    flashfsGetDirtyDataBuffers(buffers, bufferSizes);
-
-    // Plus the buffer the user supplied:
-    buffers[2] = data;
-    bufferSizes[2] = len;
-
-    /*
-     * Would writing this data to our buffer cause our buffer to reach the flush threshold? If so try to write through
-     * to the flash now
-     */
-    if (bufferSizes[0] + bufferSizes[1] + bufferSizes[2] >= FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN) {
-        uint32_t bytesWritten;
-
-        // Attempt to write all three buffers through to the flash asynchronously
-        bytesWritten = flashfsWriteBuffers(buffers, bufferSizes, 3, false);
-
-        if (bufferSizes[0] == 0 && bufferSizes[1] == 0) {
-            // We wrote all the data that was previously buffered
-            flashfsClearBuffer();
-
-            if (bufferSizes[2] == 0) {
-                // And we wrote all the data the user supplied! Job done!
-                return;
-            }
-        } else {
-            // We only wrote a portion of the old data, so advance the tail to remove the bytes we did write from the buffer
-            flashfsAdvanceTailInBuffer(bytesWritten);
-        }
-
-        // Is the remainder of the data to be written too big to fit in the buffers?
-        if (bufferSizes[0] + bufferSizes[1] + bufferSizes[2] > FLASHFS_WRITE_BUFFER_USABLE) {
-            if (sync) {
-                // Write it through synchronously
-                flashfsWriteBuffers(buffers, bufferSizes, 3, true);
-                flashfsClearBuffer();
-            } else {
-                /*
-                 * Silently drop the data the user asked to write (i.e. no-op) since we can't buffer it and they
-                 * requested async.
-                 */
-            }
-
+    if (!sync && len > flashfsGetWriteBufferFreeSpace()) {
+        // Try to make room by programming the next page
+        flashfsProgramNextPage(false, false);
+
+        if (len > flashfsGetWriteBufferFreeSpace()) {
+            /*
+             * Silently drop the data the user asked to write (i.e. no-op) since we can't buffer it and they
+             * requested async.
+             */
             return;
         }
-
-        // Fall through and add the remainder of the incoming data to our buffer
-        data = buffers[2];
-        len = bufferSizes[2];
     }
 
-    // Buffer up the data the user supplied instead of writing it right away
-
-    // First write the portion before we wrap around the end of the circular buffer
-    unsigned int bufferBytesBeforeWrap = FLASHFS_WRITE_BUFFER_SIZE - bufferHead;
+    while (true) {
+        const uint32_t bytesBuffered = flashfsBufferData(data, len);
 
-    unsigned int firstPortion = len < bufferBytesBeforeWrap ? len : bufferBytesBeforeWrap;
+        data += bytesBuffered;
+        len -= bytesBuffered;
 
-    memcpy(flashWriteBuffer + bufferHead, data, firstPortion);
-
-    bufferHead += firstPortion;
-
-    data += firstPortion;
-    len -= firstPortion;
-
-    // If we wrap the head around, write the remainder to the start of the buffer (if any)
-    if (bufferHead == FLASHFS_WRITE_BUFFER_SIZE) {
-        memcpy(flashWriteBuffer + 0, data, len);
+        if (len == 0) {
+            break;
+        }
 
-        bufferHead = len;
+        // Only a synchronous write gets here, wait for the flash to free up a page
+        flashfsProgramNextPage(true, true);
     }
+
+    flashfsProgramCompletePage();
 }
 
 /**
@@ -462,6 +479,10 @@ int flashfsReadAbs(uint32_t address, uint8_t *buffer, unsigned int len)
 {
     int bytesRead;
 
+    if (address >= flashfsGetSize()) {
+        return 0;
+    }
+
     // Did caller try to read past the end of the volume?
     if (address + len > flashfsGetSize()) {
         // Truncate their request
@@ -476,6 +497,98 @@ int flashfsReadAbs(uint32_t address, uint8_t *buffer, unsigned int len)
     return bytesRead;
 }
 
+/**
+ * Squeeze the erased runs out of data read from the flash, so the erased parts of a download cost next to nothing.
+ *
+ * Runs of at least FLASHFS_ERASED_RUN_MIN_LENGTH 0xFF bytes are removed, the rest of the data is moved up in place and
+ * followed by a table of the runs, {U16 offset in the original data, U16 length} each. Removing a run frees more space
+ * than its table entry takes, so the result is never longer than the original.
+ *
+ * Returns the length of the packed data and table, *runCount is set to the number of table entries.
+ */
+unsigned int flashfsPackErasedRuns(uint8_t *buffer, unsigned int len, unsigned int *runCount)
+{
+    uint16_t runs[FLASHFS_ERASED_RUN_MAX_COUNT][2];
+    unsigned int count = 0;
+    unsigned int packedLength = 0;
+    unsigned int i = 0;
+
+    while (i < len) {
+        const bool erased = buffer[i] == 0xFF && count < FLASHFS_ERASED_RUN_MAX_COUNT;
+        unsigned int end = i + 1;
+
+        if (erased) {
+            while (end < len && buffer[end] == 0xFF) {
+                end++;
+            }
+
+            if (end - i >= FLASHFS_ERASED_RUN_MIN_LENGTH) {
+                runs[count][0] = i;
+                runs[count][1] = end - i;
+                count++;
+                i = end;
+                continue;
+            }
+        } else if (count == FLASHFS_ERASED_RUN_MAX_COUNT) {
+            // Table full, keep the rest as it is
+            end = len;
+        } else {
+            while (end < len && buffer[end] != 0xFF) {
+                end++;
+            }
+        }
+
+        memmove(buffer + packedLength, buffer + i, end - i);
+        packedLength += end - i;
+        i = end;
+    }
+
+    for (unsigned int run = 0; run < count; run++) {
+        for (int field = 0; field < 2; field++) {
+            buffer[packedLength++] = runs[run][field] & 0xFF;
+            buffer[packedLength++] = runs[run][field] >> 8;
+        }
+    }
+
+    *runCount = count;
+
+    return packedLength;
+}
+
+enum {
+    /* We don't expect valid data to ever contain this many consecutive uint32_t's of all 1 bits: */
+    FREE_BLOCK_TEST_SIZE_INTS = 4, // i.e. 16 bytes
+    FREE_BLOCK_TEST_SIZE_BYTES = FREE_BLOCK_TEST_SIZE_INTS * sizeof(uint32_t),
+};
+
+/**
+ * Check whether the flash appears to be erased at the given address.
+ *
+ * Returns false if the flash could not be read.
+ */
+static bool flashfsReadIsErased(uint32_t address, bool *erased)
+{
+    union {
+        uint8_t bytes[FREE_BLOCK_TEST_SIZE_BYTES];
+        uint32_t ints[FREE_BLOCK_TEST_SIZE_INTS];
+    } testBuffer;
+
+    if (m25p16_readBytes(address, testBuffer.bytes, FREE_BLOCK_TEST_SIZE_BYTES) < FREE_BLOCK_TEST_SIZE_BYTES) {
+        return false;
+    }
+
+    // Checking the buffer 4 bytes at a time like this is probably faster than byte-by-byte, but I didn't benchmark it :)
+    *erased = true;
+    for (int i = 0; i < FREE_BLOCK_TEST_SIZE_INTS; i++) {
+        if (testBuffer.ints[i] != 0xFFFFFFFF) {
+            *erased = false;
+            break;
+        }
+    }
+
+    return true;
+}
+
 /**
  * Find the offset of the start of the free space on the device (or the size of the device if it is full).
  */
@@ -495,41 +608,22 @@ int flashfsIdentifyStartOfFreeSpace(void)
          * at the end of the last written data. But smaller blocksizes will require more searching.
          */
         FREE_BLOCK_SIZE = 2048,
-
-        /* We don't expect valid data to ever contain this many consecutive uint32_t's of all 1 bits: */
-        FREE_BLOCK_TEST_SIZE_INTS = 4, // i.e. 16 bytes
-        FREE_BLOCK_TEST_SIZE_BYTES = FREE_BLOCK_TEST_SIZE_INTS * sizeof(uint32_t),
     };
 
-    union {
-        uint8_t bytes[FREE_BLOCK_TEST_SIZE_BYTES];
-        uint32_t ints[FREE_BLOCK_TEST_SIZE_INTS];
-    } testBuffer;
-
     int left = 0; // Smallest block index in the search region
     int right = flashfsGetSize() / FREE_BLOCK_SIZE; // One past the largest block index in the search region
     int mid;
     int result = right;
-    int i;
     bool blockErased;
 
     while (left < right) {
         mid = (left + right) / 2;
 
-        if (m25p16_readBytes(mid * FREE_BLOCK_SIZE, testBuffer.bytes, FREE_BLOCK_TEST_SIZE_BYTES) < FREE_BLOCK_TEST_SIZE_BYTES) {
+        if (!flashfsReadIsErased(mid * FREE_BLOCK_SIZE, &blockErased)) {
             // Unexpected timeout from flash, so bail early (reporting the device fuller than it really is)
             break;
         }
 
-        // Checking the buffer 4 bytes at a time like this is probably faster than byte-by-byte, but I didn't benchmark it :)
-        blockErased = true;
-        for (i = 0; i < FREE_BLOCK_TEST_SIZE_INTS; i++) {
-            if (testBuffer.ints[i] != 0xFFFFFFFF) {
-                blockErased = false;
-                break;
-            }
-        }
-
         if (blockErased) {
             /* This erased block might be the leftmost erased block in the volume, but we'll need to continue the
              * search leftwards to find out:
@@ -545,6 +639,32 @@ int flashfsIdentifyStartOfFreeSpace(void)
     return result * FREE_BLOCK_SIZE;
 }
 
+/**
+ * Find the sectors past the given start of the free space that still hold data, such as those left behind by an
+ * erase that was interrupted, so they are erased before anything is written over them.
+ */
+static void flashfsFindDataAhead(uint32_t freeSpaceStart)
+{
+    const uint32_t sectorSize = m25p16_getGeometry()->sectorSize;
+
+    eraseAddress = eraseEndAddress = 0;
+
+    for (uint32_t address = flashfsSectorRoundUp(freeSpaceStart); address < flashfsGetSize(); address += sectorSize) {
+        bool sectorErased;
+
+        if (!flashfsReadIsErased(address, &sectorErased)) {
+            break;
+        }
+
+        if (!sectorErased) {
+            if (eraseEndAddress == 0) {
+                eraseAddress = address;
+            }
+            eraseEndAddress = address + sectorSize;
+        }
+    }
+}
+
 /**
  * Returns true if the file pointer is at the end of the device.
  */
@@ -553,6 +673,186 @@ bool flashfsIsEOF(void)
     return tailAddress >= flashfsGetSize();
 }
 
+/**
+ * Count the entries of the log directory. They are written one after the other, so a binary search finds the first
+ * free one.
+ *
+ * Returns false if the directory sector holds something other than a directory.
+ */
+static bool flashfsLoadDirectory(void)
+{
+    flashfsDirectoryEntry_t entry;
+    int left = 0;
+    int right = flashfsDirectoryMaxEntries();
+
+    while (left < right) {
+        const int mid = (left + right) / 2;
+
+        if (!flashfsReadDirectoryEntry(mid, &entry)) {
+            return false;
+        }
+
+        if (entry.magic == FLASHFS_DIRECTORY_MAGIC) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+
+    // Whatever follows the last entry must be erased
+    if (left < flashfsDirectoryMaxEntries()) {
+        if (!flashfsReadDirectoryEntry(left, &entry)) {
+            return false;
+        }
+
+        const uint32_t *words = (const uint32_t *)&entry;
+        for (unsigned i = 0; i < sizeof(entry) / sizeof(uint32_t); i++) {
+            if (words[i] != FLASHFS_ERASED_WORD) {
+                return false;
+            }
+        }
+    }
+
+    directoryEntryCount = left;
+
+    return true;
+}
+
+/**
+ * Find the start of the free space from the end of the last log in the directory, falling back to searching the
+ * flash for it when there's no directory, the last log wasn't ended or more data follows it.
+ */
+static uint32_t flashfsFindStartOfFreeSpace(void)
+{
+    flashfsDirectoryEntry_t entry;
+
+    if (!flashfsLoadDirectory()) {
+        directoryEntryCount = -1;
+        return flashfsIdentifyStartOfFreeSpace();
+    }
+
+    if (directoryEntryCount == 0 || !flashfsReadDirectoryEntry(directoryEntryCount - 1, &entry)) {
+        return flashfsIdentifyStartOfFreeSpace();
+    }
+
+    if (entry.length != FLASHFS_ERASED_WORD) {
+        const uint32_t logEnd = entry.start + entry.length;
+        bool erased;
+
+        // Logs begun once the directory was full follow the last entry unlisted, search for their end instead
+        if (logEnd < flashfsGetSize() && (!flashfsReadIsErased(logEnd, &erased) || !erased)) {
+            return MAX((uint32_t)flashfsIdentifyStartOfFreeSpace(), logEnd);
+        }
+
+        return logEnd;
+    }
+
+    // Power was lost while logging, the log ends where the free space starts
+    const uint32_t freeSpaceStart = MAX((uint32_t)flashfsIdentifyStartOfFreeSpace(), entry.start);
+    const uint32_t length = freeSpaceStart - entry.start;
+    const uint32_t address = flashfsDirectoryAddress() + (directoryEntryCount - 1) * sizeof(entry) + offsetof(flashfsDirectoryEntry_t, length);
+
+    m25p16_pageProgram(address, (const uint8_t *)&length, sizeof(length));
+
+    return freeSpaceStart;
+}
+
+/**
+ * Start a new log at the current offset, adding it to the directory. The log is still written if the directory is
+ * full or unavailable, it just isn't listed.
+ *
+ * Old data left to erase by flashfsEraseUsed() is erased first, including the directory of those logs. A sector erase
+ * during the log would hold up its writes for long enough to drop data.
+ *
+ * Returns false if the flash is busy, keep calling until it returns true.
+ */
+bool flashfsBeginLog(uint32_t timestamp)
+{
+    if ((logOpen && !flashfsEndLog()) || !flashfsEraseAsync()) {
+        return false;
+    }
+
+    if (directoryEntryCount < 0 || directoryEntryCount >= flashfsDirectoryMaxEntries() || flashfsIsEOF()) {
+        return true;
+    }
+
+    if (!m25p16_isReady()) {
+        return false;
+    }
+
+    const flashfsDirectoryEntry_t entry = {
+        .magic = FLASHFS_DIRECTORY_MAGIC,
+        .start = headAddress,
+        .timestamp = timestamp,
+        .length = FLASHFS_ERASED_WORD,
+    };
+
+    m25p16_pageProgram(flashfsDirectoryAddress() + directoryEntryCount * sizeof(entry), (const uint8_t *)&entry, sizeof(entry));
+
+    directoryEntryCount++;
+    logOpen = true;
+    logStartAddress = headAddress;
+
+    return true;
+}
+
+/**
+ * Write out the rest of the log and record its length in the directory.
+ *
+ * Returns false while that's still in progress, keep calling until it returns true.
+ */
+bool flashfsEndLog(void)
+{
+    if (!logOpen) {
+        return true;
+    }
+
+    if (!flashfsFlushAsync(true) || !m25p16_isReady()) {
+        return false;
+    }
+
+    const uint32_t length = headAddress - logStartAddress;
+    const uint32_t address = flashfsDirectoryAddress() + (directoryEntryCount - 1) * sizeof(flashfsDirectoryEntry_t) + offsetof(flashfsDirectoryEntry_t, length);
+
+    m25p16_pageProgram(address, (const uint8_t *)&length, sizeof(length));
+
+    logOpen = false;
+
+    return true;
+}
+
+int flashfsGetLogCount(void)
+{
+    return MAX(directoryEntryCount, 0);
+}
+
+/**
+ * Look up a log of the directory, logs are numbered from 0 in the order they were written.
+ *
+ * Returns false if there is no such log or the directory couldn't be read.
+ */
+bool flashfsGetLog(int index, flashfsLogEntry_t *log)
+{
+    flashfsDirectoryEntry_t entry;
+
+    if (index < 0 || index >= flashfsGetLogCount() || !flashfsReadDirectoryEntry(index, &entry)) {
+        return false;
+    }
+
+    log->start = entry.start;
+    log->timestamp = entry.timestamp;
+
+    if (entry.length != FLASHFS_ERASED_WORD) {
+        log->length = entry.length;
+    } else if (logOpen && index == directoryEntryCount - 1) {
+        log->length = headAddress - entry.start;
+    } else {
+        log->length = 0;
+    }
+
+    return true;
+}
+
 /**
  * Call after initializing the flash chip in order to set up the filesystem.
  */
@@ -561,6 +861,9 @@ void flashfsInit(void)
     // If we have a flash chip present at all
     if (flashfsGetSize() > 0) {
         // Start the file pointer off at the beginning of free space so caller can start writing immediately
-        flashfsSeekAbs(flashfsIdentifyStartOfFreeSpace());
+        const uint32_t freeSpaceStart = flashfsFindStartOfFreeSpace();
+
+        flashfsSeekAbs(freeSpaceStart);
+        flashfsFindDataAhead(freeSpaceStart);
     }
 }
@@ -17,18 +17,35 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "drivers/flash.h"
 
-#define FLASHFS_WRITE_BUFFER_SIZE 128
-#define FLASHFS_WRITE_BUFFER_USABLE (FLASHFS_WRITE_BUFFER_SIZE - 1)
+// All supported chips use 256 byte pages, each page is buffered and programmed in a single operation
+#define FLASHFS_WRITE_PAGE_SIZE 256
 
-// Automatically trigger a flush when this much data is in the buffer
-#define FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN 64
+// Pages of write buffer. The flash programs one page while the next fills, targets may add more to ride out stalls
+#ifndef FLASHFS_WRITE_BUFFER_PAGES
+#define FLASHFS_WRITE_BUFFER_PAGES 2
+#endif
+
+#define FLASHFS_WRITE_BUFFER_SIZE (FLASHFS_WRITE_BUFFER_PAGES * FLASHFS_WRITE_PAGE_SIZE)
+
+// Erased runs removed by flashfsPackErasedRuns(), the data packed must be shorter than 64KB
+#define FLASHFS_ERASED_RUN_MIN_LENGTH 16
+#define FLASHFS_ERASED_RUN_MAX_COUNT 32
+
+typedef struct flashfsLogEntry_s {
+    uint32_t start;
+    uint32_t length;
+    uint32_t timestamp;     // Seconds since 1970, 0 if the time wasn't known when the log started
+} flashfsLogEntry_t;
 
 void flashfsEraseCompletely(void);
+void flashfsEraseUsed(void);
 void flashfsEraseRange(uint32_t start, uint32_t end);
+bool flashfsEraseAsync(void);
 
 uint32_t flashfsGetSize(void);
 uint32_t flashfsGetOffset(void);
@@ -44,11 +61,17 @@ void flashfsWriteByte(uint8_t byte);
 void flashfsWrite(const uint8_t *data, unsigned int len, bool sync);
 
 int flashfsReadAbs(uint32_t offset, uint8_t *data, unsigned int len);
+unsigned int flashfsPackErasedRuns(uint8_t *buffer, unsigned int len, unsigned int *runCount);
 
-bool flashfsFlushAsync(void);
+bool flashfsFlushAsync(bool force);
 void flashfsFlushSync(void);
 
 void flashfsInit(void);
 
 bool flashfsIsReady(void);
 bool flashfsIsEOF(void);
+
+bool flashfsBeginLog(uint32_t timestamp);
+bool flashfsEndLog(void);
+int flashfsGetLogCount(void);
+bool flashfsGetLog(int index, flashfsLogEntry_t *log);
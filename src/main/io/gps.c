@@ -147,6 +147,26 @@ void gpsSetProtocolTimeout(timeMs_t timeoutMs)
     gpsState.timeoutMs = timeoutMs;
 }
 
+// Feed received bytes to the protocol parser, stop after a complete frame and leave the rest in the port buffer
+bool gpsReceiveFrame(gpsNewFrameFnPtr newFrameFn)
+{
+    const uint8_t *data;
+    uint32_t count;
+
+    while ((count = serialPeekRxSpan(gpsState.gpsPort, &data)) > 0) {
+        for (uint32_t processed = 0; processed < count; ) {
+            if (newFrameFn(data[processed++])) {
+                serialConsumeRx(gpsState.gpsPort, processed);
+                return true;
+            }
+        }
+
+        serialConsumeRx(gpsState.gpsPort, count);
+    }
+
+    return false;
+}
+
 void gpsProcessNewSolutionData(void)
 {
     // Set GPS fix flag only if we have 3D fix
@@ -407,18 +427,19 @@ void gpsEnablePassthrough(serialPort_t *gpsPassthroughPort)
     LED0_OFF;
     LED1_OFF;
 
-    char c;
+    const uint8_t *data;
+    uint32_t count;
     while (1) {
-        if (serialRxBytesWaiting(gpsState.gpsPort)) {
+        if ((count = serialPeekRxSpan(gpsState.gpsPort, &data)) > 0) {
             LED0_ON;
-            c = serialRead(gpsState.gpsPort);
-            serialWrite(gpsPassthroughPort, c);
+            serialWriteBuf(gpsPassthroughPort, data, count);
+            serialConsumeRx(gpsState.gpsPort, count);
             LED0_OFF;
         }
-        if (serialRxBytesWaiting(gpsPassthroughPort)) {
+        if ((count = serialPeekRxSpan(gpsPassthroughPort, &data)) > 0) {
             LED1_ON;
-            c = serialRead(gpsPassthroughPort);
-            serialWrite(gpsState.gpsPort, c);
+            serialWriteBuf(gpsState.gpsPort, data, count);
+            serialConsumeRx(gpsPassthroughPort, count);
             LED1_OFF;
         }
     }
@@ -323,12 +323,8 @@ STATIC_PROTOTHREAD(gpsProtocolReceiverThread)
         ptWait(serialRxBytesWaiting(gpsState.gpsPort));
 
         // Consume bytes until buffer empty of until we have full message received
-        while (serialRxBytesWaiting(gpsState.gpsPort)) {
-            uint8_t newChar = serialRead(gpsState.gpsPort);
-            if (gpsNewFrameNAZA(newChar)) {
-                ptSemaphoreSignal(semNewDataReady);
-                break;
-            }
+        if (gpsReceiveFrame(gpsNewFrameNAZA)) {
+            ptSemaphoreSignal(semNewDataReady);
         }
     }
 
@@ -100,7 +100,7 @@ typedef struct gpsDataNmea_s {
 
 #define NMEA_BUFFER_SIZE        16
 
-static bool gpsNewFrameNMEA(char c)
+static bool gpsNewFrameNMEA(uint8_t c)
 {
     static gpsDataNmea_t gps_Msg;
 
@@ -273,14 +273,10 @@ STATIC_PROTOTHREAD(gpsProtocolReceiverThread)
         ptWait(serialRxBytesWaiting(gpsState.gpsPort));
 
         // Consume bytes until buffer empty of until we have full message received
-        while (serialRxBytesWaiting(gpsState.gpsPort)) {
-            uint8_t newChar = serialRead(gpsState.gpsPort);
-            if (gpsNewFrameNMEA(newChar)) {
-                gpsSol.flags.validVelNE = 0;
-                gpsSol.flags.validVelD = 0;
-                ptSemaphoreSignal(semNewDataReady);
-                break;
-            }
+        if (gpsReceiveFrame(gpsNewFrameNMEA)) {
+            gpsSol.flags.validVelNE = 0;
+            gpsSol.flags.validVelD = 0;
+            ptSemaphoreSignal(semNewDataReady);
         }
     }
 
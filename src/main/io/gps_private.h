@@ -68,6 +68,9 @@ extern uint16_t gpsConstrainHDOP(uint32_t hdop);
 void gpsProcessNewSolutionData(void);
 void gpsSetProtocolTimeout(timeMs_t timeoutMs);
 
+typedef bool (*gpsNewFrameFnPtr)(uint8_t c);
+bool gpsReceiveFrame(gpsNewFrameFnPtr newFrameFn);
+
 extern void gpsRestartUBLOX(void);
 extern void gpsHandleUBLOX(void);
 
@@ -821,12 +821,8 @@ STATIC_PROTOTHREAD(gpsProtocolReceiverThread)
         ptWait(serialRxBytesWaiting(gpsState.gpsPort));
 
         // Consume bytes until buffer empty of until we have full message received
-        while (serialRxBytesWaiting(gpsState.gpsPort)) {
-            uint8_t newChar = serialRead(gpsState.gpsPort);
-            if (gpsNewFrameUBLOX(newChar)) {
-                ptSemaphoreSignal(semNewDataReady);
-                break;
-            }
+        if (gpsReceiveFrame(gpsNewFrameUBLOX)) {
+            ptSemaphoreSignal(semNewDataReady);
         }
     }
 
@@ -532,25 +532,32 @@ void serialPassthrough(serialPort_t *left, serialPort_t *right, serialConsumer
     LED1_OFF;
 
     // Either port might be open in a mode other than MODE_RXTX. We rely on
-    // serialRxBytesWaiting() to do the right thing for a TX only port. No
+    // serialPeekRxSpan() to do the right thing for a TX only port. No
     // special handling is necessary OR performed.
     while (1) {
         // TODO: maintain a timestamp of last data received. Use this to
         // implement a guard interval and check for `+++` as an escape sequence
         // to return to CLI command mode.
         // https://en.wikipedia.org/wiki/Escape_sequence#Modem_control
-        if (serialRxBytesWaiting(left)) {
+        const uint8_t *data;
+        uint32_t count;
+
+        if ((count = serialPeekRxSpan(left, &data)) > 0) {
             LED0_ON;
-            uint8_t c = serialRead(left);
-            serialWrite(right, c);
-            leftC(c);
+            serialWriteBuf(right, data, count);
+            for (uint32_t i = 0; i < count; i++) {
+                leftC(data[i]);
+            }
+            serialConsumeRx(left, count);
             LED0_OFF;
          }
-         if (serialRxBytesWaiting(right)) {
+         if ((count = serialPeekRxSpan(right, &data)) > 0) {
              LED0_ON;
-             uint8_t c = serialRead(right);
-             serialWrite(left, c);
-             rightC(c);
+             serialWriteBuf(left, data, count);
+             for (uint32_t i = 0; i < count; i++) {
+                 rightC(data[i]);
+             }
+             serialConsumeRx(right, count);
              LED0_OFF;
          }
      }
@@ -46,6 +46,7 @@ typedef struct mspPacket_s {
 
 typedef enum {
     MSP_FLAG_DONT_REPLY           = (1 << 0),
+    MSP_FLAG_OUT_ONLY             = (1 << 1),   // Only run output commands, used for push subscriptions
 } mspFlags_e;
 
 struct serialPort_s;
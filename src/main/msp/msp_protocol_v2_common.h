@@ -27,4 +27,7 @@
 #define MSP2_COMMON_PG_LIST         0x1008  //in/out message    Returns a list of the PG ids used by the settings
 
 #define MSP2_COMMON_SERIAL_CONFIG       0x1009
-#define MSP2_COMMON_SET_SERIAL_CONFIG   0x100A
\ No newline at end of file
+#define MSP2_COMMON_SET_SERIAL_CONFIG   0x100A
+
+#define MSP2_COMMON_SETTINGS_EXPORT     0x100B  //in/out message    Returns raw values of consecutive settings (index, profile, type, value) of all profiles with a table CRC
+#define MSP2_COMMON_SETTINGS_IMPORT     0x100C  //in message        Applies raw setting values in one transaction, single EEPROM write on commit
\ No newline at end of file
@@ -52,3 +52,16 @@
 #define MSP2_INAV_TEMP_SENSOR_CONFIG            0x201C
 #define MSP2_INAV_SET_TEMP_SENSOR_CONFIG        0x201D
 #define MSP2_INAV_TEMPERATURES                  0x201E
+
+#define MSP2_INAV_DSHOT_COMMAND                 0x201F
+
+#define MSP2_INAV_MSP_STATS                     0x2020
+#define MSP2_INAV_MULTI_REQUEST                 0x2021
+#define MSP2_INAV_SUBSCRIBE                     0x2022
+#define MSP2_INAV_CHUNK_STREAM                  0x2023
+#define MSP2_INAV_CHUNK_DATA                    0x2024
+#define MSP2_INAV_CHUNK_ACK                     0x2025
+#define MSP2_INAV_WP_BLOCK                      0x2026
+#define MSP2_INAV_SET_WP_BLOCK                  0x2027
+#define MSP2_INAV_BOOTLOG                       0x2028
+#define MSP2_INAV_DATAFLASH_LOGS                0x2029
@@ -35,6 +35,7 @@
 #include "fc/cli.h"
 
 #include "msp/msp.h"
+#include "msp/msp_protocol.h"
 #include "msp/msp_serial.h"
 
 static mspPort_t mspPorts[MAX_MSP_PORT_COUNT];
@@ -136,8 +137,9 @@ static bool mspSerialProcessReceivedData(mspPort_t *mspPort, uint8_t c)
             mspPort->checksum1 ^= c;
             if (mspPort->offset == sizeof(mspHeaderV1_t)) {
                 mspHeaderV1_t * hdr = (mspHeaderV1_t *)&mspPort->inBuf[0];
+                const unsigned payloadSize = hdr->size;     // V1 sizes can't exceed larger buffers
                 // Check incoming buffer size limit
-                if (hdr->size > MSP_PORT_INBUF_SIZE) {
+                if (payloadSize > MSP_PORT_INBUF_SIZE) {
                     mspPort->c_state = MSP_IDLE;
                 }
                 else if (hdr->cmd == MSP_V2_FRAME_ID) {
@@ -378,6 +380,166 @@ static int mspSerialEncode(mspPort_t *msp, mspPacket_t *packet, mspVersion_e msp
     return mspSerialSendFrame(msp, hdrBuf, hdrLen, sbufPtr(&packet->buf), dataLen, crcBuf, crcLen);
 }
 
+/*
+ * Request: list of {U16 command id, U16 interval in ms}, replacing all subscriptions of this port. Empty request unsubscribes.
+ * Reply: U8 number of accepted subscriptions. Pushed frames use the MSP version of the subscribe request.
+ * Subscriptions are dropped after MSP_SUBSCRIPTION_TIMEOUT_MS without any data from the client, any request
+ * (e.g. repeating the subscription) keeps them alive.
+ */
+static mspResult_e mspSerialSubscribeCommand(mspPort_t *msp, sbuf_t *dst, sbuf_t *src)
+{
+    const timeMs_t now = millis();
+
+    msp->subscriptionCount = 0;
+    msp->subscriptionNext = 0;
+    msp->subscriptionVersion = msp->mspVersion;
+
+    while (sbufBytesRemaining(src) >= 4) {
+        const uint16_t cmd = sbufReadU16(src);
+        const uint16_t intervalMs = sbufReadU16(src);
+
+        if (intervalMs == 0 || cmd == MSP2_INAV_SUBSCRIBE || msp->subscriptionCount >= MSP_MAX_SUBSCRIPTIONS) {
+            continue;
+        }
+
+        mspSubscription_t *subscription = &msp->subscriptions[msp->subscriptionCount++];
+        subscription->cmd = cmd;
+        subscription->intervalMs = intervalMs;
+        subscription->lastSentMs = now - intervalMs;    // due right away
+    }
+
+    sbufWriteU8(dst, msp->subscriptionCount);
+    return MSP_RESULT_ACK;
+}
+
+/*
+ * Request: U16 read command, U32 start offset, U32 length, U16 chunk size, U8 window, optional U8 read flags.
+ * Length 0 aborts a running transfer.
+ * Reply: U16 accepted chunk size, U8 accepted window.
+ *
+ * The read command must be MSP_DATAFLASH_READ or MSP2_INAV_WP_BLOCK, both take {U32 offset, U16 size} and
+ * reply {U32 offset, data}. Waypoint chunks are rounded down to whole waypoints and take no read flags.
+ * Non-zero read flags are passed on as {U32 offset, U16 size, U8 flags}, and the reply must then be
+ * {U32 offset, U16 size of the source data covered, info, encoded data} with up to MSP_CHUNK_READ_INFO_SIZE bytes
+ * of size and info.
+ * Chunks are pushed as MSP2_INAV_CHUNK_DATA {U16 sequence, read command reply}, up to window chunks ahead
+ * of the last MSP2_INAV_CHUNK_ACK. A chunk covering less than the chunk size ends the transfer.
+ */
+static mspResult_e mspSerialChunkStreamCommand(mspPort_t *msp, sbuf_t *dst, sbuf_t *src)
+{
+    mspChunkTransfer_t * const transfer = &msp->transfer;
+
+    if (sbufBytesRemaining(src) < 13) {
+        return MSP_RESULT_ERROR;
+    }
+
+    const uint16_t readCmd = sbufReadU16(src);
+    const uint32_t offset = sbufReadU32(src);
+    const uint32_t length = sbufReadU32(src);
+    const uint16_t chunkSize = sbufReadU16(src);
+    const uint8_t window = sbufReadU8(src);
+    const uint8_t readFlags = sbufBytesRemaining(src) ? sbufReadU8(src) : 0;
+
+    memset(transfer, 0, sizeof(*transfer));
+
+    if (length == 0) {
+        sbufWriteU16(dst, 0);
+        sbufWriteU8(dst, 0);
+        return MSP_RESULT_ACK;
+    }
+
+    const uint16_t maxChunkSize = readFlags ? MSP_CHUNK_MAX_SIZE - MSP_CHUNK_READ_INFO_SIZE : MSP_CHUNK_MAX_SIZE;
+    uint16_t chunkAlign = 1;
+
+    switch (readCmd) {
+    case MSP_DATAFLASH_READ:
+        break;
+
+    case MSP2_INAV_WP_BLOCK:
+        if (readFlags) {
+            return MSP_RESULT_ERROR;
+        }
+        chunkAlign = MSP_WP_RECORD_SIZE;
+        break;
+
+    default:
+        // Other commands don't follow the offset/size convention and could have side effects
+        return MSP_RESULT_ERROR;
+    }
+
+    transfer->readCmd = readCmd;
+    transfer->readFlags = readFlags;
+    transfer->offset = offset;
+    transfer->length = length;
+    transfer->chunkSize = constrain(chunkSize, chunkAlign, maxChunkSize);
+    transfer->chunkSize -= transfer->chunkSize % chunkAlign;
+    transfer->window = constrain(window, 1, MSP_CHUNK_MAX_WINDOW);
+    transfer->lastSeq = (length - 1) / transfer->chunkSize;
+    transfer->version = msp->mspVersion;
+    transfer->lastAckMs = millis();
+    transfer->active = true;
+
+    sbufWriteU16(dst, transfer->chunkSize);
+    sbufWriteU8(dst, transfer->window);
+    return MSP_RESULT_ACK;
+}
+
+// Request: U16 sequence of the next chunk expected, acknowledging every chunk before it. No reply.
+static void mspSerialChunkAckCommand(mspPort_t *msp, sbuf_t *src)
+{
+    mspChunkTransfer_t * const transfer = &msp->transfer;
+
+    if (!transfer->active || sbufBytesRemaining(src) < 2) {
+        return;
+    }
+
+    // Sequence numbers on the wire are the low 16 bits, the window keeps them unambiguous
+    const uint32_t ackSeq = transfer->ackedSeq + (uint16_t)(sbufReadU16(src) - (uint16_t)transfer->ackedSeq);
+
+    if (ackSeq > transfer->ackedSeq && ackSeq <= transfer->nextSeq) {
+        transfer->ackedSeq = ackSeq;
+        transfer->lastAckMs = millis();
+        transfer->retries = 0;
+
+        if (transfer->ackedSeq > transfer->lastSeq) {
+            transfer->active = false;
+        }
+    }
+}
+
+/*
+ * Commands working on per port state, handled here rather than by the FC command processor.
+ * Returns true if the command was handled.
+ */
+static bool mspSerialProcessPortCommand(mspPort_t *msp, mspPacket_t *command, mspPacket_t *reply, mspResult_e *status)
+{
+    switch (command->cmd) {
+    case MSP2_INAV_SUBSCRIBE:
+        *status = mspSerialSubscribeCommand(msp, &reply->buf, &command->buf);
+        break;
+
+    case MSP2_INAV_CHUNK_STREAM:
+        *status = mspSerialChunkStreamCommand(msp, &reply->buf, &command->buf);
+        break;
+
+    case MSP2_INAV_CHUNK_ACK:
+        mspSerialChunkAckCommand(msp, &command->buf);
+        *status = MSP_RESULT_NO_REPLY;
+        break;
+
+    default:
+        return false;
+    }
+
+    if (command->flags & MSP_FLAG_DONT_REPLY) {
+        *status = MSP_RESULT_NO_REPLY;
+    }
+
+    reply->cmd = command->cmd;
+    reply->result = *status;
+    return true;
+}
+
 static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
 {
     uint8_t outBuf[MSP_PORT_OUTBUF_SIZE];
@@ -398,7 +560,11 @@ static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspPr
     };
 
     mspPostProcessFnPtr mspPostProcessFn = NULL;
-    const mspResult_e status = mspProcessCommandFn(&command, &reply, &mspPostProcessFn);
+    mspResult_e status;
+
+    if (!mspSerialProcessPortCommand(msp, &command, &reply, &status)) {
+        status = mspProcessCommandFn(&command, &reply, &mspPostProcessFn);
+    }
 
     if (status != MSP_RESULT_NO_REPLY) {
         sbufSwitchToReader(&reply.buf, outBufHead); // change streambuf direction
@@ -409,6 +575,144 @@ static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspPr
     return mspPostProcessFn;
 }
 
+/*
+ * Send the subscribed commands that are due, as long as the port TX buffer can take the whole frame.
+ * Commands that don't fit stay due and are retried on the next call, starting with the one that didn't fit.
+ */
+static void mspSerialProcessSubscriptions(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+{
+    uint8_t outBuf[MSP_PORT_OUTBUF_SIZE];
+    const timeMs_t now = millis();
+
+    for (int i = 0; i < msp->subscriptionCount; i++) {
+        const uint8_t index = (msp->subscriptionNext + i) % msp->subscriptionCount;
+        mspSubscription_t * const subscription = &msp->subscriptions[index];
+
+        if (now - subscription->lastSentMs < subscription->intervalMs) {
+            continue;
+        }
+
+        // Header and checksums alone don't fit, TX budget used up for this cycle
+        const uint32_t txBytesFree = serialTxBytesFree(msp->port);
+        if (txBytesFree <= MSP_MAX_HEADER_SIZE + 2) {
+            msp->subscriptionNext = index;
+            return;
+        }
+
+        mspPacket_t reply = {
+            .buf = { .ptr = outBuf, .end = ARRAYEND(outBuf), },
+            .cmd = -1,
+            .flags = 0,
+            .result = 0,
+        };
+
+        mspPacket_t command = {
+            .buf = { .ptr = NULL, .end = NULL, },
+            .cmd = subscription->cmd,
+            .flags = MSP_FLAG_OUT_ONLY,
+            .result = 0,
+        };
+
+        if (mspProcessCommandFn(&command, &reply, NULL) != MSP_RESULT_ACK) {
+            // Not an output command, nothing to stream
+            subscription->lastSentMs = now;
+            continue;
+        }
+
+        const int dataLen = reply.buf.ptr - outBuf;
+        if ((uint32_t)dataLen + MSP_MAX_HEADER_SIZE + 2 > txBytesFree) {
+            msp->subscriptionNext = index;
+            return;
+        }
+
+        sbufSwitchToReader(&reply.buf, outBuf);
+        mspSerialEncode(msp, &reply, msp->subscriptionVersion);
+        subscription->lastSentMs = now;
+    }
+}
+
+/*
+ * Push chunks of the running transfer until the window is full or the TX buffer can't take another chunk.
+ * Without acknowledgement progress the transfer goes back to the first unacknowledged chunk.
+ */
+static void mspSerialProcessChunkTransfer(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+{
+    mspChunkTransfer_t * const transfer = &msp->transfer;
+    uint8_t outBuf[MSP_PORT_OUTBUF_SIZE];
+    const timeMs_t now = millis();
+
+    if (transfer->nextSeq != transfer->ackedSeq && now - transfer->lastAckMs >= MSP_CHUNK_ACK_TIMEOUT_MS) {
+        if (++transfer->retries > MSP_CHUNK_MAX_RETRIES) {
+            transfer->active = false;
+            return;
+        }
+        transfer->nextSeq = transfer->ackedSeq;
+        transfer->lastAckMs = now;
+    }
+
+    while (transfer->nextSeq <= transfer->lastSeq && transfer->nextSeq - transfer->ackedSeq < transfer->window) {
+        const uint32_t chunkOffset = transfer->nextSeq * transfer->chunkSize;
+        const uint16_t chunkSize = MIN(transfer->chunkSize, transfer->length - chunkOffset);
+        const uint32_t replySize = chunkSize + MSP_CHUNK_HEADER_SIZE + 4u + (transfer->readFlags ? MSP_CHUNK_READ_INFO_SIZE : 0);
+
+        // Same rule as mspSerialSendFrame, checked before the chunk is read
+        if (!isSerialTransmitBufferEmpty(msp->port) && serialTxBytesFree(msp->port) < replySize + MSP_MAX_HEADER_SIZE + 2) {
+            return;
+        }
+
+        uint8_t request[7];
+        mspPacket_t command = {
+            .buf = { .ptr = request, .end = ARRAYEND(request), },
+            .cmd = transfer->readCmd,
+            .flags = 0,
+            .result = 0,
+        };
+        sbufWriteU32(&command.buf, transfer->offset + chunkOffset);
+        sbufWriteU16(&command.buf, chunkSize);
+        if (transfer->readFlags) {
+            sbufWriteU8(&command.buf, transfer->readFlags);
+        }
+        sbufSwitchToReader(&command.buf, request);
+
+        // Read command reply goes straight behind the sequence number
+        mspPacket_t reply = {
+            .buf = { .ptr = outBuf + MSP_CHUNK_HEADER_SIZE, .end = ARRAYEND(outBuf), },
+            .cmd = -1,
+            .flags = 0,
+            .result = 0,
+        };
+
+        const mspResult_e status = mspProcessCommandFn(&command, &reply, NULL);
+        const uint8_t *readData = outBuf + MSP_CHUNK_HEADER_SIZE + 4;   // Past the offset field
+        int readSize = reply.buf.ptr - readData;
+        if (transfer->readFlags) {
+            readSize = readSize >= 2 ? readData[0] | (readData[1] << 8) : 0;
+        }
+
+        reply.cmd = MSP2_INAV_CHUNK_DATA;
+        reply.result = status;
+        sbufSwitchToReader(&reply.buf, outBuf);
+        outBuf[0] = transfer->nextSeq & 0xFF;
+        outBuf[1] = (transfer->nextSeq >> 8) & 0xFF;
+
+        if (!mspSerialEncode(msp, &reply, transfer->version)) {
+            return;
+        }
+
+        if (status != MSP_RESULT_ACK) {
+            transfer->active = false;
+            return;
+        }
+
+        // Source ended before the requested length
+        if (readSize < chunkSize) {
+            transfer->lastSeq = transfer->nextSeq;
+        }
+
+        transfer->nextSeq++;
+    }
+}
+
 static void mspEvaluateNonMspData(mspPort_t * mspPort, uint8_t receivedChar)
 {
     if (receivedChar == '#') {
@@ -438,7 +742,7 @@ static void mspProcessPendingRequest(mspPort_t * mspPort)
             if (!cliMode) {
                 // When we enter CLI mode - disable this MSP port. Don't care about preserving the port since CLI can only be exited via reboot
                 cliEnter(mspPort->port);
-                mspPort->port = NULL;
+                resetMspPort(mspPort, NULL);
             }
             break;
 
@@ -467,19 +771,33 @@ void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessComm
             mspPort->lastActivityMs = millis();
             mspPort->pendingRequest = MSP_PENDING_NONE;
 
-            // Process incoming bytes
-            while (serialRxBytesWaiting(mspPort->port)) {
-                const uint8_t c = serialRead(mspPort->port);
-                const bool consumed = mspSerialProcessReceivedData(mspPort, c);
+            // Process incoming bytes span by span, leaving anything after a complete command in the port buffer
+            const uint8_t *data;
+            uint32_t count;
+            bool commandReceived = false;
 
-                if (!consumed && evaluateNonMspData == MSP_EVALUATE_NON_MSP_DATA) {
-                    mspEvaluateNonMspData(mspPort, c);
-                }
+            while (!commandReceived && (count = serialPeekRxSpan(mspPort->port, &data)) > 0) {
+                uint32_t processed = 0;
+
+                while (processed < count) {
+                    const uint8_t c = data[processed++];
+                    const bool consumed = mspSerialProcessReceivedData(mspPort, c);
+
+                    if (!consumed && evaluateNonMspData == MSP_EVALUATE_NON_MSP_DATA) {
+                        mspEvaluateNonMspData(mspPort, c);
+                    }
 
-                if (mspPort->c_state == MSP_COMMAND_RECEIVED) {
-                    mspPostProcessFn = mspSerialProcessReceivedCommand(mspPort, mspProcessCommandFn);
-                    break; // process one command at a time so as not to block.
+                    if (mspPort->c_state == MSP_COMMAND_RECEIVED) {
+                        commandReceived = true;
+                        break; // process one command at a time so as not to block.
+                    }
                 }
+
+                serialConsumeRx(mspPort->port, processed);
+            }
+
+            if (commandReceived) {
+                mspPostProcessFn = mspSerialProcessReceivedCommand(mspPort, mspProcessCommandFn);
             }
 
             if (mspPostProcessFn) {
@@ -490,6 +808,20 @@ void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessComm
         else {
             mspProcessPendingRequest(mspPort);
         }
+
+        // Port may have been handed over to the CLI
+        if (mspPort->port && mspPort->transfer.active) {
+            mspSerialProcessChunkTransfer(mspPort, mspProcessCommandFn);
+        }
+
+        if (mspPort->port && mspPort->subscriptionCount) {
+            // Client went away without unsubscribing
+            if (millis() - mspPort->lastActivityMs >= MSP_SUBSCRIPTION_TIMEOUT_MS) {
+                mspPort->subscriptionCount = 0;
+            } else if (serialIsConnected(mspPort->port)) {
+                mspSerialProcessSubscriptions(mspPort, mspProcessCommandFn);
+            }
+        }
     }
 }
 
@@ -536,6 +868,21 @@ int mspSerialPush(uint8_t cmd, const uint8_t *data, int datalen)
     return ret; // return the number of bytes written
 }
 
+/*
+ * Returns true while a chunked transfer is streaming on any port, the serial task then runs more often to keep
+ * the link busy.
+ */
+bool mspSerialTransferActive(void)
+{
+    for (int portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
+        if (mspPorts[portIndex].port && mspPorts[portIndex].transfer.active) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 uint32_t mspSerialTxBytesFree(void)
 {
     uint32_t ret = UINT32_MAX;
@@ -55,7 +55,9 @@ typedef enum {
     MSP_PENDING_CLI
 } mspPendingSystemRequest_e;
 
+#ifndef MSP_PORT_INBUF_SIZE
 #define MSP_PORT_INBUF_SIZE 192
+#endif
 #ifdef USE_FLASHFS
 #define MSP_PORT_DATAFLASH_BUFFER_SIZE 4096
 #define MSP_PORT_DATAFLASH_INFO_SIZE 16
@@ -81,6 +83,44 @@ typedef struct __attribute__((packed)) {
 
 #define MSP_MAX_HEADER_SIZE     9
 
+// Commands a client can subscribe to per port, sent periodically without a request
+#define MSP_MAX_SUBSCRIPTIONS   8
+// Subscriptions end when nothing was received from the client for this long
+#define MSP_SUBSCRIPTION_TIMEOUT_MS 5000
+
+typedef struct mspSubscription_s {
+    uint16_t cmd;
+    uint16_t intervalMs;
+    timeMs_t lastSentMs;
+} mspSubscription_t;
+
+// Chunked transfers: sequence number in front of every chunk, chunks in flight before an acknowledgement is needed
+#define MSP_CHUNK_HEADER_SIZE       2
+#define MSP_CHUNK_MAX_SIZE          (MSP_PORT_OUTBUF_SIZE - MSP_CHUNK_HEADER_SIZE - 4)
+#define MSP_CHUNK_MAX_WINDOW        16
+#define MSP_CHUNK_ACK_TIMEOUT_MS    250
+#define MSP_CHUNK_MAX_RETRIES       8
+// Reads with flags reply with up to this many bytes of info after the offset, starting with the U16 size of source data
+#define MSP_CHUNK_READ_INFO_SIZE    5
+// MSP2_INAV_WP_BLOCK replies whole waypoints of this size, chunks are multiples of it
+#define MSP_WP_RECORD_SIZE          21
+
+typedef struct mspChunkTransfer_s {
+    bool active;
+    mspVersion_e version;
+    uint16_t readCmd;
+    uint8_t readFlags;
+    uint16_t chunkSize;
+    uint8_t window;
+    uint8_t retries;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t nextSeq;       // Next chunk to send
+    uint32_t ackedSeq;      // All chunks before this one are acknowledged
+    uint32_t lastSeq;
+    timeMs_t lastAckMs;
+} mspChunkTransfer_t;
+
 struct serialPort_s;
 typedef struct mspPort_s {
     struct serialPort_s *port; // null when port unused.
@@ -95,6 +135,11 @@ typedef struct mspPort_s {
     uint16_t cmdMSP;
     uint8_t checksum1;
     uint8_t checksum2;
+    mspSubscription_t subscriptions[MSP_MAX_SUBSCRIPTIONS];
+    uint8_t subscriptionCount;
+    uint8_t subscriptionNext;
+    mspVersion_e subscriptionVersion;
+    mspChunkTransfer_t transfer;
 } mspPort_t;
 
 
@@ -105,4 +150,5 @@ void mspSerialReleasePortIfAllocated(struct serialPort_s *serialPort);
 int mspSerialPushPort(uint16_t cmd, const uint8_t *data, int datalen, mspPort_t *mspPort, mspVersion_e version);
 int mspSerialPush(uint8_t cmd, const uint8_t *data, int datalen);
 uint32_t mspSerialTxBytesFree(void);
+bool mspSerialTransferActive(void);
 mspPort_t * mspSerialPortFind(const struct serialPort_s *serialPort);
@@ -110,6 +110,9 @@ typedef enum {
 #ifdef USE_VTX_CONTROL
     TASK_VTXCTRL,
 #endif
+#ifdef USE_BLACKBOX
+    TASK_BLACKBOX,
+#endif
 
     /* Count of real tasks */
     TASK_COUNT,
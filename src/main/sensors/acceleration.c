@@ -512,6 +512,10 @@ void accGetMeasuredAcceleration(fpVector3_t *measuredAcc)
 
 void accUpdate(void)
 {
+    if (acc.dev.busDev && busIsBusy(acc.dev.busDev)) {
+        return;
+    }
+
     if (!acc.dev.readFn(&acc.dev)) {
         return;
     }
@@ -389,6 +389,11 @@ void gyroGetMeasuredRotationRate(fpVector3_t *measuredRotationRate)
 
 void gyroUpdate()
 {
+    // Skip this sample rather than wait for a DMA transfer on a shared bus
+    if (gyroDev0.busDev && busIsBusy(gyroDev0.busDev)) {
+        return;
+    }
+
     // range: +/- 8192; +/- 2000 deg/sec
     if (gyroDev0.readFn(&gyroDev0)) {
         if (zeroCalibrationIsCompleteV(&gyroCalibration)) {
@@ -48,34 +48,51 @@ bool sensorsAutodetect(void)
 {
     bool eepromUpdatePending = false;
 
-    if (!gyroInit()) {
+    addBootlogPhaseBegin(BOOT_EVENT_GYRO_DETECTION);
+    const bool gyroDetected = gyroInit();
+    addBootlogPhaseEnd(BOOT_EVENT_GYRO_DETECTION);
+    if (!gyroDetected) {
         return false;
     }
 
+    addBootlogPhaseBegin(BOOT_EVENT_ACC_DETECTION);
     accInit(getLooptime());
+    addBootlogPhaseEnd(BOOT_EVENT_ACC_DETECTION);
 
 #ifdef USE_BARO
+    addBootlogPhaseBegin(BOOT_EVENT_BARO_DETECTION);
     baroInit();
+    addBootlogPhaseEnd(BOOT_EVENT_BARO_DETECTION);
 #endif
 
 #ifdef USE_PITOT
+    addBootlogPhaseBegin(BOOT_EVENT_PITOT_DETECTION);
     pitotInit();
+    addBootlogPhaseEnd(BOOT_EVENT_PITOT_DETECTION);
 #endif
 
 #ifdef USE_MAG
+    addBootlogPhaseBegin(BOOT_EVENT_MAG_DETECTION);
     compassInit();
+    addBootlogPhaseEnd(BOOT_EVENT_MAG_DETECTION);
 #endif
 
 #ifdef USE_TEMPERATURE_SENSOR
+    addBootlogPhaseBegin(BOOT_EVENT_TEMP_SENSOR_DETECTION);
     temperatureInit();
+    addBootlogPhaseEnd(BOOT_EVENT_TEMP_SENSOR_DETECTION);
 #endif
 
 #ifdef USE_RANGEFINDER
+    addBootlogPhaseBegin(BOOT_EVENT_RANGEFINDER_DETECTION);
     rangefinderInit();
+    addBootlogPhaseEnd(BOOT_EVENT_RANGEFINDER_DETECTION);
 #endif
 
 #ifdef USE_OPTICAL_FLOW
+    addBootlogPhaseBegin(BOOT_EVENT_OPFLOW_DETECTION);
     opflowInit();
+    addBootlogPhaseEnd(BOOT_EVENT_OPFLOW_DETECTION);
 #endif
 
     if (accelerometerConfig()->acc_hardware == ACC_AUTODETECT) {
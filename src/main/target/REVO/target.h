@@ -87,6 +87,11 @@
 
 #define USE_UART_INVERTER
 
+#define USE_UART_RX_DMA
+// USART3 RX shares DMA1 stream 1 with the TIM2 motor outputs
+#define UART3_RX_DMA            DMA_NONE
+#define USE_UART_TX_DMA
+
 #define USE_UART1
 #define UART1_RX_PIN            PA10
 #define UART1_TX_PIN            PA9
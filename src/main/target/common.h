@@ -65,6 +65,9 @@
 #endif
 
 #if (FLASH_SIZE > 256)
+// Room for multi-waypoint and other bulk MSP requests on F4/F7
+#define MSP_PORT_INBUF_SIZE 1024
+
 #define USE_EXTENDED_CMS_MENUS
 #define USE_UAV_INTERCONNECT
 #define USE_RX_UIB
@@ -99,6 +102,17 @@
 
 #define USE_BOOTLOG
 #define BOOTLOG_DESCRIPTIONS
+#if !defined(STM32F411xE) && !defined(MAX_BOOTLOG_ENTRIES)
+// Room for the init phase timing events, F411 keeps the default to save RAM
+#define MAX_BOOTLOG_ENTRIES     128
+#endif
+
+#define USE_MSP_STATISTICS
+
+#if !defined(STM32F411xE)
+// Needs about 2.5 KB of RAM, whether compression is on or not
+#define USE_BLACKBOX_COMPRESSION
+#endif
 #endif
 
 #if (FLASH_SIZE > 128)
@@ -134,7 +148,9 @@
 #define USE_PWM_SERVO_DRIVER
 #define USE_SERIAL_PASSTHROUGH
 #define NAV_MAX_WAYPOINTS       60
+#ifndef MAX_BOOTLOG_ENTRIES
 #define MAX_BOOTLOG_ENTRIES     64
+#endif
 #define USE_RCDEVICE
 #define USE_PITOT
 #define USE_PITOT_ADC
@@ -35,3 +35,22 @@
 #if !defined(USE_MSP_DISPLAYPORT) && (FLASH_SIZE > 128) && !defined(USE_OSD)
 #define USE_MSP_DISPLAYPORT
 #endif
+
+// DSHOT on F4/F7 drives all motors of a timer with a single DMA burst
+#if defined(USE_DSHOT) && (defined(STM32F4) || defined(STM32F7))
+#define USE_DSHOT_DMAR
+#endif
+
+// DMA UART reception and transmission are opted in per target and implemented for F4 only
+#if defined(USE_UART_RX_DMA) && !defined(STM32F4)
+#undef USE_UART_RX_DMA
+#endif
+
+#if defined(USE_UART_TX_DMA) && !defined(STM32F4)
+#undef USE_UART_TX_DMA
+#endif
+
+// F4/F7 program the onboard flash and write SD card blocks by SPI DMA
+#if (defined(USE_FLASH_M25P16) || defined(USE_SDCARD_SPI)) && (defined(STM32F4) || defined(STM32F7))
+#define USE_SPI_DMA
+#endif
@@ -368,8 +368,11 @@ static bool processBinaryModeRequest(uint8_t address)
 
 static void flushHottRxBuffer(void)
 {
-    while (serialRxBytesWaiting(hottPort) > 0) {
-        serialRead(hottPort);
+    const uint8_t *data;
+    uint32_t count;
+
+    while ((count = serialPeekRxSpan(hottPort, &data)) > 0) {
+        serialConsumeRx(hottPort, count);
     }
 }
 
@@ -440,8 +443,8 @@ void handleHoTTTelemetry(timeUs_t currentTimeUs)
                 hottSwitchState(HOTT_WAITING_FOR_REQUEST, currentTimeUs);
             }
             else {
-                while (serialRxBytesWaiting(hottPort) && hottRequestBufferPtr < 2) {
-                    hottRequestBuffer[hottRequestBufferPtr++] = serialRead(hottPort);
+                if (hottRequestBufferPtr < 2) {
+                    hottRequestBufferPtr += serialReadBuf(hottPort, &hottRequestBuffer[hottRequestBufferPtr], 2 - hottRequestBufferPtr);
                 }
 
                 if (hottRequestBufferPtr >= 2) {
@@ -92,9 +92,7 @@ static uint8_t transmitIbusPacket(uint8_t ibusPacket[static IBUS_MIN_LEN], size_
     uint16_t checksum = ibusCalculateChecksum(ibusPacket, packetLength);
     ibusPacket[packetLength - IBUS_CHECKSUM_SIZE] = (checksum & 0xFF);
     ibusPacket[packetLength - IBUS_CHECKSUM_SIZE + 1] = (checksum >> 8);
-    for (size_t i = 0; i < packetLength; i++) {
-        serialWrite(ibusSerialPort, ibusPacket[i]);
-    }
+    serialWriteBuf(ibusSerialPort, ibusPacket, packetLength);
     return packetLength;
 }
 
@@ -187,9 +187,7 @@ static void mavlinkSendMessage(void)
     uint8_t mavBuffer[MAVLINK_MAX_PACKET_LEN];
     int msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavSendMsg);
 
-    for (int i = 0; i < msgLength; i++) {
-        serialWrite(mavlinkPort, mavBuffer[i]);
-    }
+    serialWriteBuf(mavlinkPort, mavBuffer, msgLength);
 }
 
 void mavlinkSendSystemStatus(void)
@@ -694,30 +692,41 @@ static bool handleIncoming_MISSION_REQUEST(void)
     return false;
 }
 
+static bool handleIncomingMavlinkMessage(void)
+{
+    switch (mavRecvMsg.msgid) {
+        case MAVLINK_MSG_ID_MISSION_CLEAR_ALL:
+            return handleIncoming_MISSION_CLEAR_ALL();
+        case MAVLINK_MSG_ID_MISSION_COUNT:
+            return handleIncoming_MISSION_COUNT();
+        case MAVLINK_MSG_ID_MISSION_ITEM:
+            return handleIncoming_MISSION_ITEM();
+        case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
+            return handleIncoming_MISSION_REQUEST_LIST();
+        case MAVLINK_MSG_ID_MISSION_REQUEST:
+            return handleIncoming_MISSION_REQUEST();
+        default:
+            return false;
+    }
+}
+
 static bool processMAVLinkIncomingTelemetry(void)
 {
-    while (serialRxBytesWaiting(mavlinkPort) > 0) {
-        // Limit handling to one message per cycle
-        char c = serialRead(mavlinkPort);
-        uint8_t result = mavlink_parse_char(0, c, &mavRecvMsg, &mavRecvStatus);
-        if (result == MAVLINK_FRAMING_OK) {
-            switch (mavRecvMsg.msgid) {
-                case MAVLINK_MSG_ID_HEARTBEAT:
-                    break;
-                case MAVLINK_MSG_ID_MISSION_CLEAR_ALL:
-                    return handleIncoming_MISSION_CLEAR_ALL();
-                case MAVLINK_MSG_ID_MISSION_COUNT:
-                    return handleIncoming_MISSION_COUNT();
-                case MAVLINK_MSG_ID_MISSION_ITEM:
-                    return handleIncoming_MISSION_ITEM();
-                case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
-                    return handleIncoming_MISSION_REQUEST_LIST();
-                case MAVLINK_MSG_ID_MISSION_REQUEST:
-                    return handleIncoming_MISSION_REQUEST();
-                default:
-                    return false;
+    const uint8_t *data;
+    uint32_t count;
+
+    while ((count = serialPeekRxSpan(mavlinkPort, &data)) > 0) {
+        for (uint32_t processed = 0; processed < count; ) {
+            uint8_t result = mavlink_parse_char(0, data[processed++], &mavRecvMsg, &mavRecvStatus);
+
+            // Limit handling to one message per cycle, heartbeats don't count
+            if (result == MAVLINK_FRAMING_OK && mavRecvMsg.msgid != MAVLINK_MSG_ID_HEARTBEAT) {
+                serialConsumeRx(mavlinkPort, processed);
+                return handleIncomingMavlinkMessage();
             }
         }
+
+        serialConsumeRx(mavlinkPort, count);
     }
 
     return false;
@@ -219,15 +219,23 @@ smartPortPayload_t *smartPortDataReceive(uint16_t c, bool *clearToSend, smartPor
     return NULL;
 }
 
-void smartPortSendByte(uint8_t c, uint16_t *checksum, serialPort_t *port)
+static uint8_t smartPortEscapeByte(uint8_t c, uint8_t *dst)
 {
     // smart port escape sequence
     if (c == FSSP_DLE || c == FSSP_START_STOP) {
-        serialWrite(port, FSSP_DLE);
-        serialWrite(port, c ^ FSSP_DLE_XOR);
+        dst[0] = FSSP_DLE;
+        dst[1] = c ^ FSSP_DLE_XOR;
+        return 2;
     } else {
-        serialWrite(port, c);
+        dst[0] = c;
+        return 1;
     }
+}
+
+void smartPortSendByte(uint8_t c, uint16_t *checksum, serialPort_t *port)
+{
+    uint8_t buf[2];
+    serialWriteBuf(port, buf, smartPortEscapeByte(c, buf));
 
     if (checksum != NULL) {
         *checksum += c;
@@ -241,12 +249,19 @@ bool smartPortPayloadContainsMSP(const smartPortPayload_t *payload)
 
 void smartPortWriteFrameSerial(const smartPortPayload_t *payload, serialPort_t *port, uint16_t checksum)
 {
-    uint8_t *data = (uint8_t *)payload;
+    // Escaped frame is assembled in one go, worst case every byte including checksum is escaped
+    uint8_t frame[(sizeof(smartPortPayload_t) + 1) * 2];
+    uint8_t *dst = frame;
+
+    const uint8_t *data = (const uint8_t *)payload;
     for (unsigned i = 0; i < sizeof(smartPortPayload_t); i++) {
-        smartPortSendByte(*data++, &checksum, port);
+        checksum += *data;
+        dst += smartPortEscapeByte(*data++, dst);
     }
     checksum = 0xff - ((checksum & 0xff) + (checksum >> 8));
-    smartPortSendByte((uint8_t)checksum, NULL, port);
+    dst += smartPortEscapeByte((uint8_t)checksum, dst);
+
+    serialWriteBuf(port, frame, dst - frame);
 }
 
 static void smartPortWriteFrameInternal(const smartPortPayload_t *payload)
@@ -0,0 +1,284 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "blackbox/blackbox_compress.h"
+    #include "blackbox/blackbox_encoding.h"
+    #include "blackbox/blackbox_io.h"
+
+    #include "common/utils.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+typedef std::vector<uint8_t> bytes_t;
+
+static uint16_t hashTable[BLACKBOX_COMPRESS_HASH_SIZE];
+
+static bytes_t compressStream(const bytes_t &input)
+{
+    bytes_t output;
+    uint8_t block[BLACKBOX_COMPRESS_MAX_OUTPUT(BLACKBOX_COMPRESS_BLOCK_SIZE)];
+
+    for (size_t pos = 0; pos < input.size(); pos += BLACKBOX_COMPRESS_BLOCK_SIZE) {
+        const int length = std::min(input.size() - pos, (size_t)BLACKBOX_COMPRESS_BLOCK_SIZE);
+        const int blockLength = blackboxCompressBlock(block, input.data() + pos, length, hashTable);
+        EXPECT_LE(blockLength, BLACKBOX_COMPRESS_MAX_OUTPUT(length));
+        output.insert(output.end(), block, block + blockLength);
+    }
+
+    return output;
+}
+
+// Host side stream decoder, skips over whatever isn't a valid block
+static bytes_t decompressStream(const bytes_t &input, int *skippedBytes)
+{
+    bytes_t output;
+    uint8_t block[BLACKBOX_COMPRESS_BLOCK_SIZE];
+    size_t pos = 0;
+
+    *skippedBytes = 0;
+    while (pos < input.size()) {
+        int blockLength;
+        const int length = blackboxDecompressBlock(block, sizeof(block), input.data() + pos, input.size() - pos, &blockLength);
+
+        if (length >= 0) {
+            output.insert(output.end(), block, block + length);
+            pos += blockLength;
+        } else if (length == BLACKBOX_DECOMPRESS_INCOMPLETE) {
+            *skippedBytes += input.size() - pos;
+            break;
+        } else {
+            (*skippedBytes)++;
+            pos++;
+        }
+    }
+
+    return output;
+}
+
+// Pseudo random numbers that are the same on every host
+static uint32_t randomState;
+
+static uint32_t randomNext(void)
+{
+    randomState = randomState * 1664525 + 1013904223;
+    return randomState >> 8;
+}
+
+static int32_t randomNoise(int amplitude)
+{
+    return (int32_t)(randomNext() % (2 * amplitude + 1)) - amplitude;
+}
+
+/*
+ * Main frames shaped like those of a quad in flight, encoded with the firmware encoders and predictors: smooth
+ * setpoints and PID terms, rarely changing RC and sensors, filtered gyro, acc and motors, and an I-frame every 32
+ * frames.
+ */
+static bytes_t syntheticFlightLog(int frames)
+{
+    bytes_t log;
+    uint8_t frame[256];
+    int32_t history[3][20] = {};
+    float filtered[19] = {};
+
+    randomState = 1;
+    for (int i = 0; i < frames; i++) {
+        int32_t *current = history[0];
+        const float t = i * 0.001f;
+
+        for (int field = 9; field < 19; field++) {
+            filtered[field] += 0.1f * (randomNoise(40) - filtered[field]);
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            current[axis] = 200 * sinf(t * (1 + axis));                                    // axisRate
+            current[3 + axis] = 40 * sinf(t * (1 + axis) + 0.5f) + filtered[9 + axis] / 4; // axisP
+            current[6 + axis] = 10 * sinf(t * 0.1f * (1 + axis));                          // axisI
+            current[9 + axis] = current[axis] + filtered[9 + axis];                        // gyroADC
+            current[12 + axis] = (axis == 2 ? 512 : 0) + filtered[12 + axis];              // accSmooth
+        }
+        for (int motor = 0; motor < 4; motor++) {
+            current[15 + motor] = 1400 + current[3 + motor % 3] + filtered[15 + motor] / 2;
+        }
+        current[19] = (i % 200 == 0) ? randomNoise(1) : 0;                                 // rc and sensor deltas
+
+        uint8_t *pos = frame;
+        if (i % 32 == 0) {
+            *pos++ = 'I';
+            pos = blackboxEncodeUnsignedVB(pos, i);
+            pos = blackboxEncodeUnsignedVB(pos, i * 1000);
+            for (int field = 0; field < 19; field++) {
+                pos = blackboxEncodeSignedVB(pos, current[field]);
+            }
+            memcpy(history[1], current, sizeof(history[0]));
+            memcpy(history[2], current, sizeof(history[0]));
+        } else {
+            int32_t deltas[8];
+
+            *pos++ = 'P';
+            pos = blackboxEncodeSignedVB(pos, randomNoise(1));
+            for (int field = 0; field < 6; field++) {
+                pos = blackboxEncodeSignedVB(pos, current[field] - history[1][field]);
+            }
+            for (int axis = 0; axis < 3; axis++) {
+                deltas[axis] = current[6 + axis] - history[1][6 + axis];
+            }
+            pos = blackboxEncodeTag2_3S32(pos, deltas);
+            for (int field = 0; field < 4; field++) {
+                deltas[field] = current[19];
+            }
+            pos = blackboxEncodeTag8_4S16(pos, deltas);
+            pos = blackboxEncodeTag8_4S16(pos, deltas);
+            pos = blackboxEncodeTag8_8SVB(pos, deltas, 3);
+            for (int field = 9; field < 19; field++) {
+                pos = blackboxEncodeSignedVB(pos, current[field] - (history[1][field] + history[2][field]) / 2);
+            }
+            memcpy(history[2], history[1], sizeof(history[0]));
+            memcpy(history[1], current, sizeof(history[0]));
+        }
+        log.insert(log.end(), frame, pos);
+    }
+
+    return log;
+}
+
+TEST(BlackboxCompressTest, RoundTripFlightLog)
+{
+    const bytes_t log = syntheticFlightLog(20000);
+    const bytes_t compressed = compressStream(log);
+
+    int skipped;
+    EXPECT_EQ(log, decompressStream(compressed, &skipped));
+    EXPECT_EQ(0, skipped);
+
+    EXPECT_LT(compressed.size(), log.size() * 85 / 100);
+}
+
+TEST(BlackboxCompressTest, EdgeCases)
+{
+    // Long runs need extra match length bytes, text needs extra literal length bytes
+    bytes_t input(3000, 0);
+    const char *text = "End of log (disarm reason:3)";
+    input.insert(input.end(), text, text + strlen(text));
+    for (int i = 0; i < 600; i++) {
+        input.push_back(i % 7);
+    }
+    for (int i = 0; i < 400; i++) {
+        input.push_back(randomNext());
+    }
+
+    int skipped;
+    EXPECT_EQ(input, decompressStream(compressStream(input), &skipped));
+    EXPECT_EQ(0, skipped);
+
+    // Short and empty blocks
+    for (int length = 0; length < 10; length++) {
+        const bytes_t small(input.end() - length, input.end());
+        EXPECT_EQ(small, decompressStream(compressStream(small), &skipped));
+    }
+
+    uint8_t block[BLACKBOX_COMPRESS_MAX_OUTPUT(0)];
+    EXPECT_EQ(BLACKBOX_COMPRESS_HEADER_SIZE, blackboxCompressBlock(block, NULL, 0, hashTable));
+}
+
+TEST(BlackboxCompressTest, IncompressibleBlocksAreStored)
+{
+    bytes_t input;
+    for (int i = 0; i < BLACKBOX_COMPRESS_BLOCK_SIZE; i++) {
+        input.push_back(randomNext());
+    }
+
+    const bytes_t compressed = compressStream(input);
+    ASSERT_EQ((size_t)BLACKBOX_COMPRESS_MAX_OUTPUT(BLACKBOX_COMPRESS_BLOCK_SIZE), compressed.size());
+    EXPECT_TRUE(compressed[2] & (BLACKBOX_COMPRESS_STORED_FLAG >> 8));
+
+    int skipped;
+    EXPECT_EQ(input, decompressStream(compressed, &skipped));
+}
+
+TEST(BlackboxCompressTest, DecoderResynchronises)
+{
+    const bytes_t log = syntheticFlightLog(3000);
+    bytes_t compressed = compressStream(log);
+
+    int firstBlockLength;
+    uint8_t block[BLACKBOX_COMPRESS_BLOCK_SIZE];
+    ASSERT_EQ(BLACKBOX_COMPRESS_BLOCK_SIZE, blackboxDecompressBlock(block, sizeof(block), compressed.data(), compressed.size(), &firstBlockLength));
+
+    // A truncated block waits for more data
+    EXPECT_EQ(BLACKBOX_DECOMPRESS_INCOMPLETE, blackboxDecompressBlock(block, sizeof(block), compressed.data(), firstBlockLength - 1, &firstBlockLength));
+
+    // Corrupt the second block and insert garbage before the third, everything else still decodes
+    int secondBlockLength;
+    ASSERT_EQ(BLACKBOX_COMPRESS_BLOCK_SIZE, blackboxDecompressBlock(block, sizeof(block), compressed.data() + firstBlockLength,
+        compressed.size() - firstBlockLength, &secondBlockLength));
+    compressed[firstBlockLength + secondBlockLength / 2] ^= 0x10;
+    const bytes_t garbage = { 'Z', 0x10, 0x00, 0x10, 0x00, 0x55, 'Z', 'Z', 1, 2, 3 };
+    compressed.insert(compressed.begin() + firstBlockLength + secondBlockLength, garbage.begin(), garbage.end());
+
+    int skipped;
+    const bytes_t decoded = decompressStream(compressed, &skipped);
+    EXPECT_EQ(secondBlockLength + (int)garbage.size(), skipped);
+
+    bytes_t expected(log.begin(), log.begin() + BLACKBOX_COMPRESS_BLOCK_SIZE);
+    expected.insert(expected.end(), log.begin() + 2 * BLACKBOX_COMPRESS_BLOCK_SIZE, log.end());
+    EXPECT_EQ(expected, decoded);
+}
+
+// STUBS
+
+extern "C" {
+    int32_t blackboxHeaderBudget;
+
+    void blackboxWrite(uint8_t value)
+    {
+        UNUSED(value);
+    }
+
+    void blackboxWriteBuf(const uint8_t *data, int length)
+    {
+        UNUSED(data);
+        UNUSED(length);
+    }
+
+    int blackboxPrint(const char *s)
+    {
+        UNUSED(s);
+        return 0;
+    }
+
+    int tfp_format(void *putp, void (*putf) (void *, char), const char *fmt, va_list va)
+    {
+        UNUSED(putp);
+        UNUSED(putf);
+        UNUSED(fmt);
+        UNUSED(va);
+        return 0;
+    }
+}
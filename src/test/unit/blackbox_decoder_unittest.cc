@@ -0,0 +1,650 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "blackbox/blackbox_compress.h"
+    #include "blackbox/blackbox_encoding.h"
+    #include "blackbox/blackbox_fielddefs.h"
+    #include "blackbox/blackbox_io.h"
+
+    #include "common/utils.h"
+
+    #include "blackbox_decoder.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+typedef std::vector<uint8_t> bytes_t;
+
+struct frame_t {
+    char type;
+    std::vector<int32_t> values;
+
+    bool operator==(const frame_t &other) const
+    {
+        return type == other.type && values == other.values;
+    }
+};
+
+struct event_t {
+    FlightLogEvent event;
+    uint32_t value;
+    std::string message;
+
+    bool operator==(const event_t &other) const
+    {
+        return event == other.event && value == other.value && message == other.message;
+    }
+};
+
+struct fieldDef_t {
+    const char *name;
+    bool isSigned;
+    uint8_t Ipredict;
+    uint8_t Iencode;
+    uint8_t Ppredict;
+    uint8_t Pencode;
+};
+
+#define PREDICT(x)  FLIGHT_LOG_FIELD_PREDICTOR_ ## x
+#define ENCODING(x) FLIGHT_LOG_FIELD_ENCODING_ ## x
+
+// A subset of blackboxMainFields[] covering every predictor and encoding of main frames
+static const fieldDef_t mainFields[] = {
+    {"loopIteration", false, PREDICT(0),           ENCODING(UNSIGNED_VB), PREDICT(INC),           ENCODING(NULL)},
+    {"time",          false, PREDICT(0),           ENCODING(UNSIGNED_VB), PREDICT(STRAIGHT_LINE), ENCODING(SIGNED_VB)},
+    {"axisRate[0]",   true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(PREVIOUS),      ENCODING(SIGNED_VB)},
+    {"axisRate[1]",   true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(PREVIOUS),      ENCODING(SIGNED_VB)},
+    {"axisRate[2]",   true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(PREVIOUS),      ENCODING(SIGNED_VB)},
+    {"axisI[0]",      true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(PREVIOUS),      ENCODING(TAG2_3S32)},
+    {"axisI[1]",      true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(PREVIOUS),      ENCODING(TAG2_3S32)},
+    {"axisI[2]",      true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(PREVIOUS),      ENCODING(TAG2_3S32)},
+    {"rcCommand[0]",  true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(PREVIOUS),      ENCODING(TAG8_4S16)},
+    {"rcCommand[1]",  true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(PREVIOUS),      ENCODING(TAG8_4S16)},
+    {"rcCommand[2]",  true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(PREVIOUS),      ENCODING(TAG8_4S16)},
+    {"rcCommand[3]",  false, PREDICT(MINTHROTTLE), ENCODING(UNSIGNED_VB), PREDICT(PREVIOUS),      ENCODING(TAG8_4S16)},
+    {"vbat",          false, PREDICT(VBATREF),     ENCODING(NEG_14BIT),   PREDICT(PREVIOUS),      ENCODING(TAG8_8SVB)},
+    {"amperage",      true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(PREVIOUS),      ENCODING(TAG8_8SVB)},
+    {"gyroADC[0]",    true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(AVERAGE_2),     ENCODING(SIGNED_VB)},
+    {"gyroADC[1]",    true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(AVERAGE_2),     ENCODING(SIGNED_VB)},
+    {"gyroADC[2]",    true,  PREDICT(0),           ENCODING(SIGNED_VB),   PREDICT(AVERAGE_2),     ENCODING(SIGNED_VB)},
+    {"motor[0]",      false, PREDICT(MINTHROTTLE), ENCODING(UNSIGNED_VB), PREDICT(AVERAGE_2),     ENCODING(SIGNED_VB)},
+    {"motor[1]",      false, PREDICT(MOTOR_0),     ENCODING(SIGNED_VB),   PREDICT(AVERAGE_2),     ENCODING(SIGNED_VB)},
+    {"motor[2]",      false, PREDICT(MOTOR_0),     ENCODING(SIGNED_VB),   PREDICT(AVERAGE_2),     ENCODING(SIGNED_VB)},
+    {"motor[3]",      false, PREDICT(MOTOR_0),     ENCODING(SIGNED_VB),   PREDICT(AVERAGE_2),     ENCODING(SIGNED_VB)},
+};
+
+static const fieldDef_t gpsFields[] = {
+    {"time",          false, PREDICT(LAST_MAIN_FRAME_TIME), ENCODING(UNSIGNED_VB), 0, 0},
+    {"GPS_numSat",    false, PREDICT(0),                    ENCODING(UNSIGNED_VB), 0, 0},
+    {"GPS_coord[0]",  true,  PREDICT(HOME_COORD),           ENCODING(SIGNED_VB),   0, 0},
+    {"GPS_coord[1]",  true,  PREDICT(HOME_COORD),           ENCODING(SIGNED_VB),   0, 0},
+    {"GPS_speed",     false, PREDICT(0),                    ENCODING(UNSIGNED_VB), 0, 0},
+};
+
+static const fieldDef_t gpsHomeFields[] = {
+    {"GPS_home[0]",   true,  PREDICT(0),           ENCODING(SIGNED_VB),   0, 0},
+    {"GPS_home[1]",   true,  PREDICT(0),           ENCODING(SIGNED_VB),   0, 0},
+};
+
+static const fieldDef_t slowFields[] = {
+    {"flightModeFlags",       false, PREDICT(0),   ENCODING(UNSIGNED_VB), 0, 0},
+    {"failsafePhase",         false, PREDICT(0),   ENCODING(TAG2_3S32),   0, 0},
+    {"rxSignalReceived",      false, PREDICT(0),   ENCODING(TAG2_3S32),   0, 0},
+    {"rxFlightChannelsValid", false, PREDICT(0),   ENCODING(TAG2_3S32),   0, 0},
+};
+
+#define MINTHROTTLE     1070
+#define VBATREF         1680
+#define I_INTERVAL      32
+#define P_INTERVAL_NUM  1
+#define P_INTERVAL_DENOM 2
+
+#define FIELD_COUNT(fields) ((int)ARRAYLEN(fields))
+
+static uint32_t randomState;
+
+static int32_t randomNoise(int amplitude)
+{
+    randomState = randomState * 1664525 + 1013904223;
+    return (int32_t)((randomState >> 8) % (2 * amplitude + 1)) - amplitude;
+}
+
+/*
+ * Writes a log the way blackbox.c does, with the firmware encoders, and records what a decoder should read back.
+ */
+class LogWriter {
+public:
+    bytes_t headers;
+    bytes_t data;
+    std::vector<frame_t> frames;
+    std::vector<event_t> events;
+
+    explicit LogWriter(bool compressed = false)
+    {
+        printHeader("Product", "Blackbox flight data recorder by Nicholas Sherlock");
+        printHeader("Data version", "2");
+        printHeader("I interval", std::to_string(I_INTERVAL));
+        printFieldHeaders('I', 'P', mainFields, FIELD_COUNT(mainFields));
+        printFieldHeaders('H', 0, gpsHomeFields, FIELD_COUNT(gpsHomeFields));
+        printFieldHeaders('G', 0, gpsFields, FIELD_COUNT(gpsFields));
+        printFieldHeaders('S', 0, slowFields, FIELD_COUNT(slowFields));
+        printHeader("Firmware type", "Cleanflight");
+        printHeader("P interval", std::to_string(P_INTERVAL_NUM) + "/" + std::to_string(P_INTERVAL_DENOM));
+        if (compressed) {
+            printHeader("data_compression", BLACKBOX_COMPRESS_FORMAT);
+        }
+        printHeader("minthrottle", std::to_string(MINTHROTTLE));
+        printHeader("vbatref", std::to_string(VBATREF));
+    }
+
+    void writeFlight(int iterations)
+    {
+        int32_t history[3][FIELD_COUNT(mainFields)] = {};
+
+        randomState = 1;
+        writeEvent(FLIGHT_LOG_EVENT_SYNC_BEEP, 1234);
+        writeSlowFrame(0x05, 0, 1, 1);
+        writeGPSHomeFrame(473977420, 85455940);
+
+        for (int iteration = 0; iteration < iterations; iteration++) {
+            // blackboxShouldLogPFrame()
+            const int pFrameIndex = iteration % I_INTERVAL;
+            if ((pFrameIndex + P_INTERVAL_NUM - 1) % P_INTERVAL_DENOM >= P_INTERVAL_NUM) {
+                continue;
+            }
+
+            int32_t *current = history[0];
+            current[0] = iteration;
+            current[1] = 1000000 + iteration * 1000 + randomNoise(3);
+            for (int axis = 0; axis < 3; axis++) {
+                current[2 + axis] = (iteration % 700) - 350 + randomNoise(2);
+                current[5 + axis] = (iteration / 50) % 30 - 15 + axis;
+                current[8 + axis] = (iteration % 97 < 50) ? 0 : randomNoise(500);
+                current[14 + axis] = current[2 + axis] + randomNoise(40);
+            }
+            current[11] = 1400 + (iteration / 10) % 400;
+            current[12] = VBATREF - 10 - iteration / 500;
+            current[13] = 1200 + (iteration % 3 ? 0 : randomNoise(100));
+            for (int motor = 0; motor < 4; motor++) {
+                current[17 + motor] = current[11] + randomNoise(60);
+            }
+
+            if (pFrameIndex == 0) {
+                writeIntraframe(current);
+                memcpy(history[1], current, sizeof(history[0]));
+                memcpy(history[2], current, sizeof(history[0]));
+            } else {
+                writeInterframe(history[0], history[1], history[2]);
+                memcpy(history[2], history[1], sizeof(history[0]));
+                memcpy(history[1], history[0], sizeof(history[0]));
+            }
+            frames.push_back({ pFrameIndex == 0 ? 'I' : 'P', std::vector<int32_t>(current, current + FIELD_COUNT(mainFields)) });
+
+            if (iteration % 200 == 100) {
+                writeGPSFrame(current[1] + 123, 12, 473977420 + iteration, 85455940 - iteration, 850);
+            }
+            if (iteration % 1000 == 500) {
+                writeSlowFrame(0x07, 1, 1, 0);
+                writeInflightAdjustment(3, 0.125f);
+            }
+        }
+
+        writeLogEnd("End of log (disarm reason:3)");
+    }
+
+    bytes_t log(bool compressed = false) const
+    {
+        bytes_t log = headers;
+
+        if (compressed) {
+            static uint16_t hashTable[BLACKBOX_COMPRESS_HASH_SIZE];
+            uint8_t block[BLACKBOX_COMPRESS_MAX_OUTPUT(BLACKBOX_COMPRESS_BLOCK_SIZE)];
+
+            for (size_t pos = 0; pos < data.size(); pos += BLACKBOX_COMPRESS_BLOCK_SIZE) {
+                const int length = std::min(data.size() - pos, (size_t)BLACKBOX_COMPRESS_BLOCK_SIZE);
+                const int blockLength = blackboxCompressBlock(block, data.data() + pos, length, hashTable);
+                log.insert(log.end(), block, block + blockLength);
+            }
+        } else {
+            log.insert(log.end(), data.begin(), data.end());
+        }
+
+        return log;
+    }
+
+private:
+    uint8_t buffer[256];
+    int32_t gpsHome[2];
+    uint32_t lastMainTime;
+
+    void printHeader(const std::string &name, const std::string &value)
+    {
+        const std::string line = "H " + name + ":" + value + "\n";
+        headers.insert(headers.end(), line.begin(), line.end());
+    }
+
+    // sendFieldDefinition()
+    void printFieldHeaders(char frameType, char deltaFrameType, const fieldDef_t *fields, int count)
+    {
+        std::string names, isSigned, Ipredict, Iencode, Ppredict, Pencode;
+
+        for (int i = 0; i < count; i++) {
+            const char *comma = i ? "," : "";
+            names += comma + std::string(fields[i].name);
+            isSigned += comma + std::to_string(fields[i].isSigned);
+            Ipredict += comma + std::to_string(fields[i].Ipredict);
+            Iencode += comma + std::to_string(fields[i].Iencode);
+            Ppredict += comma + std::to_string(fields[i].Ppredict);
+            Pencode += comma + std::to_string(fields[i].Pencode);
+        }
+
+        const std::string frame(1, frameType);
+        printHeader("Field " + frame + " name", names);
+        printHeader("Field " + frame + " signed", isSigned);
+        printHeader("Field " + frame + " predictor", Ipredict);
+        printHeader("Field " + frame + " encoding", Iencode);
+        if (deltaFrameType) {
+            const std::string deltaFrame(1, deltaFrameType);
+            printHeader("Field " + deltaFrame + " predictor", Ppredict);
+            printHeader("Field " + deltaFrame + " encoding", Pencode);
+        }
+    }
+
+    void append(uint8_t *end)
+    {
+        data.insert(data.end(), buffer, end);
+    }
+
+    // writeIntraframe()
+    void writeIntraframe(const int32_t *current)
+    {
+        uint8_t *dst = buffer;
+
+        lastMainTime = current[1];
+
+        *dst++ = 'I';
+        dst = blackboxEncodeUnsignedVB(dst, current[0]);
+        dst = blackboxEncodeUnsignedVB(dst, current[1]);
+        for (int i = 2; i < 11; i++) {
+            dst = blackboxEncodeSignedVB(dst, current[i]);
+        }
+        dst = blackboxEncodeUnsignedVB(dst, current[11] - MINTHROTTLE);
+        dst = blackboxEncodeUnsignedVB(dst, (VBATREF - current[12]) & 0x3FFF);
+        dst = blackboxEncodeSignedVB(dst, current[13]);
+        for (int i = 14; i < 17; i++) {
+            dst = blackboxEncodeSignedVB(dst, current[i]);
+        }
+        dst = blackboxEncodeUnsignedVB(dst, current[17] - MINTHROTTLE);
+        for (int i = 18; i < 21; i++) {
+            dst = blackboxEncodeSignedVB(dst, current[i] - current[17]);
+        }
+        append(dst);
+    }
+
+    // writeInterframe()
+    void writeInterframe(const int32_t *current, const int32_t *previous, const int32_t *previous2)
+    {
+        uint8_t *dst = buffer;
+        int32_t deltas[8];
+
+        lastMainTime = current[1];
+
+        *dst++ = 'P';
+        dst = blackboxEncodeSignedVB(dst, current[1] - 2 * previous[1] + previous2[1]);
+        for (int i = 2; i < 5; i++) {
+            dst = blackboxEncodeSignedVB(dst, current[i] - previous[i]);
+        }
+        for (int i = 0; i < 3; i++) {
+            deltas[i] = current[5 + i] - previous[5 + i];
+        }
+        dst = blackboxEncodeTag2_3S32(dst, deltas);
+        for (int i = 0; i < 4; i++) {
+            deltas[i] = current[8 + i] - previous[8 + i];
+        }
+        dst = blackboxEncodeTag8_4S16(dst, deltas);
+        deltas[0] = current[12] - previous[12];
+        deltas[1] = current[13] - previous[13];
+        dst = blackboxEncodeTag8_8SVB(dst, deltas, 2);
+        for (int i = 14; i < 21; i++) {
+            dst = blackboxEncodeSignedVB(dst, current[i] - (previous[i] + previous2[i]) / 2);
+        }
+        append(dst);
+    }
+
+    // writeSlowFrame()
+    void writeSlowFrame(uint32_t flightModeFlags, int32_t failsafePhase, int32_t rxSignalReceived, int32_t rxFlightChannelsValid)
+    {
+        const int32_t values[3] = { failsafePhase, rxSignalReceived, rxFlightChannelsValid };
+        uint8_t *dst = buffer;
+
+        *dst++ = 'S';
+        dst = blackboxEncodeUnsignedVB(dst, flightModeFlags);
+        dst = blackboxEncodeTag2_3S32(dst, values);
+        append(dst);
+
+        frames.push_back({ 'S', { (int32_t)flightModeFlags, failsafePhase, rxSignalReceived, rxFlightChannelsValid } });
+    }
+
+    // writeGPSHomeFrame()
+    void writeGPSHomeFrame(int32_t lat, int32_t lon)
+    {
+        uint8_t *dst = buffer;
+
+        *dst++ = 'H';
+        dst = blackboxEncodeSignedVB(dst, lat);
+        dst = blackboxEncodeSignedVB(dst, lon);
+        append(dst);
+
+        gpsHome[0] = lat;
+        gpsHome[1] = lon;
+        frames.push_back({ 'H', { lat, lon } });
+    }
+
+    // writeGPSFrame()
+    void writeGPSFrame(uint32_t time, uint32_t numSat, int32_t lat, int32_t lon, uint32_t speed)
+    {
+        uint8_t *dst = buffer;
+
+        *dst++ = 'G';
+        dst = blackboxEncodeUnsignedVB(dst, time - lastMainTime);
+        dst = blackboxEncodeUnsignedVB(dst, numSat);
+        dst = blackboxEncodeSignedVB(dst, lat - gpsHome[0]);
+        dst = blackboxEncodeSignedVB(dst, lon - gpsHome[1]);
+        dst = blackboxEncodeUnsignedVB(dst, speed);
+        append(dst);
+
+        frames.push_back({ 'G', { (int32_t)time, (int32_t)numSat, lat, lon, (int32_t)speed } });
+    }
+
+    // blackboxLogEvent()
+    void writeEvent(FlightLogEvent event, uint32_t value)
+    {
+        uint8_t *dst = buffer;
+
+        *dst++ = 'E';
+        *dst++ = event;
+        dst = blackboxEncodeUnsignedVB(dst, value);
+        append(dst);
+
+        events.push_back({ event, value, "" });
+    }
+
+    void writeInflightAdjustment(uint8_t adjustmentFunction, float value)
+    {
+        uint8_t *dst = buffer;
+        uint32_t bits;
+
+        memcpy(&bits, &value, sizeof(bits));
+        *dst++ = 'E';
+        *dst++ = FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT;
+        *dst++ = adjustmentFunction | FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT_FUNCTION_FLOAT_VALUE_FLAG;
+        for (int i = 0; i < 4; i++) {
+            *dst++ = bits >> (i * 8);
+        }
+        append(dst);
+
+        events.push_back({ FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT, bits, "" });
+    }
+
+    void writeLogEnd(const char *message)
+    {
+        data.push_back('E');
+        data.push_back(FLIGHT_LOG_EVENT_LOG_END);
+        data.insert(data.end(), message, message + strlen(message) + 1);
+
+        events.push_back({ FLIGHT_LOG_EVENT_LOG_END, 0, message });
+    }
+};
+
+// Collects what the decoder reports
+struct LogReader {
+    std::vector<frame_t> frames;
+    std::vector<event_t> events;
+    std::vector<std::string> headers;
+    int logs = 0;
+
+    static void onHeader(void *context, const char *name, const char *value)
+    {
+        static_cast<LogReader *>(context)->headers.push_back(std::string(name) + ":" + value);
+    }
+
+    static void onLogBegin(void *context, const blackboxDecoder_t *decoder)
+    {
+        EXPECT_EQ(FIELD_COUNT(mainFields), decoder->fields[BLACKBOX_DECODER_FIELDS_MAIN].count);
+        EXPECT_STREQ("motor[3]", decoder->fields[BLACKBOX_DECODER_FIELDS_MAIN].name[FIELD_COUNT(mainFields) - 1]);
+        static_cast<LogReader *>(context)->logs++;
+    }
+
+    static void onFrame(void *context, char frameType, const int32_t *values, int valueCount)
+    {
+        static_cast<LogReader *>(context)->frames.push_back({ frameType, std::vector<int32_t>(values, values + valueCount) });
+    }
+
+    static void onEvent(void *context, const blackboxDecoderEvent_t *event)
+    {
+        event_t decoded = { event->event, 0, event->message ? event->message : "" };
+
+        switch (event->event) {
+        case FLIGHT_LOG_EVENT_SYNC_BEEP:
+            decoded.value = event->data.syncBeep.time;
+            break;
+        case FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT:
+            EXPECT_TRUE(event->data.inflightAdjustment.floatFlag);
+            EXPECT_EQ(3, event->data.inflightAdjustment.adjustmentFunction);
+            memcpy(&decoded.value, &event->data.inflightAdjustment.newFloatValue, sizeof(decoded.value));
+            break;
+        default:
+            break;
+        }
+        static_cast<LogReader *>(context)->events.push_back(decoded);
+    }
+};
+
+static const blackboxDecoderCallbacks_t readerCallbacks = {
+    .header = LogReader::onHeader,
+    .logBegin = LogReader::onLogBegin,
+    .frame = LogReader::onFrame,
+    .event = LogReader::onEvent,
+};
+
+static blackboxDecoder_t decoder;
+
+static void decode(LogReader *reader, const bytes_t &log, size_t chunkSize = SIZE_MAX)
+{
+    blackboxDecoderInit(&decoder, &readerCallbacks, reader);
+
+    for (size_t pos = 0; pos < log.size(); pos += chunkSize) {
+        blackboxDecoderFeed(&decoder, log.data() + pos, std::min(chunkSize, log.size() - pos));
+    }
+    blackboxDecoderFinish(&decoder);
+}
+
+TEST(BlackboxDecoderTest, DecodesEncodedLog)
+{
+    LogWriter writer;
+    writer.writeFlight(3000);
+
+    LogReader reader;
+    decode(&reader, writer.log());
+
+    EXPECT_EQ(1, reader.logs);
+    EXPECT_EQ(writer.frames, reader.frames);
+    EXPECT_EQ(writer.events, reader.events);
+    EXPECT_EQ("Product:Blackbox flight data recorder by Nicholas Sherlock", reader.headers[0]);
+
+    EXPECT_EQ(0u, decoder.stats.corruptBytes);
+    EXPECT_EQ(0u, decoder.stats.droppedFrames);
+    EXPECT_EQ(3000u / I_INTERVAL + 1, decoder.stats.frameCount[0]);
+    EXPECT_EQ(writer.headers.size(), decoder.stats.headerBytes);
+}
+
+TEST(BlackboxDecoderTest, StreamsInChunksOfAnySize)
+{
+    LogWriter writer;
+    writer.writeFlight(500);
+    const bytes_t log = writer.log();
+
+    for (size_t chunkSize : { 1, 2, 3, 7, 64, 1000, 4096, 5000 }) {
+        LogReader reader;
+        decode(&reader, log, chunkSize);
+
+        EXPECT_EQ(writer.frames, reader.frames) << "chunk size " << chunkSize;
+        EXPECT_EQ(writer.events, reader.events) << "chunk size " << chunkSize;
+        EXPECT_EQ(0u, decoder.stats.corruptBytes) << "chunk size " << chunkSize;
+    }
+}
+
+TEST(BlackboxDecoderTest, DecodesCompressedLog)
+{
+    LogWriter writer(true);
+    writer.writeFlight(3000);
+    const bytes_t log = writer.log(true);
+
+    for (size_t chunkSize : { (size_t)13, (size_t)1024, SIZE_MAX }) {
+        LogReader reader;
+        decode(&reader, log, chunkSize);
+
+        EXPECT_EQ(writer.frames, reader.frames);
+        EXPECT_EQ(writer.events, reader.events);
+        EXPECT_EQ(0u, decoder.stats.corruptBytes);
+        EXPECT_LT(0u, decoder.stats.compressedBlocks);
+    }
+}
+
+TEST(BlackboxDecoderTest, ResynchronisesAfterCorruption)
+{
+    LogWriter writer;
+    writer.writeFlight(3000);
+    bytes_t log = writer.log();
+
+    // Overwrite part of the frames and insert garbage further on
+    const size_t damaged = writer.headers.size() + writer.data.size() / 3;
+    for (int i = 0; i < 40; i++) {
+        log[damaged + i] = 0x55;
+    }
+    const bytes_t garbage = { 0xFF, 0x00, 'Q', 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 };
+    log.insert(log.begin() + writer.headers.size() + writer.data.size() * 2 / 3, garbage.begin(), garbage.end());
+
+    LogReader reader;
+    decode(&reader, log);
+
+    EXPECT_LT(0u, decoder.stats.corruptBytes);
+    EXPECT_EQ(writer.events.back(), reader.events.back());
+
+    // Only frames near the damage are lost, and every frame that is decoded is correct
+    EXPECT_GT(reader.frames.size(), writer.frames.size() * 9 / 10);
+    size_t expected = 0;
+    for (const frame_t &frame : reader.frames) {
+        while (expected < writer.frames.size() && !(writer.frames[expected] == frame)) {
+            expected++;
+        }
+        ASSERT_LT(expected, writer.frames.size()) << "unexpected " << frame.type << " frame";
+    }
+}
+
+TEST(BlackboxDecoderTest, DecodesEveryLogOfAFile)
+{
+    LogWriter first;
+    first.writeFlight(300);
+    LogWriter second(true);
+    second.writeFlight(600);
+
+    // Erased flash before the first log and a log that was cut off by a power loss
+    bytes_t file(100, 0xFF);
+    const bytes_t firstLog = first.log();
+    const bytes_t secondLog = second.log(true);
+    file.insert(file.end(), firstLog.begin(), firstLog.end() - 500);
+    file.insert(file.end(), firstLog.begin(), firstLog.end());
+    file.insert(file.end(), secondLog.begin(), secondLog.end());
+
+    LogReader reader;
+    decode(&reader, file, 777);
+
+    EXPECT_EQ(3, reader.logs);
+    EXPECT_EQ(3u, decoder.stats.logCount);
+    EXPECT_EQ(2, std::count(reader.events.begin(), reader.events.end(), first.events.back()));
+}
+
+// Large feeds without callbacks, the way a bulk decode runs, count every main frame of plain and compressed logs
+TEST(BlackboxDecoderTest, CountsFramesWithoutCallbacks)
+{
+    LogWriter writer;
+    writer.writeFlight(5000);
+    const bytes_t log = writer.log();
+    LogWriter compressedWriter(true);
+    compressedWriter.writeFlight(5000);
+    const bytes_t compressedLog = compressedWriter.log(true);
+
+    const uint32_t mainFrames = std::count_if(writer.frames.begin(), writer.frames.end(),
+        [](const frame_t &frame) { return frame.type == 'I' || frame.type == 'P'; });
+
+    static const blackboxDecoderCallbacks_t noCallbacks = {};
+    for (const bytes_t *input : { &log, &compressedLog }) {
+        blackboxDecoderInit(&decoder, &noCallbacks, NULL);
+        for (size_t pos = 0; pos < input->size(); pos += 65536) {
+            blackboxDecoderFeed(&decoder, input->data() + pos, std::min((size_t)65536, input->size() - pos));
+        }
+        blackboxDecoderFinish(&decoder);
+
+        EXPECT_EQ(mainFrames, decoder.stats.frameCount[0] + decoder.stats.frameCount[1]);
+        EXPECT_EQ(0u, decoder.stats.corruptBytes);
+    }
+}
+
+// STUBS
+
+extern "C" {
+    int32_t blackboxHeaderBudget;
+
+    void blackboxWrite(uint8_t value)
+    {
+        UNUSED(value);
+    }
+
+    void blackboxWriteBuf(const uint8_t *data, int length)
+    {
+        UNUSED(data);
+        UNUSED(length);
+    }
+
+    int blackboxPrint(const char *s)
+    {
+        UNUSED(s);
+        return 0;
+    }
+
+    int tfp_format(void *putp, void (*putf) (void *, char), const char *fmt, va_list va)
+    {
+        UNUSED(putp);
+        UNUSED(putf);
+        UNUSED(fmt);
+        UNUSED(va);
+        return 0;
+    }
+}
@@ -0,0 +1,426 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "blackbox/blackbox_encoding.h"
+    #include "blackbox/blackbox_io.h"
+
+    #include "common/encoding.h"
+    #include "common/utils.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+// Everything the encoders hand to the device
+static std::vector<uint8_t> deviceOutput;
+static int deviceWrites;
+
+// Reference decoder, following the one in blackbox-tools
+typedef struct {
+    const uint8_t *pos;
+    const uint8_t *end;
+} frameReader_t;
+
+static uint8_t readByte(frameReader_t *reader)
+{
+    EXPECT_LT(reader->pos, reader->end);
+    return reader->pos < reader->end ? *reader->pos++ : 0;
+}
+
+static int32_t signExtend(uint32_t value, int bits)
+{
+    return (int32_t)(value << (32 - bits)) >> (32 - bits);
+}
+
+static uint32_t readUnsignedVB(frameReader_t *reader)
+{
+    uint32_t result = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        const uint8_t c = readByte(reader);
+        result |= (uint32_t)(c & 0x7F) << shift;
+        if (c < 128) {
+            break;
+        }
+    }
+    return result;
+}
+
+static int32_t readSignedVB(frameReader_t *reader)
+{
+    const uint32_t i = readUnsignedVB(reader);
+    // Apply ZigZag decoding to recover the signed value
+    return (i >> 1) ^ -(int32_t)(i & 1);
+}
+
+static void readTag2_3S32(frameReader_t *reader, int32_t *values)
+{
+    uint8_t leadByte = readByte(reader);
+    uint8_t byte1, byte2;
+
+    switch (leadByte >> 6) {
+    case 0:
+        values[0] = signExtend((leadByte >> 4) & 0x03, 2);
+        values[1] = signExtend((leadByte >> 2) & 0x03, 2);
+        values[2] = signExtend(leadByte & 0x03, 2);
+        break;
+    case 1:
+        values[0] = signExtend(leadByte & 0x0F, 4);
+        byte1 = readByte(reader);
+        values[1] = signExtend(byte1 >> 4, 4);
+        values[2] = signExtend(byte1 & 0x0F, 4);
+        break;
+    case 2:
+        values[0] = signExtend(leadByte & 0x3F, 6);
+        byte1 = readByte(reader);
+        values[1] = signExtend(byte1 & 0x3F, 6);
+        byte2 = readByte(reader);
+        values[2] = signExtend(byte2 & 0x3F, 6);
+        break;
+    case 3:
+        for (int i = 0; i < 3; i++, leadByte >>= 2) {
+            const int bytes = (leadByte & 0x03) + 1;
+            uint32_t value = 0;
+            for (int b = 0; b < bytes; b++) {
+                value |= (uint32_t)readByte(reader) << (b * 8);
+            }
+            values[i] = signExtend(value, bytes * 8);
+        }
+        break;
+    }
+}
+
+static void readTag8_4S16(frameReader_t *reader, int32_t *values)
+{
+    uint8_t selector = readByte(reader);
+    uint8_t buffer = 0;
+    bool nibble = false;
+
+    for (int i = 0; i < 4; i++, selector >>= 2) {
+        uint8_t c1, c2;
+
+        switch (selector & 0x03) {
+        case 0:
+            values[i] = 0;
+            break;
+        case 1:
+            if (!nibble) {
+                buffer = readByte(reader);
+                values[i] = signExtend(buffer >> 4, 4);
+            } else {
+                values[i] = signExtend(buffer & 0x0F, 4);
+            }
+            nibble = !nibble;
+            break;
+        case 2:
+            if (!nibble) {
+                values[i] = signExtend(readByte(reader), 8);
+            } else {
+                c1 = buffer << 4;
+                buffer = readByte(reader);
+                values[i] = signExtend((uint8_t)(c1 | (buffer >> 4)), 8);
+            }
+            break;
+        case 3:
+            c1 = readByte(reader);
+            c2 = readByte(reader);
+            if (!nibble) {
+                values[i] = signExtend((c1 << 8) | c2, 16);
+            } else {
+                values[i] = signExtend(((buffer & 0x0F) << 12) | (c1 << 4) | (c2 >> 4), 16);
+                buffer = c2;
+            }
+            break;
+        }
+    }
+}
+
+static void readTag8_8SVB(frameReader_t *reader, int32_t *values, int valueCount)
+{
+    if (valueCount == 1) {
+        values[0] = readSignedVB(reader);
+        return;
+    }
+
+    uint8_t header = readByte(reader);
+    for (int i = 0; i < valueCount; i++, header >>= 1) {
+        values[i] = (header & 0x01) ? readSignedVB(reader) : 0;
+    }
+}
+
+// Random frames made of a mix of field groups, with values of random bit width
+typedef enum {
+    GROUP_UNSIGNED_VB,
+    GROUP_SIGNED_VB,
+    GROUP_TAG2_3S32,
+    GROUP_TAG8_4S16,
+    GROUP_TAG8_8SVB,
+    GROUP_COUNT
+} fieldGroup_e;
+
+typedef struct {
+    fieldGroup_e group;
+    int count;
+    int32_t values[8];
+} fieldGroup_t;
+
+#define FRAME_MAX_GROUPS    40
+
+typedef struct {
+    int groupCount;
+    fieldGroup_t groups[FRAME_MAX_GROUPS];
+} testFrame_t;
+
+static int32_t randomValue(int maxBits)
+{
+    // Mostly small deltas, like a real log
+    int bits = rand() % 100 < 80 ? rand() % 8 : rand() % maxBits;
+    int32_t value = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand()) >> (31 - bits);
+    return value;
+}
+
+static void randomFrame(testFrame_t *frame)
+{
+    frame->groupCount = 1 + rand() % FRAME_MAX_GROUPS;
+    for (int g = 0; g < frame->groupCount; g++) {
+        fieldGroup_t *group = &frame->groups[g];
+        group->group = (fieldGroup_e)(rand() % GROUP_COUNT);
+        switch (group->group) {
+        case GROUP_UNSIGNED_VB:
+        case GROUP_SIGNED_VB:
+            group->count = 1;
+            group->values[0] = randomValue(32);
+            break;
+        case GROUP_TAG2_3S32:
+            group->count = 3;
+            for (int i = 0; i < 3; i++) {
+                group->values[i] = randomValue(32);
+            }
+            break;
+        case GROUP_TAG8_4S16:
+            group->count = 4;
+            for (int i = 0; i < 4; i++) {
+                group->values[i] = randomValue(16);
+            }
+            break;
+        case GROUP_TAG8_8SVB:
+            group->count = 1 + rand() % 8;
+            for (int i = 0; i < group->count; i++) {
+                group->values[i] = rand() % 2 ? 0 : randomValue(32);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static void writeFrame(const testFrame_t *frame)
+{
+    blackboxBeginFrame('P');
+    for (int g = 0; g < frame->groupCount; g++) {
+        const fieldGroup_t *group = &frame->groups[g];
+        int32_t values[8];
+        memcpy(values, group->values, sizeof(values));
+
+        switch (group->group) {
+        case GROUP_UNSIGNED_VB:
+            blackboxWriteUnsignedVB(values[0]);
+            break;
+        case GROUP_SIGNED_VB:
+            blackboxWriteSignedVB(values[0]);
+            break;
+        case GROUP_TAG2_3S32:
+            blackboxWriteTag2_3S32(values);
+            break;
+        case GROUP_TAG8_4S16:
+            blackboxWriteTag8_4S16(values);
+            break;
+        case GROUP_TAG8_8SVB:
+            blackboxWriteTag8_8SVB(values, group->count);
+            break;
+        default:
+            break;
+        }
+    }
+    blackboxEndFrame();
+}
+
+static void readAndCheckFrame(frameReader_t *reader, const testFrame_t *frame)
+{
+    ASSERT_EQ('P', readByte(reader));
+    for (int g = 0; g < frame->groupCount; g++) {
+        const fieldGroup_t *group = &frame->groups[g];
+        int32_t values[8];
+
+        switch (group->group) {
+        case GROUP_UNSIGNED_VB:
+            values[0] = readUnsignedVB(reader);
+            break;
+        case GROUP_SIGNED_VB:
+            values[0] = readSignedVB(reader);
+            break;
+        case GROUP_TAG2_3S32:
+            readTag2_3S32(reader, values);
+            break;
+        case GROUP_TAG8_4S16:
+            readTag8_4S16(reader, values);
+            break;
+        case GROUP_TAG8_8SVB:
+            readTag8_8SVB(reader, values, group->count);
+            break;
+        default:
+            break;
+        }
+
+        for (int i = 0; i < group->count; i++) {
+            ASSERT_EQ(group->values[i], values[i]) << "group " << g << " type " << group->group << " field " << i;
+        }
+    }
+}
+
+TEST(BlackboxEncodingTest, EdgeValuesRoundTrip)
+{
+    static const int32_t edges[] = {
+        0, 1, -1, 2, -2, 3, -3, 7, -8, 8, -9, 31, -32, 32, -33, 127, -128, 128, -129,
+        32767, -32768, 32768, -32769, 8388607, -8388608, 8388608, -8388609, INT32_MAX, INT32_MIN,
+    };
+    const int edgeCount = ARRAYLEN(edges);
+
+    uint8_t buf[64];
+    for (int a = 0; a < edgeCount; a++) {
+        for (int b = 0; b < edgeCount; b++) {
+            const int32_t values[4] = { edges[a], edges[b], edges[(a + b) % edgeCount], edges[(a * 3 + b) % edgeCount] };
+            int32_t decoded[8];
+            frameReader_t reader;
+
+            reader = { buf, blackboxEncodeTag2_3S32(buf, values) };
+            readTag2_3S32(&reader, decoded);
+            EXPECT_EQ(reader.end, reader.pos);
+            EXPECT_EQ(0, memcmp(values, decoded, 3 * sizeof(int32_t)));
+
+            reader = { buf, blackboxEncodeTag8_8SVB(buf, values, 4) };
+            readTag8_8SVB(&reader, decoded, 4);
+            EXPECT_EQ(reader.end, reader.pos);
+            EXPECT_EQ(0, memcmp(values, decoded, 4 * sizeof(int32_t)));
+
+            int32_t values16[4];
+            for (int i = 0; i < 4; i++) {
+                values16[i] = (int16_t)values[i];
+            }
+            reader = { buf, blackboxEncodeTag8_4S16(buf, values16) };
+            readTag8_4S16(&reader, decoded);
+            EXPECT_EQ(reader.end, reader.pos);
+            EXPECT_EQ(0, memcmp(values16, decoded, 4 * sizeof(int32_t)));
+        }
+
+        frameReader_t reader = { buf, blackboxEncodeSignedVB(buf, edges[a]) };
+        EXPECT_EQ(edges[a], readSignedVB(&reader));
+        EXPECT_EQ(reader.end, reader.pos);
+
+        reader = { buf, blackboxEncodeUnsignedVB(buf, edges[a]) };
+        EXPECT_EQ((uint32_t)edges[a], readUnsignedVB(&reader));
+        EXPECT_EQ(reader.end, reader.pos);
+    }
+}
+
+TEST(BlackboxEncodingTest, SmallestPacking)
+{
+    uint8_t buf[64];
+    const int32_t twoBits[3] = { 1, -2, 0 };
+    const int32_t fourBits[3] = { 7, -8, 2 };
+    const int32_t sixBits[3] = { 31, -32, 8 };
+    EXPECT_EQ(1, blackboxEncodeTag2_3S32(buf, twoBits) - buf);
+    EXPECT_EQ(2, blackboxEncodeTag2_3S32(buf, fourBits) - buf);
+    EXPECT_EQ(3, blackboxEncodeTag2_3S32(buf, sixBits) - buf);
+
+    const int32_t nibbles[4] = { 0, 1, -8, 7 };
+    EXPECT_EQ(3, blackboxEncodeTag8_4S16(buf, nibbles) - buf);
+
+    const int32_t zeros[8] = { 0 };
+    EXPECT_EQ(1, blackboxEncodeTag8_8SVB(buf, zeros, 8) - buf);
+    EXPECT_EQ(0, blackboxEncodeTag8_8SVB(buf, zeros, 0) - buf);
+}
+
+TEST(BlackboxEncodingTest, RandomFramesRoundTrip)
+{
+    static testFrame_t frames[1000];
+    srand(1);
+
+    deviceOutput.clear();
+    deviceWrites = 0;
+    for (unsigned i = 0; i < ARRAYLEN(frames); i++) {
+        randomFrame(&frames[i]);
+        writeFrame(&frames[i]);
+    }
+
+    // Large frames are split, everything else goes out in one write
+    EXPECT_GE(deviceWrites, (int)ARRAYLEN(frames));
+    EXPECT_LT(deviceWrites, (int)ARRAYLEN(frames) * 2);
+
+    frameReader_t reader = { deviceOutput.data(), deviceOutput.data() + deviceOutput.size() };
+    for (unsigned i = 0; i < ARRAYLEN(frames); i++) {
+        readAndCheckFrame(&reader, &frames[i]);
+        if (HasFatalFailure()) {
+            return;
+        }
+    }
+    EXPECT_EQ(reader.end, reader.pos);
+}
+
+// STUBS
+
+extern "C" {
+    int32_t blackboxHeaderBudget;
+
+    void blackboxWrite(uint8_t value)
+    {
+        deviceOutput.push_back(value);
+        deviceWrites++;
+    }
+
+    void blackboxWriteBuf(const uint8_t *data, int length)
+    {
+        deviceOutput.insert(deviceOutput.end(), data, data + length);
+        deviceWrites++;
+    }
+
+    int blackboxPrint(const char *s)
+    {
+        const int length = strlen(s);
+        blackboxWriteBuf((const uint8_t *)s, length);
+        return length;
+    }
+
+    int tfp_format(void *putp, void (*putf) (void *, char), const char *fmt, va_list va)
+    {
+        UNUSED(putp);
+        UNUSED(putf);
+        UNUSED(fmt);
+        UNUSED(va);
+        return 0;
+    }
+}
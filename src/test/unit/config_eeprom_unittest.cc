@@ -0,0 +1,399 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/crc.h"
+
+    #include "config/config_eeprom.h"
+    #include "config/parameter_group.h"
+
+    #include "drivers/system.h"
+
+    #include "fc/config.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define TEST_FLASH_PAGE_SIZE    0x400   // FLASH_PAGE_SIZE of config_streamer.c for UNIT_TEST
+#define TEST_FLASH_PAGES        4
+
+#define TEST_SYSTEM_PGN         10
+#define TEST_PROFILE_PGN        20
+
+typedef struct {
+    uint8_t values[40];
+} testSystemConfig_t;
+
+typedef struct {
+    uint8_t values[24];
+} testProfileConfig_t;
+
+// Flash emulation: programming can only clear bits of erased words
+static struct {
+    int erases;
+    int words;
+    bool failed;
+} flashStats;
+
+extern "C" {
+    __attribute__((section("config_flash_test"), used, aligned(TEST_FLASH_PAGE_SIZE)))
+    uint8_t testConfigFlash[TEST_FLASH_PAGES * TEST_FLASH_PAGE_SIZE];
+
+    static testSystemConfig_t testSystemConfig;
+    static testSystemConfig_t testSystemConfigCopy;
+    static testProfileConfig_t testProfileConfig[MAX_PROFILE_COUNT];
+    static testProfileConfig_t testProfileConfigCopy[MAX_PROFILE_COUNT];
+    static testProfileConfig_t *testProfileConfigCurrent;
+
+    static void testSystemConfigReset(void *base)
+    {
+        memset(base, 0x11, sizeof(testSystemConfig_t));
+    }
+
+    static void testProfileConfigReset(void *base)
+    {
+        memset(base, 0x22, sizeof(testProfileConfig_t));
+    }
+
+    // Sorted by pgn, like the firmware linker script does
+    __attribute__((section("pg_registry_test"), used))
+    const pgRegistry_t testRegistry[] = {
+        {
+            .pgn = TEST_SYSTEM_PGN | (1 << 12),
+            .size = sizeof(testSystemConfig_t) | PGR_SIZE_SYSTEM_FLAG,
+            .address = (uint8_t *)&testSystemConfig,
+            .copy = (uint8_t *)&testSystemConfigCopy,
+            .ptr = 0,
+            .reset = { .fn = testSystemConfigReset },
+        },
+        {
+            .pgn = TEST_PROFILE_PGN | (2 << 12),
+            .size = sizeof(testProfileConfig_t) | PGR_SIZE_PROFILE_FLAG,
+            .address = (uint8_t *)&testProfileConfig,
+            .copy = (uint8_t *)&testProfileConfigCopy,
+            .ptr = (uint8_t **)&testProfileConfigCurrent,
+            .reset = { .fn = testProfileConfigReset },
+        },
+    };
+
+    // Version 1 of the profile PG stored values[0] in half the units
+    static void testProfileConfigMigrate1(void *base)
+    {
+        testProfileConfig_t *config = (testProfileConfig_t *)base;
+        config->values[0] *= 2;
+    }
+
+    __attribute__((section("pg_migration_test"), used))
+    const pgMigration_t testMigrations[] = {
+        {
+            .pgn = TEST_PROFILE_PGN,
+            .fromVersion = 1,
+            .fn = testProfileConfigMigrate1,
+        },
+    };
+}
+
+static void eraseFlash(void)
+{
+    memset(testConfigFlash, 0xFF, sizeof(testConfigFlash));
+    memset(&flashStats, 0, sizeof(flashStats));
+}
+
+static void saveAndCount(int *erases, int *bytes)
+{
+    memset(&flashStats, 0, sizeof(flashStats));
+    writeConfigToEEPROM();
+    EXPECT_FALSE(flashStats.failed);
+    *erases = flashStats.erases;
+    *bytes = flashStats.words * 4;
+}
+
+TEST(ConfigEepromTest, FirstSaveWritesEverything)
+{
+    eraseFlash();
+    pgResetAll(MAX_PROFILE_COUNT);
+    EXPECT_FALSE(isEEPROMContentValid());
+
+    testSystemConfig.values[3] = 42;
+    testProfileConfig[2].values[5] = 7;
+
+    int erases, bytes;
+    saveAndCount(&erases, &bytes);
+    EXPECT_EQ(TEST_FLASH_PAGES, erases);
+    EXPECT_TRUE(isEEPROMContentValid());
+    EXPECT_EQ(bytes, getEEPROMConfigSize());
+
+    pgResetAll(MAX_PROFILE_COUNT);
+    EXPECT_EQ(0x11, testSystemConfig.values[3]);
+    EXPECT_TRUE(loadEEPROM());
+    EXPECT_EQ(42, testSystemConfig.values[3]);
+    EXPECT_EQ(7, testProfileConfig[2].values[5]);
+    EXPECT_EQ(0x22, testProfileConfig[1].values[5]);
+}
+
+TEST(ConfigEepromTest, SaveAppendsChangedInstancesOnly)
+{
+    eraseFlash();
+    pgResetAll(MAX_PROFILE_COUNT);
+
+    int fullErases, fullBytes, erases, bytes;
+    saveAndCount(&fullErases, &fullBytes);
+
+    // Nothing changed, nothing written
+    saveAndCount(&erases, &bytes);
+    EXPECT_EQ(0, erases);
+    EXPECT_EQ(0, bytes);
+
+    // One profile instance changed: one record plus the commit record
+    testProfileConfig[1].values[0] = 99;
+    saveAndCount(&erases, &bytes);
+    EXPECT_EQ(0, erases);
+    EXPECT_EQ((int)((6 + sizeof(testProfileConfig_t) + 2 + 3) & ~3) + 8, bytes);
+    EXPECT_EQ(TEST_FLASH_PAGES, fullErases);
+    EXPECT_LT(bytes, fullBytes);
+
+    pgResetAll(MAX_PROFILE_COUNT);
+    loadEEPROM();
+    EXPECT_EQ(99, testProfileConfig[1].values[0]);
+    EXPECT_EQ(0x22, testProfileConfig[0].values[0]);
+    EXPECT_EQ(0x11, testSystemConfig.values[0]);
+}
+
+TEST(ConfigEepromTest, CompactsWhenFull)
+{
+    eraseFlash();
+    pgResetAll(MAX_PROFILE_COUNT);
+
+    int erases, fullBytes;
+    saveAndCount(&erases, &fullBytes);
+
+    int bytes;
+    int saves = 0;
+    int totalErases = 0;
+    for (int i = 0; totalErases == 0; i++) {
+        testSystemConfig.values[0] = i;
+        saveAndCount(&erases, &bytes);
+        totalErases += erases;
+        saves++;
+        ASSERT_LT(saves, 1000);
+    }
+    // Every save that fits appends one record and a commit, the one after them compacts
+    const int appendBytes = (int)((6 + sizeof(testSystemConfig_t) + 2 + 3) & ~3) + 8;
+    EXPECT_EQ(((int)sizeof(testConfigFlash) - fullBytes) / appendBytes + 1, saves);
+    EXPECT_GT(saves, 10);
+
+    // The compacted copy holds the latest values
+    const uint8_t latest = testSystemConfig.values[0];
+    pgResetAll(MAX_PROFILE_COUNT);
+    loadEEPROM();
+    EXPECT_EQ(latest, testSystemConfig.values[0]);
+}
+
+TEST(ConfigEepromTest, InterruptedSaveIsIgnored)
+{
+    eraseFlash();
+    pgResetAll(MAX_PROFILE_COUNT);
+
+    int erases, bytes;
+    testSystemConfig.values[1] = 1;
+    saveAndCount(&erases, &bytes);
+    const uint16_t committedSize = getEEPROMConfigSize();
+
+    testSystemConfig.values[1] = 2;
+    saveAndCount(&erases, &bytes);
+
+    // Power lost before the commit record made it to flash
+    memset(testConfigFlash + committedSize + bytes - 8, 0xFF, 8);
+    EXPECT_TRUE(isEEPROMContentValid());
+    EXPECT_EQ(committedSize, getEEPROMConfigSize());
+
+    pgResetAll(MAX_PROFILE_COUNT);
+    loadEEPROM();
+    EXPECT_EQ(1, testSystemConfig.values[1]);
+
+    // The next save of another PG must not commit the dangling record along with its own
+    testProfileConfig[0].values[1] = 3;
+    saveAndCount(&erases, &bytes);
+    EXPECT_EQ(TEST_FLASH_PAGES, erases);
+
+    pgResetAll(MAX_PROFILE_COUNT);
+    loadEEPROM();
+    EXPECT_EQ(3, testProfileConfig[0].values[1]);
+    EXPECT_EQ(1, testSystemConfig.values[1]);
+
+    // With the log compacted, saves append again
+    testProfileConfig[0].values[1] = 4;
+    saveAndCount(&erases, &bytes);
+    EXPECT_EQ(0, erases);
+
+    pgResetAll(MAX_PROFILE_COUNT);
+    loadEEPROM();
+    EXPECT_EQ(4, testProfileConfig[0].values[1]);
+    EXPECT_EQ(1, testSystemConfig.values[1]);
+}
+
+TEST(ConfigEepromTest, TornRecordForcesRewrite)
+{
+    eraseFlash();
+    pgResetAll(MAX_PROFILE_COUNT);
+
+    int erases, bytes;
+    saveAndCount(&erases, &bytes);
+    const uint16_t committedSize = getEEPROMConfigSize();
+
+    // Half programmed record after the log
+    memset(testConfigFlash + committedSize, 0x00, 4);
+
+    testProfileConfig[0].values[2] = 5;
+    saveAndCount(&erases, &bytes);
+    EXPECT_EQ(TEST_FLASH_PAGES, erases);
+
+    pgResetAll(MAX_PROFILE_COUNT);
+    loadEEPROM();
+    EXPECT_EQ(5, testProfileConfig[0].values[2]);
+}
+
+TEST(ConfigEepromTest, OlderVersionIsMigrated)
+{
+    const pgRegistry_t *systemReg = pgFind(TEST_SYSTEM_PGN);
+    const pgRegistry_t *profileReg = pgFind(TEST_PROFILE_PGN);
+    ASSERT_TRUE(systemReg && profileReg);
+
+    uint8_t stored[sizeof(testProfileConfig_t) - 4];
+    memset(stored, 5, sizeof(stored));
+
+    // Stored at version 1, migrated to 2. Fields the old version lacked keep their defaults.
+    pgLoad(profileReg, 1, stored, sizeof(stored), 1);
+    EXPECT_EQ(10, testProfileConfig[1].values[0]);
+    EXPECT_EQ(5, testProfileConfig[1].values[1]);
+    EXPECT_EQ(0x22, testProfileConfig[1].values[sizeof(testProfileConfig_t) - 1]);
+
+    // Current version is taken as is
+    pgLoad(profileReg, 1, stored, sizeof(stored), 2);
+    EXPECT_EQ(5, testProfileConfig[1].values[0]);
+
+    // No migration from version 0, and no downgrades
+    pgLoad(profileReg, 1, stored, sizeof(stored), 0);
+    EXPECT_EQ(0x22, testProfileConfig[1].values[0]);
+    pgLoad(profileReg, 1, stored, sizeof(stored), 3);
+    EXPECT_EQ(0x22, testProfileConfig[1].values[0]);
+
+    // No migrations registered at all
+    pgLoad(systemReg, 0, stored, sizeof(stored), 0);
+    EXPECT_EQ(0x11, testSystemConfig.values[0]);
+}
+
+// Appends a record of the flat layout that came before the record log: header, data, no CRC or padding
+static uint8_t *writeLegacyRecord(uint8_t *p, uint16_t pgn, uint8_t version, uint8_t flags, uint8_t value, uint16_t dataSize)
+{
+    const uint16_t size = 6 + dataSize;
+    memcpy(p, &size, sizeof(size));
+    memcpy(p + 2, &pgn, sizeof(pgn));
+    p[4] = version;
+    p[5] = flags;
+    memset(p + 6, value, dataSize);
+    return p + size;
+}
+
+TEST(ConfigEepromTest, LegacyFlatConfigIsMigrated)
+{
+    eraseFlash();
+
+    uint8_t *p = testConfigFlash;
+    *p++ = EEPROM_CONF_VERSION;
+    p = writeLegacyRecord(p, TEST_SYSTEM_PGN, 1, 0, 0x33, sizeof(testSystemConfig_t));
+    // Profile 2, saved at version 1 of the PG
+    p = writeLegacyRecord(p, TEST_PROFILE_PGN, 1, 2, 0x05, sizeof(testProfileConfig_t));
+    *p++ = 0;
+    *p++ = 0;
+    uint16_t crc = 0;
+    for (const uint8_t *q = testConfigFlash; q < p; q++) {
+        crc = crc16_ccitt(crc, *q);
+    }
+    memcpy(p, &crc, sizeof(crc));
+
+    EXPECT_TRUE(isEEPROMContentValid());
+    EXPECT_TRUE(isEEPROMContentLegacy());
+
+    loadEEPROM();
+    EXPECT_EQ(0x33, testSystemConfig.values[0]);
+    EXPECT_EQ(0x22, testProfileConfig[0].values[0]);
+    EXPECT_EQ(10, testProfileConfig[1].values[0]);
+    EXPECT_EQ(5, testProfileConfig[1].values[1]);
+
+    // The next save rewrites it as a record log, which loads the same
+    memset(&flashStats, 0, sizeof(flashStats));
+    writeConfigToEEPROM();
+    EXPECT_FALSE(flashStats.failed);
+    EXPECT_TRUE(isEEPROMContentValid());
+    EXPECT_FALSE(isEEPROMContentLegacy());
+
+    memset(&testSystemConfig, 0, sizeof(testSystemConfig));
+    memset(testProfileConfig, 0, sizeof(testProfileConfig));
+    loadEEPROM();
+    EXPECT_EQ(0x33, testSystemConfig.values[0]);
+    EXPECT_EQ(10, testProfileConfig[1].values[0]);
+    EXPECT_EQ(5, testProfileConfig[1].values[1]);
+
+    // A corrupted flat copy is neither
+    eraseFlash();
+    memset(testConfigFlash, 0, 16);
+    testConfigFlash[0] = EEPROM_CONF_VERSION;
+    testConfigFlash[1] = 8;
+    EXPECT_FALSE(isEEPROMContentValid());
+    EXPECT_FALSE(isEEPROMContentLegacy());
+}
+
+// STUBS
+
+extern "C" {
+    void FLASH_Unlock(void) {}
+    void FLASH_Lock(void) {}
+
+    FLASH_Status FLASH_ErasePage(uintptr_t Page_Address)
+    {
+        uint8_t *page = (uint8_t *)Page_Address;
+        EXPECT_TRUE(page >= testConfigFlash && page < testConfigFlash + sizeof(testConfigFlash));
+        memset(page, 0xFF, TEST_FLASH_PAGE_SIZE);
+        flashStats.erases++;
+        return FLASH_COMPLETE;
+    }
+
+    FLASH_Status FLASH_ProgramWord(uintptr_t Address, uint32_t Data)
+    {
+        uint32_t *word = (uint32_t *)Address;
+        if ((uint8_t *)word < testConfigFlash || (uint8_t *)word >= testConfigFlash + sizeof(testConfigFlash) || *word != 0xFFFFFFFF) {
+            flashStats.failed = true;
+            return FLASH_ERROR_PG;
+        }
+        *word = Data;
+        flashStats.words++;
+        return FLASH_COMPLETE;
+    }
+
+    void failureMode(failureMode_e mode)
+    {
+        UNUSED(mode);
+        flashStats.failed = true;
+    }
+}
@@ -0,0 +1,580 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "drivers/flash_m25p16.h"
+
+    #include "io/flashfs.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define FLASH_SECTOR_SIZE   4096
+#define FLASH_SECTORS       16
+#define FLASH_SIZE          (FLASH_SECTOR_SIZE * FLASH_SECTORS)
+
+typedef std::vector<uint8_t> bytes_t;
+
+typedef struct flashProgram_s {
+    uint32_t address;
+    int length;
+} flashProgram_t;
+
+/*
+ * Fake flash chip in RAM. An asynchronous program only copies its data once the chip reports ready again, like a DMA
+ * transfer would, so data that flashfs overwrites before then is caught.
+ */
+static uint8_t flashMemory[FLASH_SIZE];
+static std::vector<flashProgram_t> programs;
+static std::vector<uint32_t> erases;
+static const uint8_t *pendingData;
+static int busyPolls;
+static int programBusyPolls;
+
+static void completeProgram(void)
+{
+    if (pendingData) {
+        const flashProgram_t &program = programs.back();
+        for (int i = 0; i < program.length; i++) {
+            flashMemory[program.address + i] &= pendingData[i];
+        }
+        pendingData = NULL;
+    }
+    busyPolls = 0;
+}
+
+// Pseudo random numbers that are the same on every host
+static uint32_t randomState;
+
+static uint8_t randomByte(void)
+{
+    randomState = randomState * 1664525 + 1013904223;
+    return randomState >> 24;
+}
+
+static bytes_t randomBytes(int length)
+{
+    bytes_t data;
+    for (int i = 0; i < length; i++) {
+        data.push_back(randomByte());
+    }
+    return data;
+}
+
+static bytes_t flashContents(uint32_t address, int length)
+{
+    return bytes_t(flashMemory + address, flashMemory + address + length);
+}
+
+class FlashfsTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        completeProgram();
+        programBusyPolls = 0;
+        randomState = 1;
+
+        flashfsEraseCompletely();
+        programs.clear();
+        erases.clear();
+    }
+};
+
+TEST_F(FlashfsTest, StreamedWritesProgramWholePages)
+{
+    const bytes_t data = randomBytes(3000);
+
+    for (size_t pos = 0; pos < data.size(); pos += 37) {
+        flashfsWrite(data.data() + pos, std::min((size_t)37, data.size() - pos), false);
+    }
+    EXPECT_EQ(data.size(), flashfsGetOffset());
+
+    // Every page completed so far has been programmed in one go
+    ASSERT_EQ(data.size() / FLASHFS_WRITE_PAGE_SIZE, programs.size());
+    for (size_t i = 0; i < programs.size(); i++) {
+        EXPECT_EQ(i * FLASHFS_WRITE_PAGE_SIZE, programs[i].address);
+        EXPECT_EQ(FLASHFS_WRITE_PAGE_SIZE, programs[i].length);
+    }
+
+    while (!flashfsFlushAsync(true)) {
+    }
+    flashfsFlushSync();
+
+    EXPECT_EQ((int)(data.size() % FLASHFS_WRITE_PAGE_SIZE), programs.back().length);
+    EXPECT_EQ(data, flashContents(0, data.size()));
+}
+
+TEST_F(FlashfsTest, PartialPageIsOnlyProgrammedWhenForced)
+{
+    const bytes_t data = randomBytes(200);
+
+    flashfsWrite(data.data(), 100, false);
+    EXPECT_FALSE(flashfsFlushAsync(false));
+    EXPECT_TRUE(programs.empty());
+
+    EXPECT_TRUE(flashfsFlushAsync(true));
+    ASSERT_EQ(1u, programs.size());
+    EXPECT_EQ(100, programs[0].length);
+
+    // The rest of the page is programmed after the part already written
+    flashfsWrite(data.data() + 100, 100, false);
+    EXPECT_EQ(1u, programs.size());
+    flashfsFlushSync();
+
+    ASSERT_EQ(2u, programs.size());
+    EXPECT_EQ(100u, programs[1].address);
+    EXPECT_EQ(100, programs[1].length);
+    EXPECT_EQ(data, flashContents(0, data.size()));
+}
+
+TEST_F(FlashfsTest, SyncWritesWrapTheBufferWhileFlashIsBusy)
+{
+    const bytes_t data = randomBytes(10000);
+    programBusyPolls = 3;
+
+    for (size_t pos = 0, length = 1; pos < data.size(); pos += length, length = length * 7 % 1001) {
+        length = std::min(length, data.size() - pos);
+        flashfsWrite(data.data() + pos, length, true);
+    }
+    flashfsFlushSync();
+
+    for (size_t i = 0; i + 1 < programs.size(); i++) {
+        EXPECT_EQ(FLASHFS_WRITE_PAGE_SIZE, programs[i].length);
+    }
+    EXPECT_EQ(data.size(), flashfsGetOffset());
+    EXPECT_EQ(data, flashContents(0, data.size()));
+}
+
+TEST_F(FlashfsTest, AsyncWritesAreDroppedWhenBufferIsFull)
+{
+    const bytes_t data = randomBytes(FLASHFS_WRITE_BUFFER_SIZE + 2);
+    programBusyPolls = 1000;
+
+    // The first page goes to the flash, which then stays busy while the rest of the buffer fills
+    flashfsWrite(data.data(), FLASHFS_WRITE_BUFFER_SIZE, false);
+    EXPECT_EQ(1u, programs.size());
+    EXPECT_EQ(0u, flashfsGetWriteBufferFreeSpace());
+
+    flashfsWrite(data.data() + FLASHFS_WRITE_BUFFER_SIZE, 1, false);
+    flashfsWriteByte(data[FLASHFS_WRITE_BUFFER_SIZE]);
+    EXPECT_EQ((uint32_t)FLASHFS_WRITE_BUFFER_SIZE, flashfsGetOffset());
+
+    // Once the flash is ready the page that was sent frees up
+    completeProgram();
+    flashfsWriteByte(data[FLASHFS_WRITE_BUFFER_SIZE]);
+    flashfsWriteByte(data[FLASHFS_WRITE_BUFFER_SIZE + 1]);
+    EXPECT_EQ(data.size(), flashfsGetOffset());
+
+    flashfsFlushSync();
+    EXPECT_EQ(data, flashContents(0, data.size()));
+}
+
+TEST_F(FlashfsTest, InitAndSeek)
+{
+    memset(flashMemory, 0, 5000);
+
+    flashfsInit();
+    EXPECT_EQ(6144u, flashfsGetOffset());
+
+    const bytes_t data = randomBytes(10);
+    flashfsWrite(data.data(), data.size(), false);
+    EXPECT_EQ(6154u, flashfsGetOffset());
+
+    // Seeking writes out the buffer first
+    flashfsSeekAbs(0x100);
+    EXPECT_EQ(0x100u, flashfsGetOffset());
+    EXPECT_EQ(data, flashContents(6144, data.size()));
+
+    flashfsSeekRel(0x20);
+    EXPECT_EQ(0x120u, flashfsGetOffset());
+}
+
+TEST_F(FlashfsTest, WritesPastTheEndAreDiscarded)
+{
+    // The last sector is kept for the log directory
+    ASSERT_EQ((uint32_t)(FLASH_SIZE - FLASH_SECTOR_SIZE), flashfsGetSize());
+    flashfsSeekAbs(flashfsGetSize() - FLASHFS_WRITE_PAGE_SIZE);
+
+    const bytes_t data = randomBytes(FLASHFS_WRITE_PAGE_SIZE * 2);
+    flashfsWrite(data.data(), data.size(), true);
+    flashfsFlushSync();
+
+    EXPECT_TRUE(flashfsIsEOF());
+    ASSERT_EQ(1u, programs.size());
+    EXPECT_EQ(bytes_t(data.begin(), data.begin() + FLASHFS_WRITE_PAGE_SIZE), flashContents(flashfsGetSize() - FLASHFS_WRITE_PAGE_SIZE, FLASHFS_WRITE_PAGE_SIZE));
+}
+
+TEST_F(FlashfsTest, EraseUsedErasesOnlyTheUsedSectors)
+{
+    const bytes_t data = randomBytes(3 * FLASH_SECTOR_SIZE + 100);
+    flashfsWrite(data.data(), data.size(), true);
+    flashfsFlushSync();
+
+    flashfsEraseUsed();
+    EXPECT_EQ(0u, flashfsGetOffset());
+
+    while (!flashfsIsReady()) {
+    }
+
+    EXPECT_EQ(std::vector<uint32_t>({ 0, FLASH_SECTOR_SIZE, 2 * FLASH_SECTOR_SIZE, 3 * FLASH_SECTOR_SIZE }), erases);
+    EXPECT_EQ(bytes_t(FLASH_SIZE, 0xFF), flashContents(0, FLASH_SIZE));
+}
+
+TEST_F(FlashfsTest, WritesCatchingUpWithEraseWaitForIt)
+{
+    const bytes_t oldData = randomBytes(2 * FLASH_SECTOR_SIZE);
+    flashfsWrite(oldData.data(), oldData.size(), true);
+    flashfsFlushSync();
+
+    // Log again straight away, each sector of old data is erased as the log reaches it
+    flashfsEraseUsed();
+    programBusyPolls = 2;
+
+    const bytes_t data = randomBytes(3 * FLASH_SECTOR_SIZE);
+    for (size_t pos = 0; pos < data.size(); pos += 100) {
+        flashfsWrite(data.data() + pos, std::min((size_t)100, data.size() - pos), true);
+    }
+    flashfsFlushSync();
+
+    EXPECT_EQ(std::vector<uint32_t>({ 0, FLASH_SECTOR_SIZE }), erases);
+    EXPECT_EQ(data, flashContents(0, data.size()));
+    EXPECT_TRUE(flashfsIsReady());
+}
+
+TEST_F(FlashfsTest, InitFindsDataLeftAheadOfFreeSpace)
+{
+    // An erase that was interrupted left a sector of data past the start of the free space
+    memset(flashMemory + 5 * FLASH_SECTOR_SIZE, 0x55, FLASH_SECTOR_SIZE);
+
+    flashfsInit();
+    EXPECT_EQ(0u, flashfsGetOffset());
+    EXPECT_FALSE(flashfsIsReady());
+
+    while (!flashfsEraseAsync()) {
+    }
+
+    EXPECT_EQ(std::vector<uint32_t>({ 5 * FLASH_SECTOR_SIZE }), erases);
+    EXPECT_EQ(bytes_t(FLASH_SIZE, 0xFF), flashContents(0, FLASH_SIZE));
+}
+
+static void writeLog(uint32_t timestamp, int length)
+{
+    while (!flashfsBeginLog(timestamp)) {
+    }
+
+    const bytes_t data = randomBytes(length);
+    flashfsWrite(data.data(), data.size(), true);
+
+    while (!flashfsEndLog()) {
+    }
+}
+
+TEST_F(FlashfsTest, LogWaitsForEraseAhead)
+{
+    writeLog(0, 3 * FLASH_SECTOR_SIZE);
+    flashfsEraseUsed();
+
+    // The log only begins once the old data is gone, nothing is erased while it's written
+    int polls = 0;
+    while (!flashfsBeginLog(0)) {
+        polls++;
+    }
+    EXPECT_GT(polls, 0);
+    EXPECT_TRUE(flashfsIsReady());
+
+    const size_t erasesBeforeLog = erases.size();
+    const bytes_t data = randomBytes(2 * FLASH_SECTOR_SIZE);
+    flashfsWrite(data.data(), data.size(), true);
+    while (!flashfsEndLog()) {
+    }
+
+    EXPECT_EQ(erasesBeforeLog, erases.size());
+    EXPECT_EQ(data, flashContents(0, data.size()));
+    EXPECT_EQ(1, flashfsGetLogCount());
+}
+
+TEST_F(FlashfsTest, LogDirectoryListsEachLog)
+{
+    writeLog(1000, 3000);
+    writeLog(2000, 500);
+    EXPECT_EQ(3500u, flashfsGetOffset());
+
+    // After a restart the free space starts right after the last log rather than at the next free block
+    flashfsInit();
+    EXPECT_EQ(3500u, flashfsGetOffset());
+    ASSERT_EQ(2, flashfsGetLogCount());
+
+    flashfsLogEntry_t log;
+    ASSERT_TRUE(flashfsGetLog(0, &log));
+    EXPECT_EQ(0u, log.start);
+    EXPECT_EQ(3000u, log.length);
+    EXPECT_EQ(1000u, log.timestamp);
+    ASSERT_TRUE(flashfsGetLog(1, &log));
+    EXPECT_EQ(3000u, log.start);
+    EXPECT_EQ(500u, log.length);
+    EXPECT_EQ(2000u, log.timestamp);
+    EXPECT_FALSE(flashfsGetLog(2, &log));
+
+    // The log being written reports its length so far
+    ASSERT_TRUE(flashfsBeginLog(3000));
+    const bytes_t data = randomBytes(100);
+    flashfsWrite(data.data(), data.size(), true);
+    ASSERT_TRUE(flashfsGetLog(2, &log));
+    EXPECT_EQ(3500u, log.start);
+    EXPECT_EQ(100u, log.length);
+}
+
+TEST_F(FlashfsTest, LogLeftOpenIsClosedAtStartup)
+{
+    ASSERT_TRUE(flashfsBeginLog(0));
+    const bytes_t data = randomBytes(5000);
+    flashfsWrite(data.data(), data.size(), true);
+    flashfsFlushSync();
+
+    // Lose power, the end of the log is found by searching for the free space
+    flashfsInit();
+    EXPECT_EQ(6144u, flashfsGetOffset());
+
+    flashfsLogEntry_t log;
+    ASSERT_TRUE(flashfsGetLog(0, &log));
+    EXPECT_EQ(6144u, log.length);
+    flashfsInit();
+    EXPECT_EQ(6144u, flashfsGetOffset());
+}
+
+TEST_F(FlashfsTest, LogsPastAFullDirectoryAreKept)
+{
+    // Each sector of directory has room for 256 logs
+    for (int i = 0; i < 256; i++) {
+        writeLog(i, 10);
+    }
+    EXPECT_EQ(256, flashfsGetLogCount());
+
+    // The next log is written without being listed
+    writeLog(256, 5000);
+    EXPECT_EQ(256, flashfsGetLogCount());
+    flashfsFlushSync();
+    const bytes_t contents = flashContents(0, FLASH_SIZE);
+
+    // After a restart the free space starts past it, and nothing is left to erase
+    flashfsInit();
+    EXPECT_EQ(8192u, flashfsGetOffset());
+    EXPECT_TRUE(flashfsIsReady());
+    EXPECT_EQ(contents, flashContents(0, FLASH_SIZE));
+}
+
+TEST_F(FlashfsTest, DirectorySectorHoldingOtherDataIsLeftAlone)
+{
+    // A log written before there was a directory filled the flash
+    memset(flashMemory, 0x55, FLASH_SIZE);
+
+    flashfsInit();
+    EXPECT_TRUE(flashfsIsEOF());
+    EXPECT_TRUE(flashfsBeginLog(0));
+    EXPECT_EQ(0, flashfsGetLogCount());
+    EXPECT_EQ(bytes_t(FLASH_SECTOR_SIZE, 0x55), flashContents(flashfsGetSize(), FLASH_SECTOR_SIZE));
+
+    // Erasing makes room for the directory
+    flashfsEraseUsed();
+    writeLog(0, 100);
+    EXPECT_EQ(1, flashfsGetLogCount());
+    while (!flashfsIsReady()) {
+    }
+    EXPECT_EQ((size_t)FLASH_SECTORS, erases.size());
+}
+
+TEST_F(FlashfsTest, EraseUsedClearsTheDirectory)
+{
+    writeLog(0, 100);
+    writeLog(0, 100);
+
+    flashfsEraseUsed();
+    EXPECT_EQ(0, flashfsGetLogCount());
+    while (!flashfsIsReady()) {
+    }
+
+    flashfsInit();
+    EXPECT_EQ(0, flashfsGetLogCount());
+    EXPECT_EQ(0u, flashfsGetOffset());
+    EXPECT_EQ(bytes_t(FLASH_SIZE, 0xFF), flashContents(0, FLASH_SIZE));
+}
+
+// Undo flashfsPackErasedRuns() like a configurator would
+static bytes_t unpackErasedRuns(const bytes_t &packed, unsigned int runCount)
+{
+    const size_t tableOffset = packed.size() - runCount * 4;
+    bytes_t data;
+    size_t source = 0;
+
+    for (unsigned int run = 0; run < runCount; run++) {
+        const uint8_t *entry = &packed[tableOffset + run * 4];
+        const size_t offset = entry[0] | (entry[1] << 8);
+        const size_t length = entry[2] | (entry[3] << 8);
+        const size_t literal = offset - data.size();
+
+        data.insert(data.end(), packed.begin() + source, packed.begin() + source + literal);
+        data.insert(data.end(), length, 0xFF);
+        source += literal;
+    }
+    data.insert(data.end(), packed.begin() + source, packed.begin() + tableOffset);
+
+    return data;
+}
+
+static unsigned int packErasedRuns(bytes_t &data)
+{
+    unsigned int runCount;
+    const bytes_t original = data;
+
+    data.resize(flashfsPackErasedRuns(data.data(), data.size(), &runCount));
+    EXPECT_LE(data.size(), original.size());
+    EXPECT_EQ(original, unpackErasedRuns(data, runCount));
+
+    return runCount;
+}
+
+TEST(FlashfsPackTest, ErasedRunsAreRemoved)
+{
+    bytes_t data(100, 0x55);
+    data.insert(data.end(), 1000, 0xFF);
+    data.push_back(0x00);
+    // Too short to be worth a table entry
+    data.insert(data.end(), FLASHFS_ERASED_RUN_MIN_LENGTH - 1, 0xFF);
+    data.push_back(0x00);
+    data.insert(data.end(), FLASHFS_ERASED_RUN_MIN_LENGTH, 0xFF);
+
+    EXPECT_EQ(2u, packErasedRuns(data));
+    EXPECT_EQ(100u + 1 + FLASHFS_ERASED_RUN_MIN_LENGTH - 1 + 1 + 2 * 4, data.size());
+}
+
+TEST(FlashfsPackTest, ErasedChunkPacksToOneRun)
+{
+    bytes_t data(4096, 0xFF);
+
+    EXPECT_EQ(1u, packErasedRuns(data));
+    EXPECT_EQ(4u, data.size());
+}
+
+TEST(FlashfsPackTest, DataWithoutRunsIsUnchanged)
+{
+    bytes_t data = randomBytes(1000);
+    const bytes_t original = data;
+
+    EXPECT_EQ(0u, packErasedRuns(data));
+    EXPECT_EQ(original, data);
+
+    data.clear();
+    EXPECT_EQ(0u, packErasedRuns(data));
+}
+
+TEST(FlashfsPackTest, RunsPastTheTableAreKept)
+{
+    bytes_t data;
+    for (int i = 0; i < FLASHFS_ERASED_RUN_MAX_COUNT + 10; i++) {
+        data.push_back(i);
+        data.insert(data.end(), 20, 0xFF);
+    }
+
+    EXPECT_EQ((unsigned)FLASHFS_ERASED_RUN_MAX_COUNT, packErasedRuns(data));
+}
+
+// STUBS
+
+extern "C" {
+    static flashGeometry_t geometry = {
+        .sectors = FLASH_SECTORS,
+        .pagesPerSector = FLASH_SECTOR_SIZE / M25P16_PAGESIZE,
+        .pageSize = M25P16_PAGESIZE,
+        .sectorSize = FLASH_SECTOR_SIZE,
+        .totalSize = FLASH_SIZE,
+    };
+
+    const flashGeometry_t* m25p16_getGeometry(void)
+    {
+        return &geometry;
+    }
+
+    bool m25p16_isReady(void)
+    {
+        if (busyPolls > 0) {
+            busyPolls--;
+            return false;
+        }
+        completeProgram();
+        return true;
+    }
+
+    bool m25p16_waitForReady(uint32_t timeoutMillis)
+    {
+        UNUSED(timeoutMillis);
+        completeProgram();
+        return true;
+    }
+
+    uint32_t m25p16_pageProgramAsync(uint32_t address, const uint8_t *data, int length)
+    {
+        // flashfs only programs once the previous program is done, and never across a page boundary
+        EXPECT_TRUE(pendingData == NULL);
+        EXPECT_GT(length, 0);
+        EXPECT_EQ(address / M25P16_PAGESIZE, (address + length - 1) / M25P16_PAGESIZE);
+        EXPECT_LE(address + length, (uint32_t)FLASH_SIZE);
+        EXPECT_EQ(bytes_t(length, 0xFF), flashContents(address, length)) << "programming over data at " << address;
+
+        programs.push_back({ address, length });
+        pendingData = data;
+        busyPolls = programBusyPolls;
+
+        return address + length;
+    }
+
+    uint32_t m25p16_pageProgram(uint32_t address, const uint8_t *data, int length)
+    {
+        m25p16_pageProgramAsync(address, data, length);
+        completeProgram();
+
+        return address + length;
+    }
+
+    int m25p16_readBytes(uint32_t address, uint8_t *buffer, int length)
+    {
+        completeProgram();
+        memcpy(buffer, flashMemory + address, length);
+        return length;
+    }
+
+    void m25p16_eraseSector(uint32_t address)
+    {
+        completeProgram();
+        memset(flashMemory + address, 0xFF, FLASH_SECTOR_SIZE);
+        erases.push_back(address);
+        busyPolls = programBusyPolls;
+    }
+
+    void m25p16_eraseCompletely(void)
+    {
+        completeProgram();
+        memset(flashMemory, 0xFF, sizeof(flashMemory));
+    }
+}
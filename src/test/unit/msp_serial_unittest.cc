@@ -0,0 +1,592 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <deque>
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/crc.h"
+    #include "common/maths.h"
+    #include "common/streambuf.h"
+    #include "common/utils.h"
+
+    #include "config/parameter_group.h"
+    #include "config/parameter_group_ids.h"
+
+    #include "drivers/serial.h"
+    #include "drivers/system.h"
+    #include "drivers/time.h"
+
+    #include "fc/cli.h"
+
+    #include "io/serial.h"
+
+    #include "msp/msp.h"
+    #include "msp/msp_protocol.h"
+    #include "msp/msp_serial.h"
+
+    PG_REGISTER(serialConfig_t, serialConfig, PG_SERIAL_CONFIG, 0);
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+// Simulated link: 115200 baud both ways, one way latency of a telemetry radio, serial task at 100Hz
+#define LINK_BYTES_PER_MS       11
+#define LINK_LATENCY_MS         5
+#define SERIAL_TASK_PERIOD_MS   10
+#define LINK_BUFFER_SIZE        256
+
+#define TRANSFER_SIZE           (16 * 1024)
+#define TRANSFER_TIMEOUT_MS     60000
+
+static timeMs_t simulatedTimeMs;
+static uint8_t transferData[TRANSFER_SIZE];
+
+typedef struct linkPort_s {
+    serialPort_t port;
+    volatile uint8_t rxBuffer[LINK_BUFFER_SIZE * 2];
+    volatile uint8_t txBuffer[LINK_BUFFER_SIZE];
+    uint32_t txHead;
+    uint32_t txTail;
+} linkPort_t;
+
+static linkPort_t linkPort;
+
+typedef struct linkByte_s {
+    timeMs_t arrivalMs;
+    uint8_t data;
+} linkByte_t;
+
+static std::deque<linkByte_t> downlink;        // FC to host, in flight
+static std::deque<uint8_t> hostTxQueue;
+static std::deque<linkByte_t> uplink;          // Host to FC, in flight
+
+static uint32_t linkRxWaiting(const serialPort_t *instance)
+{
+    return (instance->rxBufferHead - instance->rxBufferTail) & (instance->rxBufferSize - 1);
+}
+
+static uint32_t linkTxWaiting(void)
+{
+    return (linkPort.txHead - linkPort.txTail) & (LINK_BUFFER_SIZE - 1);
+}
+
+static uint32_t linkTxFree(const serialPort_t *instance)
+{
+    UNUSED(instance);
+    return (LINK_BUFFER_SIZE - 1) - linkTxWaiting();
+}
+
+static void linkWrite(serialPort_t *instance, uint8_t ch)
+{
+    UNUSED(instance);
+    // Real drivers block on a full buffer, the simulated link can't drain while we wait
+    ASSERT_GT(linkTxFree(instance), 0u);
+    linkPort.txBuffer[linkPort.txHead] = ch;
+    linkPort.txHead = (linkPort.txHead + 1) & (LINK_BUFFER_SIZE - 1);
+}
+
+static uint8_t linkRead(serialPort_t *instance)
+{
+    const uint8_t ch = instance->rxBuffer[instance->rxBufferTail];
+    instance->rxBufferTail = (instance->rxBufferTail + 1) & (instance->rxBufferSize - 1);
+    return ch;
+}
+
+static uint32_t linkPeekRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    return serialRxRingSpan(instance, instance->rxBufferHead, data);
+}
+
+static void linkConsumeRx(serialPort_t *instance, uint32_t count)
+{
+    serialRxRingConsume(instance, count);
+}
+
+static bool linkTxEmpty(const serialPort_t *instance)
+{
+    UNUSED(instance);
+    return linkTxWaiting() == 0;
+}
+
+static const struct serialPortVTable linkVTable = {
+    .serialWrite = linkWrite,
+    .serialTotalRxWaiting = linkRxWaiting,
+    .serialTotalTxFree = linkTxFree,
+    .serialRead = linkRead,
+    .peekRxSpan = linkPeekRxSpan,
+    .consumeRx = linkConsumeRx,
+    .serialSetBaudRate = NULL,
+    .isSerialTransmitBufferEmpty = linkTxEmpty,
+    .setMode = NULL,
+    .writeBuf = NULL,
+    .isConnected = NULL,
+    .beginWrite = NULL,
+    .endWrite = NULL,
+};
+
+/*
+ * Host side MSPv2 codec
+ */
+typedef struct hostFrame_s {
+    uint16_t cmd;
+    bool error;
+    std::vector<uint8_t> payload;
+} hostFrame_t;
+
+static std::deque<hostFrame_t> hostFrames;
+static std::vector<uint8_t> hostRxFrame;       // Reply being received
+
+static void hostSend(uint16_t cmd, const std::vector<uint8_t> &payload)
+{
+    uint8_t hdr[5] = { 0, (uint8_t)(cmd & 0xFF), (uint8_t)(cmd >> 8), (uint8_t)(payload.size() & 0xFF), (uint8_t)(payload.size() >> 8) };
+    uint8_t crc = 0;
+
+    hostTxQueue.push_back('$');
+    hostTxQueue.push_back('X');
+    hostTxQueue.push_back('<');
+    for (unsigned i = 0; i < sizeof(hdr); i++) {
+        crc = crc8_dvb_s2_update(crc, &hdr[i], 1);
+        hostTxQueue.push_back(hdr[i]);
+    }
+    for (uint8_t b : payload) {
+        crc = crc8_dvb_s2_update(crc, &b, 1);
+        hostTxQueue.push_back(b);
+    }
+    hostTxQueue.push_back(crc);
+}
+
+static void hostReceive(uint8_t c)
+{
+    std::vector<uint8_t> &frame = hostRxFrame;
+
+    frame.push_back(c);
+
+    // Resynchronise on anything that isn't a reply header
+    static const uint8_t magic[] = { '$', 'X' };
+    if (frame.size() <= 2 && c != magic[frame.size() - 1]) {
+        frame.clear();
+        return;
+    }
+    if (frame.size() == 3 && c != '>' && c != '!') {
+        frame.clear();
+        return;
+    }
+    if (frame.size() < 8) {
+        return;
+    }
+
+    const unsigned size = frame[6] | (frame[7] << 8);
+    if (frame.size() < 8 + size + 1) {
+        return;
+    }
+
+    const uint8_t crc = crc8_dvb_s2_update(0, &frame[3], 5 + size);
+    if (crc == frame.back()) {
+        hostFrame_t reply;
+        reply.cmd = frame[4] | (frame[5] << 8);
+        reply.error = frame[2] == '!';
+        reply.payload.assign(frame.begin() + 8, frame.begin() + 8 + size);
+        hostFrames.push_back(reply);
+    }
+    frame.clear();
+}
+
+static void putU16(std::vector<uint8_t> &buf, uint16_t val)
+{
+    buf.push_back(val & 0xFF);
+    buf.push_back(val >> 8);
+}
+
+static void putU32(std::vector<uint8_t> &buf, uint32_t val)
+{
+    putU16(buf, val & 0xFFFF);
+    putU16(buf, val >> 16);
+}
+
+static uint16_t getU16(const std::vector<uint8_t> &buf, unsigned at)
+{
+    return buf[at] | (buf[at + 1] << 8);
+}
+
+static uint32_t getU32(const std::vector<uint8_t> &buf, unsigned at)
+{
+    return getU16(buf, at) | (getU16(buf, at + 2) << 16);
+}
+
+/*
+ * FC side: dataflash style read command on a test pattern, MSP_API_VERSION as an output command to subscribe to
+ */
+static mspResult_e testProcessCommand(mspPacket_t *cmd, mspPacket_t *reply, mspPostProcessFnPtr *mspPostProcessFn)
+{
+    UNUSED(mspPostProcessFn);
+
+    sbuf_t *src = &cmd->buf;
+    sbuf_t *dst = &reply->buf;
+    reply->cmd = cmd->cmd;
+
+    if (cmd->cmd == MSP_API_VERSION) {
+        sbufWriteU8(dst, 2);
+        return MSP_RESULT_ACK;
+    }
+
+    if (cmd->cmd != MSP_DATAFLASH_READ || sbufBytesRemaining(src) < 6) {
+        return MSP_RESULT_ERROR;
+    }
+
+    const uint32_t address = sbufReadU32(src);
+    uint32_t size = sbufReadU16(src);
+    size = MIN(size, (uint32_t)sbufBytesRemaining(dst) - 4);
+    size = MIN(size, address < TRANSFER_SIZE ? TRANSFER_SIZE - address : 0);
+
+    sbufWriteU32(dst, address);
+    sbufWriteData(dst, &transferData[address], size);
+    return MSP_RESULT_ACK;
+}
+
+/*
+ * Advance the simulation by one millisecond
+ */
+static void simulateStep(void)
+{
+    simulatedTimeMs++;
+
+    for (int i = 0; i < LINK_BYTES_PER_MS && linkTxWaiting(); i++) {
+        const linkByte_t byte = { simulatedTimeMs + LINK_LATENCY_MS, linkPort.txBuffer[linkPort.txTail] };
+        downlink.push_back(byte);
+        linkPort.txTail = (linkPort.txTail + 1) & (LINK_BUFFER_SIZE - 1);
+    }
+    for (int i = 0; i < LINK_BYTES_PER_MS && !hostTxQueue.empty(); i++) {
+        const linkByte_t byte = { simulatedTimeMs + LINK_LATENCY_MS, hostTxQueue.front() };
+        uplink.push_back(byte);
+        hostTxQueue.pop_front();
+    }
+
+    while (!downlink.empty() && downlink.front().arrivalMs <= simulatedTimeMs) {
+        hostReceive(downlink.front().data);
+        downlink.pop_front();
+    }
+    while (!uplink.empty() && uplink.front().arrivalMs <= simulatedTimeMs) {
+        serialPort_t *port = &linkPort.port;
+        port->rxBuffer[port->rxBufferHead] = uplink.front().data;
+        port->rxBufferHead = (port->rxBufferHead + 1) & (port->rxBufferSize - 1);
+        uplink.pop_front();
+    }
+
+    if (simulatedTimeMs % SERIAL_TASK_PERIOD_MS == 0) {
+        mspSerialProcess(MSP_SKIP_NON_MSP_DATA, testProcessCommand);
+    }
+}
+
+static void simulationInit(void)
+{
+    memset(&linkPort, 0, sizeof(linkPort));
+    linkPort.port.vTable = &linkVTable;
+    linkPort.port.mode = MODE_RXTX;
+    linkPort.port.rxBuffer = linkPort.rxBuffer;
+    linkPort.port.txBuffer = linkPort.txBuffer;
+    linkPort.port.rxBufferSize = sizeof(linkPort.rxBuffer);
+    linkPort.port.txBufferSize = sizeof(linkPort.txBuffer);
+
+    downlink.clear();
+    uplink.clear();
+    hostTxQueue.clear();
+    hostFrames.clear();
+    hostRxFrame.clear();
+    simulatedTimeMs = 0;
+
+    for (unsigned i = 0; i < sizeof(transferData); i++) {
+        transferData[i] = (i * 31) ^ (i >> 8);
+    }
+
+    mspSerialInit();
+}
+
+static bool waitForFrame(hostFrame_t *frame)
+{
+    while (hostFrames.empty()) {
+        if (simulatedTimeMs > TRANSFER_TIMEOUT_MS) {
+            return false;
+        }
+        simulateStep();
+    }
+    *frame = hostFrames.front();
+    hostFrames.pop_front();
+    return true;
+}
+
+// One MSP_DATAFLASH_READ request per block, the way configurators download logs today
+static uint32_t requestResponseTransfer(uint16_t blockSize)
+{
+    simulationInit();
+
+    std::vector<uint8_t> received;
+    while (received.size() < TRANSFER_SIZE) {
+        std::vector<uint8_t> request;
+        putU32(request, received.size());
+        putU16(request, blockSize);
+        hostSend(MSP_DATAFLASH_READ, request);
+
+        hostFrame_t reply;
+        if (!waitForFrame(&reply)) {
+            break;
+        }
+        EXPECT_EQ(MSP_DATAFLASH_READ, reply.cmd);
+        EXPECT_EQ(received.size(), getU32(reply.payload, 0));
+        received.insert(received.end(), reply.payload.begin() + 4, reply.payload.end());
+    }
+
+    EXPECT_EQ(TRANSFER_SIZE, received.size());
+    EXPECT_EQ(0, memcmp(transferData, received.data(), MIN(received.size(), sizeof(transferData))));
+    return simulatedTimeMs;
+}
+
+// Windowed chunk stream, optionally ignoring one chunk the first time it arrives to force a retransmission
+static uint32_t chunkedTransfer(uint16_t chunkSize, uint8_t window, int dropSeq)
+{
+    simulationInit();
+
+    std::vector<uint8_t> request;
+    putU16(request, MSP_DATAFLASH_READ);
+    putU32(request, 0);
+    putU32(request, TRANSFER_SIZE);
+    putU16(request, chunkSize);
+    request.push_back(window);
+    hostSend(MSP2_INAV_CHUNK_STREAM, request);
+
+    hostFrame_t reply;
+    EXPECT_TRUE(waitForFrame(&reply));
+    EXPECT_EQ(MSP2_INAV_CHUNK_STREAM, reply.cmd);
+    EXPECT_EQ(chunkSize, getU16(reply.payload, 0));
+    EXPECT_EQ(window, reply.payload[2]);
+
+    std::vector<uint8_t> received;
+    uint16_t expectedSeq = 0;
+    bool dropped = false;
+
+    while (received.size() < TRANSFER_SIZE && waitForFrame(&reply)) {
+        EXPECT_EQ(MSP2_INAV_CHUNK_DATA, reply.cmd);
+        EXPECT_FALSE(reply.error);
+
+        const uint16_t seq = getU16(reply.payload, 0);
+        if (seq == dropSeq && !dropped) {
+            dropped = true;
+            continue;
+        }
+        if (seq != expectedSeq) {
+            continue;
+        }
+
+        EXPECT_EQ(received.size(), getU32(reply.payload, 2));
+        received.insert(received.end(), reply.payload.begin() + 6, reply.payload.end());
+        expectedSeq++;
+
+        std::vector<uint8_t> ack;
+        putU16(ack, expectedSeq);
+        hostSend(MSP2_INAV_CHUNK_ACK, ack);
+    }
+
+    EXPECT_EQ(TRANSFER_SIZE, received.size());
+    EXPECT_EQ(0, memcmp(transferData, received.data(), MIN(received.size(), sizeof(transferData))));
+    return simulatedTimeMs;
+}
+
+// Transfers run on simulated link time, returned in ms
+TEST(MspSerialTest, ChunkedTransferBeatsRequestResponse)
+{
+    const uint32_t requestResponseMs = requestResponseTransfer(128);
+    const uint32_t chunkedMs = chunkedTransfer(192, 4, -1);
+
+    // Streaming keeps the link busy instead of waiting a round trip per block
+    EXPECT_LT(chunkedMs * 3, requestResponseMs * 2);
+    EXPECT_GT(chunkedMs, TRANSFER_SIZE / LINK_BYTES_PER_MS);
+}
+
+TEST(MspSerialTest, ChunkedTransferRetransmitsUnacknowledged)
+{
+    const uint32_t chunkedMs = chunkedTransfer(192, 4, 5);
+    EXPECT_LT(chunkedMs, (uint32_t)TRANSFER_TIMEOUT_MS);
+}
+
+TEST(MspSerialTest, ChunkedTransferAbort)
+{
+    simulationInit();
+
+    std::vector<uint8_t> request;
+    putU16(request, MSP_DATAFLASH_READ);
+    putU32(request, 0);
+    putU32(request, TRANSFER_SIZE);
+    putU16(request, 128);
+    request.push_back(2);
+    hostSend(MSP2_INAV_CHUNK_STREAM, request);
+
+    // Zero length stops the stream, nothing is sent after the reply
+    std::vector<uint8_t> abort;
+    putU16(abort, MSP_DATAFLASH_READ);
+    putU32(abort, 0);
+    putU32(abort, 0);
+    putU16(abort, 0);
+    abort.push_back(0);
+    hostSend(MSP2_INAV_CHUNK_STREAM, abort);
+
+    while (simulatedTimeMs < 1000) {
+        simulateStep();
+    }
+
+    unsigned chunks = 0;
+    unsigned streamReplies = 0;
+    for (const hostFrame_t &frame : hostFrames) {
+        chunks += frame.cmd == MSP2_INAV_CHUNK_DATA;
+        streamReplies += frame.cmd == MSP2_INAV_CHUNK_STREAM;
+    }
+    EXPECT_EQ(2u, streamReplies);
+    EXPECT_LE(chunks, 2u);
+}
+
+TEST(MspSerialTest, ChunkedTransferRejectsUnsupportedCommand)
+{
+    simulationInit();
+
+    std::vector<uint8_t> request;
+    putU16(request, MSP_SET_RAW_RC);
+    putU32(request, 0);
+    putU32(request, TRANSFER_SIZE);
+    putU16(request, 128);
+    request.push_back(2);
+    hostSend(MSP2_INAV_CHUNK_STREAM, request);
+
+    hostFrame_t reply;
+    EXPECT_TRUE(waitForFrame(&reply));
+    EXPECT_EQ(MSP2_INAV_CHUNK_STREAM, reply.cmd);
+    EXPECT_TRUE(reply.error);
+
+    while (simulatedTimeMs < 1000) {
+        simulateStep();
+    }
+    EXPECT_TRUE(hostFrames.empty());
+}
+
+TEST(MspSerialTest, ChunkedTransferWaypointChunksAreWholeWaypoints)
+{
+    simulationInit();
+
+    std::vector<uint8_t> request;
+    putU16(request, MSP2_INAV_WP_BLOCK);
+    putU32(request, 0);
+    putU32(request, 10 * MSP_WP_RECORD_SIZE);
+    putU16(request, 100);
+    request.push_back(2);
+    hostSend(MSP2_INAV_CHUNK_STREAM, request);
+
+    hostFrame_t reply;
+    EXPECT_TRUE(waitForFrame(&reply));
+    EXPECT_EQ(MSP2_INAV_CHUNK_STREAM, reply.cmd);
+    EXPECT_FALSE(reply.error);
+    EXPECT_EQ(4 * MSP_WP_RECORD_SIZE, getU16(reply.payload, 0));
+}
+
+static unsigned countFrames(uint16_t cmd)
+{
+    unsigned count = 0;
+    for (const hostFrame_t &frame : hostFrames) {
+        count += frame.cmd == cmd;
+    }
+    return count;
+}
+
+static void simulateUntil(timeMs_t timeMs)
+{
+    while (simulatedTimeMs < timeMs) {
+        simulateStep();
+    }
+}
+
+TEST(MspSerialTest, SubscriptionsExpireWithoutKeepAlive)
+{
+    simulationInit();
+
+    std::vector<uint8_t> request;
+    putU16(request, MSP_API_VERSION);
+    putU16(request, 100);
+    hostSend(MSP2_INAV_SUBSCRIBE, request);
+
+    simulateUntil(MSP_SUBSCRIPTION_TIMEOUT_MS - 1000);
+    EXPECT_EQ(1u, countFrames(MSP2_INAV_SUBSCRIBE));
+    EXPECT_GE(countFrames(MSP_API_VERSION), 30u);
+
+    // Repeating the subscription keeps it alive past the timeout
+    hostSend(MSP2_INAV_SUBSCRIBE, request);
+    simulateUntil(MSP_SUBSCRIPTION_TIMEOUT_MS + 1000);
+    hostFrames.clear();
+    simulateUntil(MSP_SUBSCRIPTION_TIMEOUT_MS + 2000);
+    EXPECT_GE(countFrames(MSP_API_VERSION), 9u);
+
+    // Nothing from the client for a full timeout ends it
+    simulateUntil(2 * MSP_SUBSCRIPTION_TIMEOUT_MS);
+    hostFrames.clear();
+    simulateUntil(2 * MSP_SUBSCRIPTION_TIMEOUT_MS + 1000);
+    EXPECT_EQ(0u, countFrames(MSP_API_VERSION));
+}
+
+// STUBS
+
+extern "C" {
+    uint8_t cliMode = 0;
+    const uint32_t baudRates[] = { 0, 115200 };
+
+    static serialPortConfig_t testPortConfig;
+
+    timeMs_t millis(void) { return simulatedTimeMs; }
+    void systemResetToBootloader(void) {}
+    void cliEnter(serialPort_t *serialPort) { UNUSED(serialPort); }
+
+    serialPortConfig_t *findSerialPortConfig(serialPortFunction_e function)
+    {
+        UNUSED(function);
+        testPortConfig.msp_baudrateIndex = 1;
+        return &testPortConfig;
+    }
+
+    serialPortConfig_t *findNextSerialPortConfig(serialPortFunction_e function)
+    {
+        UNUSED(function);
+        return NULL;
+    }
+
+    serialPort_t *openSerialPort(serialPortIdentifier_e identifier, serialPortFunction_e function, serialReceiveCallbackPtr callback,
+                                 void *rxCallbackData, uint32_t baudrate, portMode_t mode, portOptions_t options)
+    {
+        UNUSED(identifier);
+        UNUSED(function);
+        UNUSED(callback);
+        UNUSED(rxCallbackData);
+        UNUSED(baudrate);
+        UNUSED(mode);
+        UNUSED(options);
+        return &linkPort.port;
+    }
+
+    void closeSerialPort(serialPort_t *serialPort) { UNUSED(serialPort); }
+    void waitForSerialPortToFinishTransmitting(serialPort_t *serialPort) { UNUSED(serialPort); }
+}
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #define U_ID_0 0
 #define U_ID_1 1
 #define U_ID_2 2
@@ -73,6 +75,19 @@ typedef struct
 
 extern SysTick_Type *SysTick;
 
+typedef enum {
+    FLASH_BUSY = 1,
+    FLASH_ERROR_PG,
+    FLASH_ERROR_WRP,
+    FLASH_COMPLETE,
+    FLASH_TIMEOUT
+} FLASH_Status;
+
+void FLASH_Unlock(void);
+void FLASH_Lock(void);
+FLASH_Status FLASH_ErasePage(uintptr_t Page_Address);
+FLASH_Status FLASH_ProgramWord(uintptr_t Address, uint32_t Data);
+
 
 #define WS2811_DMA_TC_FLAG 1
 #define WS2811_DMA_HANDLER_IDENTIFER 0
@@ -145,4 +145,5 @@ void addBootlogEvent6(bootLogEventCode_e eventCode, uint16_t eventFlags, uint16_
 timeDelta_t getLooptime(void) {return gyro.targetLooptime;}
 void sensorsSet(uint32_t) {}
 void schedulerResetTaskStatistics(cfTaskId_e) {}
+bool busIsBusy(const busDevice_t *) {return false;}
 }
@@ -0,0 +1,241 @@
+#include <cstdint>
+#include <cstring>
+
+extern "C" {
+#include "platform.h"
+#include "common/utils.h"
+#include "drivers/serial.h"
+}
+
+#include "gtest/gtest.h"
+
+#define LOOPBACK_BUFFER_SIZE    256
+
+typedef struct loopbackPort_s {
+    serialPort_t port;
+    volatile uint8_t rxBuffer[LOOPBACK_BUFFER_SIZE];
+    volatile uint8_t txBuffer[LOOPBACK_BUFFER_SIZE];
+} loopbackPort_t;
+
+// Driver calls made by the reading side, each one is an indirect call on the target
+static uint32_t rxDriverCalls;
+
+// Loopback driver built on the same rx ring helpers as the UART and softserial drivers
+static uint32_t loopbackRxWaiting(const serialPort_t *instance)
+{
+    rxDriverCalls++;
+    return (instance->rxBufferHead - instance->rxBufferTail) & (instance->rxBufferSize - 1);
+}
+
+static uint32_t loopbackTxFree(const serialPort_t *instance)
+{
+    return (instance->rxBufferSize - 1) - ((instance->rxBufferHead - instance->rxBufferTail) & (instance->rxBufferSize - 1));
+}
+
+static void loopbackWrite(serialPort_t *instance, uint8_t ch)
+{
+    // What is transmitted shows up in the receive ring, as if written by the RX interrupt
+    instance->rxBuffer[instance->rxBufferHead] = ch;
+    instance->rxBufferHead = (instance->rxBufferHead + 1) & (instance->rxBufferSize - 1);
+}
+
+static uint8_t loopbackRead(serialPort_t *instance)
+{
+    rxDriverCalls++;
+    const uint8_t ch = instance->rxBuffer[instance->rxBufferTail];
+    instance->rxBufferTail = (instance->rxBufferTail + 1) & (instance->rxBufferSize - 1);
+    return ch;
+}
+
+static uint32_t loopbackPeekRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    rxDriverCalls++;
+    return serialRxRingSpan(instance, instance->rxBufferHead, data);
+}
+
+static void loopbackConsumeRx(serialPort_t *instance, uint32_t count)
+{
+    rxDriverCalls++;
+    serialRxRingConsume(instance, count);
+}
+
+static bool loopbackTxEmpty(const serialPort_t *instance)
+{
+    UNUSED(instance);
+    return true;
+}
+
+static const struct serialPortVTable loopbackVTable = {
+    .serialWrite = loopbackWrite,
+    .serialTotalRxWaiting = loopbackRxWaiting,
+    .serialTotalTxFree = loopbackTxFree,
+    .serialRead = loopbackRead,
+    .peekRxSpan = loopbackPeekRxSpan,
+    .consumeRx = loopbackConsumeRx,
+    .serialSetBaudRate = NULL,
+    .isSerialTransmitBufferEmpty = loopbackTxEmpty,
+    .setMode = NULL,
+    .writeBuf = NULL,
+    .isConnected = NULL,
+    .beginWrite = NULL,
+    .endWrite = NULL,
+};
+
+static loopbackPort_t loopback;
+
+static serialPort_t *loopbackOpen(uint32_t startOffset)
+{
+    memset(&loopback, 0, sizeof(loopback));
+    loopback.port.vTable = &loopbackVTable;
+    loopback.port.mode = MODE_RXTX;
+    loopback.port.rxBuffer = loopback.rxBuffer;
+    loopback.port.txBuffer = loopback.txBuffer;
+    loopback.port.rxBufferSize = LOOPBACK_BUFFER_SIZE;
+    loopback.port.txBufferSize = LOOPBACK_BUFFER_SIZE;
+    loopback.port.rxBufferHead = loopback.port.rxBufferTail = startOffset;
+    return &loopback.port;
+}
+
+TEST(SerialTest, PeekRxSpanStopsAtWrap)
+{
+    serialPort_t *port = loopbackOpen(LOOPBACK_BUFFER_SIZE - 4);
+
+    for (int i = 0; i < 10; i++) {
+        serialWrite(port, i);
+    }
+    EXPECT_EQ(10u, serialRxBytesWaiting(port));
+
+    const uint8_t *data;
+    uint32_t count = serialPeekRxSpan(port, &data);
+    EXPECT_EQ(4u, count);
+    EXPECT_EQ(0, data[0]);
+    EXPECT_EQ(3, data[3]);
+
+    // Peek doesn't consume
+    EXPECT_EQ(4u, serialPeekRxSpan(port, &data));
+    serialConsumeRx(port, 3);
+    EXPECT_EQ(7u, serialRxBytesWaiting(port));
+
+    count = serialPeekRxSpan(port, &data);
+    EXPECT_EQ(1u, count);
+    EXPECT_EQ(3, data[0]);
+    serialConsumeRx(port, count);
+
+    count = serialPeekRxSpan(port, &data);
+    EXPECT_EQ(6u, count);
+    EXPECT_EQ(4, data[0]);
+    EXPECT_EQ(9, data[5]);
+    serialConsumeRx(port, count);
+
+    EXPECT_EQ(0u, serialRxBytesWaiting(port));
+    EXPECT_EQ(0u, serialPeekRxSpan(port, &data));
+}
+
+TEST(SerialTest, ReadBufAcrossWrap)
+{
+    serialPort_t *port = loopbackOpen(LOOPBACK_BUFFER_SIZE - 5);
+
+    for (int i = 0; i < 20; i++) {
+        serialWrite(port, 100 + i);
+    }
+
+    uint8_t buf[32];
+    EXPECT_EQ(8u, serialReadBuf(port, buf, 8));
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(100 + i, buf[i]);
+    }
+
+    EXPECT_EQ(12u, serialReadBuf(port, buf, sizeof(buf)));
+    for (int i = 0; i < 12; i++) {
+        EXPECT_EQ(108 + i, buf[i]);
+    }
+
+    EXPECT_EQ(0u, serialReadBuf(port, buf, sizeof(buf)));
+}
+
+// Push data through the ring and compare bytewise reads against span reads by driver calls made
+#define STREAM_BYTES            (64 * 1024)
+#define STREAM_BURST            200
+#define STREAM_BURSTS           ((STREAM_BYTES + STREAM_BURST - 1) / STREAM_BURST)
+
+typedef uint32_t (*streamReader_t)(serialPort_t *port, uint32_t *checksum);
+
+static uint32_t readBytewise(serialPort_t *port, uint32_t *checksum)
+{
+    uint32_t count = 0;
+    while (serialRxBytesWaiting(port)) {
+        *checksum += serialRead(port);
+        count++;
+    }
+    return count;
+}
+
+static uint32_t readSpans(serialPort_t *port, uint32_t *checksum)
+{
+    const uint8_t *data;
+    uint32_t count;
+    uint32_t total = 0;
+
+    while ((count = serialPeekRxSpan(port, &data)) > 0) {
+        for (uint32_t i = 0; i < count; i++) {
+            *checksum += data[i];
+        }
+        serialConsumeRx(port, count);
+        total += count;
+    }
+    return total;
+}
+
+static uint32_t readBuffered(serialPort_t *port, uint32_t *checksum)
+{
+    uint8_t buf[64];
+    uint32_t count;
+    uint32_t total = 0;
+
+    while ((count = serialReadBuf(port, buf, sizeof(buf))) > 0) {
+        for (uint32_t i = 0; i < count; i++) {
+            *checksum += buf[i];
+        }
+        total += count;
+    }
+    return total;
+}
+
+static uint32_t streamThrough(streamReader_t reader, uint32_t *calls)
+{
+    serialPort_t *port = loopbackOpen(0);
+    uint8_t burst[STREAM_BURST];
+    for (unsigned i = 0; i < sizeof(burst); i++) {
+        burst[i] = i * 7;
+    }
+
+    uint32_t checksum = 0;
+    uint32_t received = 0;
+
+    rxDriverCalls = 0;
+    for (uint32_t sent = 0; sent < STREAM_BYTES; sent += sizeof(burst)) {
+        serialWriteBuf(port, burst, sizeof(burst));
+        received += reader(port, &checksum);
+    }
+    *calls = rxDriverCalls;
+
+    EXPECT_EQ((uint32_t)(STREAM_BURSTS * STREAM_BURST), received);
+    return checksum;
+}
+
+TEST(SerialTest, SpanReadsSaveDriverCalls)
+{
+    uint32_t bytewiseCalls, spanCalls, bufferedCalls;
+    const uint32_t bytewise = streamThrough(readBytewise, &bytewiseCalls);
+    const uint32_t spans = streamThrough(readSpans, &spanCalls);
+    const uint32_t buffered = streamThrough(readBuffered, &bufferedCalls);
+
+    EXPECT_EQ(bytewise, spans);
+    EXPECT_EQ(bytewise, buffered);
+
+    // Two calls per byte plus the final empty check, against a peek and consume per span and
+    // at most two spans per burst, or per 64 byte read for serialReadBuf()
+    EXPECT_EQ((uint32_t)(STREAM_BURSTS * (2 * STREAM_BURST + 1)), bytewiseCalls);
+    EXPECT_LE(spanCalls, (uint32_t)(STREAM_BURSTS * (2 * 2 + 1)));
+    EXPECT_LE(bufferedCalls, (uint32_t)(STREAM_BURSTS * ((STREAM_BURST / 64 + 1) * 2 * 2 + 2)));
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/utils.h"
+
+    #include "config/parameter_group.h"
+
+    #include "fc/config.h"
+    #include "fc/settings.h"
+
+    #include "settings_unittest.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+// Table generated by utils/settings.rb from settings_unittest.yaml
+
+// settingFind() compares a single candidate, so this fails if two names share a hash slot
+TEST(SettingsTest, FindEveryName)
+{
+    char name[SETTING_MAX_NAME_LENGTH];
+
+    for (unsigned ii = 0; ii < SETTINGS_TABLE_COUNT; ii++) {
+        const setting_t *setting = settingGet(ii);
+        settingGetName(setting, name);
+        EXPECT_EQ(setting, settingFind(name)) << name;
+        EXPECT_EQ(ii, settingGetIndex(settingFind(name)));
+    }
+}
+
+TEST(SettingsTest, UnknownNames)
+{
+    char name[SETTING_MAX_NAME_LENGTH];
+
+    EXPECT_EQ(NULL, settingFind(""));
+    EXPECT_EQ(NULL, settingFind("no_such_setting"));
+
+    // Prefixes, suffixes and other cases of existing names are not matches
+    settingGetName(settingGet(0), name);
+    const size_t len = strlen(name);
+
+    name[len - 1] = '\0';
+    EXPECT_EQ(NULL, settingFind(name));
+
+    settingGetName(settingGet(0), name);
+    strcat(name, "x");
+    EXPECT_EQ(NULL, settingFind(name));
+
+    settingGetName(settingGet(0), name);
+    name[0] -= 'a' - 'A';
+    EXPECT_EQ(NULL, settingFind(name));
+}
+
+// STUBS
+
+extern "C" {
+    static uint8_t settingsTestStorage[200];
+    static const pgRegistry_t settingsTestRegistry = {
+        .pgn = PG_SETTINGS_TEST,
+        .size = sizeof(settingsTestStorage),
+        .address = settingsTestStorage,
+        .copy = settingsTestStorage,
+        .ptr = NULL,
+        .reset = { .ptr = NULL },
+    };
+
+    const pgRegistry_t *pgFind(pgn_t pgn)
+    {
+        UNUSED(pgn);
+        return &settingsTestRegistry;
+    }
+
+    uint8_t getConfigProfile(void) { return 0; }
+    uint8_t getConfigBatteryProfile(void) { return 0; }
+}
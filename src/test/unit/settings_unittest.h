@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+
+#define PG_SETTINGS_TEST    4000
+
+typedef struct settingsTestConfig_s {
+    uint8_t values[200];
+} settingsTestConfig_t;
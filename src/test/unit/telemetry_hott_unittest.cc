@@ -205,6 +205,24 @@ uint8_t serialRead(serialPort_t *instance) {
     return 0;
 }
 
+uint32_t serialPeekRxSpan(serialPort_t *instance, const uint8_t **data) {
+    UNUSED(instance);
+    UNUSED(data);
+    return 0;
+}
+
+void serialConsumeRx(serialPort_t *instance, uint32_t count) {
+    UNUSED(instance);
+    UNUSED(count);
+}
+
+uint32_t serialReadBuf(serialPort_t *instance, uint8_t *data, uint32_t maxCount) {
+    UNUSED(instance);
+    UNUSED(data);
+    UNUSED(maxCount);
+    return 0;
+}
+
 void serialWrite(serialPort_t *instance, uint8_t ch) {
     UNUSED(instance);
     UNUSED(ch);
@@ -0,0 +1,195 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Decode blackbox logs on the host with the in-tree decoder, built by src/test/Makefile:
+ *
+ *   blackbox_decode [--stats] [--no-csv] [file]
+ *
+ * Main frames of every log in the file (or stdin) are written to stdout as CSV, --stats prints frame statistics,
+ * field ranges and the decoding speed to stderr. Use --no-csv to time the decoder alone.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "blackbox_decoder.h"
+
+#define READ_CHUNK_SIZE     (64 * 1024)
+
+typedef struct decodeContext_s {
+    bool csv;
+    const blackboxDecoderFieldDefs_t *mainFields;
+    uint32_t mainFrames;
+    int32_t fieldMin[BLACKBOX_DECODER_MAX_FIELDS];
+    int32_t fieldMax[BLACKBOX_DECODER_MAX_FIELDS];
+} decodeContext_t;
+
+static void onLogBegin(void *context, const blackboxDecoder_t *decoder)
+{
+    decodeContext_t *decode = context;
+    const blackboxDecoderFieldDefs_t *fields = &decoder->fields[BLACKBOX_DECODER_FIELDS_MAIN];
+
+    decode->mainFields = fields;
+    decode->mainFrames = 0;
+
+    if (decode->csv) {
+        if (decoder->stats.logCount > 1) {
+            printf("\n");
+        }
+        for (int i = 0; i < fields->count; i++) {
+            printf(i ? ",%s" : "%s", fields->name[i]);
+        }
+        printf("\n");
+    }
+}
+
+static void onFrame(void *context, char frameType, const int32_t *values, int valueCount)
+{
+    decodeContext_t *decode = context;
+
+    if (frameType != 'I' && frameType != 'P') {
+        return;
+    }
+
+    for (int i = 0; i < valueCount; i++) {
+        if (decode->mainFrames == 0 || values[i] < decode->fieldMin[i]) {
+            decode->fieldMin[i] = values[i];
+        }
+        if (decode->mainFrames == 0 || values[i] > decode->fieldMax[i]) {
+            decode->fieldMax[i] = values[i];
+        }
+
+        if (decode->csv) {
+            if (decode->mainFields->isSigned[i]) {
+                printf(i ? ",%" PRId32 : "%" PRId32, values[i]);
+            } else {
+                printf(i ? ",%" PRIu32 : "%" PRIu32, (uint32_t)values[i]);
+            }
+        }
+    }
+    if (decode->csv) {
+        printf("\n");
+    }
+
+    decode->mainFrames++;
+}
+
+static void onEvent(void *context, const blackboxDecoderEvent_t *event)
+{
+    const decodeContext_t *decode = context;
+
+    if (event->event == FLIGHT_LOG_EVENT_LOG_END && !decode->csv) {
+        fprintf(stderr, "%s\n", event->message);
+    }
+}
+
+static void printStats(const blackboxDecoder_t *decoder, const decodeContext_t *decode, uint64_t bytes, double seconds)
+{
+    const blackboxDecoderStats_t *stats = &decoder->stats;
+
+    fprintf(stderr, "Logs            %10" PRIu32 "\n", stats->logCount);
+    fprintf(stderr, "Header bytes    %10" PRIu32 "\n", stats->headerBytes);
+    for (int i = 0; i < BLACKBOX_DECODER_FRAME_TYPE_COUNT; i++) {
+        if (stats->frameCount[i]) {
+            fprintf(stderr, "%c frames        %10" PRIu32 " %10" PRIu32 " bytes %6.1f bytes/frame\n", BLACKBOX_DECODER_FRAME_TYPES[i],
+                stats->frameCount[i], stats->frameBytes[i], (double)stats->frameBytes[i] / stats->frameCount[i]);
+        }
+    }
+    if (stats->compressedBlocks) {
+        fprintf(stderr, "Compressed      %10" PRIu32 " blocks %9" PRIu32 " bytes\n", stats->compressedBlocks, stats->compressedBytes);
+    }
+    fprintf(stderr, "Corrupt bytes   %10" PRIu32 "\n", stats->corruptBytes);
+    fprintf(stderr, "Dropped frames  %10" PRIu32 "\n", stats->droppedFrames);
+
+    if (decode->mainFields && decode->mainFrames) {
+        fprintf(stderr, "\nMain fields of the last log:\n");
+        for (int i = 0; i < decode->mainFields->count; i++) {
+            fprintf(stderr, "%-20s %12" PRId32 " %12" PRId32 "\n", decode->mainFields->name[i], decode->fieldMin[i], decode->fieldMax[i]);
+        }
+    }
+
+    fprintf(stderr, "\nDecoded %" PRIu64 " bytes in %.3f s, %.1f MB/s\n", bytes, seconds, seconds > 0 ? bytes / seconds / 1e6 : 0);
+}
+
+static double monotonicSeconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+    static blackboxDecoder_t decoder;
+    static uint8_t chunk[READ_CHUNK_SIZE];
+    static const blackboxDecoderCallbacks_t callbacks = {
+        .logBegin = onLogBegin,
+        .frame = onFrame,
+        .event = onEvent,
+    };
+    decodeContext_t decode = { .csv = true };
+    bool showStats = false;
+    const char *filename = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--stats") == 0) {
+            showStats = true;
+        } else if (strcmp(argv[i], "--no-csv") == 0) {
+            decode.csv = false;
+        } else if (argv[i][0] == '-' && argv[i][1]) {
+            fprintf(stderr, "Usage: %s [--stats] [--no-csv] [file]\n", argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            filename = argv[i];
+        }
+    }
+
+    FILE *file = (filename && strcmp(filename, "-") != 0) ? fopen(filename, "rb") : stdin;
+    if (!file) {
+        perror(filename);
+        return EXIT_FAILURE;
+    }
+
+    blackboxDecoderInit(&decoder, &callbacks, &decode);
+
+    const double start = monotonicSeconds();
+    uint64_t bytes = 0;
+    size_t length;
+    while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        blackboxDecoderFeed(&decoder, chunk, length);
+        bytes += length;
+    }
+    blackboxDecoderFinish(&decoder);
+    const double seconds = monotonicSeconds() - start;
+
+    if (file != stdin) {
+        fclose(file);
+    }
+
+    if (showStats) {
+        printStats(&decoder, &decode, bytes, seconds);
+    }
+
+    return decoder.stats.logCount ? EXIT_SUCCESS : EXIT_FAILURE;
+}
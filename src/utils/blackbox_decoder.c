@@ -0,0 +1,871 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "blackbox_decoder.h"
+
+#include "common/maths.h"
+#include "common/utils.h"
+
+#define LOG_START               "H Product:"
+#define LOG_START_LENGTH        (sizeof(LOG_START) - 1)
+
+typedef int (*blackboxDecoderParseFn)(blackboxDecoder_t *decoder, const uint8_t *data, int length, bool final);
+
+typedef struct frameReader_s {
+    const uint8_t *pos;
+    const uint8_t *end;
+    bool overrun;           // The frame continues past the end of the data
+    bool invalid;
+} frameReader_t;
+
+static uint8_t readByte(frameReader_t *reader)
+{
+    if (reader->pos < reader->end) {
+        return *reader->pos++;
+    }
+
+    reader->overrun = true;
+    return 0;
+}
+
+static int32_t signExtend(uint32_t value, int bits)
+{
+    return (int32_t)(value << (32 - bits)) >> (32 - bits);
+}
+
+static uint32_t readUnsignedVB(frameReader_t *reader)
+{
+    uint32_t value = 0;
+
+    for (int shift = 0; shift < 35; shift += 7) {
+        const uint8_t c = readByte(reader);
+
+        value |= (uint32_t)(c & 0x7F) << shift;
+        if (!(c & 0x80)) {
+            return value;
+        }
+    }
+
+    // A 32 bit value never takes more than 5 bytes
+    reader->invalid = true;
+    return 0;
+}
+
+static int32_t readSignedVB(frameReader_t *reader)
+{
+    const uint32_t value = readUnsignedVB(reader);
+
+    // ZigZag decode
+    return (value >> 1) ^ -(int32_t)(value & 1);
+}
+
+// Mirrors blackboxEncodeTag2_3S32()
+static void readTag2_3S32(frameReader_t *reader, int32_t *values)
+{
+    const uint8_t lead = readByte(reader);
+
+    switch (lead >> 6) {
+    case 0:
+        values[0] = signExtend((lead >> 4) & 0x03, 2);
+        values[1] = signExtend((lead >> 2) & 0x03, 2);
+        values[2] = signExtend(lead & 0x03, 2);
+        break;
+    case 1:
+    {
+        const uint8_t c = readByte(reader);
+        values[0] = signExtend(lead & 0x0F, 4);
+        values[1] = signExtend(c >> 4, 4);
+        values[2] = signExtend(c & 0x0F, 4);
+        break;
+    }
+    case 2:
+        values[0] = signExtend(lead & 0x3F, 6);
+        values[1] = signExtend(readByte(reader) & 0x3F, 6);
+        values[2] = signExtend(readByte(reader) & 0x3F, 6);
+        break;
+    case 3:
+        // Each field has a 2 bit byte count less one, first field in the low bits, values are little endian
+        for (int x = 0; x < 3; x++) {
+            const int byteCount = ((lead >> (x * 2)) & 0x03) + 1;
+            uint32_t value = 0;
+
+            for (int i = 0; i < byteCount; i++) {
+                value |= (uint32_t)readByte(reader) << (i * 8);
+            }
+            values[x] = signExtend(value, byteCount * 8);
+        }
+        break;
+    }
+}
+
+// Mirrors blackboxEncodeTag8_4S16(), fields are packed in nibbles, high nibble first
+static void readTag8_4S16(frameReader_t *reader, int32_t *values)
+{
+    uint8_t selector = readByte(reader);
+    uint8_t buffer = 0;
+    bool halfByteUsed = false;
+
+    for (int x = 0; x < 4; x++, selector >>= 2) {
+        switch (selector & 0x03) {
+        case 0:
+            values[x] = 0;
+            break;
+        case 1:
+            if (halfByteUsed) {
+                values[x] = signExtend(buffer & 0x0F, 4);
+            } else {
+                buffer = readByte(reader);
+                values[x] = signExtend(buffer >> 4, 4);
+            }
+            halfByteUsed = !halfByteUsed;
+            break;
+        case 2:
+            if (halfByteUsed) {
+                const uint8_t high = buffer << 4;
+                buffer = readByte(reader);
+                values[x] = (int8_t)(high | (buffer >> 4));
+            } else {
+                values[x] = (int8_t)readByte(reader);
+            }
+            break;
+        case 3:
+            if (halfByteUsed) {
+                const uint8_t c1 = readByte(reader);
+                const uint8_t c2 = readByte(reader);
+                values[x] = (int16_t)(((buffer & 0x0F) << 12) | (c1 << 4) | (c2 >> 4));
+                buffer = c2;
+            } else {
+                const uint8_t c1 = readByte(reader);
+                const uint8_t c2 = readByte(reader);
+                values[x] = (int16_t)((c1 << 8) | c2);
+            }
+            break;
+        }
+    }
+}
+
+// Mirrors blackboxEncodeTag8_8SVB()
+static void readTag8_8SVB(frameReader_t *reader, int32_t *values, int valueCount)
+{
+    if (valueCount == 1) {
+        values[0] = readSignedVB(reader);
+        return;
+    }
+
+    const uint8_t header = readByte(reader);
+    for (int i = 0; i < valueCount; i++) {
+        values[i] = (header & (1 << i)) ? readSignedVB(reader) : 0;
+    }
+}
+
+/*
+ * Read the raw field values of a frame. Fields that share an encoding with their neighbours are read as a group, as
+ * blackbox.c writes them, so values needs room for a few more fields than count.
+ */
+static void readFieldValues(frameReader_t *reader, const uint8_t *encoding, int count, int32_t *values)
+{
+    for (int i = 0; i < count && !reader->invalid; ) {
+        switch (encoding[i]) {
+        case FLIGHT_LOG_FIELD_ENCODING_SIGNED_VB:
+            values[i++] = readSignedVB(reader);
+            break;
+        case FLIGHT_LOG_FIELD_ENCODING_UNSIGNED_VB:
+            values[i++] = readUnsignedVB(reader);
+            break;
+        case FLIGHT_LOG_FIELD_ENCODING_NEG_14BIT:
+            values[i++] = -signExtend(readUnsignedVB(reader), 14);
+            break;
+        case FLIGHT_LOG_FIELD_ENCODING_TAG8_8SVB:
+        {
+            int groupCount = 1;
+            while (groupCount < 8 && i + groupCount < count && encoding[i + groupCount] == FLIGHT_LOG_FIELD_ENCODING_TAG8_8SVB) {
+                groupCount++;
+            }
+            readTag8_8SVB(reader, values + i, groupCount);
+            i += groupCount;
+            break;
+        }
+        case FLIGHT_LOG_FIELD_ENCODING_TAG2_3S32:
+            readTag2_3S32(reader, values + i);
+            i += 3;
+            break;
+        case FLIGHT_LOG_FIELD_ENCODING_TAG8_4S16:
+            readTag8_4S16(reader, values + i);
+            i += 4;
+            break;
+        case FLIGHT_LOG_FIELD_ENCODING_NULL:
+            values[i++] = 0;
+            break;
+        default:
+            reader->invalid = true;
+            break;
+        }
+    }
+}
+
+// Same frame selection as blackboxShouldLogPFrame()
+static bool shouldHaveFrame(const blackboxDecoder_t *decoder, uint32_t iteration)
+{
+    return (iteration % decoder->iInterval + decoder->pIntervalNum - 1) % decoder->pIntervalDenom < decoder->pIntervalNum;
+}
+
+static uint32_t countSkippedFrames(const blackboxDecoder_t *decoder)
+{
+    uint32_t count = 0;
+
+    for (uint32_t iteration = decoder->lastIteration + 1; !shouldHaveFrame(decoder, iteration) && count < decoder->iInterval; iteration++) {
+        count++;
+    }
+
+    return count;
+}
+
+/*
+ * Turn the raw values read from a frame into field values. previous and previous2 are the main frame history, NULL for
+ * frames without deltas.
+ */
+static void applyPredictors(const blackboxDecoder_t *decoder, frameReader_t *reader, const blackboxDecoderFieldDefs_t *defs,
+    int deltaIndex, int32_t *values, const int32_t *previous, const int32_t *previous2)
+{
+    int homeCoord = 0;
+
+    for (int i = 0; i < defs->count; i++) {
+        const uint8_t predictor = defs->predictor[deltaIndex][i];
+        uint32_t value = values[i];
+
+        if (!previous && (predictor == FLIGHT_LOG_FIELD_PREDICTOR_PREVIOUS || predictor == FLIGHT_LOG_FIELD_PREDICTOR_STRAIGHT_LINE
+                || predictor == FLIGHT_LOG_FIELD_PREDICTOR_AVERAGE_2 || predictor == FLIGHT_LOG_FIELD_PREDICTOR_INC)) {
+            reader->invalid = true;
+            return;
+        }
+
+        switch (predictor) {
+        case FLIGHT_LOG_FIELD_PREDICTOR_0:
+            break;
+        case FLIGHT_LOG_FIELD_PREDICTOR_PREVIOUS:
+            value += previous[i];
+            break;
+        case FLIGHT_LOG_FIELD_PREDICTOR_STRAIGHT_LINE:
+            value += 2 * (uint32_t)previous[i] - previous2[i];
+            break;
+        case FLIGHT_LOG_FIELD_PREDICTOR_AVERAGE_2:
+            if (defs->isSigned[i]) {
+                value += (int32_t)(((int64_t)previous[i] + previous2[i]) / 2);
+            } else {
+                value += (uint32_t)(((uint64_t)(uint32_t)previous[i] + (uint32_t)previous2[i]) / 2);
+            }
+            break;
+        case FLIGHT_LOG_FIELD_PREDICTOR_MINTHROTTLE:
+            value += decoder->minthrottle;
+            break;
+        case FLIGHT_LOG_FIELD_PREDICTOR_MOTOR_0:
+            // Motor 0 comes before the other motors in the frame
+            if (decoder->motor0Field < 0 || decoder->motor0Field >= i) {
+                reader->invalid = true;
+                return;
+            }
+            value += values[decoder->motor0Field];
+            break;
+        case FLIGHT_LOG_FIELD_PREDICTOR_INC:
+            value += previous[i] + 1 + countSkippedFrames(decoder);
+            break;
+        case FLIGHT_LOG_FIELD_PREDICTOR_HOME_COORD:
+            if (homeCoord >= 2) {
+                reader->invalid = true;
+                return;
+            }
+            value += decoder->gpsHome[homeCoord++];
+            break;
+        case FLIGHT_LOG_FIELD_PREDICTOR_1500:
+            value += 1500;
+            break;
+        case FLIGHT_LOG_FIELD_PREDICTOR_VBATREF:
+            value += decoder->vbatref;
+            break;
+        case FLIGHT_LOG_FIELD_PREDICTOR_LAST_MAIN_FRAME_TIME:
+            value += decoder->lastMainTime;
+            break;
+        default:
+            reader->invalid = true;
+            return;
+        }
+
+        values[i] = value;
+    }
+}
+
+static void readEvent(blackboxDecoder_t *decoder, frameReader_t *reader, blackboxDecoderEvent_t *event)
+{
+    memset(event, 0, sizeof(*event));
+    event->event = readByte(reader);
+
+    switch (event->event) {
+    case FLIGHT_LOG_EVENT_SYNC_BEEP:
+        event->data.syncBeep.time = readUnsignedVB(reader);
+        break;
+    case FLIGHT_LOG_EVENT_FLIGHTMODE:
+        event->data.flightMode.flags = readUnsignedVB(reader);
+        event->data.flightMode.lastFlags = readUnsignedVB(reader);
+        break;
+    case FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT:
+    {
+        const uint8_t adjustmentFunction = readByte(reader);
+
+        event->data.inflightAdjustment.adjustmentFunction = adjustmentFunction & ~FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT_FUNCTION_FLOAT_VALUE_FLAG;
+        if (adjustmentFunction & FLIGHT_LOG_EVENT_INFLIGHT_ADJUSTMENT_FUNCTION_FLOAT_VALUE_FLAG) {
+            uint32_t value = 0;
+            for (int i = 0; i < 4; i++) {
+                value |= (uint32_t)readByte(reader) << (i * 8);
+            }
+            event->data.inflightAdjustment.floatFlag = true;
+            memcpy(&event->data.inflightAdjustment.newFloatValue, &value, sizeof(value));
+        } else {
+            event->data.inflightAdjustment.newValue = readSignedVB(reader);
+        }
+        break;
+    }
+    case FLIGHT_LOG_EVENT_LOGGING_RESUME:
+        event->data.loggingResume.logIteration = readUnsignedVB(reader);
+        event->data.loggingResume.currentTimeUs = readUnsignedVB(reader);
+        break;
+    case FLIGHT_LOG_EVENT_IMU_FAILURE:
+        event->data.imuError.errorCode = readUnsignedVB(reader);
+        break;
+    case FLIGHT_LOG_EVENT_LOG_END:
+        // Followed by a message and a zero byte
+        for (int i = 0; ; i++) {
+            if (i == BLACKBOX_DECODER_MESSAGE_SIZE) {
+                reader->invalid = true;
+                return;
+            }
+            decoder->message[i] = readByte(reader);
+            if (decoder->message[i] == '\0' || reader->overrun) {
+                break;
+            }
+        }
+        event->message = decoder->message;
+        break;
+    default:
+        reader->invalid = true;
+        break;
+    }
+}
+
+static int frameTypeIndex(uint8_t frameType)
+{
+    const char *type = frameType ? strchr(BLACKBOX_DECODER_FRAME_TYPES, frameType) : NULL;
+
+    return type ? type - BLACKBOX_DECODER_FRAME_TYPES : -1;
+}
+
+static void commitFrame(blackboxDecoder_t *decoder, char frameType, const blackboxDecoderEvent_t *event)
+{
+    const blackboxDecoderCallbacks_t *callbacks = decoder->callbacks;
+    int32_t *values = decoder->values;
+
+    switch (frameType) {
+    case 'I':
+    case 'P':
+    {
+        const int count = decoder->fields[BLACKBOX_DECODER_FIELDS_MAIN].count;
+
+        memcpy(decoder->mainHistory[1], frameType == 'I' ? values : decoder->mainHistory[0], count * sizeof(int32_t));
+        memcpy(decoder->mainHistory[0], values, count * sizeof(int32_t));
+        decoder->mainHistoryValid = true;
+
+        if (decoder->iterationField >= 0) {
+            decoder->lastIteration = values[decoder->iterationField];
+        }
+        if (decoder->timeField >= 0) {
+            decoder->lastMainTime = values[decoder->timeField];
+        }
+
+        if (callbacks->frame) {
+            callbacks->frame(decoder->context, frameType, values, count);
+        }
+        break;
+    }
+    case 'H':
+        decoder->gpsHome[0] = values[0];
+        decoder->gpsHome[1] = values[1];
+        FALLTHROUGH;
+    case 'G':
+    case 'S':
+        if (callbacks->frame) {
+            const blackboxDecoderFields_e fields = frameType == 'G' ? BLACKBOX_DECODER_FIELDS_GPS :
+                frameType == 'H' ? BLACKBOX_DECODER_FIELDS_GPS_HOME : BLACKBOX_DECODER_FIELDS_SLOW;
+
+            callbacks->frame(decoder->context, frameType, values, decoder->fields[fields].count);
+        }
+        break;
+    case 'E':
+        if (event->event == FLIGHT_LOG_EVENT_LOGGING_RESUME) {
+            decoder->lastIteration = event->data.loggingResume.logIteration;
+            decoder->lastMainTime = event->data.loggingResume.currentTimeUs;
+        } else if (event->event == FLIGHT_LOG_EVENT_LOG_END) {
+            decoder->mode = BLACKBOX_DECODER_SEARCH;
+        }
+
+        if (callbacks->event) {
+            callbacks->event(decoder->context, event);
+        }
+        break;
+    }
+}
+
+/*
+ * Decode the frame at start. Returns the number of bytes used, 1 to skip a byte that doesn't start a valid frame, or 0
+ * if more data is needed.
+ */
+static int parseFrame(blackboxDecoder_t *decoder, const uint8_t *start, const uint8_t *end, bool final)
+{
+    const bool canWait = !final && end - start < BLACKBOX_DECODER_BUFFER_SIZE;
+    const char frameType = *start;
+    frameReader_t reader = { .pos = start + 1, .end = end };
+    blackboxDecoderEvent_t event;
+    const blackboxDecoderFieldDefs_t *defs = NULL;
+    bool predicted = true;
+
+    switch (frameType) {
+    case 'I':
+    case 'P':
+        defs = &decoder->fields[BLACKBOX_DECODER_FIELDS_MAIN];
+        break;
+    case 'G':
+        defs = &decoder->fields[BLACKBOX_DECODER_FIELDS_GPS];
+        break;
+    case 'H':
+        defs = &decoder->fields[BLACKBOX_DECODER_FIELDS_GPS_HOME];
+        break;
+    case 'S':
+        defs = &decoder->fields[BLACKBOX_DECODER_FIELDS_SLOW];
+        break;
+    case 'E':
+        readEvent(decoder, &reader, &event);
+        break;
+    default:
+        reader.invalid = true;
+        break;
+    }
+
+    if (defs) {
+        const int deltaIndex = frameType == 'P' ? 1 : 0;
+
+        if (defs->count == 0 || (frameType == 'H' && defs->count < 2)) {
+            reader.invalid = true;
+        } else {
+            readFieldValues(&reader, defs->encoding[deltaIndex], defs->count, decoder->values);
+        }
+
+        if (frameType == 'P' && !decoder->mainHistoryValid) {
+            // Can't be predicted, but still has to be read to find where the next frame starts
+            predicted = false;
+        } else if (!reader.overrun && !reader.invalid) {
+            const bool history = frameType == 'P';
+
+            applyPredictors(decoder, &reader, defs, deltaIndex, decoder->values,
+                history ? decoder->mainHistory[0] : NULL, history ? decoder->mainHistory[1] : NULL);
+        }
+    }
+
+    if (reader.overrun && canWait) {
+        return 0;
+    }
+
+    // Frames have no length or checksum, so a frame is only accepted when the next one starts right after it
+    if (!reader.overrun && !reader.invalid && !(frameType == 'E' && event.event == FLIGHT_LOG_EVENT_LOG_END)) {
+        if (reader.pos == end) {
+            if (canWait) {
+                return 0;
+            }
+        } else if (frameTypeIndex(*reader.pos) < 0) {
+            reader.invalid = true;
+        }
+    }
+
+    if (reader.overrun || reader.invalid) {
+        decoder->stats.corruptBytes++;
+        decoder->mainHistoryValid = false;
+        return 1;
+    }
+
+    const int frameLength = reader.pos - start;
+    if (predicted) {
+        const int index = frameTypeIndex(frameType);
+
+        decoder->stats.frameCount[index]++;
+        decoder->stats.frameBytes[index] += frameLength;
+        commitFrame(decoder, frameType, &event);
+    } else {
+        decoder->stats.droppedFrames++;
+    }
+
+    return frameLength;
+}
+
+// Decoded blocks of compressed logs
+static int parseFrames(blackboxDecoder_t *decoder, const uint8_t *data, int length, bool final)
+{
+    const uint8_t *pos = data;
+    const uint8_t *const end = data + length;
+
+    while (pos < end) {
+        // Nothing useful follows the end of the log
+        if (decoder->mode != BLACKBOX_DECODER_COMPRESSED_FRAMES) {
+            return length;
+        }
+
+        const int frameLength = parseFrame(decoder, pos, end, final);
+        if (frameLength == 0) {
+            break;
+        }
+        pos += frameLength;
+    }
+
+    return pos - data;
+}
+
+/*
+ * Pass data to parse, which returns how much of it it used. Whatever is left is an incomplete unit that is kept in
+ * buffer and completed from the next data. Once the unit is parsed, parsing carries on in the caller's data.
+ */
+static void bufferFeed(blackboxDecoder_t *decoder, blackboxDecoderBuffer_t *buffer, const uint8_t *data, int length,
+    blackboxDecoderParseFn parse)
+{
+    while (length > 0) {
+        if (buffer->length == 0) {
+            const int used = parse(decoder, data, length, false);
+
+            buffer->length = length - used;
+            memcpy(buffer->data, data + used, buffer->length);
+            return;
+        }
+
+        const int carried = buffer->length;
+        const int copied = MIN(length, (int)sizeof(buffer->data) - carried);
+        memcpy(buffer->data + carried, data, copied);
+
+        const int used = parse(decoder, buffer->data, carried + copied, false);
+        if (used >= carried) {
+            buffer->length = 0;
+            data += used - carried;
+            length -= used - carried;
+        } else {
+            buffer->length = carried + copied - used;
+            memmove(buffer->data, buffer->data + used, buffer->length);
+            data += copied;
+            length -= copied;
+        }
+    }
+}
+
+static void bufferFinish(blackboxDecoder_t *decoder, blackboxDecoderBuffer_t *buffer, blackboxDecoderParseFn parse)
+{
+    int pos = 0;
+
+    while (pos < buffer->length) {
+        pos += parse(decoder, buffer->data + pos, buffer->length - pos, true);
+    }
+    buffer->length = 0;
+}
+
+static void parseIntList(const char *text, uint8_t *values)
+{
+    for (int i = 0; i < BLACKBOX_DECODER_MAX_FIELDS && *text; i++) {
+        char *next;
+
+        values[i] = strtol(text, &next, 10);
+        if (*next != ',') {
+            break;
+        }
+        text = next + 1;
+    }
+}
+
+static void parseFieldHeader(blackboxDecoder_t *decoder, char frameType, const char *property, const char *value)
+{
+    blackboxDecoderFieldDefs_t *defs;
+    const int deltaIndex = frameType == 'P' ? 1 : 0;
+
+    switch (frameType) {
+    case 'I':
+    case 'P':
+        defs = &decoder->fields[BLACKBOX_DECODER_FIELDS_MAIN];
+        break;
+    case 'G':
+        defs = &decoder->fields[BLACKBOX_DECODER_FIELDS_GPS];
+        break;
+    case 'H':
+        defs = &decoder->fields[BLACKBOX_DECODER_FIELDS_GPS_HOME];
+        break;
+    case 'S':
+        defs = &decoder->fields[BLACKBOX_DECODER_FIELDS_SLOW];
+        break;
+    default:
+        return;
+    }
+
+    if (strcmp(property, "name") == 0) {
+        strncpy(defs->names, value, sizeof(defs->names) - 1);
+
+        defs->count = 0;
+        for (char *name = defs->names; name && defs->count < BLACKBOX_DECODER_MAX_FIELDS; ) {
+            char *comma = strchr(name, ',');
+
+            defs->name[defs->count++] = name;
+            if (comma) {
+                *comma++ = '\0';
+            }
+            name = comma;
+        }
+    } else if (strcmp(property, "signed") == 0) {
+        parseIntList(value, defs->isSigned);
+    } else if (strcmp(property, "predictor") == 0) {
+        parseIntList(value, defs->predictor[deltaIndex]);
+    } else if (strcmp(property, "encoding") == 0) {
+        parseIntList(value, defs->encoding[deltaIndex]);
+    }
+}
+
+static void parseHeaderLine(blackboxDecoder_t *decoder, char *line)
+{
+    if (line[0] != 'H' || line[1] != ' ') {
+        return;
+    }
+
+    char *name = line + 2;
+    char *value = strchr(name, ':');
+    if (!value) {
+        return;
+    }
+    *value++ = '\0';
+
+    if (decoder->callbacks->header) {
+        decoder->callbacks->header(decoder->context, name, value);
+    }
+
+    if (strncmp(name, "Field ", 6) == 0 && name[6] && name[7] == ' ') {
+        parseFieldHeader(decoder, name[6], name + 8, value);
+    } else if (strcmp(name, "I interval") == 0) {
+        decoder->iInterval = atoi(value);
+    } else if (strcmp(name, "P interval") == 0) {
+        char *denom;
+        decoder->pIntervalNum = strtol(value, &denom, 10);
+        decoder->pIntervalDenom = *denom == '/' ? strtol(denom + 1, NULL, 10) : 1;
+    } else if (strcmp(name, "minthrottle") == 0) {
+        decoder->minthrottle = atoi(value);
+    } else if (strcmp(name, "vbatref") == 0) {
+        decoder->vbatref = atoi(value);
+    } else if (strcmp(name, "data_compression") == 0) {
+        decoder->compressed = true;
+        if (strcmp(value, BLACKBOX_COMPRESS_FORMAT) != 0) {
+            // Can't read this log, skip to the next one
+            decoder->mode = BLACKBOX_DECODER_SEARCH;
+        }
+    }
+}
+
+static int findField(const blackboxDecoderFieldDefs_t *defs, const char *name)
+{
+    for (int i = 0; i < defs->count; i++) {
+        if (strcmp(defs->name[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void endLog(blackboxDecoder_t *decoder)
+{
+    if (decoder->mode == BLACKBOX_DECODER_COMPRESSED_FRAMES) {
+        bufferFinish(decoder, &decoder->decompressed, parseFrames);
+    }
+    decoder->decompressed.length = 0;
+}
+
+static void beginLog(blackboxDecoder_t *decoder)
+{
+    endLog(decoder);
+
+    memset(decoder->fields, 0, sizeof(decoder->fields));
+    decoder->minthrottle = 0;
+    decoder->vbatref = 0;
+    decoder->iInterval = 32;
+    decoder->pIntervalNum = 1;
+    decoder->pIntervalDenom = 1;
+    decoder->compressed = false;
+    decoder->mainHistoryValid = false;
+    decoder->lastIteration = 0;
+    decoder->lastMainTime = 0;
+    decoder->gpsHome[0] = 0;
+    decoder->gpsHome[1] = 0;
+
+    decoder->mode = BLACKBOX_DECODER_HEADER;
+}
+
+static void beginFrames(blackboxDecoder_t *decoder)
+{
+    const blackboxDecoderFieldDefs_t *mainFields = &decoder->fields[BLACKBOX_DECODER_FIELDS_MAIN];
+
+    decoder->iterationField = findField(mainFields, "loopIteration");
+    decoder->timeField = findField(mainFields, "time");
+    decoder->motor0Field = findField(mainFields, "motor[0]");
+
+    // Settings that would stall the skipped frame count
+    if (decoder->iInterval < 1 || decoder->pIntervalNum < 1 || decoder->pIntervalDenom < 1) {
+        decoder->iInterval = 1;
+        decoder->pIntervalNum = 1;
+        decoder->pIntervalDenom = 1;
+    }
+
+    decoder->mode = decoder->compressed ? BLACKBOX_DECODER_COMPRESSED_FRAMES : BLACKBOX_DECODER_FRAMES;
+    decoder->stats.logCount++;
+
+    if (decoder->callbacks->logBegin) {
+        decoder->callbacks->logBegin(decoder->context, decoder);
+    }
+}
+
+// Returns 1 if a log starts at data, 0 if not, or -1 if there isn't enough data to tell
+static int matchLogStart(const uint8_t *data, const uint8_t *end)
+{
+    const int length = MIN(end - data, (int)LOG_START_LENGTH);
+
+    if (memcmp(data, LOG_START, length) != 0) {
+        return 0;
+    }
+    return length == LOG_START_LENGTH ? 1 : -1;
+}
+
+// Data as it was written to the device, headers followed by frames or compressed blocks, possibly of several logs
+static int parseInput(blackboxDecoder_t *decoder, const uint8_t *data, int length, bool final)
+{
+    const uint8_t *pos = data;
+    const uint8_t *const end = data + length;
+
+    while (pos < end) {
+        // Wait for more data only while the incomplete unit could still fit in the buffer
+        const bool canWait = !final && end - pos < BLACKBOX_DECODER_BUFFER_SIZE;
+
+        // Every log starts with the product header, whatever came before it
+        if (*pos == 'H' && decoder->mode != BLACKBOX_DECODER_HEADER) {
+            const int match = matchLogStart(pos, end);
+
+            if (match < 0 && canWait) {
+                break;
+            }
+            if (match > 0) {
+                beginLog(decoder);
+            }
+        }
+
+        switch (decoder->mode) {
+        case BLACKBOX_DECODER_SEARCH:
+            pos++;
+            break;
+
+        case BLACKBOX_DECODER_HEADER:
+        {
+            if (*pos != 'H') {
+                beginFrames(decoder);
+                break;
+            }
+
+            const uint8_t *lineEnd = memchr(pos, '\n', end - pos);
+            if (!lineEnd) {
+                if (canWait) {
+                    return pos - data;
+                }
+                lineEnd = end;
+            }
+
+            const int lineLength = MIN(lineEnd - pos, (int)sizeof(decoder->line) - 1);
+            memcpy(decoder->line, pos, lineLength);
+            decoder->line[lineLength] = '\0';
+            parseHeaderLine(decoder, decoder->line);
+
+            decoder->stats.headerBytes += MIN(lineEnd + 1, end) - pos;
+            pos = MIN(lineEnd + 1, end);
+            break;
+        }
+
+        case BLACKBOX_DECODER_FRAMES:
+        {
+            const int frameLength = parseFrame(decoder, pos, end, final);
+
+            if (frameLength == 0) {
+                return pos - data;
+            }
+            pos += frameLength;
+            break;
+        }
+
+        case BLACKBOX_DECODER_COMPRESSED_FRAMES:
+        {
+            int blockLength;
+            const int decodedLength = blackboxDecompressBlock(decoder->block, sizeof(decoder->block), pos, end - pos, &blockLength);
+
+            if (decodedLength == BLACKBOX_DECOMPRESS_INCOMPLETE && canWait) {
+                return pos - data;
+            }
+            if (decodedLength < 0) {
+                decoder->stats.corruptBytes++;
+                pos++;
+                break;
+            }
+
+            decoder->stats.compressedBlocks++;
+            decoder->stats.compressedBytes += blockLength;
+            pos += blockLength;
+
+            bufferFeed(decoder, &decoder->decompressed, decoder->block, decodedLength, parseFrames);
+            break;
+        }
+        }
+    }
+
+    return pos - data;
+}
+
+void blackboxDecoderInit(blackboxDecoder_t *decoder, const blackboxDecoderCallbacks_t *callbacks, void *context)
+{
+    memset(decoder, 0, sizeof(*decoder));
+
+    decoder->callbacks = callbacks;
+    decoder->context = context;
+    decoder->mode = BLACKBOX_DECODER_SEARCH;
+}
+
+/**
+ * Decode the next length bytes of the log. Callbacks are made for everything that can be decoded so far.
+ */
+void blackboxDecoderFeed(blackboxDecoder_t *decoder, const uint8_t *data, int length)
+{
+    bufferFeed(decoder, &decoder->input, data, length, parseInput);
+}
+
+/**
+ * Decode what is left at the end of the log, a frame at the very end is accepted without seeing the next one.
+ */
+void blackboxDecoderFinish(blackboxDecoder_t *decoder)
+{
+    bufferFinish(decoder, &decoder->input, parseInput);
+    endLog(decoder);
+}
@@ -0,0 +1,140 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "blackbox/blackbox_compress.h"
+#include "blackbox/blackbox_fielddefs.h"
+
+/*
+ * Streaming decoder for the logs written by blackbox.c, built for the host and not part of the firmware.
+ *
+ * The log is fed in chunks of any size as it is read. Frames are decoded straight from the caller's buffer, only a frame
+ * that straddles two chunks is copied. Files holding several logs, compressed logs and corrupted data are handled, after
+ * an invalid frame decoding resumes at the next byte that starts a valid one.
+ */
+
+#define BLACKBOX_DECODER_MAX_FIELDS         128
+#define BLACKBOX_DECODER_NAMES_SIZE         2048
+// Longest header line or frame, and the most data carried over between chunks
+#define BLACKBOX_DECODER_BUFFER_SIZE        4096
+#define BLACKBOX_DECODER_MESSAGE_SIZE       128
+
+// Frame types in the order of blackboxDecoderStats_t
+#define BLACKBOX_DECODER_FRAME_TYPES        "IPGHSE"
+#define BLACKBOX_DECODER_FRAME_TYPE_COUNT   6
+
+typedef enum {
+    BLACKBOX_DECODER_FIELDS_MAIN = 0,       // I and P frames
+    BLACKBOX_DECODER_FIELDS_GPS,            // G frames
+    BLACKBOX_DECODER_FIELDS_GPS_HOME,       // H frames
+    BLACKBOX_DECODER_FIELDS_SLOW,           // S frames
+    BLACKBOX_DECODER_FIELDS_COUNT
+} blackboxDecoderFields_e;
+
+typedef enum {
+    BLACKBOX_DECODER_SEARCH = 0,            // Skipping to the start of the next log
+    BLACKBOX_DECODER_HEADER,
+    BLACKBOX_DECODER_FRAMES,
+    BLACKBOX_DECODER_COMPRESSED_FRAMES,
+} blackboxDecoderMode_e;
+
+typedef struct blackboxDecoderFieldDefs_s {
+    int count;
+    const char *name[BLACKBOX_DECODER_MAX_FIELDS];
+    uint8_t isSigned[BLACKBOX_DECODER_MAX_FIELDS];
+    // Index 0 holds I frames and frames without deltas, index 1 P frames
+    uint8_t predictor[2][BLACKBOX_DECODER_MAX_FIELDS];
+    uint8_t encoding[2][BLACKBOX_DECODER_MAX_FIELDS];
+    char names[BLACKBOX_DECODER_NAMES_SIZE];
+} blackboxDecoderFieldDefs_t;
+
+typedef struct blackboxDecoderEvent_s {
+    FlightLogEvent event;
+    flightLogEventData_t data;
+    const char *message;                    // Text of FLIGHT_LOG_EVENT_LOG_END, NULL for other events
+} blackboxDecoderEvent_t;
+
+typedef struct blackboxDecoderStats_s {
+    uint32_t logCount;
+    uint32_t frameCount[BLACKBOX_DECODER_FRAME_TYPE_COUNT];
+    uint32_t frameBytes[BLACKBOX_DECODER_FRAME_TYPE_COUNT];
+    uint32_t headerBytes;
+    uint32_t compressedBlocks;
+    uint32_t compressedBytes;
+    uint32_t corruptBytes;                  // Bytes skipped looking for a valid frame or block
+    uint32_t droppedFrames;                 // P frames without a valid frame to predict from
+} blackboxDecoderStats_t;
+
+struct blackboxDecoder_s;
+
+// All callbacks are optional
+typedef struct blackboxDecoderCallbacks_s {
+    void (*header)(void *context, const char *name, const char *value);
+    // Called before the first frame of each log, the field definitions and log settings are known from here
+    void (*logBegin)(void *context, const struct blackboxDecoder_s *decoder);
+    void (*frame)(void *context, char frameType, const int32_t *values, int valueCount);
+    void (*event)(void *context, const blackboxDecoderEvent_t *event);
+} blackboxDecoderCallbacks_t;
+
+typedef struct blackboxDecoderBuffer_s {
+    uint8_t data[BLACKBOX_DECODER_BUFFER_SIZE];
+    int length;
+} blackboxDecoderBuffer_t;
+
+typedef struct blackboxDecoder_s {
+    const blackboxDecoderCallbacks_t *callbacks;
+    void *context;
+    blackboxDecoderMode_e mode;
+
+    // Settings of the current log from its headers
+    blackboxDecoderFieldDefs_t fields[BLACKBOX_DECODER_FIELDS_COUNT];
+    int32_t minthrottle;
+    int32_t vbatref;
+    uint32_t iInterval;
+    uint32_t pIntervalNum;
+    uint32_t pIntervalDenom;
+    bool compressed;
+
+    int iterationField;
+    int timeField;
+    int motor0Field;
+
+    // Main frame history, [0] is the last frame and [1] the one before it
+    int32_t mainHistory[2][BLACKBOX_DECODER_MAX_FIELDS];
+    bool mainHistoryValid;
+    uint32_t lastIteration;
+    uint32_t lastMainTime;
+    int32_t gpsHome[2];
+
+    int32_t values[BLACKBOX_DECODER_MAX_FIELDS + 8];
+    char line[BLACKBOX_DECODER_BUFFER_SIZE];
+    char message[BLACKBOX_DECODER_MESSAGE_SIZE];
+    uint8_t block[BLACKBOX_COMPRESS_BLOCK_SIZE];
+
+    blackboxDecoderBuffer_t input;
+    blackboxDecoderBuffer_t decompressed;
+
+    blackboxDecoderStats_t stats;
+} blackboxDecoder_t;
+
+void blackboxDecoderInit(blackboxDecoder_t *decoder, const blackboxDecoderCallbacks_t *callbacks, void *context);
+void blackboxDecoderFeed(blackboxDecoder_t *decoder, const uint8_t *data, int length);
+void blackboxDecoderFinish(blackboxDecoder_t *decoder);
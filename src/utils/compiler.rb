@@ -35,7 +35,7 @@ class Compiler
         # are some issues with the built-in search by spawn()
         # on Windows if PATH contains spaces.
         dirs = (ENV["PATH"] || "").split(File::PATH_SEPARATOR)
-        bin = "arm-none-eabi-g++"
+        bin = ENV["SETTINGS_CXX"] || "arm-none-eabi-g++"
         dirs.each do |dir|
             p = File.join(dir, bin)
 			if File::ALT_SEPARATOR
@@ -184,6 +184,66 @@ class NameEncoder
     end
 end
 
+# Minimal perfect hash over the setting names, used by settingFind().
+# Names are split into buckets by a first hash, then every bucket gets
+# a seed for a second hash which puts all its names into free slots.
+# The hash must match settingNameHash() in fc/settings.c.
+class NameHash
+    FNV_OFFSET_BASIS = 2166136261
+    FNV_PRIME = 16777619
+    MAX_SEED = 0xffff
+
+    attr_reader :bucket_count
+    attr_reader :seeds
+    attr_reader :slots
+
+    def self.hash(name, seed)
+        h = FNV_OFFSET_BASIS ^ seed
+        name.each_byte do |c|
+            h = ((h ^ c) * FNV_PRIME) & 0xffffffff
+        end
+        return h
+    end
+
+    def initialize(names)
+        @names = names
+        # Average of 4 names per bucket, add buckets until all seeds fit
+        bucket_count = [(names.length + 3) / 4, 1].max
+        while !build(bucket_count)
+            bucket_count += 1
+            raise "Could not build settings name hash" if bucket_count > names.length * 2
+        end
+    end
+
+    private
+    def build(bucket_count)
+        count = @names.length
+        buckets = Array.new(bucket_count) { [] }
+        @names.each_with_index do |name, ii|
+            buckets[NameHash.hash(name, 0) % bucket_count] << ii
+        end
+        slots = Array.new(count)
+        seeds = Array.new(bucket_count, 0)
+        # Place the biggest buckets first, while most slots are free
+        (0...bucket_count).sort_by { |b| [-buckets[b].length, b] }.each do |b|
+            next if buckets[b].empty?
+            seed = (1..MAX_SEED).find do |candidate|
+                pos = buckets[b].map { |ii| NameHash.hash(@names[ii], candidate) % count }
+                pos.uniq.length == pos.length && pos.all? { |p| slots[p].nil? }
+            end
+            return false if seed.nil?
+            buckets[b].each do |ii|
+                slots[NameHash.hash(@names[ii], seed) % count] = ii
+            end
+            seeds[b] = seed
+        end
+        @bucket_count = bucket_count
+        @seeds = seeds
+        @slots = slots
+        return true
+    end
+end
+
 class ValueEncoder
     attr_reader :values
 
@@ -301,6 +361,7 @@ class Generator
 
         sanitize_fields
         initialize_name_encoder
+        initialize_name_hash
         initialize_value_encoder
 
         write_header_file(header_file)
@@ -337,6 +398,7 @@ class Generator
         puts "name encoder uses #{word_idx} word indexing"
         puts "each setting name uses #{@name_encoder.max_length} bytes"
         puts "#{@name_encoder.estimated_size(@count)} bytes estimated for setting name storage"
+        puts "name hash uses #{@name_hash.bucket_count} buckets, #{(@name_hash.bucket_count + @count) * 2} bytes"
         values_size = @value_encoder.values.length * 4
         puts "min/max value storage uses #{values_size} bytes"
         value_idx_size = @value_encoder.index_bytes * 2
@@ -590,6 +652,19 @@ class Generator
         end
         buf << "};\n"
 
+        # Write name hash tables
+        buf << "#define SETTINGS_NAME_HASH_BUCKETS #{@name_hash.bucket_count}\n"
+        buf << "static const uint16_t settingsNameHashSeeds[] = {\n"
+        @name_hash.seeds.each_slice(16) do |s|
+            buf << "\t#{s.join(", ")},\n"
+        end
+        buf << "};\n"
+        buf << "static const uint16_t settingsNameHashSlots[] = {\n"
+        @name_hash.slots.each_slice(16) do |s|
+            buf << "\t#{s.join(", ")},\n"
+        end
+        buf << "};\n"
+
         File.open(file, 'w') {|file| file.write(buf.string)}
     end
 
@@ -881,6 +956,14 @@ class Generator
         @name_encoder = best
     end
 
+    def initialize_name_hash
+        names = []
+        foreach_enabled_member do |group, member|
+            names << member["name"]
+        end
+        @name_hash = NameHash.new(names)
+    end
+
     def initialize_value_encoder
         values = []
         constants = []